@@ -0,0 +1,106 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jaume Nin <jaume.nin@cttc,cat>
+ * Based on NodeList implementation by Mathieu Lacage  <mathieu.lacage@sophia.inria.fr>
+ *
+ */
+
+#ifndef BUILDING_LIST_H_
+#define BUILDING_LIST_H_
+
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+class Building;
+
+class BuildingList
+{
+public:
+  typedef std::vector< Ptr<Building> >::const_iterator Iterator;
+
+  /**
+   * \param building building to add
+   * \returns index of building in list.
+   *
+   * This method is called automatically from Building::Building so
+   * the user has little reason to call it himself.
+   */
+  static uint32_t Add (Ptr<Building> building);
+  /**
+   * \returns a C++ iterator located at the beginning of this
+   *          list.
+   */
+  static Iterator Begin (void);
+  /**
+   * \returns a C++ iterator located at the end of this
+   *          list.
+   */
+  static Iterator End (void);
+  /**
+   * \param n index of requested building.
+   * \returns the Building associated to index n.
+   */
+  static Ptr<Building> GetBuilding (uint32_t n);
+  /**
+   * \returns the number of buildings currently in the list.
+   */
+  static uint32_t GetNBuildings (void);
+  /**
+   * \param position the position to look up.
+   * \returns the buildings which contain the position, in the order of
+   *          this list.
+   *
+   * The buildings are looked up in a uniform 2D grid over their
+   * footprints, so only the buildings near the position are checked
+   * with Building::IsInside.
+   */
+  static std::vector<Ptr<Building> > GetBuildingsContaining (const Vector &position);
+  /**
+   * \param l1 one end of the line segment.
+   * \param l2 the other end of the line segment.
+   * \returns the buildings intersected by the line segment, in the
+   *          order of this list.
+   *
+   * Only the buildings in the grid cells crossed by the segment are
+   * checked with Building::IsIntersect.
+   */
+  static std::vector<Ptr<Building> > GetBuildingsIntersecting (const Vector &l1, const Vector &l2);
+  /**
+   * \param l1 one end of the line segment.
+   * \param l2 the other end of the line segment.
+   * \returns true if at least one building intersects the line segment.
+   */
+  static bool IsAnyBuildingIntersected (const Vector &l1, const Vector &l2);
+  /**
+   * Invalidate the grid of the buildings, which is rebuilt at the next
+   * query.
+   *
+   * This method is called automatically from Building::SetBoundaries so
+   * the user has little reason to call it himself.
+   */
+  static void NotifyBoundariesChanged (void);
+};
+
+} // namespace ns3
+
+#endif /* BUILDING_LIST_H_ */
+
+
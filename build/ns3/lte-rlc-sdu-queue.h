@@ -0,0 +1,137 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_RLC_SDU_QUEUE_H
+#define LTE_RLC_SDU_QUEUE_H
+
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+
+#include <deque>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Transmission buffer of RLC SDUs
+ *
+ * The RLC entities take the SDUs from the head of the transmission buffer
+ * and, when an SDU is segmented, give back the remaining segment to the
+ * head. The queue is a chunked deque, so that both operations take constant
+ * time, independently of the number of buffered SDUs. The total size in
+ * bytes of the queued SDUs is kept up to date by every operation.
+ */
+class LteRlcSduQueue
+{
+public:
+  /// Const iterator over the SDUs, from the head to the tail
+  typedef std::deque<Ptr<Packet> >::const_iterator ConstIterator;
+
+  LteRlcSduQueue ();
+
+  /**
+   * Appends an SDU at the tail of the queue
+   *
+   * \param p the SDU
+   */
+  void PushBack (Ptr<Packet> p);
+
+  /**
+   * Inserts an SDU at the head of the queue, e.g., the segment of an SDU
+   * given back after segmentation
+   *
+   * \param p the SDU
+   */
+  void PushFront (Ptr<Packet> p);
+
+  /**
+   * Removes the SDU at the head of the queue
+   *
+   * \return the SDU
+   */
+  Ptr<Packet> PopFront (void);
+
+  /**
+   * \return the SDU at the head of the queue, which must not be empty
+   */
+  Ptr<Packet> Front (void) const;
+
+  /**
+   * \param i the position of the SDU, starting from the head
+   * \return the SDU
+   */
+  Ptr<Packet> Get (uint32_t i) const;
+
+  /**
+   * \return true if the queue is empty
+   */
+  bool IsEmpty (void) const;
+
+  /**
+   * \return the number of SDUs in the queue
+   */
+  uint32_t GetNPackets (void) const;
+
+  /**
+   * \return the total size of the SDUs in the queue, in bytes
+   */
+  uint32_t GetNBytes (void) const;
+
+  /**
+   * Removes all the SDUs
+   */
+  void Clear (void);
+
+  /**
+   * Exchanges the content of two queues, in constant time
+   *
+   * \param other the other queue
+   */
+  void Swap (LteRlcSduQueue &other);
+
+  /**
+   * Moves all the SDUs of another queue to the tail of this queue. The other
+   * queue is left empty.
+   *
+   * \param other the other queue
+   */
+  void Append (LteRlcSduQueue &other);
+
+  /**
+   * \return an iterator to the head of the queue
+   */
+  ConstIterator Begin (void) const;
+
+  /**
+   * \return an iterator past the tail of the queue
+   */
+  ConstIterator End (void) const;
+
+  /**
+   * \return a vector with the SDUs, from the head to the tail
+   */
+  std::vector<Ptr<Packet> > ToVector (void) const;
+
+private:
+  std::deque<Ptr<Packet> > m_sdus; ///< the SDUs
+  uint32_t m_nBytes; ///< the total size of the SDUs in bytes
+};
+
+} // namespace ns3
+
+#endif // LTE_RLC_SDU_QUEUE_H
@@ -0,0 +1,418 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ * Copyright (c) 2020 Institute for the Wireless Internet of Things,
+ * Northeastern University
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MATRIX_BASED_CHANNEL_H
+#define MATRIX_BASED_CHANNEL_H
+
+#include <complex.h>
+#include <ns3/object.h>
+#include <ns3/nstime.h>
+#include <ns3/vector.h>
+#include <ns3/three-gpp-antenna-array-model.h>
+#include <tuple>
+#include <stdexcept>
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup spectrum
+ *
+ * This is an interface for a channel model that can be described
+ * by a channel matrix, e.g., the 3GPP Spatial Channel Models,
+ * which is generally used in combination with antenna arrays
+ */
+class MatrixBasedChannelModel : public Object
+{
+public:
+  /**
+   * Destructor for MatrixBasedChannelModel
+   */
+  virtual ~MatrixBasedChannelModel ();
+
+  typedef std::vector<double> DoubleVector; //!< type definition for vectors of doubles
+  typedef std::vector<DoubleVector> Double2DVector; //!< type definition for matrices of doubles
+  typedef std::vector<Double2DVector> Double3DVector; //!< type definition for 3D matrices of doubles
+  typedef std::vector<ThreeGppAntennaArrayModel::ComplexVector> Complex2DVector; //!< type definition for complex matrices
+  typedef std::vector<Complex2DVector> Complex3DVector; //!< type definition for complex 3D matrices
+
+  /**
+   * Contiguous storage for a complex 3D matrix H[u][s][n], such as the
+   * channel matrix.
+   *
+   * All the elements are stored in a single buffer. The n-th page, i.e., the
+   * matrix H[.][.][n], is stored in column-major order, so that the elements
+   * H[0][s][n], ..., H[U-1][s][n] are contiguous in memory.
+   *
+   * The elements can be accessed either with operator () or with the
+   * strided views returned by operator [], which provide the same
+   * [u][s][n] accessors of Complex3DVector. Objects of type Complex3DVector
+   * are implicitly converted to and from this type.
+   */
+  class Complex3DTensor
+  {
+  public:
+    /**
+     * Strided view over the elements of a vector of the tensor
+     */
+    template <class T>
+    class VectorView
+    {
+    public:
+      /**
+       * Constructor
+       * \param data pointer to the first element
+       * \param stride distance between two consecutive elements
+       * \param size number of elements
+       */
+      VectorView (T *data, size_t stride, size_t size)
+        : m_data (data), m_stride (stride), m_size (size)
+      {
+      }
+
+      /**
+       * \return the number of elements
+       */
+      size_t size () const
+      {
+        return m_size;
+      }
+
+      /**
+       * \param i the element index
+       * \return a reference to the i-th element
+       */
+      T& operator[] (size_t i) const
+      {
+        return m_data[i * m_stride];
+      }
+
+      /**
+       * \param i the element index
+       * \return a reference to the i-th element, after checking the bounds
+       */
+      T& at (size_t i) const
+      {
+        if (i >= m_size)
+          {
+            throw std::out_of_range ("Complex3DTensor index out of range");
+          }
+        return m_data[i * m_stride];
+      }
+
+    private:
+      T *m_data; //!< pointer to the first element
+      size_t m_stride; //!< distance between two consecutive elements
+      size_t m_size; //!< number of elements
+    };
+
+    /**
+     * Strided view over the elements H[u][.][.] of the tensor
+     */
+    template <class T>
+    class MatrixView
+    {
+    public:
+      /**
+       * Constructor
+       * \param data pointer to the element H[u][0][0]
+       * \param uSize the first dimension of the tensor
+       * \param sSize the second dimension of the tensor
+       * \param nSize the third dimension of the tensor
+       */
+      MatrixView (T *data, size_t uSize, size_t sSize, size_t nSize)
+        : m_data (data), m_uSize (uSize), m_sSize (sSize), m_nSize (nSize)
+      {
+      }
+
+      /**
+       * \return the second dimension of the tensor
+       */
+      size_t size () const
+      {
+        return m_sSize;
+      }
+
+      /**
+       * \param s the index of the second dimension
+       * \return a view over the elements H[u][s][.]
+       */
+      VectorView<T> operator[] (size_t s) const
+      {
+        return VectorView<T> (m_data + s * m_uSize, m_uSize * m_sSize, m_nSize);
+      }
+
+      /**
+       * \param s the index of the second dimension
+       * \return a view over the elements H[u][s][.], after checking the bounds
+       */
+      VectorView<T> at (size_t s) const
+      {
+        if (s >= m_sSize)
+          {
+            throw std::out_of_range ("Complex3DTensor index out of range");
+          }
+        return (*this)[s];
+      }
+
+    private:
+      T *m_data; //!< pointer to the element H[u][0][0]
+      size_t m_uSize; //!< the first dimension of the tensor
+      size_t m_sSize; //!< the second dimension of the tensor
+      size_t m_nSize; //!< the third dimension of the tensor
+    };
+
+    /**
+     * Create an empty tensor
+     */
+    Complex3DTensor ()
+      : m_uSize (0), m_sSize (0), m_nSize (0)
+    {
+    }
+
+    /**
+     * Create a tensor with the given dimensions and all the elements equal
+     * to zero
+     * \param uSize the first dimension
+     * \param sSize the second dimension
+     * \param nSize the third dimension
+     */
+    Complex3DTensor (size_t uSize, size_t sSize, size_t nSize)
+      : m_data (uSize * sSize * nSize),
+        m_uSize (uSize), m_sSize (sSize), m_nSize (nSize)
+    {
+    }
+
+    /**
+     * Create a tensor with the same elements of a Complex3DVector
+     * \param v the Complex3DVector H[u][s][n]. All the vectors H[u] and
+     *        H[u][s] must have the same size.
+     */
+    Complex3DTensor (const Complex3DVector &v);
+
+    /**
+     * Convert the tensor to a Complex3DVector
+     * \return the Complex3DVector H[u][s][n]
+     */
+    operator Complex3DVector () const;
+
+    /**
+     * \return the first dimension of the tensor
+     */
+    size_t size () const
+    {
+      return m_uSize;
+    }
+
+    /**
+     * \return the first dimension of the tensor
+     */
+    size_t GetUSize () const
+    {
+      return m_uSize;
+    }
+
+    /**
+     * \return the second dimension of the tensor
+     */
+    size_t GetSSize () const
+    {
+      return m_sSize;
+    }
+
+    /**
+     * \return the third dimension of the tensor
+     */
+    size_t GetNSize () const
+    {
+      return m_nSize;
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \param s the index of the second dimension
+     * \param n the index of the third dimension
+     * \return a reference to the element H[u][s][n]
+     */
+    std::complex<double>& operator() (size_t u, size_t s, size_t n)
+    {
+      return m_data[(n * m_sSize + s) * m_uSize + u];
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \param s the index of the second dimension
+     * \param n the index of the third dimension
+     * \return a const reference to the element H[u][s][n]
+     */
+    const std::complex<double>& operator() (size_t u, size_t s, size_t n) const
+    {
+      return m_data[(n * m_sSize + s) * m_uSize + u];
+    }
+
+    /**
+     * \param n the index of the third dimension
+     * \return a pointer to the n-th page, which is stored in column-major order
+     */
+    std::complex<double>* GetPage (size_t n)
+    {
+      return m_data.data () + n * m_uSize * m_sSize;
+    }
+
+    /**
+     * \param n the index of the third dimension
+     * \return a const pointer to the n-th page, which is stored in column-major order
+     */
+    const std::complex<double>* GetPage (size_t n) const
+    {
+      return m_data.data () + n * m_uSize * m_sSize;
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \return a view over the elements H[u][.][.]
+     */
+    MatrixView<std::complex<double> > operator[] (size_t u)
+    {
+      return MatrixView<std::complex<double> > (m_data.data () + u, m_uSize, m_sSize, m_nSize);
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \return a const view over the elements H[u][.][.]
+     */
+    MatrixView<const std::complex<double> > operator[] (size_t u) const
+    {
+      return MatrixView<const std::complex<double> > (m_data.data () + u, m_uSize, m_sSize, m_nSize);
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \return a view over the elements H[u][.][.], after checking the bounds
+     */
+    MatrixView<std::complex<double> > at (size_t u)
+    {
+      if (u >= m_uSize)
+        {
+          throw std::out_of_range ("Complex3DTensor index out of range");
+        }
+      return (*this)[u];
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \return a const view over the elements H[u][.][.], after checking the bounds
+     */
+    MatrixView<const std::complex<double> > at (size_t u) const
+    {
+      if (u >= m_uSize)
+        {
+          throw std::out_of_range ("Complex3DTensor index out of range");
+        }
+      return (*this)[u];
+    }
+
+  private:
+    std::vector<std::complex<double> > m_data; //!< the elements of the tensor
+    size_t m_uSize; //!< the first dimension
+    size_t m_sSize; //!< the second dimension
+    size_t m_nSize; //!< the third dimension
+  };
+
+
+  /**
+   * Data structure that stores a channel realization
+   */
+  struct ChannelMatrix : public SimpleRefCount<ChannelMatrix>
+  {
+    Complex3DTensor    m_channel; //!< channel matrix H[u][s][n].
+    DoubleVector       m_delay; //!< cluster delay in nanoseconds.
+    Double2DVector     m_angle; //!< cluster angle angle[direction][n], where direction = 0(AOA), 1(ZOA), 2(AOD), 3(ZOD) in degree.
+    Time               m_generatedTime; //!< generation time
+    std::pair<uint32_t, uint32_t> m_nodeIds; //!< the first element is the s-node ID (the transmitter when the channel was generated), the second element is the u-node ID (the receiver when the channel was generated)
+
+    /**
+     * Destructor for ChannelMatrix
+     */
+    virtual ~ChannelMatrix () = default;
+    
+    /**
+     * Returns true if the ChannelMatrix object was generated
+     * considering node b as transmitter and node a as receiver.
+     * \param aId id of the a node
+     * \param bId id of the b node
+     * \return true if b is the rx and a is the tx, false otherwise
+     */
+    bool IsReverse (const uint32_t aId, const uint32_t bId) const
+    {
+      uint32_t sId, uId;
+      std::tie (sId, uId) = m_nodeIds;
+      NS_ASSERT_MSG ((sId == aId && uId == bId) || (sId == bId && uId == aId),
+                      "This matrix represents the channel between " << sId << " and " << uId);
+      return (sId == bId && uId == aId);
+    }
+  };
+
+  /**
+   * Returns a matrix with a realization of the channel between
+   * the nodes with mobility objects passed as input parameters.
+   *
+   * We assume channel reciprocity between each node pair (i.e., H_ab = H_ba^T),
+   * therefore GetChannel (a, b) and GetChannel (b, a) will return the same
+   * ChannelMatrix object.
+   * To understand if the channel matrix corresponds to H_ab or H_ba, we provide
+   * the method ChannelMatrix::IsReverse. For instance, if the channel
+   * matrix corresponds to H_ab, a call to IsReverse (idA, idB) will return
+   * false, conversely, IsReverse (idB, idA) will return true.
+   *
+   * \param aMob mobility model of the a device
+   * \param bMob mobility model of the b device
+   * \param aAntenna antenna of the a device
+   * \param bAntenna antenna of the b device
+   * \return the channel matrix
+   */
+  virtual Ptr<const ChannelMatrix> GetChannel (Ptr<const MobilityModel> aMob,
+                                               Ptr<const MobilityModel> bMob,
+                                               Ptr<const ThreeGppAntennaArrayModel> aAntenna,
+                                               Ptr<const ThreeGppAntennaArrayModel> bAntenna) = 0;
+  
+  /**
+   * Calculate the channel key using the Cantor function
+   * \param x1 first value
+   * \param x2 second value
+   * \return \f$ (((x1 + x2) * (x1 + x2 + 1))/2) + x2; \f$
+   */
+  static constexpr uint32_t GetKey (uint32_t x1, uint32_t x2)
+  {
+   return (((x1 + x2) * (x1 + x2 + 1)) / 2) + x2;
+  }
+
+  static const uint8_t AOA_INDEX = 0; //!< index of the AOA value in the m_angle array
+  static const uint8_t ZOA_INDEX = 1; //!< index of the ZOA value in the m_angle array
+  static const uint8_t AOD_INDEX = 2; //!< index of the AOD value in the m_angle array
+  static const uint8_t ZOD_INDEX = 3; //!< index of the ZOD value in the m_angle array
+
+};
+
+}; // namespace ns3
+
+#endif // MATRIX_BASED_CHANNEL_H
@@ -0,0 +1,142 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+*   Copyright (c) 2015, NYU WIRELESS, Tandon School of Engineering, New York University
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*   Author: Marco Miozzo <marco.miozzo@cttc.es>
+*           Nicola Baldo  <nbaldo@cttc.es>
+*
+*   Modified by: Marco Mezzavilla < mezzavilla@nyu.edu>
+*                         Sourjya Dutta <sdutta@nyu.edu>
+*                         Russell Ford <russell.ford@nyu.edu>
+*                         Menglei Zhang <menglei@nyu.edu>
+*/
+
+
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_AMC_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_AMC_H_
+#include <ns3/object.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/mmwave-phy-mac-common.h>
+#include <map>
+
+namespace ns3 {
+
+namespace mmwave {
+
+class MmWaveAmc : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  MmWaveAmc ();
+  MmWaveAmc (Ptr<MmWavePhyMacCommon> ConfigParams);
+  virtual ~MmWaveAmc ();
+  enum AmcModel
+  {
+    PiroEW2010,
+    MiErrorModel             // model based on 10% of BER according to LteMiErrorModel
+  };
+
+  int GetMcsFromCqi (int cqi);
+  int GetTbSizeFromMcs (unsigned mcs, unsigned nprb);
+  int GetTbSizeFromMcsSymbols (unsigned mcs, unsigned nsym);        // for TDMA
+  int GetNumSymbolsFromTbsMcs (unsigned tbSize, unsigned mcs);
+  /**
+   * Returns the minimum number of symbols of a slot needed to transmit a
+   * buffer with a given MCS, or all the symbols of the slot if the buffer
+   * does not fit in a slot
+   * \param mcs the MCS
+   * \param bufSize the size of the buffer in bytes
+   * \param tbSize set to the size in bytes of the TB with the returned number of symbols
+   * \return the number of symbols
+   */
+  unsigned GetMinNumSymbolsFromBufSize (unsigned mcs, unsigned bufSize, unsigned &tbSize);
+  std::vector<int> CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize);
+  std::vector<int> CreateCqiFeedbacksTdma (const SpectrumValue& sinr, uint8_t numSym);
+  int CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t numSym, uint32_t tbs, int &mcsWb);
+  int GetCqiFromSpectralEfficiency (double s);
+  int GetMcsFromSpectralEfficiency (double s);
+
+  static const unsigned int m_crcLen = 24;
+
+private:
+  /**
+   * Builds the table of the minimum MI which guarantees a TBLER lower than
+   * 10 % for each MCS. Within each modulation, the threshold of an MCS is
+   * not lower than the thresholds of the lower MCSs, so that the MCSs which
+   * meet the target are contiguous.
+   * \param tbSizes the size in bytes of the TB for each MCS
+   * \return the MI thresholds
+   */
+  static std::vector<double> CreateMiThresholds (const std::vector<uint32_t> &tbSizes);
+
+  /**
+   * Finds the first MCS which does not guarantee a TBLER lower than 10 %,
+   * with a binary search within each modulation
+   * \param sinr the SINR
+   * \param map the RBs (or chunks) of the TB
+   * \param miThresholds the table built by CreateMiThresholds
+   * \return the first MCS which does not meet the target, or 29 if all of them do
+   */
+  static uint8_t GetFirstFailingMcs (const SpectrumValue& sinr, const std::vector<int>& map, const std::vector<double> &miThresholds);
+
+  /**
+   * Maps the first MCS which does not meet the target TBLER to the
+   * selected MCS and CQI
+   * \param firstFailingMcs the value returned by GetFirstFailingMcs
+   * \param strict if true, select the highest CQI with a spectral efficiency
+   *        strictly lower than the one of the MCS
+   * \param mcs the selected MCS
+   * \return the CQI
+   */
+  static int GetCqiFromFirstFailingMcs (uint8_t firstFailingMcs, bool strict, uint8_t &mcs);
+
+  /**
+   * Computes the TB size for an MCS and a number of symbols
+   * \param mcs the MCS
+   * \param nsymb the number of symbols
+   * \param rscElementPerSym the number of resource elements per symbol
+   * \return the TB size in bits
+   */
+  static int CalcTbSizeFromMcsSymbols (unsigned mcs, unsigned nsymb, int rscElementPerSym);
+
+  /**
+   * Builds the table of the TB sizes for each MCS and number of symbols of a
+   * slot, if it has not been built yet or if the configuration has changed
+   */
+  void UpdateTbSizeTable ();
+
+  double m_ber;
+  AmcModel m_amcModel;
+
+  std::map<uint8_t, std::vector<double> > m_miThresholdsRbg; //!< the MI thresholds used by CreateCqiFeedbacks, for each RBG size
+  std::map<uint8_t, std::vector<double> > m_miThresholdsSym; //!< the MI thresholds used by CreateCqiFeedbacksTdma, for each number of symbols
+  std::map<uint32_t, std::vector<double> > m_miThresholdsTbs; //!< the MI thresholds used by CreateCqiFeedbackWbTdma, for each TB size
+
+  std::vector<int> m_tbSizeTable; //!< the TB size in bits for each MCS and number of symbols between 0 and m_tbSizeTableNumSym
+  int m_tbSizeTableRscPerSym; //!< the number of resource elements per symbol used to build m_tbSizeTable
+  unsigned m_tbSizeTableNumSym; //!< the number of symbols per slot used to build m_tbSizeTable
+
+  Ptr<MmWavePhyMacCommon> m_phyMacConfig;
+  Ptr<SpectrumModel> m_lteRbModel;
+};
+
+} // end namespace mmwave
+
+} // end namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_AMC_H_ */
@@ -0,0 +1,309 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef MMWAVE_INDEXED_HEAP_H
+#define MMWAVE_INDEXED_HEAP_H
+
+#include <ns3/assert.h>
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * \brief Indexed d-ary heap of pointers, used by the schedulers to select
+ * the UE or the flow with the highest priority
+ *
+ * The priority is defined by a comparison function, which returns true if
+ * the first element has a higher priority than the second one, as the
+ * functions passed to std::sort by the schedulers. Each element stores its
+ * position in the heap in the member given by the Index template parameter,
+ * so that an element whose priority changes can be moved to its new
+ * position in O(log n), without sorting all the elements again.
+ *
+ * An element can be in at most one heap at a time.
+ */
+template <class T, uint32_t T::*Index, unsigned D = 4>
+class MmWaveIndexedHeap
+{
+public:
+  /**
+   * Comparison function
+   * \return true if the first element has a higher priority than the second one
+   */
+  typedef bool (*Compare) (T*, T*);
+
+  /**
+   * Constructor
+   * \param compare the comparison function
+   */
+  MmWaveIndexedHeap (Compare compare = 0)
+    : m_compare (compare)
+  {
+  }
+
+  /**
+   * Sets the comparison function. The heap must be empty.
+   * \param compare the comparison function
+   */
+  void SetCompare (Compare compare)
+  {
+    NS_ASSERT (m_heap.empty ());
+    m_compare = compare;
+  }
+
+  /**
+   * Removes all the elements. The storage is kept.
+   */
+  void Clear ()
+  {
+    m_heap.clear ();
+  }
+
+  /**
+   * \return true if the heap is empty
+   */
+  bool Empty () const
+  {
+    return m_heap.empty ();
+  }
+
+  /**
+   * \return the number of elements in the heap
+   */
+  size_t Size () const
+  {
+    return m_heap.size ();
+  }
+
+  /**
+   * Replaces the content of the heap with a range of elements, in O(n)
+   * \param first the first element
+   * \param last the element after the last one
+   */
+  template <class Iterator>
+  void Assign (Iterator first, Iterator last)
+  {
+    m_heap.assign (first, last);
+    for (uint32_t pos = 0; pos < m_heap.size (); pos++)
+      {
+        m_heap[pos]->*Index = pos;
+      }
+    if (m_heap.size () > 1)
+      {
+        // sift down the internal nodes, starting from the parent of the last element
+        for (uint32_t pos = (m_heap.size () - 2) / D + 1; pos > 0; pos--)
+          {
+            SiftDown (pos - 1);
+          }
+      }
+  }
+
+  /**
+   * Inserts an element
+   * \param element the element
+   */
+  void Push (T* element)
+  {
+    m_heap.push_back (element);
+    SiftUp (m_heap.size () - 1);
+  }
+
+  /**
+   * \return the element with the highest priority
+   */
+  T* Top () const
+  {
+    NS_ASSERT (!m_heap.empty ());
+    return m_heap.front ();
+  }
+
+  /**
+   * Removes the element with the highest priority
+   */
+  void Pop ()
+  {
+    NS_ASSERT (!m_heap.empty ());
+    RemoveAt (0);
+  }
+
+  /**
+   * \param element the element
+   * \return true if the element is in the heap
+   */
+  bool Contains (T* element) const
+  {
+    uint32_t pos = element->*Index;
+    return pos < m_heap.size () && m_heap[pos] == element;
+  }
+
+  /**
+   * Removes an element
+   * \param element the element, which must be in the heap
+   */
+  void Remove (T* element)
+  {
+    NS_ASSERT (Contains (element));
+    RemoveAt (element->*Index);
+  }
+
+  /**
+   * Moves an element to its position after its priority changed
+   * \param element the element, which must be in the heap
+   */
+  void Update (T* element)
+  {
+    NS_ASSERT (Contains (element));
+    uint32_t pos = element->*Index;
+    if (pos > 0 && m_compare (element, m_heap[(pos - 1) / D]))
+      {
+        SiftUp (pos);
+      }
+    else
+      {
+        SiftDown (pos);
+      }
+  }
+
+  /**
+   * Gets the elements with the highest priority, without modifying the
+   * heap, in O(k log k)
+   * \param k the maximum number of elements
+   * \param topK filled with the elements, in decreasing order of priority
+   */
+  void GetTopK (size_t k, std::vector<T*> &topK) const
+  {
+    topK.clear ();
+    if (m_heap.empty () || k == 0)
+      {
+        return;
+      }
+    // the candidates are the children of the elements already selected,
+    // kept in a heap with the highest priority candidate at the front
+    auto lower = [this] (uint32_t l, uint32_t r)
+      {
+        return m_compare (m_heap[r], m_heap[l]);
+      };
+    m_candidates.clear ();
+    m_candidates.push_back (0);
+    while (topK.size () < k && !m_candidates.empty ())
+      {
+        std::pop_heap (m_candidates.begin (), m_candidates.end (), lower);
+        uint32_t pos = m_candidates.back ();
+        m_candidates.pop_back ();
+        topK.push_back (m_heap[pos]);
+        for (uint32_t child = pos * D + 1; child <= pos * D + D && child < m_heap.size (); child++)
+          {
+            m_candidates.push_back (child);
+            std::push_heap (m_candidates.begin (), m_candidates.end (), lower);
+          }
+      }
+  }
+
+private:
+  /**
+   * Stores an element at a position of the heap
+   * \param element the element
+   * \param pos the position
+   */
+  void Place (T* element, uint32_t pos)
+  {
+    m_heap[pos] = element;
+    element->*Index = pos;
+  }
+
+  /**
+   * Moves an element towards the root until its parent has a higher priority
+   * \param pos the position of the element
+   */
+  void SiftUp (uint32_t pos)
+  {
+    T* element = m_heap[pos];
+    while (pos > 0)
+      {
+        uint32_t parent = (pos - 1) / D;
+        if (!m_compare (element, m_heap[parent]))
+          {
+            break;
+          }
+        Place (m_heap[parent], pos);
+        pos = parent;
+      }
+    Place (element, pos);
+  }
+
+  /**
+   * Moves an element towards the leaves until its children have a lower priority
+   * \param pos the position of the element
+   */
+  void SiftDown (uint32_t pos)
+  {
+    T* element = m_heap[pos];
+    uint32_t size = m_heap.size ();
+    while (true)
+      {
+        uint32_t first = pos * D + 1;
+        if (first >= size)
+          {
+            break;
+          }
+        uint32_t best = first;
+        for (uint32_t child = first + 1; child < first + D && child < size; child++)
+          {
+            if (m_compare (m_heap[child], m_heap[best]))
+              {
+                best = child;
+              }
+          }
+        if (!m_compare (m_heap[best], element))
+          {
+            break;
+          }
+        Place (m_heap[best], pos);
+        pos = best;
+      }
+    Place (element, pos);
+  }
+
+  /**
+   * Removes the element at a position
+   * \param pos the position
+   */
+  void RemoveAt (uint32_t pos)
+  {
+    T* last = m_heap.back ();
+    m_heap.pop_back ();
+    if (pos < m_heap.size ())
+      {
+        Place (last, pos);
+        Update (last);
+      }
+  }
+
+  std::vector<T*> m_heap; //!< the elements, in heap order
+  Compare m_compare; //!< the comparison function
+  mutable std::vector<uint32_t> m_candidates; //!< the candidates of GetTopK, kept to avoid reallocating them
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* MMWAVE_INDEXED_HEAP_H */
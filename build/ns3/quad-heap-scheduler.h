@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUAD_HEAP_SCHEDULER_H
+#define QUAD_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::QuadHeapScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a 4-ary heap event scheduler
+ *
+ * This scheduler keeps the events in a 4-ary heap stored in a
+ * `std::vector`, with the root at index 0 and the children of the entry
+ * at index \c i at indexes `4 i + 1` to `4 i + 4`.
+ *
+ * Compared with the binary HeapScheduler, the heap is half as deep and
+ * the four children of an entry are contiguous, so that they usually
+ * share a cache line: Insert() makes half the comparisons and
+ * RemoveNext() touches half the cache lines, which pays off with the
+ * large event lists of simulations with many nodes. The children are
+ * compared without branches and the entries are moved along a hole
+ * instead of being swapped.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Logarithmic     | Heapify
+ * IsEmpty()    | Constant        | `std::vector::empty()`
+ * PeekNext()   | Constant        | Heap kept sorted
+ * Remove()     | Linear          | Search, heapify
+ * RemoveNext() | Logarithmic     | Heapify
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 3 x `sizeof (*)`<br/>(24 bytes)  | `std::vector`
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class QuadHeapScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  QuadHeapScheduler ();
+  /** Destructor. */
+  virtual ~QuadHeapScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Event list type:  vector of Events, managed as a 4-ary heap. */
+  typedef std::vector<Scheduler::Event> QuadHeap;
+
+  /**
+   * Find the earliest child of an entry.
+   *
+   * \param [in] first The index of the first child.
+   * \param [in] size The number of entries of the heap.
+   * \returns The index of the earliest child.
+   */
+  std::size_t SmallestChild (std::size_t first, std::size_t size) const;
+  /**
+   * Move an event towards the root, until its parent is earlier.
+   *
+   * \param [in] index The hole where the event would be stored.
+   * \param [in] ev The event.
+   */
+  void SiftUp (std::size_t index, const Scheduler::Event &ev);
+  /**
+   * Move an event towards the bottom, until its children are later.
+   *
+   * \param [in] index The hole where the event would be stored.
+   * \param [in] ev The event.
+   */
+  void SiftDown (std::size_t index, const Scheduler::Event &ev);
+  /**
+   * Remove the entry at an index, filling the hole with the last entry.
+   *
+   * \param [in] index The index of the entry.
+   */
+  void RemoveAt (std::size_t index);
+
+  /** The event list. */
+  QuadHeap m_heap;
+};
+
+} // namespace ns3
+
+#endif /* QUAD_HEAP_SCHEDULER_H */
@@ -0,0 +1,272 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015, NYU WIRELESS, Tandon School of Engineering,
+ * New York University
+ * Copyright (c) 2019 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef THREE_GPP_SPECTRUM_PROPAGATION_LOSS_H
+#define THREE_GPP_SPECTRUM_PROPAGATION_LOSS_H
+
+#include "ns3/spectrum-propagation-loss-model.h"
+#include <complex.h>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include "ns3/matrix-based-channel-model.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-value.h"
+
+namespace ns3 {
+
+class NetDevice;
+class ChannelConditionModel;
+class ChannelCondition;
+
+/**
+ * \ingroup spectrum
+ * \brief 3GPP Spectrum Propagation Loss Model
+ *
+ * This class models the frequency dependent propagation phenomena in the way
+ * described by 3GPP TR 38.901 document. The main method is DoCalcRxPowerSpectralDensity,
+ * which takes as input the power spectral density (PSD) of the transmitted signal,
+ * the mobility models of the transmitting node and receiving node, and
+ * returns the PSD of the received signal.
+ *
+ * \see MatrixBasedChannelModel
+ * \see ThreeGppAntennaArrayModel
+ * \see ChannelCondition
+ */
+class ThreeGppSpectrumPropagationLossModel : public SpectrumPropagationLossModel
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppSpectrumPropagationLossModel ();
+
+  /**
+   * Destructor
+   */
+  ~ThreeGppSpectrumPropagationLossModel ();
+  
+  void DoDispose () override;
+
+  /**
+   * Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * Set the channel model object
+   * \param channel a pointer to an object implementing the MatrixBasedChannelModel interface
+   */
+  void SetChannelModel (Ptr<MatrixBasedChannelModel> channel);
+
+  /**
+   * Get the channel model object
+   * \return a pointer to the object implementing the MatrixBasedChannelModel interface
+   */
+  Ptr<MatrixBasedChannelModel> GetChannelModel() const;
+
+  /**
+   * Add a device-antenna pair
+   * \param n a pointer to the NetDevice
+   * \param a a pointer to the associated ThreeGppAntennaArrayModel
+   */
+  void AddDevice (Ptr<NetDevice> n, Ptr<const ThreeGppAntennaArrayModel> a);
+
+
+  /**
+   * Sets the value of an attribute belonging to the associated
+   * MatrixBasedChannelModel instance
+   * \param name name of the attribute
+   * \param value the attribute value
+   */
+  void SetChannelModelAttribute (const std::string &name, const AttributeValue &value);
+
+  /**
+   * Returns the value of an attribute belonging to the associated
+   * MatrixBasedChannelModel instance
+   * \param name name of the attribute
+   * \param where the result should be stored
+   */
+  void GetChannelModelAttribute (const std::string &name, AttributeValue &value) const;
+
+  /**
+   * \brief Computes the received PSD.
+   *
+   * This function computes the received PSD by applying the 3GPP fast fading
+   * model and the beamforming gain.
+   * In particular, it retrieves the matrix representing the channel between
+   * node a and node b, computes the corresponding long term component, i.e.,
+   * the product between the cluster matrices and the TX and RX beamforming
+   * vectors (w_rx^T H^n_ab w_tx), and accounts for the Doppler component and
+   * the propagation delay.
+   * To reduce the computational load, the long term component associated with
+   * a certain channel is cached and recomputed only when the channel realization
+   * is updated, or when the beamforming vectors change.
+   * The cache is bounded: the least recently used entries are evicted when
+   * the memory they occupy exceeds the LongTermCacheMaxMemory attribute, or
+   * when they have not been used for longer than the LongTermCacheTimeout
+   * attribute. The number of hits, misses and evictions can be monitored
+   * through the corresponding trace sources.
+   *
+   * \param txPsd tx PSD
+   * \param a first node mobility model
+   * \param b second node mobility model
+   *
+   * \return the received PSD
+   */
+  Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity (Ptr<const SpectrumValue> txPsd,
+                                                           Ptr<const MobilityModel> a,
+                                                           Ptr<const MobilityModel> b) const override;
+
+  /**
+   * \brief Computes the received PSD for given beamforming vectors.
+   *
+   * As DoCalcRxPowerSpectralDensity, but the beamforming vectors of the two
+   * devices are passed as arguments instead of being read from their
+   * antennas. This allows to evaluate the gain of candidate beams without
+   * reconfiguring the antennas. The long term component is not cached.
+   *
+   * \param txPsd tx PSD
+   * \param a first node mobility model
+   * \param b second node mobility model
+   * \param aW the beamforming vector of the first node
+   * \param bW the beamforming vector of the second node
+   *
+   * \return the received PSD
+   */
+  Ptr<SpectrumValue> CalcRxPowerSpectralDensityForBeams (Ptr<const SpectrumValue> txPsd,
+                                                         Ptr<const MobilityModel> a,
+                                                         Ptr<const MobilityModel> b,
+                                                         const ThreeGppAntennaArrayModel::ComplexVector &aW,
+                                                         const ThreeGppAntennaArrayModel::ComplexVector &bW) const;
+
+private:
+  /**
+   * Data structure that stores the long term component for a tx-rx pair
+   */
+  struct LongTerm : public SimpleRefCount<LongTerm>
+  {
+    ThreeGppAntennaArrayModel::ComplexVector m_longTerm; //!< vector containing the long term component for each cluster
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> m_channel; //!< pointer to the channel matrix used to compute the long term
+    uint64_t m_sVersion; //!< the version of the beamforming vector of the node s used to compute the long term
+    uint64_t m_uVersion; //!< the version of the beamforming vector of the node u used to compute the long term
+
+    // The following terms only depend on m_channel, they are computed when
+    // needed and reset when the channel matrix is updated
+    std::vector<Vector> m_uDirection; //!< the direction cosines of the arrival angles of each cluster
+    std::vector<Vector> m_sDirection; //!< the direction cosines of the departure angles of each cluster
+    Vector m_sSpeed; //!< the speed of the s node used to compute m_dopplerRate
+    Vector m_uSpeed; //!< the speed of the u node used to compute m_dopplerRate
+    MatrixBasedChannelModel::DoubleVector m_dopplerRate; //!< the Doppler phase of each cluster, to be multiplied by time and frequency
+    SpectrumModelUid_t m_delayPhasorsUid {0}; //!< the uid of the SpectrumModel used to compute m_delayPhasors
+    ThreeGppAntennaArrayModel::ComplexVector m_delayPhasors; //!< the delay phasors of each subband and cluster
+
+    std::list<uint32_t>::iterator m_lruPosition; //!< the position of the entry in m_longTermLru
+    Time m_lastAccess; //!< the last time the entry was used
+    size_t m_memory {0}; //!< the memory occupied by the entry, in bytes, as accounted in m_longTermCacheMemory
+  };
+
+  /**
+   * Get the operating frequency
+   * \return the operating frequency in Hz
+  */
+  double GetFrequency () const;
+
+  /**
+   * Looks for the long term component in m_longTermMap. If found, checks
+   * whether it has to be updated. If not found or if it has to be updated,
+   * calls the method CalcLongTerm to compute it.
+   * \param aId id of the first node
+   * \param bId id of the second node
+   * The beamforming vectors are compared through their versions, see
+   * ThreeGppAntennaArrayModel::GetBeamformingVectorVersion.
+   * \param channelMatrix the channel matrix
+   * \param aAntenna the antenna array of the first device
+   * \param bAntenna the antenna array of the second device
+   * \return the cache entry containing the long term compoenent for each cluster
+   */
+  Ptr<LongTerm> GetLongTerm (uint32_t aId, uint32_t bId,
+                             Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                             Ptr<const ThreeGppAntennaArrayModel> aAntenna,
+                             Ptr<const ThreeGppAntennaArrayModel> bAntenna) const;
+  /**
+   * Updates the memory occupied by a long term entry after its use and
+   * evicts the least recently used entries which exceed the memory budget or
+   * the timeout. The entry passed as argument is never evicted.
+   * \param longTerm the long term entry which has just been used
+   */
+  void UpdateLongTermCache (Ptr<LongTerm> longTerm) const;
+
+  /**
+   * Estimates the memory occupied by a long term entry, including the
+   * overhead of the containers of the cache
+   * \param longTerm the long term entry
+   * \return the memory in bytes
+   */
+  static size_t GetLongTermMemory (Ptr<const LongTerm> longTerm);
+
+  /**
+   * Computes the long term component
+   * \param channelMatrix the channel matrix H
+   * \param sW the beamforming vector of the s device
+   * \param uW the beamforming vector of the u device
+   * \return the long term component
+   */
+  ThreeGppAntennaArrayModel::ComplexVector CalcLongTerm (Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                         const ThreeGppAntennaArrayModel::ComplexVector &sW,
+                                                         const ThreeGppAntennaArrayModel::ComplexVector &uW) const;
+
+  /**
+   * Computes the beamforming gain and applies it to the tx PSD.
+   * The direction cosines of the cluster angles, the Doppler rates and the
+   * delay phasors are stored in the long term entry and reused as long as
+   * the channel matrix, the speeds and the SpectrumModel do not change.
+   * \param txPsd the tx PSD
+   * \param longTerm the long term entry
+   * \param params The channel matrix
+   * \param sSpeed speed of the first node
+   * \param uSpeed speed of the second node
+   * \param cacheDelayPhasors if false, the delay phasors are computed on the
+   *        fly and they are not stored in the long term entry
+   * \return the rx PSD
+   */
+  Ptr<SpectrumValue> CalcBeamformingGain (Ptr<SpectrumValue> txPsd,
+                                          Ptr<LongTerm> longTerm,
+                                          Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                          const Vector &sSpeed, const Vector &uSpeed,
+                                          bool cacheDelayPhasors = true) const;
+
+  std::unordered_map <uint32_t, Ptr<const ThreeGppAntennaArrayModel> > m_deviceAntennaMap; //!< map containig the <node, antenna> associations
+  mutable std::unordered_map < uint32_t, Ptr<LongTerm> > m_longTermMap; //!< map containing the long term components
+  mutable std::list<uint32_t> m_longTermLru; //!< keys of the long term entries, from the most to the least recently used
+  mutable uint64_t m_longTermCacheMemory {0}; //!< the memory occupied by the long term entries, in bytes
+  uint64_t m_longTermCacheMaxMemory; //!< the maximum memory occupied by the long term entries, in bytes (0 for no limit)
+  Time m_longTermCacheTimeout; //!< the time after which an unused long term entry is evicted (0 to disable)
+  mutable TracedValue<uint64_t> m_longTermCacheHits; //!< number of long term lookups served by the cache
+  mutable TracedValue<uint64_t> m_longTermCacheMisses; //!< number of long term lookups which required the computation of the long term
+  mutable TracedValue<uint64_t> m_longTermCacheEvictions; //!< number of long term entries evicted from the cache
+  Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
+  uint32_t m_maxDelayPhasors; //!< the maximum number of delay phasors stored for each long term entry
+};
+} // namespace ns3
+
+#endif /* THREE_GPP_SPECTRUM_PROPAGATION_LOSS_H */
@@ -30,10 +30,13 @@ NS_LOG_COMPONENT_DEFINE ("ThreeGppAntennaArrayModel");
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeGppAntennaArrayModel);
 
+uint64_t ThreeGppAntennaArrayModel::m_lastBeamformingVectorVersion = 0;
+
 ThreeGppAntennaArrayModel::ThreeGppAntennaArrayModel (void)
 {
   NS_LOG_FUNCTION (this);
   m_isOmniTx = false;
+  m_beamformingVectorVersion = 0;
 }
 
 ThreeGppAntennaArrayModel::~ThreeGppAntennaArrayModel (void)
@@ -109,8 +112,14 @@ void
 ThreeGppAntennaArrayModel::SetBeamformingVector (const ComplexVector &beamformingVector)
 {
   NS_LOG_FUNCTION (this);
-  m_isOmniTx = false;
-  m_beamformingVector = beamformingVector;
+  // the beamforming vectors are often set again to the same value, e.g., at
+  // each TTI, hence a new version is assigned only if the vector changed
+  if (m_isOmniTx || beamformingVector != m_beamformingVector)
+    {
+      m_isOmniTx = false;
+      m_beamformingVector = beamformingVector;
+      m_beamformingVectorVersion = ++m_lastBeamformingVectorVersion;
+    }
 }
 
 const ThreeGppAntennaArrayModel::ComplexVector &
@@ -120,6 +129,12 @@ ThreeGppAntennaArrayModel::GetBeamformingVector(void) const
   return m_beamformingVector;
 }
 
+uint64_t
+ThreeGppAntennaArrayModel::GetBeamformingVectorVersion (void) const
+{
+  return m_beamformingVectorVersion;
+}
+
 std::pair<double, double>
 ThreeGppAntennaArrayModel::GetElementFieldPattern (Angles a) const
 {
@@ -97,7 +97,7 @@ public:
   void ChangeToOmniTx (void);
 
   /**
-   * Sets the beamforming vector to be used
+   * Sets the beamforming vector to be used and assigns it a new version
    * \param beamformingVector the beamforming vector
    */
   void SetBeamformingVector (const ComplexVector &beamformingVector);
@@ -108,6 +108,19 @@ public:
    */
   const ComplexVector & GetBeamformingVector (void) const;
 
+  /**
+   * Returns the version of the beamforming vector that is currently being
+   * used. Each call to SetBeamformingVector which changes the vector, or
+   * which follows ChangeToOmniTx, assigns a new version, taken from a counter
+   * shared by all the instances, hence two beamforming vectors with the same
+   * version are the same vector. The version 0 denotes an
+   * antenna whose beamforming vector has never been set.
+   * This allows the users of the beamforming vector to detect its changes
+   * without copying and comparing it.
+   * \return the version of the current beamforming vector
+   */
+  uint64_t GetBeamformingVectorVersion (void) const;
+
 private:
   /**
    * Returns the radiation power pattern of a single antenna element in dB,
@@ -120,6 +133,8 @@ private:
 
   bool m_isOmniTx; //!< true if the antenna is configured for omni transmissions
   ComplexVector m_beamformingVector; //!< the beamforming vector in use
+  uint64_t m_beamformingVectorVersion; //!< the version of the beamforming vector in use
+  static uint64_t m_lastBeamformingVectorVersion; //!< the last version assigned to a beamforming vector
   uint32_t m_numColumns; //!< number of columns
   uint32_t m_numRows; //!< number of rows
   double m_disV; //!< antenna spacing in the vertical direction in multiples of wave length
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/building.h"
+#include "ns3/building-list.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * \file
+ * Benchmark of the spatial queries of BuildingList.
+ *
+ * The buildings are placed on a square city grid, one per block, and the
+ * links connect random positions on the streets within a given distance.
+ * For an increasing number of buildings, the program reports the time per
+ * line of sight and per indoor query with a linear scan of the list, as
+ * done before the grid, and with the grid of BuildingList.
+ */
+
+using namespace ns3;
+
+namespace {
+
+/**
+ * \param l1 one end of the line segment
+ * \param l2 the other end of the line segment
+ * \returns true if the segment intersects a building, with a linear scan
+ */
+bool
+IsBlockedLinear (const Vector &l1, const Vector &l2)
+{
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      if ((*bit)->IsIntersect (l1, l2))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * \param position the position
+ * \returns true if the position is inside a building, with a linear scan
+ */
+bool
+IsIndoorLinear (const Vector &position)
+{
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      if ((*bit)->IsInside (position))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * \param start the start of the measure
+ * \param queries the number of queries
+ * \returns the time per query, in microseconds
+ */
+double
+GetTimePerQuery (std::chrono::high_resolution_clock::time_point start, uint32_t queries)
+{
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now ();
+  return std::chrono::duration<double, std::micro> (end - start).count () / queries;
+}
+
+}  // unnamed namespace
+
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t links = 10000;
+  double maxDistance = 300;
+  double blockSize = 80;
+  double streetWidth = 20;
+
+  CommandLine cmd;
+  cmd.AddValue ("links", "Number of links evaluated for each number of buildings", links);
+  cmd.AddValue ("maxDistance", "Maximum length of a link, in meters", maxDistance);
+  cmd.Parse (argc, argv);
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+
+  std::cout << std::setw (10) << "buildings"
+            << std::setw (14) << "LOS linear"
+            << std::setw (14) << "LOS grid"
+            << std::setw (16) << "indoor linear"
+            << std::setw (14) << "indoor grid"
+            << "   (us per query)" << std::endl;
+  std::vector<uint32_t> side = {10, 32, 71, 100, 141};
+  for (uint32_t s : side)
+    {
+      // one building per block
+      double pitch = blockSize + streetWidth;
+      for (uint32_t i = 0; i < s; i++)
+        {
+          for (uint32_t j = 0; j < s; j++)
+            {
+              Ptr<Building> b = CreateObject<Building> ();
+              b->SetBoundaries (Box (i * pitch, i * pitch + blockSize, j * pitch, j * pitch + blockSize,
+                                     0, rand->GetValue (10, 50)));
+            }
+        }
+
+      // links between positions on the streets
+      std::vector<std::pair<Vector, Vector> > segments;
+      for (uint32_t k = 0; k < links; k++)
+        {
+          double x = std::floor (rand->GetValue (0, s)) * pitch - streetWidth / 2;
+          double y = rand->GetValue (0, s * pitch);
+          Vector l1 (x, y, 1.5);
+          Vector l2 (x + rand->GetValue (-maxDistance, maxDistance), y + rand->GetValue (-maxDistance, maxDistance), 10);
+          segments.push_back (std::make_pair (l1, l2));
+        }
+
+      uint32_t blockedLinear = 0;
+      std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now ();
+      for (const std::pair<Vector, Vector> &segment : segments)
+        {
+          blockedLinear += IsBlockedLinear (segment.first, segment.second);
+        }
+      double losLinear = GetTimePerQuery (start, links);
+
+      uint32_t blockedGrid = 0;
+      start = std::chrono::high_resolution_clock::now ();
+      for (const std::pair<Vector, Vector> &segment : segments)
+        {
+          blockedGrid += BuildingList::IsAnyBuildingIntersected (segment.first, segment.second);
+        }
+      double losGrid = GetTimePerQuery (start, links);
+
+      uint32_t indoorLinear = 0;
+      start = std::chrono::high_resolution_clock::now ();
+      for (const std::pair<Vector, Vector> &segment : segments)
+        {
+          indoorLinear += IsIndoorLinear (segment.second);
+        }
+      double inLinear = GetTimePerQuery (start, links);
+
+      uint32_t indoorGrid = 0;
+      start = std::chrono::high_resolution_clock::now ();
+      for (const std::pair<Vector, Vector> &segment : segments)
+        {
+          indoorGrid += !BuildingList::GetBuildingsContaining (segment.second).empty ();
+        }
+      double inGrid = GetTimePerQuery (start, links);
+
+      NS_ABORT_MSG_UNLESS (blockedLinear == blockedGrid && indoorLinear == indoorGrid,
+                           "The grid and the linear scan do not agree");
+      std::cout << std::setw (10) << BuildingList::GetNBuildings ()
+                << std::fixed << std::setprecision (3)
+                << std::setw (14) << losLinear
+                << std::setw (14) << losGrid
+                << std::setw (16) << inLinear
+                << std::setw (14) << inGrid << std::endl;
+
+      // start again with an empty list
+      Simulator::Destroy ();
+    }
+
+  return 0;
+}
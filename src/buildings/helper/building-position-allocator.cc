@@ -182,17 +182,15 @@ OutdoorPositionAllocator::GetNext () const
       NS_LOG_INFO ("Position " << position);
 
       bool inside = false;
-      for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+      std::vector<Ptr<Building> > buildings = BuildingList::GetBuildingsContaining (position);
+      if (!buildings.empty ())
         {
-          if ((*bit)->IsInside (position))
-            {
-              NS_LOG_INFO ("Position " << position << " is inside the building with boundaries "
-                                       << (*bit)->GetBoundaries ().xMin << " " << (*bit)->GetBoundaries ().xMax << " "
-                                       << (*bit)->GetBoundaries ().yMin << " " << (*bit)->GetBoundaries ().yMax << " "
-                                       << (*bit)->GetBoundaries ().zMin << " " << (*bit)->GetBoundaries ().zMax);
-              inside = true;
-              break;
-            }
+          Ptr<Building> b = buildings.front ();
+          NS_LOG_INFO ("Position " << position << " is inside the building with boundaries "
+                                   << b->GetBoundaries ().xMin << " " << b->GetBoundaries ().xMax << " "
+                                   << b->GetBoundaries ().yMin << " " << b->GetBoundaries ().yMax << " "
+                                   << b->GetBoundaries ().zMin << " " << b->GetBoundaries ().zMax);
+          inside = true;
         }
 
       if (inside)
@@ -28,6 +28,10 @@
 #include "building-list.h"
 #include "building.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("BuildingList");
@@ -47,6 +51,10 @@ public:
   BuildingList::Iterator End (void) const;
   Ptr<Building> GetBuilding (uint32_t n);
   uint32_t GetNBuildings (void);
+  std::vector<Ptr<Building> > GetBuildingsContaining (const Vector &position);
+  std::vector<Ptr<Building> > GetBuildingsIntersecting (const Vector &l1, const Vector &l2);
+  bool IsAnyBuildingIntersected (const Vector &l1, const Vector &l2);
+  void NotifyBoundariesChanged (void);
 
   static Ptr<BuildingListPriv> Get (void);
 
@@ -54,7 +62,43 @@ private:
   virtual void DoDispose (void);
   static Ptr<BuildingListPriv> *DoGet (void);
   static void Delete (void);
+  /**
+   * Build the grid of the buildings, if it is not up to date.
+   */
+  void UpdateGrid (void);
+  /**
+   * \param v a coordinate.
+   * \param origin the lowest coordinate of the grid along the same axis.
+   * \param n the number of cells of the grid along the same axis.
+   * \returns the cell of the coordinate, clamped to the grid.
+   */
+  uint32_t GetCell (double v, double origin, uint32_t n) const;
+  /**
+   * Check the buildings in the grid cells crossed by a line segment.
+   * \param l1 one end of the line segment.
+   * \param l2 the other end of the line segment.
+   * \param firstOnly stop at the first building intersecting the segment.
+   * \param found the indexes of the buildings intersecting the segment.
+   */
+  void FindIntersecting (const Vector &l1, const Vector &l2, bool firstOnly, std::vector<uint32_t> &found);
+
   std::vector<Ptr<Building> > m_buildings;
+
+  bool m_gridValid; //!< whether the grid reflects the current buildings
+  double m_xMin; //!< lowest x coordinate of the grid
+  double m_xMax; //!< highest x coordinate of the grid
+  double m_yMin; //!< lowest y coordinate of the grid
+  double m_yMax; //!< highest y coordinate of the grid
+  double m_cellSize; //!< side of the square cells of the grid
+  uint32_t m_nx; //!< number of cells along the x axis, zero if there are no buildings
+  uint32_t m_ny; //!< number of cells along the y axis
+  /// index in m_cellBuildings of the first building of each cell, plus the end
+  std::vector<uint32_t> m_cellStart;
+  /// indexes of the buildings overlapping each cell, cell by cell
+  std::vector<uint32_t> m_cellBuildings;
+  /// last segment query which checked each building
+  std::vector<uint32_t> m_lastQuery;
+  uint32_t m_query; //!< counter of the segment queries
 };
 
 NS_OBJECT_ENSURE_REGISTERED (BuildingListPriv);
@@ -100,6 +144,15 @@ BuildingListPriv::Delete (void)
 
 
 BuildingListPriv::BuildingListPriv ()
+  : m_gridValid (false),
+    m_xMin (0),
+    m_xMax (0),
+    m_yMin (0),
+    m_yMax (0),
+    m_cellSize (1),
+    m_nx (0),
+    m_ny (0),
+    m_query (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -118,6 +171,10 @@ BuildingListPriv::DoDispose (void)
       *i = 0;
     }
   m_buildings.erase (m_buildings.begin (), m_buildings.end ());
+  m_gridValid = false;
+  m_cellStart.clear ();
+  m_cellBuildings.clear ();
+  m_lastQuery.clear ();
   Object::DoDispose ();
 }
 
@@ -127,6 +184,7 @@ BuildingListPriv::Add (Ptr<Building> building)
 {
   uint32_t index = m_buildings.size ();
   m_buildings.push_back (building);
+  m_gridValid = false;
   Simulator::ScheduleWithContext (index, TimeStep (0), &Building::Initialize, building);
   return index;
 
@@ -155,6 +213,230 @@ BuildingListPriv::GetBuilding (uint32_t n)
   return m_buildings.at (n);
 }
 
+uint32_t
+BuildingListPriv::GetCell (double v, double origin, uint32_t n) const
+{
+  double cell = std::floor ((v - origin) / m_cellSize);
+  if (cell < 0)
+    {
+      return 0;
+    }
+  if (cell >= n)
+    {
+      return n - 1;
+    }
+  return static_cast<uint32_t> (cell);
+}
+
+void
+BuildingListPriv::UpdateGrid (void)
+{
+  if (m_gridValid)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this << m_buildings.size ());
+  m_gridValid = true;
+  m_nx = 0;
+  m_ny = 0;
+  m_cellStart.clear ();
+  m_cellBuildings.clear ();
+  m_lastQuery.assign (m_buildings.size (), 0);
+  m_query = 0;
+  if (m_buildings.empty ())
+    {
+      return;
+    }
+
+  m_xMin = m_yMin = std::numeric_limits<double>::max ();
+  m_xMax = m_yMax = -std::numeric_limits<double>::max ();
+  for (std::vector<Ptr<Building> >::const_iterator it = m_buildings.begin (); it != m_buildings.end (); ++it)
+    {
+      Box box = (*it)->GetBoundaries ();
+      m_xMin = std::min (m_xMin, box.xMin);
+      m_xMax = std::max (m_xMax, box.xMax);
+      m_yMin = std::min (m_yMin, box.yMin);
+      m_yMax = std::max (m_yMax, box.yMax);
+    }
+
+  // about one cell per building, and at most one row or column per
+  // building when the area is very elongated
+  double width = m_xMax - m_xMin;
+  double height = m_yMax - m_yMin;
+  uint32_t n = m_buildings.size ();
+  m_cellSize = std::max (std::sqrt (width * height / n), std::max (width, height) / n);
+  if (!(m_cellSize > 0))
+    {
+      m_cellSize = 1;
+    }
+  m_nx = GetCell (m_xMax, m_xMin, n + 1) + 1;
+  m_ny = GetCell (m_yMax, m_yMin, n + 1) + 1;
+
+  // count the buildings of each cell, then fill the cells in the order of
+  // the list, so that the buildings of a cell are sorted by index
+  m_cellStart.assign (m_nx * m_ny + 1, 0);
+  for (uint32_t pass = 0; pass < 2; pass++)
+    {
+      if (pass == 1)
+        {
+          for (uint32_t c = 1; c < m_cellStart.size (); c++)
+            {
+              m_cellStart[c] += m_cellStart[c - 1];
+            }
+          m_cellBuildings.resize (m_cellStart.back ());
+        }
+      for (uint32_t b = n; b-- > 0; )
+        {
+          Box box = m_buildings[b]->GetBoundaries ();
+          uint32_t i1 = GetCell (box.xMax, m_xMin, m_nx);
+          uint32_t j1 = GetCell (box.yMax, m_yMin, m_ny);
+          for (uint32_t j = GetCell (box.yMin, m_yMin, m_ny); j <= j1; j++)
+            {
+              for (uint32_t i = GetCell (box.xMin, m_xMin, m_nx); i <= i1; i++)
+                {
+                  uint32_t c = j * m_nx + i;
+                  if (pass == 0)
+                    {
+                      m_cellStart[c]++;
+                    }
+                  else
+                    {
+                      // filled backwards, from the end of the cell, which
+                      // leaves m_cellStart[c] at the beginning of the cell
+                      m_cellBuildings[--m_cellStart[c]] = b;
+                    }
+                }
+            }
+        }
+    }
+  NS_LOG_LOGIC ("grid of " << m_nx << "x" << m_ny << " cells of " << m_cellSize << " m, "
+                           << m_cellBuildings.size () << " building entries");
+}
+
+std::vector<Ptr<Building> >
+BuildingListPriv::GetBuildingsContaining (const Vector &position)
+{
+  UpdateGrid ();
+  std::vector<Ptr<Building> > buildings;
+  if (m_nx == 0
+      || position.x < m_xMin || position.x > m_xMax
+      || position.y < m_yMin || position.y > m_yMax)
+    {
+      return buildings;
+    }
+  uint32_t c = GetCell (position.y, m_yMin, m_ny) * m_nx + GetCell (position.x, m_xMin, m_nx);
+  for (uint32_t k = m_cellStart[c]; k < m_cellStart[c + 1]; k++)
+    {
+      Ptr<Building> building = m_buildings[m_cellBuildings[k]];
+      if (building->IsInside (position))
+        {
+          buildings.push_back (building);
+        }
+    }
+  return buildings;
+}
+
+void
+BuildingListPriv::FindIntersecting (const Vector &l1, const Vector &l2, bool firstOnly, std::vector<uint32_t> &found)
+{
+  UpdateGrid ();
+  double segXMin = std::min (l1.x, l2.x);
+  double segXMax = std::max (l1.x, l2.x);
+  double segYMin = std::min (l1.y, l2.y);
+  double segYMax = std::max (l1.y, l2.y);
+  if (m_nx == 0
+      || segXMax < m_xMin || segXMin > m_xMax
+      || segYMax < m_yMin || segYMin > m_yMax)
+    {
+      return;
+    }
+
+  // a building can overlap several cells crossed by the segment, but it is
+  // checked only once per query
+  if (++m_query == 0)
+    {
+      std::fill (m_lastQuery.begin (), m_lastQuery.end (), 0);
+      m_query = 1;
+    }
+
+  // visit the cells column by column: in each column, the segment spans
+  // the rows between its y coordinates at the borders of the column, which
+  // are widened a little to absorb the rounding errors
+  double eps = 1e-6 * m_cellSize;
+  uint32_t i0 = GetCell (segXMin, m_xMin, m_nx);
+  uint32_t i1 = GetCell (segXMax, m_xMin, m_nx);
+  for (uint32_t i = i0; i <= i1; i++)
+    {
+      double yLo = segYMin;
+      double yHi = segYMax;
+      if (l1.x != l2.x)
+        {
+          double xLo = (i == i0) ? segXMin : m_xMin + i * m_cellSize;
+          double xHi = (i == i1) ? segXMax : m_xMin + (i + 1) * m_cellSize;
+          double slope = (l2.y - l1.y) / (l2.x - l1.x);
+          double ya = l1.y + (xLo - l1.x) * slope;
+          double yb = l1.y + (xHi - l1.x) * slope;
+          yLo = std::max (segYMin, std::min (ya, yb) - eps);
+          yHi = std::min (segYMax, std::max (ya, yb) + eps);
+        }
+      if (yHi < m_yMin || yLo > m_yMax)
+        {
+          continue;
+        }
+      uint32_t j1 = GetCell (yHi, m_yMin, m_ny);
+      for (uint32_t j = GetCell (yLo, m_yMin, m_ny); j <= j1; j++)
+        {
+          uint32_t c = j * m_nx + i;
+          for (uint32_t k = m_cellStart[c]; k < m_cellStart[c + 1]; k++)
+            {
+              uint32_t b = m_cellBuildings[k];
+              if (m_lastQuery[b] == m_query)
+                {
+                  continue;
+                }
+              m_lastQuery[b] = m_query;
+              if (m_buildings[b]->IsIntersect (l1, l2))
+                {
+                  found.push_back (b);
+                  if (firstOnly)
+                    {
+                      return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::vector<Ptr<Building> >
+BuildingListPriv::GetBuildingsIntersecting (const Vector &l1, const Vector &l2)
+{
+  std::vector<uint32_t> found;
+  FindIntersecting (l1, l2, false, found);
+  std::sort (found.begin (), found.end ());
+  std::vector<Ptr<Building> > buildings;
+  buildings.reserve (found.size ());
+  for (std::vector<uint32_t>::const_iterator it = found.begin (); it != found.end (); ++it)
+    {
+      buildings.push_back (m_buildings[*it]);
+    }
+  return buildings;
+}
+
+bool
+BuildingListPriv::IsAnyBuildingIntersected (const Vector &l1, const Vector &l2)
+{
+  std::vector<uint32_t> found;
+  FindIntersecting (l1, l2, true, found);
+  return !found.empty ();
+}
+
+void
+BuildingListPriv::NotifyBoundariesChanged (void)
+{
+  m_gridValid = false;
+}
+
 }
 
 /**
@@ -189,5 +471,25 @@ BuildingList::GetNBuildings (void)
 {
   return BuildingListPriv::Get ()->GetNBuildings ();
 }
+std::vector<Ptr<Building> >
+BuildingList::GetBuildingsContaining (const Vector &position)
+{
+  return BuildingListPriv::Get ()->GetBuildingsContaining (position);
+}
+std::vector<Ptr<Building> >
+BuildingList::GetBuildingsIntersecting (const Vector &l1, const Vector &l2)
+{
+  return BuildingListPriv::Get ()->GetBuildingsIntersecting (l1, l2);
+}
+bool
+BuildingList::IsAnyBuildingIntersected (const Vector &l1, const Vector &l2)
+{
+  return BuildingListPriv::Get ()->IsAnyBuildingIntersected (l1, l2);
+}
+void
+BuildingList::NotifyBoundariesChanged (void)
+{
+  BuildingListPriv::Get ()->NotifyBoundariesChanged ();
+}
 
 } // namespace ns3
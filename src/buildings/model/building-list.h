@@ -25,6 +25,7 @@
 
 #include <vector>
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
@@ -62,6 +63,40 @@ public:
    * \returns the number of buildings currently in the list.
    */
   static uint32_t GetNBuildings (void);
+  /**
+   * \param position the position to look up.
+   * \returns the buildings which contain the position, in the order of
+   *          this list.
+   *
+   * The buildings are looked up in a uniform 2D grid over their
+   * footprints, so only the buildings near the position are checked
+   * with Building::IsInside.
+   */
+  static std::vector<Ptr<Building> > GetBuildingsContaining (const Vector &position);
+  /**
+   * \param l1 one end of the line segment.
+   * \param l2 the other end of the line segment.
+   * \returns the buildings intersected by the line segment, in the
+   *          order of this list.
+   *
+   * Only the buildings in the grid cells crossed by the segment are
+   * checked with Building::IsIntersect.
+   */
+  static std::vector<Ptr<Building> > GetBuildingsIntersecting (const Vector &l1, const Vector &l2);
+  /**
+   * \param l1 one end of the line segment.
+   * \param l2 the other end of the line segment.
+   * \returns true if at least one building intersects the line segment.
+   */
+  static bool IsAnyBuildingIntersected (const Vector &l1, const Vector &l2);
+  /**
+   * Invalidate the grid of the buildings, which is rebuilt at the next
+   * query.
+   *
+   * This method is called automatically from Building::SetBoundaries so
+   * the user has little reason to call it himself.
+   */
+  static void NotifyBoundariesChanged (void);
 };
 
 } // namespace ns3
@@ -140,6 +140,7 @@ Building::SetBoundaries (Box boundaries)
 {
   NS_LOG_FUNCTION (this << boundaries);
   m_buildingBounds = boundaries;
+  BuildingList::NotifyBoundariesChanged ();
 }
 
 void
@@ -179,19 +179,16 @@ MobilityBuildingInfo::MakeConsistent (Ptr<MobilityModel> mm)
 {
   bool found = false;
   Vector pos = mm->GetPosition ();
-  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+  std::vector<Ptr<Building> > buildings = BuildingList::GetBuildingsContaining (pos);
+  for (std::vector<Ptr<Building> >::const_iterator bit = buildings.begin (); bit != buildings.end (); ++bit)
     {
-      NS_LOG_LOGIC ("checking building " << (*bit)->GetId () << " with boundaries " << (*bit)->GetBoundaries ());
-      if ((*bit)->IsInside (pos))
-        {
-          NS_LOG_LOGIC ("MobilityBuildingInfo " << this << " pos " << pos << " falls inside building " << (*bit)->GetId ());
-          NS_ABORT_MSG_UNLESS (found == false, " MobilityBuildingInfo already inside another building!");
-          found = true;
-          uint16_t floor = (*bit)->GetFloor (pos);
-          uint16_t roomX = (*bit)->GetRoomX (pos);
-          uint16_t roomY = (*bit)->GetRoomY (pos);
-          SetIndoor (*bit, floor, roomX, roomY);
-        }
+      NS_LOG_LOGIC ("MobilityBuildingInfo " << this << " pos " << pos << " falls inside building " << (*bit)->GetId ());
+      NS_ABORT_MSG_UNLESS (found == false, " MobilityBuildingInfo already inside another building!");
+      found = true;
+      uint16_t floor = (*bit)->GetFloor (pos);
+      uint16_t roomX = (*bit)->GetRoomX (pos);
+      uint16_t roomY = (*bit)->GetRoomY (pos);
+      SetIndoor (*bit, floor, roomX, roomY);
     }
   if (!found)
     {
@@ -203,24 +203,22 @@ RandomWalk2dOutdoorMobilityModel::IsLineClearOfBuildings ( Vector currentPositio
   double minIntersectionDistance = std::numeric_limits<double>::max ();
   Ptr<Building> minIntersectionDistanceBuilding;
 
-  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+  // the buildings which intersect the line between the current and next positions,
+  // this includes the building which contains the next position
+  std::vector<Ptr<Building> > buildings = BuildingList::GetBuildingsIntersecting (currentPosition, nextPosition);
+  for (std::vector<Ptr<Building> >::const_iterator bit = buildings.begin (); bit != buildings.end (); ++bit)
     {
-      // check if this building intersects the line between the current and next positions
-      // this checks also if the next position is inside the building
-      if ((*bit)->IsIntersect (currentPosition, nextPosition))
+      NS_LOG_LOGIC ("Building " << (*bit)->GetBoundaries ()
+                                << " intersects the line between " << currentPosition
+                                << " and " << nextPosition);
+      auto intersection = CalculateIntersectionFromOutside (
+        currentPosition, nextPosition, (*bit)->GetBoundaries ());
+      double distance = CalculateDistance (intersection, currentPosition);
+      intersectBuilding = true;
+      if (distance < minIntersectionDistance)
         {
-          NS_LOG_LOGIC ("Building " << (*bit)->GetBoundaries ()
-                                    << " intersects the line between " << currentPosition
-                                    << " and " << nextPosition);
-          auto intersection = CalculateIntersectionFromOutside (
-            currentPosition, nextPosition, (*bit)->GetBoundaries ());
-          double distance = CalculateDistance (intersection, currentPosition);
-          intersectBuilding = true;
-          if (distance < minIntersectionDistance)
-            {
-              minIntersectionDistance = distance;
-              minIntersectionDistanceBuilding = (*bit);
-            }
+          minIntersectionDistance = distance;
+          minIntersectionDistanceBuilding = (*bit);
         }
     }
 
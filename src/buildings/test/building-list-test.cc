@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/building.h"
+#include "ns3/building-list.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("BuildingListTest");
+
+/**
+ * Test case for the spatial queries of BuildingList. It compares the
+ * buildings returned by the grid with a linear scan of the list, for
+ * random positions and line segments, and checks that the grid follows
+ * the changes of the boundaries of the buildings.
+ */
+class BuildingListQueriesTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  BuildingListQueriesTestCase ();
+
+  /**
+   * Destructor
+   */
+  virtual ~BuildingListQueriesTestCase ();
+
+private:
+  /**
+   * Builds the buildings and perform the tests
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Compare the grid queries with a linear scan of the list
+   * \param l1 one end of the line segment, also used as position
+   * \param l2 the other end of the line segment
+   */
+  void CheckQueries (const Vector &l1, const Vector &l2);
+};
+
+BuildingListQueriesTestCase::BuildingListQueriesTestCase ()
+  : TestCase ("Check the spatial queries of BuildingList against a linear scan")
+{
+}
+
+BuildingListQueriesTestCase::~BuildingListQueriesTestCase ()
+{
+}
+
+void
+BuildingListQueriesTestCase::CheckQueries (const Vector &l1, const Vector &l2)
+{
+  std::vector<Ptr<Building> > inside;
+  std::vector<Ptr<Building> > intersecting;
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      if ((*bit)->IsInside (l1))
+        {
+          inside.push_back (*bit);
+        }
+      if ((*bit)->IsIntersect (l1, l2))
+        {
+          intersecting.push_back (*bit);
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ ((BuildingList::GetBuildingsContaining (l1) == inside), true,
+                         "wrong buildings containing " << l1);
+  NS_TEST_ASSERT_MSG_EQ ((BuildingList::GetBuildingsIntersecting (l1, l2) == intersecting), true,
+                         "wrong buildings intersecting " << l1 << " - " << l2);
+  NS_TEST_ASSERT_MSG_EQ (BuildingList::IsAnyBuildingIntersected (l1, l2), !intersecting.empty (),
+                         "wrong intersection of " << l1 << " - " << l2);
+}
+
+void
+BuildingListQueriesTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  // overlapping buildings of different sizes, with some large ones which
+  // span several cells of the grid
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      double x = rand->GetValue (0, 1000);
+      double y = rand->GetValue (0, 500);
+      double side = (i % 20 == 0) ? 200 : rand->GetValue (5, 40);
+      Ptr<Building> b = CreateObject<Building> ();
+      b->SetBoundaries (Box (x, x + side, y, y + side * 0.5, 0, rand->GetValue (3, 60)));
+    }
+
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      // the segments also start and end outside the buildings area
+      Vector l1 (rand->GetValue (-100, 1300), rand->GetValue (-100, 800), rand->GetValue (0, 30));
+      Vector l2 (rand->GetValue (-100, 1300), rand->GetValue (-100, 800), rand->GetValue (0, 30));
+      CheckQueries (l1, l2);
+      // vertical and horizontal segments
+      CheckQueries (l1, Vector (l1.x, l2.y, l2.z));
+      CheckQueries (l1, Vector (l2.x, l1.y, l2.z));
+      // a segment reduced to a point
+      CheckQueries (l1, l1);
+    }
+
+  // segments along the walls of a building
+  Box box = BuildingList::GetBuilding (3)->GetBoundaries ();
+  CheckQueries (Vector (box.xMin, box.yMin - 10, 1), Vector (box.xMin, box.yMax + 10, 1));
+  CheckQueries (Vector (box.xMin - 10, box.yMax, 1), Vector (box.xMax + 10, box.yMax, 1));
+
+  // move a building, the grid must be rebuilt
+  Ptr<Building> moved = BuildingList::GetBuilding (7);
+  moved->SetBoundaries (Box (2000, 2010, 2000, 2010, 0, 10));
+  NS_TEST_ASSERT_MSG_EQ (BuildingList::GetBuildingsContaining (Vector (2005, 2005, 5)).size (), 1,
+                         "the moved building was not found");
+  CheckQueries (Vector (1990, 2005, 5), Vector (2020, 2005, 5));
+
+  // add a building, the grid must be rebuilt
+  Ptr<Building> added = CreateObject<Building> ();
+  added->SetBoundaries (Box (-500, -490, -500, -490, 0, 10));
+  NS_TEST_ASSERT_MSG_EQ (BuildingList::IsAnyBuildingIntersected (Vector (-520, -495, 5), Vector (-480, -495, 5)), true,
+                         "the added building was not found");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test suite for the spatial queries of BuildingList
+ */
+class BuildingListTestSuite : public TestSuite
+{
+public:
+  BuildingListTestSuite ();
+};
+
+BuildingListTestSuite::BuildingListTestSuite ()
+  : TestSuite ("building-list", UNIT)
+{
+  AddTestCase (new BuildingListQueriesTestCase, TestCase::QUICK);
+}
+
+static BuildingListTestSuite g_buildingListTestSuite; //!< the test suite
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/command-line.h"
+#include "ns3/system-thread.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <list>
+
+/**
+ * \file
+ * \ingroup core-examples
+ * \ingroup simulator
+ * Stress benchmark of Simulator::ScheduleWithContext called from other
+ * threads.
+ *
+ * The main thread runs a chain of local events, each scheduling the next
+ * one, while a number of injector threads schedule events with
+ * Simulator::ScheduleWithContext as fast as they can, as the emulation
+ * devices do under load. The program reports the number of events handled
+ * by the main loop per second and the number of events injected per
+ * second.
+ */
+
+using namespace ns3;
+
+namespace {
+
+/** Number of injector threads. */
+uint32_t g_threads = 4;
+/** Number of events injected by each thread. */
+uint32_t g_eventsPerThread = 1000000;
+/** Number of injected events handled by the main thread. */
+uint64_t g_injectedHandled = 0;
+
+/** Event injected by the other threads. */
+void
+Injected (void)
+{
+  g_injectedHandled++;
+}
+
+/** Local event of the main thread, which keeps the event loop busy. */
+void
+Tick (void)
+{
+  if (g_injectedHandled < static_cast<uint64_t> (g_threads) * g_eventsPerThread)
+    {
+      Simulator::Schedule (NanoSeconds (1), &Tick);
+    }
+}
+
+/**
+ * Body of an injector thread.
+ * \param [in] context The context of the injected events.
+ */
+void
+Injector (uint32_t context)
+{
+  for (uint32_t i = 0; i < g_eventsPerThread; i++)
+    {
+      Simulator::ScheduleWithContext (context, NanoSeconds (1), &Injected);
+    }
+}
+
+}  // unnamed namespace
+
+
+int
+main (int argc, char *argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue ("threads", "Number of injector threads", g_threads);
+  cmd.AddValue ("events", "Number of events injected by each thread", g_eventsPerThread);
+  cmd.Parse (argc, argv);
+
+  // create the simulator in the main thread before the injectors start
+  Simulator::Schedule (NanoSeconds (1), &Tick);
+
+  std::list<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < g_threads; i++)
+    {
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (&Injector, i)));
+    }
+
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now ();
+  for (std::list<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Start ();
+    }
+  Simulator::Run ();
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now ();
+  for (std::list<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Join ();
+    }
+
+  double seconds = std::chrono::duration<double> (end - start).count ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::cout << "threads:                  " << g_threads << std::endl
+            << "injected events:          " << g_injectedHandled << std::endl
+            << "main loop events:         " << events << std::endl
+            << "wall clock time (s):      " << std::fixed << std::setprecision (3) << seconds << std::endl
+            << "main loop events/s:       " << std::setprecision (0) << events / seconds << std::endl
+            << "injected events/s:        " << g_injectedHandled / seconds << std::endl;
+
+  return 0;
+}
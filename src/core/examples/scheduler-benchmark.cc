@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/command-line.h"
+#include "ns3/object-factory.h"
+#include "ns3/event-id.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-examples
+ * \ingroup scheduler
+ * Benchmark of the event schedulers with the event pattern of a slotted
+ * radio access network.
+ *
+ * Each cell starts a slot every 125 us. At the start of the slot, every
+ * UE of the cell schedules the events of its TTI within the slot (start
+ * of the TTI, transmission of the data channels, end of the TTI) and
+ * restarts a 10 ms timer, as the RLC and HARQ timers which are cancelled
+ * and rescheduled on every transmission. The simulation is run with each
+ * scheduler and the wall clock time per event is reported.
+ */
+
+using namespace ns3;
+
+namespace {
+
+/**
+ * A UE, with its slot events and its timer.
+ */
+class BenchmarkUe
+{
+public:
+  BenchmarkUe ()
+    : m_events (0)
+  {}
+
+  /**
+   * Schedule the events of the TTI of the UE.
+   * \param [in] offset The start of the TTI from the start of the slot.
+   * \param [in] duration The duration of the TTI.
+   */
+  void StartSlot (Time offset, Time duration)
+  {
+    Simulator::Schedule (offset, &BenchmarkUe::StartTti, this, duration);
+    m_timer.Cancel ();
+    m_timer = Simulator::Schedule (MilliSeconds (10), &BenchmarkUe::TimerExpired, this);
+  }
+
+  /**
+   * Start of the TTI.
+   * \param [in] duration The duration of the TTI.
+   */
+  void StartTti (Time duration)
+  {
+    m_events++;
+    Simulator::Schedule (NanoSeconds (1), &BenchmarkUe::SendDataChannels, this);
+    Simulator::Schedule (duration, &BenchmarkUe::EndTti, this);
+  }
+
+  /** Transmission of the data channels. */
+  void SendDataChannels (void)
+  {
+    m_events++;
+  }
+
+  /** End of the TTI. */
+  void EndTti (void)
+  {
+    m_events++;
+  }
+
+  /** Expiration of the timer, which never happens while the UE is served. */
+  void TimerExpired (void)
+  {
+    m_events++;
+  }
+
+  uint64_t m_events; //!< Number of events handled by the UE.
+  EventId m_timer; //!< The timer, restarted on every slot.
+};
+
+/**
+ * A cell, which starts the slots of its UEs.
+ */
+class BenchmarkCell
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] numUes The number of UEs of the cell.
+   */
+  BenchmarkCell (uint32_t numUes)
+    : m_ues (numUes)
+  {}
+
+  /** Start a slot and schedule the next one. */
+  void StartSlot (void)
+  {
+    Time slot = MicroSeconds (125);
+    Time tti = slot / 14;
+    for (uint32_t i = 0; i < m_ues.size (); i++)
+      {
+        // the UEs are multiplexed in time over the symbols of the slot
+        m_ues[i].StartSlot (tti * (i % 13 + 1), tti);
+      }
+    Simulator::Schedule (slot, &BenchmarkCell::StartSlot, this);
+  }
+
+  std::vector<BenchmarkUe> m_ues; //!< The UEs.
+};
+
+/**
+ * Run the benchmark with a scheduler.
+ * \param [in] schedulerType The TypeId name of the scheduler.
+ * \param [in] numCells The number of cells.
+ * \param [in] numUes The number of UEs per cell.
+ * \param [in] duration The simulated time.
+ * \param [out] events The number of events run by the simulator.
+ * \returns The wall clock time, in seconds.
+ */
+double
+RunScheduler (std::string schedulerType, uint32_t numCells, uint32_t numUes, Time duration, uint64_t &events)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (schedulerType);
+  Simulator::SetScheduler (factory);
+
+  std::vector<BenchmarkCell> cells (numCells, BenchmarkCell (numUes));
+  for (uint32_t i = 0; i < numCells; i++)
+    {
+      // the cells are not synchronized
+      Simulator::Schedule (NanoSeconds (i * 125000 / numCells), &BenchmarkCell::StartSlot, &cells[i]);
+    }
+  Simulator::Stop (duration);
+
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now ();
+  Simulator::Run ();
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now ();
+  events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  return std::chrono::duration<double> (end - start).count ();
+}
+
+}  // unnamed namespace
+
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numCells = 7;
+  uint32_t numUes = 20;
+  double duration = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("cells", "Number of cells", numCells);
+  cmd.AddValue ("ues", "Number of UEs per cell", numUes);
+  cmd.AddValue ("duration", "Simulated time, in seconds", duration);
+  cmd.Parse (argc, argv);
+
+  std::vector<std::string> schedulerTypes = {"ns3::MapScheduler",
+                                             "ns3::HeapScheduler",
+                                             "ns3::CalendarScheduler",
+                                             "ns3::PriorityQueueScheduler"};
+
+  std::cout << std::setw (30) << "scheduler"
+            << std::setw (14) << "events"
+            << std::setw (12) << "time (s)"
+            << std::setw (12) << "ns/event" << std::endl;
+  for (const std::string &schedulerType : schedulerTypes)
+    {
+      uint64_t events = 0;
+      double seconds = RunScheduler (schedulerType, numCells, numUes, Seconds (duration), events);
+      std::cout << std::setw (30) << schedulerType
+                << std::setw (14) << events
+                << std::setw (12) << std::fixed << std::setprecision (3) << seconds
+                << std::setw (12) << std::setprecision (1) << seconds * 1e9 / events << std::endl;
+    }
+
+  return 0;
+}
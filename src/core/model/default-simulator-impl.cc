@@ -46,6 +46,12 @@ NS_LOG_COMPONENT_DEFINE ("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED (DefaultSimulatorImpl);
 
+/**
+ * \ingroup simulator
+ * Capacity of the lock-free inbox of the events scheduled by other threads.
+ */
+static const uint32_t EVENTS_WITH_CONTEXT_INBOX_CAPACITY = 4096;
+
 TypeId
 DefaultSimulatorImpl::GetTypeId (void)
 {
@@ -58,6 +64,9 @@ DefaultSimulatorImpl::GetTypeId (void)
 }
 
 DefaultSimulatorImpl::DefaultSimulatorImpl ()
+  : m_eventsWithContextInbox (EVENTS_WITH_CONTEXT_INBOX_CAPACITY),
+    m_eventsWithContextEmpty (true),
+    m_eventsWithContextOverflow (false)
 {
   NS_LOG_FUNCTION (this);
   m_stop = false;
@@ -72,7 +81,6 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
   m_eventCount = 0;
-  m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self ();
 }
 
@@ -163,31 +171,67 @@ DefaultSimulatorImpl::IsFinished (void) const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  if (m_eventsWithContextEmpty.load (std::memory_order_relaxed))
+    {
+      return;
+    }
+  // Clear the flag before draining: an event published afterwards sets it
+  // again and is moved by the next call.
+  m_eventsWithContextEmpty.exchange (true, std::memory_order_acq_rel);
+
+  if (!m_eventsWithContextOverflow.load (std::memory_order_acquire))
     {
+      EventWithContext event;
+      while (m_eventsWithContextInbox.TryPop (event))
+        {
+          InsertEventWithContext (event);
+        }
       return;
     }
 
-  // swap queues
+  // The inbox overflowed. Take the overflow list first: the other threads
+  // keep appending to the list, but every event they put in the inbox
+  // before has already claimed a position, so move the inbox up to the
+  // current tail before the list.
   EventsWithContext eventsWithContext;
   {
     CriticalSection cs (m_eventsWithContextMutex);
     m_eventsWithContext.swap (eventsWithContext);
-    m_eventsWithContextEmpty = true;
   }
+  uint64_t tail = m_eventsWithContextInbox.GetTail ();
+  while (m_eventsWithContextInbox.GetHead () < tail)
+    {
+      InsertEventWithContext (m_eventsWithContextInbox.Pop ());
+    }
   while (!eventsWithContext.empty ())
     {
-      EventWithContext event = eventsWithContext.front ();
+      InsertEventWithContext (eventsWithContext.front ());
       eventsWithContext.pop_front ();
-      Scheduler::Event ev;
-      ev.impl = event.event;
-      ev.key.m_ts = m_currentTs + event.timestamp;
-      ev.key.m_context = event.context;
-      ev.key.m_uid = m_uid;
-      m_uid++;
-      m_unscheduledEvents++;
-      m_events->Insert (ev);
     }
+  {
+    CriticalSection cs (m_eventsWithContextMutex);
+    if (m_eventsWithContext.empty ())
+      {
+        m_eventsWithContextOverflow.store (false, std::memory_order_release);
+      }
+    else
+      {
+        m_eventsWithContextEmpty.store (false, std::memory_order_relaxed);
+      }
+  }
+}
+
+void
+DefaultSimulatorImpl::InsertEventWithContext (const EventWithContext &event)
+{
+  Scheduler::Event ev;
+  ev.impl = event.event;
+  ev.key.m_ts = m_currentTs + event.timestamp;
+  ev.key.m_context = event.context;
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
 }
 
 void
@@ -270,11 +314,14 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
       // Current time added in ProcessEventsWithContext()
       ev.timestamp = delay.GetTimeStep ();
       ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back (ev);
-        m_eventsWithContextEmpty = false;
-      }
+      if (m_eventsWithContextOverflow.load (std::memory_order_acquire)
+          || !m_eventsWithContextInbox.TryPush (ev))
+        {
+          CriticalSection cs (m_eventsWithContextMutex);
+          m_eventsWithContext.push_back (ev);
+          m_eventsWithContextOverflow.store (true, std::memory_order_release);
+        }
+      m_eventsWithContextEmpty.store (false, std::memory_order_release);
     }
 }
 
@@ -26,9 +26,11 @@
 #include "event-impl.h"
 #include "system-thread.h"
 #include "system-mutex.h"
+#include "mpsc-queue.h"
 
 #include "ptr.h"
 
+#include <atomic>
 #include <list>
 
 /**
@@ -97,15 +99,33 @@ private:
     /** The event implementation. */
     EventImpl *event;
   };
+  /**
+   * Insert an event from a different context into the main event queue.
+   * \param [in] event The event.
+   */
+  void InsertEventWithContext (const EventWithContext &event);
+
+  /**
+   * Lock-free inbox of the events scheduled by the other threads, drained
+   * by the main thread in ProcessEventsWithContext().
+   */
+  MpscQueue<EventWithContext> m_eventsWithContextInbox;
   /** Container type for the events from a different context. */
   typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
+  /**
+   * The events from a different context which did not fit in the inbox.
+   * Once the inbox overflows, the other threads append here until the
+   * main thread has moved all these events, so that the events scheduled
+   * by each thread keep their order.
+   */
   EventsWithContext m_eventsWithContext;
   /**
    * Flag \c true if all events with context have been moved to the
    * primary event queue.
    */
-  bool m_eventsWithContextEmpty;
+  std::atomic<bool> m_eventsWithContextEmpty;
+  /** Flag \c true if m_eventsWithContext is in use. */
+  std::atomic<bool> m_eventsWithContextOverflow;
   /** Mutex to control access to the list of events with context. */
   SystemMutex m_eventsWithContextMutex;
 
@@ -21,6 +21,8 @@
 #include "event-impl.h"
 #include "log.h"
 
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -31,6 +33,125 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+namespace {
+
+/** Granularity of the size classes of the event pool, in bytes. */
+const std::size_t EVENT_POOL_GRANULARITY = 16;
+/**
+ * Number of size classes of the event pool. Larger events are allocated
+ * with the global operator new.
+ */
+const std::size_t EVENT_POOL_CLASSES = 16;
+/** Maximum number of free blocks kept for each size class and thread. */
+const std::size_t EVENT_POOL_MAX_FREE = 8192;
+
+/**
+ * \ingroup events
+ * Per-thread free lists of the memory blocks of the events.
+ *
+ * The blocks of a size class are all allocated with the size of the
+ * largest event of the class, so that any of them can be reused for an
+ * event of the same class. A block freed by a thread goes to the free list
+ * of that thread, whichever thread allocated it.
+ */
+class EventImplPool
+{
+public:
+  EventImplPool ()
+    : m_destroyed (false)
+  {
+    for (std::size_t i = 0; i < EVENT_POOL_CLASSES; i++)
+      {
+        m_free[i] = 0;
+        m_nFree[i] = 0;
+      }
+  }
+
+  ~EventImplPool ()
+  {
+    for (std::size_t i = 0; i < EVENT_POOL_CLASSES; i++)
+      {
+        while (m_free[i] != 0)
+          {
+            FreeBlock *block = m_free[i];
+            m_free[i] = block->next;
+            ::operator delete (block);
+          }
+        m_nFree[i] = 0;
+      }
+    // events released by the destructors of static objects bypass the pool
+    m_destroyed = true;
+  }
+
+  /**
+   * \param [in] size The size of the event.
+   * \returns The memory of the event.
+   */
+  void * Allocate (std::size_t size)
+  {
+    std::size_t sizeClass = (size - 1) / EVENT_POOL_GRANULARITY;
+    if (sizeClass >= EVENT_POOL_CLASSES)
+      {
+        return ::operator new (size);
+      }
+    FreeBlock *block = m_free[sizeClass];
+    if (block == 0)
+      {
+        return ::operator new ((sizeClass + 1) * EVENT_POOL_GRANULARITY);
+      }
+    m_free[sizeClass] = block->next;
+    m_nFree[sizeClass]--;
+    return block;
+  }
+
+  /**
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  void Deallocate (void *p, std::size_t size)
+  {
+    std::size_t sizeClass = (size - 1) / EVENT_POOL_GRANULARITY;
+    if (m_destroyed || sizeClass >= EVENT_POOL_CLASSES
+        || m_nFree[sizeClass] >= EVENT_POOL_MAX_FREE)
+      {
+        ::operator delete (p);
+        return;
+      }
+    FreeBlock *block = static_cast<FreeBlock *> (p);
+    block->next = m_free[sizeClass];
+    m_free[sizeClass] = block;
+    m_nFree[sizeClass]++;
+  }
+
+private:
+  /** A free block, linked through its first bytes. */
+  struct FreeBlock
+  {
+    FreeBlock *next; //!< The next free block of the same size class.
+  };
+
+  FreeBlock *m_free[EVENT_POOL_CLASSES]; //!< The free lists.
+  std::size_t m_nFree[EVENT_POOL_CLASSES]; //!< The length of the free lists.
+  bool m_destroyed; //!< Whether the thread is exiting.
+};
+
+/** The event pool of the calling thread. */
+thread_local EventImplPool g_eventImplPool;
+
+}  // unnamed namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  return g_eventImplPool.Allocate (size);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  g_eventImplPool.Deallocate (p, size);
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -40,6 +41,10 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Events are small and short-lived, so their memory is recycled through
+ * per-thread free lists, one for each size class, instead of going
+ * through the global allocator for every scheduled event.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +71,23 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate the memory of an event, taking a block of the size class of
+   * the event from the free list of the calling thread when possible.
+   *
+   * \param [in] size The size of the event.
+   * \returns The memory of the event.
+   */
+  void * operator new (std::size_t size);
+  /**
+   * Release the memory of an event, keeping the block in the free list of
+   * the calling thread when possible.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  void operator delete (void *p, std::size_t size);
+
 protected:
   /**
    * Implementation for Invoke().
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "assert.h"
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Bounded lock-free queue with multiple producers and a single
+ * consumer.
+ *
+ * The queue is a ring of cells, each tagged with a sequence number which
+ * tells whether the cell is free for the producer of a given position or
+ * holds the value for the consumer of that position. A producer claims a
+ * position with a compare-and-swap on the tail, writes the value and then
+ * publishes the cell by updating its sequence number. The single consumer
+ * owns the head and needs no atomic read-modify-write operations.
+ *
+ * TryPush() fails when the queue is full; the caller is expected to keep
+ * the value elsewhere. TryPop() fails when the cell at the head has not
+ * been published yet, either because the queue is empty or because a
+ * producer is still writing it.
+ *
+ * \tparam T \explicit The type of the values, which must be default
+ * constructible and copyable.
+ */
+template <typename T>
+class MpscQueue
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] capacity The maximum number of values in the queue,
+   * which must be a power of two.
+   */
+  explicit MpscQueue (uint32_t capacity)
+    : m_mask (capacity - 1),
+      m_cells (new Cell[capacity]),
+      m_tail (0),
+      m_head (0)
+  {
+    NS_ASSERT_MSG (capacity >= 2 && (capacity & (capacity - 1)) == 0,
+                   "The capacity must be a power of two");
+    for (uint32_t i = 0; i < capacity; i++)
+      {
+        m_cells[i].sequence.store (i, std::memory_order_relaxed);
+      }
+  }
+
+  /** Destructor. */
+  ~MpscQueue ()
+  {
+    delete [] m_cells;
+  }
+
+  /**
+   * Append a value at the tail of the queue. Can be called by any thread.
+   * \param [in] value The value.
+   * \return \c false if the queue is full.
+   */
+  bool TryPush (const T &value)
+  {
+    uint64_t pos = m_tail.load (std::memory_order_relaxed);
+    while (true)
+      {
+        Cell *cell = &m_cells[pos & m_mask];
+        uint64_t sequence = cell->sequence.load (std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t> (sequence - pos);
+        if (diff == 0)
+          {
+            // the cell is free: claim the position
+            if (m_tail.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+              {
+                cell->value = value;
+                cell->sequence.store (pos + 1, std::memory_order_release);
+                return true;
+              }
+            // pos has been reloaded by the failed compare-and-swap
+          }
+        else if (diff < 0)
+          {
+            // the cell still holds the value written one lap before
+            return false;
+          }
+        else
+          {
+            // another producer claimed this position
+            pos = m_tail.load (std::memory_order_relaxed);
+          }
+      }
+  }
+
+  /**
+   * Remove the value at the head of the queue. Must be called by the
+   * consumer thread only.
+   * \param [out] value The value.
+   * \return \c false if there is no published value at the head.
+   */
+  bool TryPop (T &value)
+  {
+    Cell *cell = &m_cells[m_head & m_mask];
+    uint64_t sequence = cell->sequence.load (std::memory_order_acquire);
+    if (sequence != m_head + 1)
+      {
+        return false;
+      }
+    Release (cell, value);
+    return true;
+  }
+
+  /**
+   * Remove the value at the head of the queue, waiting for the producer
+   * which claimed the position to publish it. Must be called by the
+   * consumer thread only, and only if GetHead() < GetTail().
+   * \return The value.
+   */
+  T Pop (void)
+  {
+    NS_ASSERT (m_head < GetTail ());
+    Cell *cell = &m_cells[m_head & m_mask];
+    while (cell->sequence.load (std::memory_order_acquire) != m_head + 1)
+      {
+        // the producer is between the claim and the publication
+      }
+    T value;
+    Release (cell, value);
+    return value;
+  }
+
+  /**
+   * \return The number of positions claimed by the producers so far.
+   */
+  uint64_t GetTail (void) const
+  {
+    return m_tail.load (std::memory_order_acquire);
+  }
+
+  /**
+   * \return The number of values removed by the consumer so far.
+   */
+  uint64_t GetHead (void) const
+  {
+    return m_head;
+  }
+
+private:
+  /** A slot of the ring. */
+  struct Cell
+  {
+    /**
+     * Equal to the position for which the cell is free, or to the
+     * position plus one once the value has been published.
+     */
+    std::atomic<uint64_t> sequence;
+    /** The value. */
+    T value;
+  };
+
+  /**
+   * Take the value out of the cell at the head and hand the cell over to
+   * the producers of the next lap.
+   * \param [in] cell The cell at the head.
+   * \param [out] value The value.
+   */
+  void Release (Cell *cell, T &value)
+  {
+    value = cell->value;
+    cell->value = T ();
+    cell->sequence.store (m_head + m_mask + 1, std::memory_order_release);
+    m_head++;
+  }
+
+  /** Disable copy. */
+  MpscQueue (const MpscQueue &);
+  /**
+   * Disable assignment.
+   * \returns This object.
+   */
+  MpscQueue & operator = (const MpscQueue &);
+
+  /** The capacity minus one, used to map a position to a cell. */
+  const uint64_t m_mask;
+  /** The ring of cells. */
+  Cell *m_cells;
+  /** Keep the tail, written by the producers, in its own cache line. */
+  char m_padding0[64];
+  /** The next position to be claimed by a producer. */
+  std::atomic<uint64_t> m_tail;
+  /** Keep the head, written by the consumer, in its own cache line. */
+  char m_padding1[64 - sizeof (std::atomic<uint64_t>)];
+  /** The next position to be read by the consumer. */
+  uint64_t m_head;
+};
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
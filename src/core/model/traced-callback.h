@@ -90,6 +90,12 @@ public:
    */
   void operator() (Ts... args) const;
 
+  /**
+   * \brief Checks if the Callbacks list is empty.
+   * \return true if the Callbacks list is empty.
+   */
+  bool IsEmpty () const;
+
   /**
    *  TracedCallback signature for POD.
    *
@@ -188,6 +194,13 @@ TracedCallback<Ts...>::operator() (Ts... args) const
     }
 }
 
+template<typename... Ts>
+bool
+TracedCallback<Ts...>::IsEmpty () const
+{
+  return m_callbackList.empty ();
+}
+
 } // namespace ns3
 
 #endif /* TRACED_CALLBACK_H */
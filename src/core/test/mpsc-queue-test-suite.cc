@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/mpsc-queue.h"
+#include "ns3/system-thread.h"
+
+#include <list>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * MpscQueue test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * Check the order of the values and the behavior of a full queue, with a
+ * single thread.
+ */
+class MpscQueueOrderTestCase : public TestCase
+{
+public:
+  MpscQueueOrderTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MpscQueueOrderTestCase::MpscQueueOrderTestCase ()
+  : TestCase ("Check the order of the values and the full queue")
+{}
+
+void
+MpscQueueOrderTestCase::DoRun (void)
+{
+  MpscQueue<uint32_t> queue (8);
+  uint32_t value = 0;
+  NS_TEST_ASSERT_MSG_EQ (queue.TryPop (value), false, "The queue should be empty");
+
+  uint32_t pushed = 0;
+  uint32_t popped = 0;
+  // wrap around the ring several times, with different fill levels
+  for (uint32_t lap = 0; lap < 10; lap++)
+    {
+      uint32_t toPush = 3 + lap % 6;
+      for (uint32_t i = 0; i < toPush; i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (queue.TryPush (pushed), true, "The queue should not be full");
+          pushed++;
+        }
+      NS_TEST_ASSERT_MSG_EQ (queue.GetTail (), pushed, "Wrong tail");
+      while (queue.TryPop (value))
+        {
+          NS_TEST_ASSERT_MSG_EQ (value, popped, "Wrong order");
+          popped++;
+        }
+      NS_TEST_ASSERT_MSG_EQ (popped, pushed, "Some values were not popped");
+      NS_TEST_ASSERT_MSG_EQ (queue.GetHead (), popped, "Wrong head");
+    }
+
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (queue.TryPush (i), true, "The queue should not be full");
+    }
+  NS_TEST_ASSERT_MSG_EQ (queue.TryPush (8), false, "The queue should be full");
+  NS_TEST_ASSERT_MSG_EQ (queue.Pop (), 0, "Wrong order");
+  NS_TEST_ASSERT_MSG_EQ (queue.TryPush (8), true, "The queue should not be full");
+  for (uint32_t i = 1; i <= 8; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (queue.Pop (), i, "Wrong order");
+    }
+  NS_TEST_ASSERT_MSG_EQ (queue.TryPop (value), false, "The queue should be empty");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Check that the values pushed by several threads are all popped, in the
+ * order in which each thread pushed them.
+ */
+class MpscQueueProducersTestCase : public TestCase
+{
+public:
+  MpscQueueProducersTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Push values until the queue accepts them.
+   * \param [in] context The test case and the number of the producer.
+   */
+  static void Producer (std::pair<MpscQueueProducersTestCase *, uint32_t> context);
+
+  /** Number of producer threads. */
+  static const uint32_t PRODUCERS = 4;
+  /** Number of values pushed by each producer. */
+  static const uint32_t VALUES = 5000;
+  /** The queue, smaller than the values to push so that it fills up. */
+  MpscQueue<uint64_t> m_queue;
+};
+
+MpscQueueProducersTestCase::MpscQueueProducersTestCase ()
+  : TestCase ("Check the values pushed by several threads"),
+    m_queue (64)
+{}
+
+void
+MpscQueueProducersTestCase::Producer (std::pair<MpscQueueProducersTestCase *, uint32_t> context)
+{
+  uint64_t producer = context.second;
+  for (uint64_t i = 0; i < VALUES; i++)
+    {
+      while (!context.first->m_queue.TryPush ((producer << 32) | i))
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+void
+MpscQueueProducersTestCase::DoRun (void)
+{
+  std::list<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < PRODUCERS; i++)
+    {
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (&MpscQueueProducersTestCase::Producer,
+                                                                  std::make_pair (this, i))));
+    }
+  for (std::list<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Start ();
+    }
+
+  std::vector<uint64_t> next (PRODUCERS, 0);
+  uint64_t received = 0;
+  bool ordered = true;
+  while (received < PRODUCERS * VALUES)
+    {
+      uint64_t value;
+      if (m_queue.TryPop (value))
+        {
+          uint32_t producer = value >> 32;
+          ordered = ordered && producer < PRODUCERS && (value & 0xffffffff) == next[producer];
+          next[producer] = (value & 0xffffffff) + 1;
+          received++;
+        }
+      else
+        {
+          std::this_thread::yield ();
+        }
+    }
+
+  for (std::list<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Join ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (ordered, true, "The values of a producer were not popped in order");
+  uint64_t value;
+  NS_TEST_ASSERT_MSG_EQ (m_queue.TryPop (value), false, "The queue should be empty");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * MpscQueue test suite.
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+public:
+  MpscQueueTestSuite ();
+};
+
+MpscQueueTestSuite::MpscQueueTestSuite ()
+  : TestSuite ("mpsc-queue", UNIT)
+{
+  AddTestCase (new MpscQueueOrderTestCase, TestCase::QUICK);
+  AddTestCase (new MpscQueueProducersTestCase, TestCase::QUICK);
+}
+
+static MpscQueueTestSuite g_mpscQueueTestSuite; //!< Static variable for test initialization
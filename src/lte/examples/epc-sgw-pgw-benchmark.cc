@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/virtual-net-device.h"
+#include "ns3/epc-sgw-pgw-application.h"
+#include "ns3/epc-s11-sap.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * \file
+ * Benchmark of the downlink forwarding of EpcSgwPgwApplication.
+ *
+ * The SGW/PGW serves a number of UEs, each with a default bearer, and is
+ * connected by a fast point-to-point link to a node which stands for all
+ * the eNBs and counts the GTP-U packets it receives. The packets from the
+ * internet are handed to the SGW/PGW one at a time, as done by the TUN
+ * device, in back-to-back bursts, faster than it can forward them in wall
+ * clock time. The SGW/PGW encapsulates each packet and sends it through its
+ * S1-U socket on its own. For an increasing number of UEs, the program
+ * reports the number of packets forwarded per second of wall clock time.
+ */
+
+using namespace ns3;
+
+namespace {
+
+/**
+ * MME side of the S11 SAP, which ignores the responses of the SGW.
+ */
+class BenchmarkMme : public EpcS11SapMme
+{
+public:
+  virtual void CreateSessionResponse (CreateSessionResponseMessage msg)
+  {}
+  virtual void ModifyBearerResponse (ModifyBearerResponseMessage msg)
+  {}
+  virtual void DeleteBearerRequest (DeleteBearerRequestMessage msg)
+  {}
+};
+
+/**
+ * Source of the downlink packets.
+ */
+class BenchmarkSource
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] pgw The SGW/PGW application.
+   * \param [in] ueAddresses The addresses of the UEs.
+   * \param [in] packets The number of packets to send.
+   * \param [in] burst The number of packets in a burst.
+   */
+  BenchmarkSource (Ptr<EpcSgwPgwApplication> pgw, const std::vector<Ipv4Address> &ueAddresses,
+                   uint32_t packets, uint32_t burst)
+    : m_pgw (pgw),
+      m_sent (0),
+      m_packets (packets),
+      m_burst (burst)
+  {
+    // one packet per UE, copied for each transmission
+    for (const Ipv4Address &ueAddress : ueAddresses)
+      {
+        Ptr<Packet> p = Create<Packet> (1000);
+        UdpHeader udpHeader;
+        udpHeader.SetSourcePort (80);
+        udpHeader.SetDestinationPort (1234);
+        p->AddHeader (udpHeader);
+        Ipv4Header ipv4Header;
+        ipv4Header.SetSource (Ipv4Address ("1.0.0.2"));
+        ipv4Header.SetDestination (ueAddress);
+        ipv4Header.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+        ipv4Header.SetPayloadSize (p->GetSize ());
+        p->AddHeader (ipv4Header);
+        m_uePackets.push_back (p);
+      }
+  }
+
+  /** Send a burst of packets, to the UEs in turn, and schedule the next one. */
+  void SendBurst (void)
+  {
+    for (uint32_t i = 0; i < m_burst && m_sent < m_packets; i++, m_sent++)
+      {
+        m_pgw->RecvFromTunDevice (m_uePackets[m_sent % m_uePackets.size ()]->Copy (),
+                                  Address (), Address (), Ipv4L3Protocol::PROT_NUMBER);
+      }
+    if (m_sent < m_packets)
+      {
+        Simulator::Schedule (MicroSeconds (10), &BenchmarkSource::SendBurst, this);
+      }
+  }
+
+private:
+  Ptr<EpcSgwPgwApplication> m_pgw; //!< The SGW/PGW application.
+  std::vector<Ptr<Packet> > m_uePackets; //!< The packet of each UE.
+  uint32_t m_sent; //!< The number of packets sent.
+  uint32_t m_packets; //!< The number of packets to send.
+  uint32_t m_burst; //!< The number of packets in a burst.
+};
+
+/** Number of GTP-U packets received by the eNBs. */
+uint32_t g_received = 0;
+
+/**
+ * Receive the GTP-U packets at the eNBs.
+ * \param [in] socket The S1-U socket of the eNBs.
+ */
+void
+ReceiveAtEnb (Ptr<Socket> socket)
+{
+  while (socket->Recv ())
+    {
+      g_received++;
+    }
+}
+
+/**
+ * Run the benchmark with a number of UEs.
+ * \param [in] numUes The number of UEs.
+ * \param [in] numEnbs The number of eNBs.
+ * \param [in] packets The number of packets to send.
+ * \param [in] burst The number of packets in a burst.
+ * \returns The wall clock time, in seconds.
+ */
+double
+RunBenchmark (uint32_t numUes, uint32_t numEnbs, uint32_t packets, uint32_t burst)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  Ptr<Node> pgwNode = nodes.Get (0);
+  Ptr<Node> enbNode = nodes.Get (1);
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("1000Gb/s")));
+  p2p.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (100)));
+  p2p.SetQueue ("ns3::DropTailQueue", "MaxSize", StringValue ("100000p"));
+  NetDeviceContainer devices = p2p.Install (nodes);
+  Ipv4AddressHelper addresses ("10.0.0.0", "255.255.255.252");
+  Ipv4InterfaceContainer interfaces = addresses.Assign (devices);
+  Ipv4Address pgwAddr = interfaces.GetAddress (0);
+  Ipv4Address enbAddr = interfaces.GetAddress (1);
+
+  Ptr<Socket> enbSocket = Socket::CreateSocket (enbNode, UdpSocketFactory::GetTypeId ());
+  enbSocket->Bind (InetSocketAddress (enbAddr, 2152));
+  enbSocket->SetRecvCallback (MakeCallback (&ReceiveAtEnb));
+
+  Ptr<Socket> pgwSocket = Socket::CreateSocket (pgwNode, UdpSocketFactory::GetTypeId ());
+  pgwSocket->Bind (InetSocketAddress (Ipv4Address::GetAny (), 2152));
+  Ptr<VirtualNetDevice> tunDevice = CreateObject<VirtualNetDevice> ();
+  Ptr<EpcSgwPgwApplication> pgw = CreateObject<EpcSgwPgwApplication> (tunDevice, pgwSocket);
+  pgwNode->AddApplication (pgw);
+  BenchmarkMme mme;
+  pgw->SetS11SapMme (&mme);
+
+  // all the eNBs share the address of the node
+  for (uint16_t cellId = 1; cellId <= numEnbs; cellId++)
+    {
+      pgw->AddEnb (cellId, enbAddr, pgwAddr);
+    }
+
+  Ipv4AddressHelper ueAddresses ("7.0.0.0", "255.0.0.0");
+  std::vector<Ipv4Address> ueAddrs;
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      uint64_t imsi = i + 1;
+      pgw->AddUe (imsi);
+      Ipv4Address ueAddr = ueAddresses.NewAddress ();
+      pgw->SetUeAddress (imsi, ueAddr);
+      ueAddrs.push_back (ueAddr);
+
+      EpcS11SapSgw::CreateSessionRequestMessage msg;
+      msg.imsi = imsi;
+      msg.uli.gci = 1 + i % numEnbs;
+      EpcS11SapSgw::BearerContextToBeCreated bearerContext;
+      bearerContext.epsBearerId = 1;
+      bearerContext.bearerLevelQos = EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT);
+      bearerContext.tft = EpcTft::Default ();
+      msg.bearerContextsToBeCreated.push_back (bearerContext);
+      pgw->GetS11SapSgw ()->CreateSessionRequest (msg);
+    }
+
+  BenchmarkSource source (pgw, ueAddrs, packets, burst);
+  Simulator::Schedule (MilliSeconds (1), &BenchmarkSource::SendBurst, &source);
+
+  g_received = 0;
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now ();
+  Simulator::Run ();
+  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now ();
+  Simulator::Destroy ();
+
+  NS_ABORT_MSG_UNLESS (g_received == packets, "Only " << g_received << " of " << packets << " packets were received");
+  return std::chrono::duration<double> (end - start).count ();
+}
+
+}  // unnamed namespace
+
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t packets = 200000;
+  uint32_t burst = 100;
+  uint32_t numEnbs = 100;
+
+  CommandLine cmd;
+  cmd.AddValue ("packets", "Number of packets sent for each number of UEs", packets);
+  cmd.AddValue ("burst", "Number of packets sent every 10 us", burst);
+  cmd.AddValue ("enbs", "Number of eNBs", numEnbs);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (10) << "UEs"
+            << std::setw (12) << "time (s)"
+            << std::setw (14) << "packets/s" << std::endl;
+  std::vector<uint32_t> numUes = {100, 1000, 20000};
+  for (uint32_t n : numUes)
+    {
+      double seconds = RunBenchmark (n, numEnbs, packets, burst);
+      std::cout << std::setw (10) << n
+                << std::setw (12) << std::fixed << std::setprecision (3) << seconds
+                << std::setw (14) << std::setprecision (0) << packets / seconds << std::endl;
+    }
+
+  return 0;
+}
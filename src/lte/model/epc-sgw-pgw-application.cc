@@ -167,18 +167,24 @@ bool
 EpcSgwPgwApplication::RecvFromTunDevice (Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber)
 {
   NS_LOG_FUNCTION (this << source << dest << protocolNumber << packet << packet->GetSize ());
-  m_rxTunPktTrace (packet->Copy ());
-  Ptr<Packet> pCopy = packet->Copy ();
+  if (!m_rxTunPktTrace.IsEmpty ())
+    {
+      m_rxTunPktTrace (packet->Copy ());
+    }
+
+  // the destination address is read in place, without copying the
+  // packet and removing the IP header
+  uint8_t ipHeader[40];
+  uint32_t ipHeaderSize = packet->CopyData (ipHeader, sizeof (ipHeader));
 
   // get IP address of UE
   if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
     {
-      Ipv4Header ipv4Header;
-      pCopy->RemoveHeader (ipv4Header);
-      Ipv4Address ueAddr =  ipv4Header.GetDestination ();
+      NS_ABORT_MSG_IF (ipHeaderSize < 20, "EpcSgwPgwApplication::RecvFromTunDevice - truncated IPv4 header");
+      Ipv4Address ueAddr = Ipv4Address::Deserialize (ipHeader + 16);
       NS_LOG_LOGIC ("packet addressed to UE " << ueAddr);
       // find corresponding UeInfo address
-      std::map<Ipv4Address, Ptr<UeInfo> >::iterator it = m_ueInfoByAddrMap.find (ueAddr);
+      std::unordered_map<Ipv4Address, Ptr<UeInfo>, Ipv4AddressHash>::iterator it = m_ueInfoByAddrMap.find (ueAddr);
       if (it == m_ueInfoByAddrMap.end ())
         {
           NS_LOG_WARN ("unknown UE address " << ueAddr);
@@ -199,12 +205,11 @@ EpcSgwPgwApplication::RecvFromTunDevice (Ptr<Packet> packet, const Address& sour
       }
     else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
       {
-        Ipv6Header ipv6Header;
-        pCopy->RemoveHeader (ipv6Header);
-        Ipv6Address ueAddr =  ipv6Header.GetDestinationAddress ();
+        NS_ABORT_MSG_IF (ipHeaderSize < 40, "EpcSgwPgwApplication::RecvFromTunDevice - truncated IPv6 header");
+        Ipv6Address ueAddr = Ipv6Address::Deserialize (ipHeader + 24);
         NS_LOG_LOGIC ("packet addressed to UE " << ueAddr);
         // find corresponding UeInfo address
-        std::map<Ipv6Address, Ptr<UeInfo> >::iterator it = m_ueInfoByAddrMap6.find (ueAddr);
+        std::unordered_map<Ipv6Address, Ptr<UeInfo>, Ipv6AddressHash>::iterator it = m_ueInfoByAddrMap6.find (ueAddr);
         if (it == m_ueInfoByAddrMap6.end ())
           {
             NS_LOG_WARN ("unknown UE address " << ueAddr);
@@ -252,7 +257,10 @@ EpcSgwPgwApplication::RecvFromS1uSocket (Ptr<Socket> socket)
 
   SendToTunDevice (packet, teid);
 
-  m_rxS1uPktTrace (packet->Copy ());
+  if (!m_rxS1uPktTrace.IsEmpty ())
+    {
+      m_rxS1uPktTrace (packet->Copy ());
+    }
 }
 
 void
@@ -37,6 +37,7 @@
 #include <ns3/epc-s1ap-sap.h>
 #include <ns3/epc-s11-sap.h>
 #include <map>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -291,12 +292,12 @@ public:
   /**
    * Map telling for each UE IPv4 address the corresponding UE info
    */
-  std::map<Ipv4Address, Ptr<UeInfo> > m_ueInfoByAddrMap;
+  std::unordered_map<Ipv4Address, Ptr<UeInfo>, Ipv4AddressHash> m_ueInfoByAddrMap;
 
   /**
    * Map telling for each UE IPv6 address the corresponding UE info
    */
-  std::map<Ipv6Address, Ptr<UeInfo> > m_ueInfoByAddrMap6;
+  std::unordered_map<Ipv6Address, Ptr<UeInfo>, Ipv6AddressHash> m_ueInfoByAddrMap6;
 
   /**
    * Map telling for each IMSI the corresponding UE info
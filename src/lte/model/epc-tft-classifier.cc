@@ -27,10 +27,6 @@
 #include "epc-tft.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
-#include "ns3/ipv4-header.h"
-#include "ns3/ipv6-header.h"
-#include "ns3/udp-header.h"
-#include "ns3/tcp-header.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/udp-l4-protocol.h"
@@ -38,6 +34,8 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 
+#include <cstring>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
@@ -47,6 +45,70 @@ EpcTftClassifier::EpcTftClassifier ()
   NS_LOG_FUNCTION (this);
 }
 
+/**
+ * \param buffer the first byte of a 32 bit value in network order
+ * \return the value in host order
+ */
+static uint32_t
+ReadNtohU32 (const uint8_t *buffer)
+{
+  return (uint32_t (buffer[0]) << 24) | (uint32_t (buffer[1]) << 16) | (uint32_t (buffer[2]) << 8) | buffer[3];
+}
+
+/**
+ * \param buffer the first byte of a 16 bit value in network order
+ * \return the value in host order
+ */
+static uint16_t
+ReadNtohU16 (const uint8_t *buffer)
+{
+  return (uint16_t (buffer[0]) << 8) | buffer[1];
+}
+
+/**
+ * \param address an IPv6 address
+ * \param prefix the prefix of the filter
+ * \param masked the address of the filter, masked with the prefix
+ * \return true if the address matches with the address of the filter
+ */
+static bool
+IsIpv6PrefixMatch (const uint8_t *address, const uint8_t *prefix, const uint8_t *masked)
+{
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      if ((address[i] & prefix[i]) != masked[i])
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+EpcTftClassifier::FlowKey::operator== (const FlowKey &other) const
+{
+  return remotePort == other.remotePort && localPort == other.localPort
+         && typeOfService == other.typeOfService && direction == other.direction
+         && ipv6 == other.ipv6
+         && std::memcmp (remoteAddress, other.remoteAddress, sizeof (remoteAddress)) == 0
+         && std::memcmp (localAddress, other.localAddress, sizeof (localAddress)) == 0;
+}
+
+size_t
+EpcTftClassifier::FlowKeyHash::operator() (const FlowKey &key) const
+{
+  uint64_t words[4];
+  std::memcpy (words, key.remoteAddress, sizeof (key.remoteAddress));
+  std::memcpy (words + 2, key.localAddress, sizeof (key.localAddress));
+  uint64_t hash = (uint64_t (key.remotePort) << 32) | (uint64_t (key.localPort) << 16)
+    | (uint64_t (key.typeOfService) << 8) | (uint64_t (key.direction) << 1) | key.ipv6;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      hash ^= words[i] + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+  return hash;
+}
+
 void
 EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
 {
@@ -55,6 +117,7 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
 
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
+  Compile ();
 }
 
 void
@@ -62,54 +125,148 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  Compile ();
+}
+
+void
+EpcTftClassifier::Compile (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_ipv4Filters.clear ();
+  m_ipv6Filters.clear ();
+  m_flowCache.clear ();
+
+  // we use a reverse iterator since filter priority is not implemented properly.
+  // This way, since the default bearer is expected to be added first, it will be evaluated last.
+  for (std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
+    {
+      std::list<EpcTft::PacketFilter> filters = it->second->GetPacketFilters ();
+      for (std::list<EpcTft::PacketFilter>::const_iterator fit = filters.begin (); fit != filters.end (); ++fit)
+        {
+          Ipv4Filter f4;
+          f4.remoteMask = fit->remoteMask.Get ();
+          f4.remoteAddress = fit->remoteAddress.Get () & f4.remoteMask;
+          f4.localMask = fit->localMask.Get ();
+          f4.localAddress = fit->localAddress.Get () & f4.localMask;
+          f4.remotePortStart = fit->remotePortStart;
+          f4.remotePortEnd = fit->remotePortEnd;
+          f4.localPortStart = fit->localPortStart;
+          f4.localPortEnd = fit->localPortEnd;
+          f4.typeOfServiceMask = fit->typeOfServiceMask;
+          f4.typeOfService = fit->typeOfService & fit->typeOfServiceMask;
+          f4.direction = fit->direction;
+          f4.id = it->first;
+          m_ipv4Filters.push_back (f4);
+
+          Ipv6Filter f6;
+          fit->remoteIpv6Prefix.GetBytes (f6.remotePrefix);
+          fit->remoteIpv6Address.GetBytes (f6.remoteAddress);
+          fit->localIpv6Prefix.GetBytes (f6.localPrefix);
+          fit->localIpv6Address.GetBytes (f6.localAddress);
+          for (uint32_t i = 0; i < 16; i++)
+            {
+              f6.remoteAddress[i] &= f6.remotePrefix[i];
+              f6.localAddress[i] &= f6.localPrefix[i];
+            }
+          f6.remotePortStart = fit->remotePortStart;
+          f6.remotePortEnd = fit->remotePortEnd;
+          f6.localPortStart = fit->localPortStart;
+          f6.localPortEnd = fit->localPortEnd;
+          f6.typeOfServiceMask = fit->typeOfServiceMask;
+          f6.typeOfService = fit->typeOfService & fit->typeOfServiceMask;
+          f6.direction = fit->direction;
+          f6.id = it->first;
+          m_ipv6Filters.push_back (f6);
+        }
+    }
+  NS_LOG_LOGIC ("compiled " << m_ipv4Filters.size () << " packet filters of " << m_tftMap.size () << " TFTs");
 }
 
 uint32_t
-EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t protocolNumber)
+EpcTftClassifier::MatchIpv4 (const FlowKey &key) const
 {
-  NS_LOG_FUNCTION (this << p << p->GetSize () << direction);
+  uint32_t remoteAddress = ReadNtohU32 (key.remoteAddress);
+  uint32_t localAddress = ReadNtohU32 (key.localAddress);
+  for (std::vector<Ipv4Filter>::const_iterator it = m_ipv4Filters.begin (); it != m_ipv4Filters.end (); ++it)
+    {
+      if ((key.direction & it->direction)
+          && (remoteAddress & it->remoteMask) == it->remoteAddress
+          && (localAddress & it->localMask) == it->localAddress
+          && it->remotePortStart <= key.remotePort && key.remotePort <= it->remotePortEnd
+          && it->localPortStart <= key.localPort && key.localPort <= it->localPortEnd
+          && (key.typeOfService & it->typeOfServiceMask) == it->typeOfService)
+        {
+          NS_LOG_LOGIC ("matches with TFT ID = " << it->id);
+          return it->id;
+        }
+    }
+  NS_LOG_LOGIC ("no match");
+  return 0;
+}
 
-  Ptr<Packet> pCopy = p->Copy ();
+uint32_t
+EpcTftClassifier::MatchIpv6 (const FlowKey &key) const
+{
+  for (std::vector<Ipv6Filter>::const_iterator it = m_ipv6Filters.begin (); it != m_ipv6Filters.end (); ++it)
+    {
+      if ((key.direction & it->direction)
+          && it->remotePortStart <= key.remotePort && key.remotePort <= it->remotePortEnd
+          && it->localPortStart <= key.localPort && key.localPort <= it->localPortEnd
+          && (key.typeOfService & it->typeOfServiceMask) == it->typeOfService
+          && IsIpv6PrefixMatch (key.remoteAddress, it->remotePrefix, it->remoteAddress)
+          && IsIpv6PrefixMatch (key.localAddress, it->localPrefix, it->localAddress))
+        {
+          NS_LOG_LOGIC ("matches with TFT ID = " << it->id);
+          return it->id;
+        }
+    }
+  NS_LOG_LOGIC ("no match");
+  return 0;
+}
 
-  Ipv4Address localAddressIpv4;
-  Ipv4Address remoteAddressIpv4;
+uint32_t
+EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t protocolNumber)
+{
+  NS_LOG_FUNCTION (this << p << p->GetSize () << direction);
+  NS_ASSERT (direction == EpcTft::UPLINK || direction == EpcTft::DOWNLINK);
 
-  Ipv6Address localAddressIpv6;
-  Ipv6Address remoteAddressIpv6;
+  // the IP header, including the IPv4 options, and the ports of the UDP/TCP
+  // header are read in place from the first bytes of the packet
+  uint8_t buffer[64];
+  uint32_t size = p->CopyData (buffer, sizeof (buffer));
 
-  uint8_t protocol;
-  uint8_t tos;
+  FlowKey key;
+  std::memset (&key, 0, sizeof (key));
+  key.direction = direction;
 
-  uint16_t localPort = 0;
-  uint16_t remotePort = 0;
+  const uint8_t *sourceAddress;
+  const uint8_t *destinationAddress;
+  uint32_t addressSize;
+  uint16_t sourcePort = 0;
+  uint16_t destinationPort = 0;
 
   if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
     {
-      Ipv4Header ipv4Header;
-      pCopy->RemoveHeader (ipv4Header);
-
-      if (direction ==  EpcTft::UPLINK)
-        {
-          localAddressIpv4 = ipv4Header.GetSource ();
-          remoteAddressIpv4 = ipv4Header.GetDestination ();
-        }
-      else
-        {
-          NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-          remoteAddressIpv4 = ipv4Header.GetSource ();
-          localAddressIpv4 = ipv4Header.GetDestination ();
-        }
-      NS_LOG_INFO ("local address: " << localAddressIpv4 << " remote address: " << remoteAddressIpv4);
-
-      uint16_t payloadSize = ipv4Header.GetPayloadSize ();
-      uint16_t fragmentOffset = ipv4Header.GetFragmentOffset ();
-      bool isLastFragment = ipv4Header.IsLastFragment ();
+      NS_ABORT_MSG_IF (size < 20, "EpcTftClassifier::Classify - truncated IPv4 header");
+      uint8_t headerSize = (buffer[0] & 0x0f) * 4;
+      uint16_t payloadSize = ReadNtohU16 (buffer + 2) - headerSize;
+      uint16_t identification = ReadNtohU16 (buffer + 4);
+      bool isLastFragment = !(buffer[6] & 0x20);
+      uint16_t fragmentOffset = ReadNtohU16 (buffer + 6) & 0x1fff;
+      uint8_t protocol = buffer[9];
+      key.typeOfService = buffer[1];
+      sourceAddress = buffer + 12;
+      destinationAddress = buffer + 16;
+      addressSize = 4;
 
       // NS_LOG_DEBUG ("PayloadSize = " << payloadSize);
       // NS_LOG_DEBUG ("fragmentOffset " << fragmentOffset << " isLastFragment " << isLastFragment);
 
-      protocol = ipv4Header.GetProtocol ();
-      tos = ipv4Header.GetTos ();
+      std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
+          std::make_tuple (ReadNtohU32 (sourceAddress),
+                           ReadNtohU32 (destinationAddress),
+                           protocol,
+                           identification);
 
       // Port info only can be get if it is the first fragment and
       // there is enough data in the payload
@@ -117,55 +274,15 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
       // i.e. it is the first one but it is not the last one
       if (fragmentOffset == 0)
         {
-          if (protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
+          if (((protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
+               || (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20))
+              && size >= headerSize + 4u)
             {
-              UdpHeader udpHeader;
-              pCopy->RemoveHeader (udpHeader);
-              if (direction ==  EpcTft::UPLINK)
-                {
-                  localPort = udpHeader.GetSourcePort ();
-                  remotePort = udpHeader.GetDestinationPort ();
-                }
-              else
-                {
-                  remotePort = udpHeader.GetSourcePort ();
-                  localPort = udpHeader.GetDestinationPort ();
-                }
+              sourcePort = ReadNtohU16 (buffer + headerSize);
+              destinationPort = ReadNtohU16 (buffer + headerSize + 2);
               if (!isLastFragment)
                 {
-                  std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                      std::make_tuple (ipv4Header.GetSource ().Get (),
-                                       ipv4Header.GetDestination ().Get (),
-                                       protocol,
-                                       ipv4Header.GetIdentification ());
-
-                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
-                }
-            }
-          else if (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20)
-            {
-              TcpHeader tcpHeader;
-              pCopy->RemoveHeader (tcpHeader);
-              if (direction ==  EpcTft::UPLINK)
-                {
-                  localPort = tcpHeader.GetSourcePort ();
-                  remotePort = tcpHeader.GetDestinationPort ();
-                }
-              else
-                {
-                  remotePort = tcpHeader.GetSourcePort ();
-                  localPort = tcpHeader.GetDestinationPort ();
-                }
-
-              if (!isLastFragment)
-                {
-                  std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                      std::make_tuple (ipv4Header.GetSource ().Get (),
-                                       ipv4Header.GetDestination ().Get (),
-                                       protocol,
-                                       ipv4Header.GetIdentification ());
-
-                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
+                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (sourcePort, destinationPort);
                 }
             }
 
@@ -177,79 +294,37 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         {
           // Not first fragment, so port info is not available but
           // port info should already be known (if there is not fragment reordering)
-          std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-              std::make_tuple (ipv4Header.GetSource ().Get (),
-                               ipv4Header.GetDestination ().Get (),
-                               protocol,
-                               ipv4Header.GetIdentification ());
-
           std::map< std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
                     std::pair<uint32_t, uint32_t> >::iterator it =
               m_classifiedIpv4Fragments.find (fragmentKey);
 
           if (it != m_classifiedIpv4Fragments.end ())
             {
-              localPort = it->second.first;
-              remotePort = it->second.second;
+              sourcePort = it->second.first;
+              destinationPort = it->second.second;
 
               if (isLastFragment)
                 {
-                  m_classifiedIpv4Fragments.erase (fragmentKey);
+                  m_classifiedIpv4Fragments.erase (it);
                 }
             }
         }
     }
   else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
-      Ipv6Header ipv6Header;
-      pCopy->RemoveHeader (ipv6Header);
-
-      if (direction ==  EpcTft::UPLINK)
-        {
-          localAddressIpv6 = ipv6Header.GetSourceAddress ();
-          remoteAddressIpv6 = ipv6Header.GetDestinationAddress ();
-        }
-      else
-        {
-          NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-          remoteAddressIpv6 = ipv6Header.GetSourceAddress ();
-          localAddressIpv6 = ipv6Header.GetDestinationAddress ();
-        }
-      NS_LOG_INFO ("local address: " << localAddressIpv6 << " remote address: " << remoteAddressIpv6);
-
-      protocol = ipv6Header.GetNextHeader ();
-      tos = ipv6Header.GetTrafficClass ();
-
-      if (protocol == UdpL4Protocol::PROT_NUMBER)
-        {
-          UdpHeader udpHeader;
-          pCopy->RemoveHeader (udpHeader);
-
-          if (direction ==  EpcTft::UPLINK)
-            {
-              localPort = udpHeader.GetSourcePort ();
-              remotePort = udpHeader.GetDestinationPort ();
-            }
-          else
-            {
-              remotePort = udpHeader.GetSourcePort ();
-              localPort = udpHeader.GetDestinationPort ();
-            }
-        }
-      else if (protocol == TcpL4Protocol::PROT_NUMBER)
+      NS_ABORT_MSG_IF (size < 40, "EpcTftClassifier::Classify - truncated IPv6 header");
+      uint8_t protocol = buffer[6];
+      key.typeOfService = (buffer[0] << 4) | (buffer[1] >> 4);
+      key.ipv6 = true;
+      sourceAddress = buffer + 8;
+      destinationAddress = buffer + 24;
+      addressSize = 16;
+
+      if ((protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
+          && size >= 44)
         {
-          TcpHeader tcpHeader;
-          pCopy->RemoveHeader (tcpHeader);
-          if (direction ==  EpcTft::UPLINK)
-            {
-              localPort = tcpHeader.GetSourcePort ();
-              remotePort = tcpHeader.GetDestinationPort ();
-            }
-          else
-            {
-              remotePort = tcpHeader.GetSourcePort ();
-              localPort = tcpHeader.GetDestinationPort ();
-            }
+          sourcePort = ReadNtohU16 (buffer + 40);
+          destinationPort = ReadNtohU16 (buffer + 42);
         }
     }
   else
@@ -257,64 +332,55 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
       NS_ABORT_MSG ("EpcTftClassifier::Classify - Unknown IP type...");
     }
 
+  if (direction == EpcTft::UPLINK)
+    {
+      std::memcpy (key.localAddress, sourceAddress, addressSize);
+      std::memcpy (key.remoteAddress, destinationAddress, addressSize);
+      key.localPort = sourcePort;
+      key.remotePort = destinationPort;
+    }
+  else
+    {
+      std::memcpy (key.remoteAddress, sourceAddress, addressSize);
+      std::memcpy (key.localAddress, destinationAddress, addressSize);
+      key.remotePort = sourcePort;
+      key.localPort = destinationPort;
+    }
 
-  if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
+  if (key.ipv6)
     {
       NS_LOG_INFO ("Classifying packet:"
-          << " localAddr="  << localAddressIpv4
-          << " remoteAddr=" << remoteAddressIpv4
-          << " localPort="  << localPort
-          << " remotePort=" << remotePort
-          << " tos=0x" << (uint16_t) tos );
-
-      // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv4, localAddressIpv4, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
+          << " localAddr="  << Ipv6Address (key.localAddress)
+          << " remoteAddr=" << Ipv6Address (key.remoteAddress)
+          << " localPort="  << key.localPort
+          << " remotePort=" << key.remotePort
+          << " tos=0x" << (uint16_t) key.typeOfService );
     }
-  else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
+  else
     {
       NS_LOG_INFO ("Classifying packet:"
-          << " localAddr="  << localAddressIpv6
-          << " remoteAddr=" << remoteAddressIpv6
-          << " localPort="  << localPort
-          << " remotePort=" << remotePort
-          << " tos=0x" << (uint16_t) tos );
-
-      // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv6, localAddressIpv6, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
+          << " localAddr="  << Ipv4Address (ReadNtohU32 (key.localAddress))
+          << " remoteAddr=" << Ipv4Address (ReadNtohU32 (key.remoteAddress))
+          << " localPort="  << key.localPort
+          << " remotePort=" << key.remotePort
+          << " tos=0x" << (uint16_t) key.typeOfService );
+    }
+
+  std::unordered_map<FlowKey, uint32_t, FlowKeyHash>::const_iterator cached = m_flowCache.find (key);
+  if (cached != m_flowCache.end ())
+    {
+      NS_LOG_LOGIC ("flow already classified with TFT ID = " << cached->second);
+      return cached->second;
     }
-  NS_LOG_LOGIC ("no match");
-  return 0;  // no match
-}
 
+  // now it is possible to classify the packet!
+  uint32_t id = key.ipv6 ? MatchIpv6 (key) : MatchIpv4 (key);
+  if (m_flowCache.size () >= MAX_CACHED_FLOWS)
+    {
+      m_flowCache.clear ();
+    }
+  m_flowCache[key] = id;
+  return id;
+}
 
 } // namespace ns3
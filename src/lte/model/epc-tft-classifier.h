@@ -28,6 +28,8 @@
 #include "ns3/epc-tft.h"
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 
 namespace ns3 {
@@ -50,6 +52,12 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * The packet filters of the TFTs are compiled, when a TFT is added or deleted, into
+ * flat tables with the masked addresses, in the order in which they are evaluated.
+ * The fields of the IP and UDP/TCP headers are read from the first bytes of the packet,
+ * without copying the packet, and the result of the classification of each flow is
+ * cached. A TFT must not be modified after it is added to the classifier.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -87,6 +95,102 @@ public:
 
 protected:
 
+  /**
+   * Compile the packet filters of the TFTs in m_tftMap into m_ipv4Filters
+   * and m_ipv6Filters and clear the flow cache.
+   */
+  void Compile (void);
+
+  /**
+   * IPv4 packet filter, with the addresses already masked
+   */
+  struct Ipv4Filter
+  {
+    uint32_t remoteAddress; ///< masked remote address
+    uint32_t remoteMask; ///< remote address mask
+    uint32_t localAddress; ///< masked local address
+    uint32_t localMask; ///< local address mask
+    uint16_t remotePortStart; ///< start of the remote port range
+    uint16_t remotePortEnd; ///< end of the remote port range
+    uint16_t localPortStart; ///< start of the local port range
+    uint16_t localPortEnd; ///< end of the local port range
+    uint8_t typeOfService; ///< masked type of service
+    uint8_t typeOfServiceMask; ///< type of service mask
+    uint8_t direction; ///< direction of the filter
+    uint32_t id; ///< identifier of the TFT of the filter
+  };
+
+  /**
+   * IPv6 packet filter, with the addresses already masked
+   */
+  struct Ipv6Filter
+  {
+    uint8_t remoteAddress[16]; ///< masked remote address
+    uint8_t remotePrefix[16]; ///< remote address prefix
+    uint8_t localAddress[16]; ///< masked local address
+    uint8_t localPrefix[16]; ///< local address prefix
+    uint16_t remotePortStart; ///< start of the remote port range
+    uint16_t remotePortEnd; ///< end of the remote port range
+    uint16_t localPortStart; ///< start of the local port range
+    uint16_t localPortEnd; ///< end of the local port range
+    uint8_t typeOfService; ///< masked type of service
+    uint8_t typeOfServiceMask; ///< type of service mask
+    uint8_t direction; ///< direction of the filter
+    uint32_t id; ///< identifier of the TFT of the filter
+  };
+
+  /**
+   * Fields of a packet used by the classification. IPv4 addresses use the
+   * first 4 bytes of the address arrays.
+   */
+  struct FlowKey
+  {
+    uint8_t remoteAddress[16]; ///< remote address
+    uint8_t localAddress[16]; ///< local address
+    uint16_t remotePort; ///< remote port
+    uint16_t localPort; ///< local port
+    uint8_t typeOfService; ///< type of service
+    uint8_t direction; ///< direction
+    bool ipv6; ///< true for IPv6 packets
+
+    /**
+     * \param other the other key
+     * \return true if the keys are equal
+     */
+    bool operator== (const FlowKey &other) const;
+  };
+
+  /**
+   * Hash function of FlowKey
+   */
+  struct FlowKeyHash
+  {
+    /**
+     * \param key the key
+     * \return the hash of the key
+     */
+    size_t operator() (const FlowKey &key) const;
+  };
+
+  /**
+   * \param key the fields of an IPv4 packet
+   * \return the identifier of the first TFT that matches, 0 if none
+   */
+  uint32_t MatchIpv4 (const FlowKey &key) const;
+
+  /**
+   * \param key the fields of an IPv6 packet
+   * \return the identifier of the first TFT that matches, 0 if none
+   */
+  uint32_t MatchIpv6 (const FlowKey &key) const;
+
+  /// maximum number of flows in the cache, which is cleared when full
+  static const size_t MAX_CACHED_FLOWS = 1024;
+
+  std::vector<Ipv4Filter> m_ipv4Filters; ///< compiled IPv4 packet filters, in evaluation order
+  std::vector<Ipv6Filter> m_ipv6Filters; ///< compiled IPv6 packet filters, in evaluation order
+  std::unordered_map<FlowKey, uint32_t, FlowKeyHash> m_flowCache; ///< TFT identifier of the classified flows
+
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap; ///< TFT map
 
   std::map < std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
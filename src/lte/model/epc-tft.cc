@@ -253,6 +253,12 @@ EpcTft::Add (PacketFilter f)
   return (m_numFilters - 1);
 }
 
+std::list<EpcTft::PacketFilter>
+EpcTft::GetPacketFilters () const
+{
+  return m_filters;
+}
+
 bool
 EpcTft::Matches (Direction direction,
                  Ipv4Address remoteAddress,
@@ -155,6 +155,12 @@ public:
    */
   uint8_t Add (PacketFilter f);
 
+  /**
+   * \return the packet filters of the TFT, in the order in which they are
+   * evaluated
+   */
+  std::list<PacketFilter> GetPacketFilters () const;
+
 
     /**
      *
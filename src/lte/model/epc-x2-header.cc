@@ -25,6 +25,10 @@
 #include "ns3/log.h"
 #include "ns3/epc-x2-header.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 
 namespace ns3 {
 
@@ -2649,6 +2653,276 @@ EpcX2UeImsiSinrUpdateHeader::unpack754(uint64_t i)
   return result;
 }
 
+////////////////
+
+NS_OBJECT_ENSURE_REGISTERED (EpcX2UeImsiSinrDeltaUpdateHeader);
+
+const int16_t EpcX2UeImsiSinrDeltaUpdateHeader::REMOVED_SINR = std::numeric_limits<int16_t>::min ();
+
+EpcX2UeImsiSinrDeltaUpdateHeader::EpcX2UeImsiSinrDeltaUpdateHeader ()
+  : m_numberOfIes (1 + 1),
+    m_headerLength (2 + 2),
+    m_sourceCellId (0)
+{
+  m_map.clear ();
+}
+
+EpcX2UeImsiSinrDeltaUpdateHeader::~EpcX2UeImsiSinrDeltaUpdateHeader ()
+{
+  m_numberOfIes = 0;
+  m_headerLength = 0;
+  m_map.clear ();
+}
+
+TypeId
+EpcX2UeImsiSinrDeltaUpdateHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::EpcX2UeImsiSinrDeltaUpdateHeader")
+    .SetParent<Header> ()
+    .SetGroupName("Lte")
+    .AddConstructor<EpcX2UeImsiSinrDeltaUpdateHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+EpcX2UeImsiSinrDeltaUpdateHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+EpcX2UeImsiSinrDeltaUpdateHeader::GetSerializedSize (void) const
+{
+  return m_headerLength;
+}
+
+void
+EpcX2UeImsiSinrDeltaUpdateHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+
+  i.WriteHtonU16 (m_sourceCellId);
+
+  std::map <uint64_t, int16_t>::size_type sz = m_map.size ();
+  i.WriteHtonU16 (sz);              // number of elements in the map
+
+  uint64_t previousImsi = 0;
+  for (std::map<uint64_t, int16_t>::const_iterator iter = m_map.begin(); iter != m_map.end(); ++iter)
+    {
+      // the map is sorted, so the difference is never negative
+      uint64_t imsiDelta = iter->first - previousImsi;
+      previousImsi = iter->first;
+      do
+        {
+          uint8_t byte = imsiDelta & 0x7f;
+          imsiDelta >>= 7;
+          i.WriteU8 (imsiDelta != 0 ? (byte | 0x80) : byte);
+        }
+      while (imsiDelta != 0);
+      i.WriteHtonU16 (static_cast<uint16_t> (iter->second)); // sinr
+    }
+}
+
+uint32_t
+EpcX2UeImsiSinrDeltaUpdateHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  m_map.clear ();
+  m_headerLength = 0;
+
+  m_sourceCellId = i.ReadNtohU16();
+  m_headerLength += 2;
+  m_numberOfIes = 1;
+
+  int sz = i.ReadNtohU16 ();
+  m_headerLength += 2;
+  uint64_t imsi = 0;
+  for (int j = 0; j < sz; j++)
+    {
+      uint64_t imsiDelta = 0;
+      uint8_t byte;
+      uint32_t shift = 0;
+      do
+        {
+          byte = i.ReadU8 ();
+          imsiDelta |= static_cast<uint64_t> (byte & 0x7f) << shift;
+          shift += 7;
+          m_headerLength += 1;
+        }
+      while (byte & 0x80);
+      imsi += imsiDelta;
+      m_map[imsi] = static_cast<int16_t> (i.ReadNtohU16());
+      m_headerLength += 2;
+    }
+
+  m_numberOfIes += 1 + sz;
+
+  return GetSerializedSize ();
+}
+
+void
+EpcX2UeImsiSinrDeltaUpdateHeader::Print (std::ostream &os) const
+{
+  os << "SourceCellId " << m_sourceCellId;
+  for(std::map<uint64_t, int16_t>::const_iterator iter = m_map.begin(); iter != m_map.end(); ++iter)
+  {
+    os << " Imsi " << iter->first;
+    if (iter->second == REMOVED_SINR)
+      {
+        os << " removed";
+      }
+    else
+      {
+        os << " sinr " << iter->second / 100.0;
+      }
+  }
+}
+
+uint16_t
+EpcX2UeImsiSinrDeltaUpdateHeader::GetSourceCellId () const
+{
+  return m_sourceCellId;
+}
+
+void
+EpcX2UeImsiSinrDeltaUpdateHeader::SetSourceCellId(uint16_t cellId)
+{
+  m_sourceCellId = cellId;
+}
+
+std::map <uint64_t, double>
+EpcX2UeImsiSinrDeltaUpdateHeader::GetUeImsiSinrMap () const
+{
+  std::map <uint64_t, double> map;
+  for (std::map<uint64_t, int16_t>::const_iterator iter = m_map.begin(); iter != m_map.end(); ++iter)
+    {
+      if (iter->second != REMOVED_SINR)
+        {
+          map.insert (map.end (), std::make_pair (iter->first, DecodeSinr (iter->second)));
+        }
+    }
+  return map;
+}
+
+void
+EpcX2UeImsiSinrDeltaUpdateHeader::SetUeImsiSinrMap (std::map <uint64_t, double> map)
+{
+  // replace the reported UEs, and keep the removed ones
+  for (std::map<uint64_t, int16_t>::iterator iter = m_map.begin(); iter != m_map.end(); )
+    {
+      if (iter->second != REMOVED_SINR)
+        {
+          iter = m_map.erase (iter);
+        }
+      else
+        {
+          ++iter;
+        }
+    }
+  for (std::map<uint64_t, double>::const_iterator iter = map.begin(); iter != map.end(); ++iter)
+    {
+      NS_ASSERT_MSG (m_map.find (iter->first) == m_map.end (), "UE " << iter->first << " is both reported and removed");
+      m_map[iter->first] = EncodeSinr (iter->second);
+    }
+  UpdateLength ();
+}
+
+std::set<uint64_t>
+EpcX2UeImsiSinrDeltaUpdateHeader::GetRemovedImsis () const
+{
+  std::set<uint64_t> imsis;
+  for (std::map<uint64_t, int16_t>::const_iterator iter = m_map.begin(); iter != m_map.end(); ++iter)
+    {
+      if (iter->second == REMOVED_SINR)
+        {
+          imsis.insert (imsis.end (), iter->first);
+        }
+    }
+  return imsis;
+}
+
+void
+EpcX2UeImsiSinrDeltaUpdateHeader::SetRemovedImsis (std::set<uint64_t> imsis)
+{
+  // replace the removed UEs, and keep the reported ones
+  for (std::map<uint64_t, int16_t>::iterator iter = m_map.begin(); iter != m_map.end(); )
+    {
+      if (iter->second == REMOVED_SINR)
+        {
+          iter = m_map.erase (iter);
+        }
+      else
+        {
+          ++iter;
+        }
+    }
+  for (std::set<uint64_t>::const_iterator iter = imsis.begin(); iter != imsis.end(); ++iter)
+    {
+      NS_ASSERT_MSG (m_map.find (*iter) == m_map.end (), "UE " << *iter << " is both reported and removed");
+      m_map[*iter] = REMOVED_SINR;
+    }
+  UpdateLength ();
+}
+
+void
+EpcX2UeImsiSinrDeltaUpdateHeader::UpdateLength ()
+{
+  m_headerLength = 2 + 2;
+  uint64_t previousImsi = 0;
+  for (std::map<uint64_t, int16_t>::const_iterator iter = m_map.begin(); iter != m_map.end(); ++iter)
+    {
+      m_headerLength += GetVarintSize (iter->first - previousImsi) + 2;
+      previousImsi = iter->first;
+    }
+  m_numberOfIes = 1 + 1 + m_map.size ();
+}
+
+uint32_t
+EpcX2UeImsiSinrDeltaUpdateHeader::GetLengthOfIes () const
+{
+  return m_headerLength;
+}
+
+uint32_t
+EpcX2UeImsiSinrDeltaUpdateHeader::GetNumberOfIes () const
+{
+  return m_numberOfIes;
+}
+
+int16_t
+EpcX2UeImsiSinrDeltaUpdateHeader::EncodeSinr (double sinr)
+{
+  // the minimum value is reserved for the removed UEs
+  if (sinr <= 0)
+    {
+      return REMOVED_SINR + 1;
+    }
+  double value = std::round (1000 * std::log10 (sinr)); // 100 * dB
+  value = std::max (value, static_cast<double> (REMOVED_SINR + 1));
+  value = std::min (value, static_cast<double> (std::numeric_limits<int16_t>::max ()));
+  return static_cast<int16_t> (value);
+}
+
+double
+EpcX2UeImsiSinrDeltaUpdateHeader::DecodeSinr (int16_t value)
+{
+  return std::pow (10.0, value / 1000.0);
+}
+
+uint32_t
+EpcX2UeImsiSinrDeltaUpdateHeader::GetVarintSize (uint64_t value)
+{
+  uint32_t size = 1;
+  while (value >= 0x80)
+    {
+      value >>= 7;
+      size++;
+    }
+  return size;
+}
+
 /////////////////////////////////////////////////////////////////////
 
 NS_OBJECT_ENSURE_REGISTERED (EpcX2ConnectionSwitchHeader);
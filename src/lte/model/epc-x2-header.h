@@ -101,7 +101,8 @@ public:
     NotifyMmWaveLteHandover = 16,
     NotifyCoordinatorHandoverFailed = 17,
     SwitchConnection        = 18,
-    SecondaryCellHandoverCompleted = 19
+    SecondaryCellHandoverCompleted = 19,
+    UpdateUeSinrDelta       = 20
 
   };
 
@@ -908,6 +909,88 @@ private:
   uint16_t m_sourceCellId;
 };
 
+/**
+ * Compact version of EpcX2UeImsiSinrUpdateHeader, which carries only the
+ * entries whose SINR changed since the previous report. The IMSIs are sent
+ * in increasing order, each one as the LEB128 varint of its difference with
+ * the previous one, and the SINR is sent in dB as a signed 16 bit fixed
+ * point value with a resolution of 0.01 dB.
+ */
+class EpcX2UeImsiSinrDeltaUpdateHeader : public Header
+{
+public:
+  EpcX2UeImsiSinrDeltaUpdateHeader ();
+  virtual ~EpcX2UeImsiSinrDeltaUpdateHeader ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual void Print (std::ostream &os) const;
+
+  /**
+   * \return the SINR of the UEs, in linear units, as decoded from the
+   * fixed point values
+   */
+  std::map <uint64_t, double> GetUeImsiSinrMap () const;
+  /**
+   * \param map the SINR of the UEs, in linear units
+   */
+  void SetUeImsiSinrMap (std::map<uint64_t, double> map);
+
+  /**
+   * \return the UEs which are no longer reported by the source cell
+   */
+  std::set<uint64_t> GetRemovedImsis () const;
+  /**
+   * \param imsis the UEs which are no longer reported by the source cell,
+   * which must not be in the SINR map
+   */
+  void SetRemovedImsis (std::set<uint64_t> imsis);
+
+  uint16_t GetSourceCellId () const;
+  void SetSourceCellId (uint16_t sourceCellId);
+
+  uint32_t GetLengthOfIes () const;
+  uint32_t GetNumberOfIes () const;
+
+  /**
+   * \param sinr the SINR in linear units
+   * \return the SINR in units of 0.01 dB, saturated to the int16_t range
+   * without its minimum, which is reserved for the removed UEs
+   */
+  static int16_t EncodeSinr (double sinr);
+  /**
+   * \param value the SINR in units of 0.01 dB
+   * \return the SINR in linear units
+   */
+  static double DecodeSinr (int16_t value);
+
+private:
+  /**
+   * \param value the value to encode
+   * \return the size of the LEB128 encoding of the value, in bytes
+   */
+  static uint32_t GetVarintSize (uint64_t value);
+  /**
+   * Update the length and the number of IEs after a change of the map
+   */
+  void UpdateLength ();
+
+  static const int16_t REMOVED_SINR; ///< SINR value of the removed UEs
+
+  uint32_t          m_numberOfIes;
+  uint32_t          m_headerLength;
+
+  std::map <uint64_t, int16_t> m_map; ///< SINR of the UEs, in units of 0.01 dB, or REMOVED_SINR
+  uint16_t m_sourceCellId;
+};
+
 class EpcX2ConnectionSwitchHeader : public Header
 {
 public:
@@ -31,6 +31,7 @@
 #include <ns3/lte-enb-cmac-sap.h>
 #include <bitset>
 #include <map>
+#include <set>
 
 namespace ns3 {
 
@@ -361,6 +362,21 @@ public:
     Ptr<Packet> ueData; ///< UE data
   };
 
+  /**
+   * \brief Parameters of the UE DATA primitive for a batch of packets
+   *
+   * Forward several packets of the same GTP tunnel (gtpTeid), e.g., the
+   * content of the RLC buffers during the handover procedure, with a single
+   * call. The packets are packed in as few X2-U datagrams as possible
+   */
+  struct UeDataBatchParams
+  {
+    uint16_t    sourceCellId; ///< source cell ID
+    uint16_t    targetCellId; ///< target cell ID
+    uint32_t    gtpTeid; ///< GTP TEID
+    std::vector <Ptr<Packet> > ueData; ///< UE data, in transmission order
+  };
+
   struct SecondaryHandoverParams
   {
     uint64_t imsi;
@@ -381,6 +397,8 @@ public:
     uint16_t    sourceCellId;
     uint16_t    targetCellId;
     std::map<uint64_t, double> ueImsiSinrMap;
+    bool        deltaReport; ///< true if ueImsiSinrMap only contains the SINR which changed since the previous report
+    std::set<uint64_t> removedImsis; ///< UEs no longer reported by the source cell, only used with deltaReport
   };
 
   struct HandoverFailedParams
@@ -494,6 +512,8 @@ public:
 
   virtual void SendUeData (UeDataParams params) = 0;
 
+  virtual void SendUeDataBatch (const UeDataBatchParams &params) = 0;
+
   virtual void SetEpcX2PdcpUser (uint32_t teid, EpcX2PdcpUser * s) = 0;
 
   virtual void SetEpcX2RlcUser (uint32_t teid, EpcX2RlcUser * s) = 0;
@@ -522,6 +542,8 @@ public:
   virtual void RemoveTeidToBeForwarded (uint32_t gtpTeid) = 0;
   // to forward the packets in the RLC buffers in the source cell as if they were generated by a PDCP
   virtual void ForwardRlcPdu (UeDataParams params) = 0;
+  // as ForwardRlcPdu, for a batch of packets of the same bearer
+  virtual void ForwardRlcPduBatch (const UeDataBatchParams &params) = 0;
 
 };
 
@@ -671,6 +693,12 @@ public:
    */
   virtual void SendUeData (UeDataParams params);
 
+  /**
+   * Send UE data function for a batch of packets
+   * \param params the UE data parameters
+   */
+  virtual void SendUeDataBatch (const UeDataBatchParams &params);
+
   virtual void SetEpcX2PdcpUser (uint32_t teid, EpcX2PdcpUser * s);
 
   virtual void SetEpcX2RlcUser (uint32_t teid, EpcX2RlcUser * s);
@@ -697,6 +725,8 @@ public:
 
   virtual void ForwardRlcPdu (UeDataParams params);
 
+  virtual void ForwardRlcPduBatch (const UeDataBatchParams &params);
+
 private:
   EpcX2SpecificEpcX2SapProvider ();
   C* m_x2; ///< owner class
@@ -769,6 +799,13 @@ EpcX2SpecificEpcX2SapProvider<C>::SendUeData (UeDataParams params)
   m_x2->DoSendUeData (params);
 }
 
+template <class C>
+void
+EpcX2SpecificEpcX2SapProvider<C>::SendUeDataBatch (const UeDataBatchParams &params)
+{
+  m_x2->DoSendUeDataBatch (params);
+}
+
 /**
  * EpcX2SpecificEpcX2SapUser
  */
@@ -863,6 +900,13 @@ EpcX2SpecificEpcX2SapProvider<C>::ForwardRlcPdu(UeDataParams params)
   m_x2->DoSendMcPdcpPdu(params);
 }
 
+template <class C>
+void
+EpcX2SpecificEpcX2SapProvider<C>::ForwardRlcPduBatch(const UeDataBatchParams &params)
+{
+  m_x2->DoSendMcPdcpPduBatch(params);
+}
+
 ///////////////////////////////////////
 
 template <class C>
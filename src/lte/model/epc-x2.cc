@@ -23,6 +23,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/uinteger.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
@@ -89,7 +90,8 @@ NS_OBJECT_ENSURE_REGISTERED (EpcX2);
 
 EpcX2::EpcX2 ()
   : m_x2cUdpPort (4444),
-    m_x2uUdpPort (2152)
+    m_x2uUdpPort (2152),
+    m_maxBatchDatagramSize (2972)
 {
   NS_LOG_FUNCTION (this);
 
@@ -123,6 +125,14 @@ EpcX2::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::EpcX2")
     .SetParent<Object> ()
     .SetGroupName("Lte")
+    .AddAttribute ("MaxBatchDatagramSize",
+                   "The maximum size in bytes of the X2-U datagrams in which the GTP-U packets "
+                   "of a batch, e.g., the RLC buffers forwarded during a handover, are packed. "
+                   "A GTP-U packet larger than this size is sent alone. The default fits the "
+                   "default X2 link MTU of 3000 bytes.",
+                   UintegerValue (2972),
+                   MakeUintegerAccessor (&EpcX2::m_maxBatchDatagramSize),
+                   MakeUintegerChecker<uint32_t> ())
     .AddTraceSource ("RxPDU",
                      "PDU received.",
                      MakeTraceSourceAccessor (&EpcX2::m_rxPdu),
@@ -500,9 +510,27 @@ EpcX2::RecvFromX2cSocket (Ptr<Socket> socket)
       EpcX2SapUser::UeImsiSinrParams params;
       params.ueImsiSinrMap = x2ueSinrUpdateHeader.GetUeImsiSinrMap();
       params.sourceCellId = x2ueSinrUpdateHeader.GetSourceCellId();
+      params.deltaReport = false;
 
       m_x2SapUser->RecvUeSinrUpdate(params);  
     }
+  else if(procedureCode == EpcX2Header::UpdateUeSinrDelta)
+    {
+      NS_LOG_LOGIC ("Recv X2 message: UPDATE UE SINR DELTA");
+
+      EpcX2UeImsiSinrDeltaUpdateHeader x2ueSinrDeltaUpdateHeader;
+      packet->RemoveHeader(x2ueSinrDeltaUpdateHeader);
+
+      NS_LOG_INFO ("X2 SinrDeltaUpdateHeader header: " << x2ueSinrDeltaUpdateHeader);
+
+      EpcX2SapUser::UeImsiSinrParams params;
+      params.ueImsiSinrMap = x2ueSinrDeltaUpdateHeader.GetUeImsiSinrMap();
+      params.sourceCellId = x2ueSinrDeltaUpdateHeader.GetSourceCellId();
+      params.deltaReport = true;
+      params.removedImsis = x2ueSinrDeltaUpdateHeader.GetRemovedImsis();
+
+      m_x2SapUser->RecvUeSinrUpdate(params);
+    }
   else if (procedureCode == EpcX2Header::RequestMcHandover)
     {
       NS_LOG_LOGIC ("Recv X2 message: REQUEST MC HANDOVER");
@@ -596,6 +624,29 @@ EpcX2::RecvFromX2uSocket (Ptr<Socket> socket)
       delay = Simulator::Now() - epcX2Tag.GetSenderTimestamp ();
       packet->RemovePacketTag(epcX2Tag);
     }
+
+  // a datagram carries several GTP-U packets if it was sent by
+  // SendUeDataPackets, split it using the length of their headers
+  GtpuHeader gtpu;
+  while (packet->GetSize () > 0)
+    {
+      packet->PeekHeader (gtpu);
+      uint32_t gtpuSize = gtpu.GetLength () + 8;
+      if (gtpuSize >= packet->GetSize ())
+        {
+          RecvUeDataPacket (cellsInfo, packet, delay);
+          break;
+        }
+      RecvUeDataPacket (cellsInfo, packet->CreateFragment (0, gtpuSize), delay);
+      packet->RemoveAtStart (gtpuSize);
+    }
+}
+
+void
+EpcX2::RecvUeDataPacket (Ptr<X2CellInfo> cellsInfo, Ptr<Packet> packet, Time delay)
+{
+  NS_LOG_FUNCTION (this << packet);
+
   m_rxPdu(cellsInfo->m_remoteCellId, cellsInfo->m_localCellId, packet->GetSize (), delay.GetNanoSeconds (), 1);
 
   GtpuHeader gtpu;
@@ -1207,6 +1258,79 @@ EpcX2::DoSendUeData (EpcX2SapProvider::UeDataParams params)
   sourceSocket->SendTo (packet, 0, InetSocketAddress (targetIpAddr, m_x2uUdpPort));
 }
 
+void
+EpcX2::DoSendUeDataBatch (const EpcX2SapProvider::UeDataBatchParams &params)
+{
+  NS_LOG_FUNCTION (this);
+
+  GtpuHeader gtpu;
+  SendUeDataPackets (params, gtpu.GetMessageType ());
+}
+
+void
+EpcX2::DoSendMcPdcpPduBatch (const EpcX2SapProvider::UeDataBatchParams &params)
+{
+  NS_LOG_FUNCTION (this);
+
+  SendUeDataPackets (params, EpcX2Header::McForwardDownlinkData);
+}
+
+void
+EpcX2::SendUeDataPackets (const EpcX2SapProvider::UeDataBatchParams &params, uint8_t messageType)
+{
+  NS_LOG_LOGIC ("sourceCellId = " << params.sourceCellId);
+  NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
+  NS_LOG_LOGIC ("gtpTeid = " << params.gtpTeid);
+  NS_LOG_LOGIC ("number of packets = " << params.ueData.size ());
+
+  NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.targetCellId) != m_x2InterfaceSockets.end (),
+                 "Missing infos for targetCellId = " << params.targetCellId);
+  Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets [params.targetCellId];
+  Ptr<Socket> sourceSocket = socketInfo->m_localUserPlaneSocket;
+  InetSocketAddress targetAddress (socketInfo->m_remoteIpAddr, m_x2uUdpPort);
+
+  GtpuHeader gtpu;
+  gtpu.SetTeid (params.gtpTeid);
+  gtpu.SetMessageType (messageType);
+
+  // each packet keeps its own GTP-U header, and consecutive GTP-U packets
+  // are concatenated in the same datagram up to m_maxBatchDatagramSize bytes
+  NS_LOG_INFO ("Forward a batch of UE DATA through X2 interface");
+  Ptr<Packet> datagram;
+  for (std::vector<Ptr<Packet> >::const_iterator it = params.ueData.begin (); it != params.ueData.end (); ++it)
+    {
+      Ptr<Packet> packet = *it;
+      gtpu.SetLength (packet->GetSize () + gtpu.GetSerializedSize () - 8); /// \todo This should be done in GtpuHeader
+      packet->AddHeader (gtpu);
+      if (datagram != 0 && datagram->GetSize () + packet->GetSize () > m_maxBatchDatagramSize)
+        {
+          SendUeDataDatagram (sourceSocket, targetAddress, datagram);
+          datagram = 0;
+        }
+      if (datagram == 0)
+        {
+          datagram = packet;
+        }
+      else
+        {
+          datagram->AddAtEnd (packet);
+        }
+    }
+  if (datagram != 0)
+    {
+      SendUeDataDatagram (sourceSocket, targetAddress, datagram);
+    }
+}
+
+void
+EpcX2::SendUeDataDatagram (Ptr<Socket> sourceSocket, const InetSocketAddress &targetAddress, Ptr<Packet> datagram)
+{
+  NS_LOG_LOGIC ("datagram size = " << datagram->GetSize ());
+  EpcX2Tag tag (Simulator::Now ());
+  datagram->AddPacketTag (tag);
+  sourceSocket->SendTo (datagram, 0, targetAddress);
+}
+
 void
 EpcX2::DoSendMcPdcpPdu(EpcX2Sap::UeDataParams params)
 {
@@ -1295,22 +1419,43 @@ EpcX2::DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params)
   NS_LOG_LOGIC ("targetIpAddr = " << targetIpAddr);
 
   // Build the X2 message
-  EpcX2UeImsiSinrUpdateHeader x2imsiSinrHeader;
-  x2imsiSinrHeader.SetUeImsiSinrMap (params.ueImsiSinrMap);
-  x2imsiSinrHeader.SetSourceCellId (params.sourceCellId);
-
+  Ptr<Packet> packet = Create <Packet> ();
   EpcX2Header x2Header;
   x2Header.SetMessageType (EpcX2Header::InitiatingMessage);
-  x2Header.SetProcedureCode (EpcX2Header::UpdateUeSinr);
-  x2Header.SetLengthOfIes (x2imsiSinrHeader.GetLengthOfIes ());
-  x2Header.SetNumberOfIes (x2imsiSinrHeader.GetNumberOfIes ());
+  if (params.deltaReport)
+    {
+      // only the SINR which changed, with the compact encoding
+      EpcX2UeImsiSinrDeltaUpdateHeader x2imsiSinrDeltaHeader;
+      x2imsiSinrDeltaHeader.SetUeImsiSinrMap (params.ueImsiSinrMap);
+      x2imsiSinrDeltaHeader.SetRemovedImsis (params.removedImsis);
+      x2imsiSinrDeltaHeader.SetSourceCellId (params.sourceCellId);
 
-  NS_LOG_INFO ("X2 header: " << x2Header);
-  NS_LOG_INFO ("X2 UeImsiSinrUpdate header: " << x2imsiSinrHeader);
+      x2Header.SetProcedureCode (EpcX2Header::UpdateUeSinrDelta);
+      x2Header.SetLengthOfIes (x2imsiSinrDeltaHeader.GetLengthOfIes ());
+      x2Header.SetNumberOfIes (x2imsiSinrDeltaHeader.GetNumberOfIes ());
+
+      NS_LOG_INFO ("X2 header: " << x2Header);
+      NS_LOG_INFO ("X2 UeImsiSinrDeltaUpdate header: " << x2imsiSinrDeltaHeader);
+
+      packet->AddHeader (x2imsiSinrDeltaHeader);
+    }
+  else
+    {
+      EpcX2UeImsiSinrUpdateHeader x2imsiSinrHeader;
+      x2imsiSinrHeader.SetUeImsiSinrMap (params.ueImsiSinrMap);
+      x2imsiSinrHeader.SetSourceCellId (params.sourceCellId);
+
+      x2Header.SetProcedureCode (EpcX2Header::UpdateUeSinr);
+      x2Header.SetLengthOfIes (x2imsiSinrHeader.GetLengthOfIes ());
+      x2Header.SetNumberOfIes (x2imsiSinrHeader.GetNumberOfIes ());
+
+      NS_LOG_INFO ("X2 header: " << x2Header);
+      NS_LOG_INFO ("X2 UeImsiSinrUpdate header: " << x2imsiSinrHeader);
+
+      packet->AddHeader (x2imsiSinrHeader);
+    }
 
   // Build the X2 packet
-  Ptr<Packet> packet = Create <Packet> ();
-  packet->AddHeader (x2imsiSinrHeader);
   packet->AddHeader (x2Header);
   NS_LOG_INFO ("packetLen = " << packet->GetSize ());
 
@@ -26,6 +26,7 @@
 #define EPC_X2_H
 
 #include "ns3/socket.h"
+#include "ns3/inet-socket-address.h"
 #include "ns3/callback.h"
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -244,7 +245,14 @@ protected:
    * \param params EpcX2SapProvider::UeDataParams
    */
   virtual void DoSendUeData (EpcX2SapProvider::UeDataParams params);
+  /**
+   * Send UE data function for a batch of packets
+   *
+   * \param params EpcX2SapProvider::UeDataBatchParams
+   */
+  virtual void DoSendUeDataBatch (const EpcX2SapProvider::UeDataBatchParams &params);
   virtual void DoSendMcPdcpPdu (EpcX2SapProvider::UeDataParams params);
+  virtual void DoSendMcPdcpPduBatch (const EpcX2SapProvider::UeDataBatchParams &params);
   virtual void DoReceiveMcPdcpSdu (EpcX2SapProvider::UeDataParams params);
   virtual void DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params);
   virtual void DoSendMcHandoverRequest (EpcX2SapProvider::SecondaryHandoverParams params);
@@ -274,6 +282,35 @@ protected:
   EpcX2RlcProvider* m_x2RlcProvider;
 
 private:
+  /**
+   * Sends a batch of packets of the same GTP tunnel through the X2-U
+   * interface, looking up the socket of the target cell only once. Each
+   * packet gets its own GTP-U header, and consecutive GTP-U packets are
+   * packed in the same datagram, up to MaxBatchDatagramSize bytes
+   *
+   * \param params the packets and their tunnel
+   * \param messageType the message type of the GTP-U headers
+   */
+  void SendUeDataPackets (const EpcX2SapProvider::UeDataBatchParams &params, uint8_t messageType);
+
+  /**
+   * Sends a datagram with one or more GTP-U packets through the X2-U interface
+   *
+   * \param sourceSocket the X2-U socket of the target cell
+   * \param targetAddress the X2-U address of the target cell
+   * \param datagram the datagram
+   */
+  void SendUeDataDatagram (Ptr<Socket> sourceSocket, const InetSocketAddress &targetAddress, Ptr<Packet> datagram);
+
+  /**
+   * Delivers a GTP-U packet received through the X2-U interface, alone or
+   * as part of a datagram sent by SendUeDataPackets
+   *
+   * \param cellsInfo the cells of the X2 interface
+   * \param packet the GTP-U packet
+   * \param delay the delay of the X2 interface
+   */
+  void RecvUeDataPacket (Ptr<X2CellInfo> cellsInfo, Ptr<Packet> packet, Time delay);
 
   /**
    * Map the targetCellId to the corresponding (sourceSocket, remoteIpAddr) to be used
@@ -293,6 +330,8 @@ private:
   uint16_t m_x2cUdpPort;
   uint16_t m_x2uUdpPort;
 
+  uint32_t m_maxBatchDatagramSize; ///< maximum size of the X2-U datagrams sent by SendUeDataPackets
+
   TracedCallback<uint16_t, uint16_t, uint32_t, uint64_t, bool> m_rxPdu;
 
   /**
@@ -56,6 +56,7 @@
 #include <ns3/mc-enb-pdcp.h>
 #include "ns3/lte-pdcp-tag.h"
 #include <ns3/lte-rlc-sap.h>
+#include <limits>
 
 
 
@@ -169,7 +170,6 @@ UeManager::UeManager (Ptr<LteEnbRrc> rrc, uint16_t rnti, State s, uint8_t compon
     m_sourceX2apId (0),
     m_sourceCellId (0),
     m_needPhyMacConfiguration (false),
-    m_x2forwardingBufferSize (0),
     m_maxx2forwardingBufferSize (2*1024),
     m_allMmWaveInOutageAtInitialAccess (false),
     m_caSupportConfigured (false),
@@ -908,12 +908,10 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
   // RlcBuffers forwarding only for RlcAm bearers.
   if (0 != rlc->GetObject<LteRlcAm> ())
   {
-    //Copy lte-rlc-am.m_txOnBuffer to X2 forwarding buffer.
+    //Move lte-rlc-am.m_txOnBuffer to X2 forwarding buffer.
     Ptr<LteRlcAm> rlcAm = rlc->GetObject<LteRlcAm>();
-    uint32_t txonBufferSize = rlcAm->GetTxBufferSize();
-    std::vector < Ptr<Packet> > txonBuffer = rlcAm->GetTxBuffer();
-    //m_x2forwardingBufferSize =  drbIt->second->m_rlc->GetObject<LteRlcAm>()->GetTxBufferSize();
-    //m_x2forwardingBuffer = drbIt->second->m_rlc->GetObject<LteRlcAm>()->GetTxBuffer();
+    LteRlcSduQueue txonBuffer = rlcAm->TakeTxBuffer();
+    uint32_t txonBufferSize = txonBuffer.GetNBytes();
     uint32_t txedBufferSize = rlcAm->GetTxedBufferSize();
     std::vector < LteRlcAm::RetxPdu > txedBuffer = rlcAm->GetTxedBuffer();
     uint32_t retxBufferSize = rlcAm->GetRetxBufferSize();
@@ -940,11 +938,9 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
 
     //Construct the forwarding buffer
     //Forwarding buffer = retxBuffer + txedBuffer + txonBuffer.
-    //if ( txonBufferSize > 0 )
-    //{
       LtePdcpHeader pdcpHeader;
       uint32_t pos = 0;
-      for (std::vector< Ptr<Packet> >::iterator it = txonBuffer.begin(); it != txonBuffer.end(); ++it)
+      for (LteRlcSduQueue::ConstIterator it = txonBuffer.Begin(); it != txonBuffer.End(); ++it)
       {
         pos++;
         if((*it)->GetSize() > 3)
@@ -971,7 +967,7 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
           if (it->second != 0)
           {
             NS_LOG_DEBUG ( this << " add to forwarding buffer SEQ = " << it->first << " Ptr<Packet> = " << it->second );
-            m_x2forwardingBuffer.push_back(it->second);
+            m_x2forwardingBuffer.PushBack(it->second);
           }
         }
         NS_LOG_DEBUG(this << " ADDING TXONBUFFER OF RLC AM " << m_rnti << " Size = " << txonBufferSize) ;
@@ -982,17 +978,17 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
           segmentedRlcsdu->PeekHeader(pdcpHeader);
           NS_LOG_DEBUG(this << "SegmentedRlcSdu = " << segmentedRlcsdu->GetSize() << " SEQ = " << pdcpHeader.GetSequenceNumber());
           //insert the complete version of the fragmented SDU to the front of txonBuffer.
-          txonBuffer.insert(txonBuffer.begin(),segmentedRlcsdu);
+          txonBuffer.PushFront(segmentedRlcsdu);
         }
-        m_x2forwardingBuffer.insert(m_x2forwardingBuffer.end(), txonBuffer.begin(), txonBuffer.end());
-        m_x2forwardingBufferSize += rlcAm->GetTransmittingRlcSduBufferSize() + txonBufferSize;
+        m_x2forwardingBuffer.Append(txonBuffer);
 
         //Get the rlcAm
-        std::vector < Ptr <Packet> > rlcAmTxedSduBuffer = rlcAm->GetTxedRlcSduBuffer();
+        const std::vector < Ptr <Packet> > &rlcAmTxedSduBuffer = rlcAm->GetTxedRlcSduBuffer();
         LtePdcpHeader pdcpHeader_1;
-        m_x2forwardingBuffer.at(0)->PeekHeader(pdcpHeader_1);
-        uint16_t i = 0;
-        for (std::vector< Ptr<Packet> >::iterator it = rlcAmTxedSduBuffer.begin(); it != rlcAmTxedSduBuffer.end(); ++it)
+        m_x2forwardingBuffer.Front()->PeekHeader(pdcpHeader_1);
+        //the previous SDUs are added at the head of the forwarding buffer, in order
+        LteRlcSduQueue previousSdus;
+        for (std::vector< Ptr<Packet> >::const_iterator it = rlcAmTxedSduBuffer.begin(); it != rlcAmTxedSduBuffer.end(); ++it)
         {
           if ((*it) != NULL)
           {
@@ -1003,41 +999,33 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
             if (pdcpHeader.GetSequenceNumber() >= (pdcpHeader_1.GetSequenceNumber() - 2) && pdcpHeader.GetSequenceNumber() <= (pdcpHeader_1.GetSequenceNumber()) )
             {
               NS_LOG_DEBUG("Added previous SDU to forwarding buffer SEQ = " << pdcpHeader.GetSequenceNumber() << " Size = " << (*it)->GetSize());
-              m_x2forwardingBuffer.insert(m_x2forwardingBuffer.begin()+i, (*it)->Copy());
-              ++i;
+              previousSdus.PushBack((*it)->Copy());
             }
           }
         }
+        previousSdus.Append(m_x2forwardingBuffer);
+        m_x2forwardingBuffer.Swap(previousSdus);
 
       }
       else
-      { //TransmittingBuffer is empty. Only copy TxonBuffer.
+      { //TransmittingBuffer is empty. Only move TxonBuffer.
         NS_LOG_DEBUG(this << " ADDING TXONBUFFER OF RLC AM " << m_rnti << " Size = " << txonBufferSize) ;
-        m_x2forwardingBuffer = txonBuffer;
-        m_x2forwardingBufferSize += txonBufferSize;
+        m_x2forwardingBuffer.Append(txonBuffer);
       }
-    //}
   }
   //For RlcUM, no forwarding available as the simulator itself (seamless HO).
   //However, as the LTE-UMTS book, PDCP txbuffer should be forwarded for seamless
   //HO. Enable this code for txbuffer forwarding in seamless HO (which is believe to
   //be correct).
-  else if (0 != rlc->GetObject<LteRlcUm> ())
+  else if (0 != rlc->GetObject<LteRlcUm> () || 0 != rlc->GetObject<LteRlcUmLowLat> ())
   {
-    //Copy lte-rlc-um.m_txOnBuffer to X2 forwarding buffer.
-    NS_LOG_DEBUG(this << " Copying txonBuffer from RLC UM " << m_rnti);
-    m_x2forwardingBuffer = rlc->GetObject<LteRlcUm>()->GetTxBuffer();
-    m_x2forwardingBufferSize =  rlc->GetObject<LteRlcUm>()->GetTxBufferSize();
-  }
-  else if (0 != rlc->GetObject<LteRlcUmLowLat> ())
-  {
-    //Copy lte-rlc-um-low-lat.m_txOnBuffer to X2 forwarding buffer.
-    NS_LOG_DEBUG(this << " Copying txonBuffer from RLC UM " << m_rnti);
-    m_x2forwardingBuffer = rlc->GetObject<LteRlcUmLowLat>()->GetTxBuffer();
-    m_x2forwardingBufferSize =  rlc->GetObject<LteRlcUmLowLat>()->GetTxBufferSize();
+    //Move the RLC UM transmission buffer to the X2 forwarding buffer.
+    NS_LOG_DEBUG(this << " Moving txonBuffer from RLC UM " << m_rnti);
+    LteRlcSduQueue txBuffer = rlc->TakeTxBuffer();
+    m_x2forwardingBuffer.Append(txBuffer);
   }
   //LteRlcAm m_txBuffer stores PDCP "PDU".
-  NS_LOG_DEBUG(this << " m_x2forw buffer size = " << m_x2forwardingBufferSize);
+  NS_LOG_DEBUG(this << " m_x2forw buffer size = " << m_x2forwardingBuffer.GetNBytes());
     //Forwarding the packet inside m_x2forwardingBuffer to target eNB.
 
   // Prepare the variables for the LTE to MmWave DC forward
@@ -1050,16 +1038,18 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
     NS_ASSERT_MSG(mcPdcp->GetUseMmWaveConnection(), "The McEnbPdcp is not forwarding data to the mmWave eNB, check if the switch happened!");
   }
 
-  while (!m_x2forwardingBuffer.empty())
+  // the SDUs for the target eNB are sent through X2 in a single batch
+  EpcX2Sap::UeDataBatchParams params;
+  params.sourceCellId = m_rrc->m_cellId;
+  params.targetCellId = m_targetCellId;
+  params.gtpTeid = gtpTeid;
+  params.ueData.reserve (m_x2forwardingBuffer.GetNPackets ());
+
+  while (!m_x2forwardingBuffer.IsEmpty())
   {
     NS_LOG_DEBUG(this << " Forwarding m_x2forwardingBuffer to target eNB, gtpTeid = " << gtpTeid );
-    EpcX2Sap::UeDataParams params;
-    params.sourceCellId = m_rrc->m_cellId;
-    params.targetCellId = m_targetCellId;
-    params.gtpTeid = gtpTeid;
     //Remove tags to get PDCP SDU from PDCP PDU.
-    //Ptr<Packet> rlcSdu =  (*(m_x2forwardingBuffer.begin()))->Copy();
-    Ptr<Packet> rlcSdu =  m_x2forwardingBuffer.at(0);
+    Ptr<Packet> rlcSdu = m_x2forwardingBuffer.PopFront();
     //Tags to be removed from rlcSdu (from outer to inner)
     //LteRlcSduStatusTag rlcSduStatusTag;
     //RlcTag  rlcTag; //rlc layer timestamp
@@ -1081,7 +1071,6 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
 
         rlcSdu->RemoveAllPacketTags(); // this does not remove byte tags
         NS_LOG_LOGIC ("removed tags, size = " << rlcSdu->GetSize() );
-        params.ueData = rlcSdu;
         /*
         rlcSdu->RemovePacketTag(rlcSduStatusTag); //remove Rlc status tag.
         NS_LOG_DEBUG ("removed rlc status tag, size = " << rlcSdu->GetSize() );
@@ -1096,25 +1085,9 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
           if(!mcMmToMmWaveForwarding)
           {
             rlcSdu->RemoveHeader(pdcpHeader); //remove pdcp header
-
-            NS_LOG_INFO("Forward to target cell in HO");
-            m_rrc->m_x2SapProvider->SendUeData (params);
-            NS_LOG_LOGIC ("sourceCellId = " << params.sourceCellId);
-            NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
-            NS_LOG_LOGIC ("gtpTeid = " << params.gtpTeid);
-            NS_LOG_LOGIC ("ueData = " << params.ueData);
-            NS_LOG_LOGIC ("ueData size = " << params.ueData->GetSize ());
-          }
-          else
-          {
-            NS_LOG_INFO("Forward to target cell RLC in HO");
-            m_rrc->m_x2SapProvider->ForwardRlcPdu (params);
-            NS_LOG_LOGIC ("sourceCellId = " << params.sourceCellId);
-            NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
-            NS_LOG_LOGIC ("gtpTeid = " << params.gtpTeid);
-            NS_LOG_LOGIC ("ueData = " << params.ueData);
-            NS_LOG_LOGIC ("ueData size = " << params.ueData->GetSize ());
           }
+          NS_LOG_LOGIC ("ueData = " << rlcSdu << " size = " << rlcSdu->GetSize ());
+          params.ueData.push_back (rlcSdu);
         }
         else // the target eNB has no PDCP entity. Thus re-insert the packets in the
         // LTE eNB PDCP, which will forward them to the MmWave RLC entity.
@@ -1136,12 +1109,27 @@ UeManager::ForwardRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint32_t gtpTei
     {
       NS_LOG_UNCOND("Too small, not forwarded");
     }
-    m_x2forwardingBufferSize -= (*(m_x2forwardingBuffer.begin()))->GetSize();
-    m_x2forwardingBuffer.erase (m_x2forwardingBuffer.begin());
-    NS_LOG_LOGIC(this << " After forwarding: buffer size = " << m_x2forwardingBufferSize );
+    NS_LOG_LOGIC(this << " After forwarding: buffer size = " << m_x2forwardingBuffer.GetNBytes() );
   }
-}
 
+  if (!params.ueData.empty ())
+  {
+    NS_LOG_LOGIC ("sourceCellId = " << params.sourceCellId);
+    NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
+    NS_LOG_LOGIC ("gtpTeid = " << params.gtpTeid);
+    NS_LOG_LOGIC ("number of packets = " << params.ueData.size ());
+    if(!mcMmToMmWaveForwarding)
+    {
+      NS_LOG_INFO("Forward to target cell in HO");
+      m_rrc->m_x2SapProvider->SendUeDataBatch (params);
+    }
+    else
+    {
+      NS_LOG_INFO("Forward to target cell RLC in HO");
+      m_rrc->m_x2SapProvider->ForwardRlcPduBatch (params);
+    }
+  }
+}
 
 LteRrcSap::RadioResourceConfigDedicated
 UeManager::GetRadioResourceConfigForHandoverPreparationInfo ()
@@ -1201,7 +1189,7 @@ UeManager::SendData (uint8_t bid, Ptr<Packet> p)
       {
         NS_LOG_LOGIC("SEQ SEQ HANDOVERLEAVING STATE LTE ENB RRC.");
         //m_x2forwardingBuffer is empty, forward incomming pkts to target eNB.
-        if (m_x2forwardingBuffer.empty()){
+        if (m_x2forwardingBuffer.IsEmpty()){
         NS_LOG_INFO ("forwarding incoming pkts to target eNB over X2-U");
         NS_LOG_LOGIC ("forwarding data to target eNB over X2-U");
         uint8_t drbid = Bid2Drbid (bid);
@@ -1222,7 +1210,7 @@ UeManager::SendData (uint8_t bid, Ptr<Packet> p)
       //Forwarding of this m_x2forwardingBuffer is done in RecvHandoverRequestAck
       else{
         NS_LOG_INFO ("append incomming pkts to m_x2forwardingBuffer");
-        m_x2forwardingBuffer.push_back(p);
+        m_x2forwardingBuffer.PushBack(p);
         //NS_LOG_DEBUG("Forwarding but push_bach to buffer SEQ = " << pdcpHeader.GetSequenceNumber());
       }
     }
@@ -2447,8 +2435,13 @@ UeManager::SwitchToState (State newState)
             if(m_rrc->m_bestMmWaveCellForImsiMap.at(m_imsi) != m_rrc->GetCellId() && !m_rrc->m_ismmWave)
             {
               uint16_t maxSinrCellId = m_rrc->m_bestMmWaveCellForImsiMap.at(m_imsi);
-              // get the SINR
-              double maxSinrDb = 10*std::log10(m_rrc->m_imsiCellSinrMap.find(m_imsi)->second.find(maxSinrCellId)->second);
+              // get the SINR, which is unknown if the cell stopped reporting the UE
+              double maxSinrDb = -std::numeric_limits<double>::infinity();
+              std::map<uint64_t, CellSinrMap>::const_iterator cellsIter = m_rrc->m_imsiCellSinrMap.find(m_imsi);
+              if (cellsIter != m_rrc->m_imsiCellSinrMap.end() && cellsIter->second.find(maxSinrCellId) != cellsIter->second.end())
+              {
+                maxSinrDb = 10*std::log10(cellsIter->second.find(maxSinrCellId)->second);
+              }
               if(maxSinrDb > m_rrc->m_outageThreshold)
               {
                 // there is a MmWave cell to which the UE can connect
@@ -2989,6 +2982,19 @@ LteEnbRrc::GetTypeId (void)
             BooleanValue (true),
             MakeBooleanAccessor (&LteEnbRrc::m_reportAllUeMeas),
             MakeBooleanChecker ())
+   .AddAttribute ("DeltaSinrReports",
+            "If true, the MmWave eNB sends to the LTE coordinator only the UE SINR which changed by more than "
+            "SinrReportHysteresis since the previous report, with a compact encoding (0.01 dB resolution). "
+            "If false, it sends the SINR of all the UEs in every report",
+            BooleanValue (false),
+            MakeBooleanAccessor (&LteEnbRrc::m_deltaSinrReports),
+            MakeBooleanChecker ())
+   .AddAttribute ("SinrReportHysteresis",
+            "The minimum change of the SINR of a UE for which it is sent to the LTE coordinator "
+            "when DeltaSinrReports is true [dB]",
+            DoubleValue (1.0),
+            MakeDoubleAccessor (&LteEnbRrc::m_sinrReportHysteresis),
+            MakeDoubleChecker<double> (0.0))
     // Trace sources
     .AddTraceSource ("NewUeContext",
                      "Fired upon creation of a new UE context.",
@@ -3615,6 +3621,8 @@ LteEnbRrc::DoUpdateUeSinrEstimate(LteEnbCphySapUser::UeAssociatedSinrInfo info)
     EpcX2SapProvider::UeImsiSinrParams params;
     params.targetCellId = m_lteCellId;
     params.sourceCellId = m_cellId;
+    params.deltaReport = m_deltaSinrReports;
+    bool reportComplete = false; // true if params.ueImsiSinrMap merges the reports of all the CCs
 
     //if (m_reportAllUeMeas == true)
     if(false)
@@ -3650,10 +3658,47 @@ LteEnbRrc::DoUpdateUeSinrEstimate(LteEnbCphySapUser::UeAssociatedSinrInfo info)
         }
         params.ueImsiSinrMap = ueImsiSinrMapToSend;
         m_ueImsiSinrMap.clear(); // delete the reports
+        reportComplete = true;
+      }
+    }
+
+    if (m_deltaSinrReports)
+    {
+      if (reportComplete)
+      {
+        // the UEs which are no longer in the report are sent as removed, so that the coordinator forgets their SINR
+        for (ImsiSinrMap::iterator last = m_lastReportedSinrDbMap.begin(); last != m_lastReportedSinrDbMap.end(); )
+        {
+          if (params.ueImsiSinrMap.find(last->first) == params.ueImsiSinrMap.end())
+          {
+            params.removedImsis.insert(last->first);
+            last = m_lastReportedSinrDbMap.erase(last);
+          }
+          else
+          {
+            ++last;
+          }
+        }
+      }
+
+      // keep only the SINR which moved by more than the hysteresis since they were last sent
+      for (ImsiSinrMap::iterator ue = params.ueImsiSinrMap.begin(); ue != params.ueImsiSinrMap.end(); )
+      {
+        double sinrDb = 10*std::log10(ue->second);
+        std::pair<ImsiSinrMap::iterator, bool> last = m_lastReportedSinrDbMap.insert(std::make_pair(ue->first, sinrDb));
+        if (last.second || std::abs(sinrDb - last.first->second) > m_sinrReportHysteresis)
+        {
+          last.first->second = sinrDb;
+          ++ue;
+        }
+        else
+        {
+          ue = params.ueImsiSinrMap.erase(ue);
+        }
       }
     }
 
-    NS_LOG_INFO("number of SINR reported " << params.ueImsiSinrMap.size());
+    NS_LOG_INFO("number of SINR reported " << params.ueImsiSinrMap.size() << " removed " << params.removedImsis.size());
     m_x2SapProvider->SendUeSinrUpdate (params);
   }
 
@@ -3665,16 +3710,35 @@ LteEnbRrc::DoRecvUeSinrUpdate(EpcX2SapUser::UeImsiSinrParams params)
   NS_LOG_FUNCTION(this);
   NS_LOG_LOGIC("Recv Ue SINR Update from cell " << params.sourceCellId);
   uint16_t mmWaveCellId = params.sourceCellId;
-  if(m_cellSinrMap.find(mmWaveCellId) != m_cellSinrMap.end())
-  {     // update the entry
-    m_cellSinrMap[mmWaveCellId] = params.ueImsiSinrMap;
-    m_numNewSinrReports++;
+  if (params.deltaReport)
+  {
+    // only the SINR which changed were sent, update them in place
+    ImsiSinrMap &cellSinrMap = m_cellSinrMap[mmWaveCellId];
+    for(ImsiSinrMap::const_iterator imsiIter = params.ueImsiSinrMap.begin(); imsiIter != params.ueImsiSinrMap.end(); ++imsiIter)
+    {
+      cellSinrMap[imsiIter->first] = imsiIter->second;
+    }
+    // forget the UEs which are no longer reported by this cell
+    for(std::set<uint64_t>::const_iterator removedIter = params.removedImsis.begin(); removedIter != params.removedImsis.end(); ++removedIter)
+    {
+      NS_LOG_LOGIC("Imsi " << *removedIter << " removed");
+      cellSinrMap.erase(*removedIter);
+      std::map<uint64_t, CellSinrMap>::iterator cellsIter = m_imsiCellSinrMap.find(*removedIter);
+      if (cellsIter != m_imsiCellSinrMap.end())
+      {
+        cellsIter->second.erase(mmWaveCellId);
+        if (cellsIter->second.empty())
+        {
+          m_imsiCellSinrMap.erase(cellsIter);
+        }
+      }
+    }
   }
-  else  // add the entry
+  else
   {
-    m_cellSinrMap.insert(std::pair<uint16_t, ImsiSinrMap> (mmWaveCellId, params.ueImsiSinrMap));
-    m_numNewSinrReports++;
+    m_cellSinrMap[mmWaveCellId] = params.ueImsiSinrMap;
   }
+  m_numNewSinrReports++;
   // cycle on all the Imsi whose SINR is known in cell mmWaveCellId
   for(std::map<uint64_t, double>::iterator imsiIter = params.ueImsiSinrMap.begin(); imsiIter != params.ueImsiSinrMap.end(); ++imsiIter)
   {
@@ -3685,33 +3749,19 @@ LteEnbRrc::DoRecvUeSinrUpdate(EpcX2SapUser::UeImsiSinrParams params)
 
     NS_LOG_LOGIC("Imsi " << imsi << " sinr " << sinr);
 
-    if(m_imsiCellSinrMap.find(imsi) != m_imsiCellSinrMap.end())
-    {
-      if(m_imsiCellSinrMap[imsi].find(mmWaveCellId) != m_imsiCellSinrMap[imsi].end())
-      {
-        // update the SINR measure
-        m_imsiCellSinrMap[imsi].find(mmWaveCellId)->second = sinr;
-      }
-      else // new cell for this Imsi
-      {
-        // insert a new SINR measure
-        m_imsiCellSinrMap[imsi].insert(std::pair<uint16_t, double>(mmWaveCellId, sinr));
-      }
-    }
-    else // new imsi
-    {
-      CellSinrMap map;
-      map.insert(std::pair<uint16_t, double>(mmWaveCellId, sinr));
-      m_imsiCellSinrMap.insert(std::pair<uint64_t, CellSinrMap> (imsi, map));
-    }
+    // update the SINR measure, or insert it for a new imsi or a new cell for this imsi
+    m_imsiCellSinrMap[imsi][mmWaveCellId] = sinr;
   }
 
-  for(std::map<uint64_t, CellSinrMap>::iterator imsiIter = m_imsiCellSinrMap.begin(); imsiIter != m_imsiCellSinrMap.end(); ++imsiIter)
+  if (g_log.IsEnabled (ns3::LOG_LOGIC))
   {
-    NS_LOG_LOGIC("Imsi " << imsiIter->first);
-    for(CellSinrMap::iterator cellIter = imsiIter->second.begin(); cellIter != imsiIter->second.end(); ++cellIter)
+    for(std::map<uint64_t, CellSinrMap>::iterator imsiIter = m_imsiCellSinrMap.begin(); imsiIter != m_imsiCellSinrMap.end(); ++imsiIter)
     {
-      NS_LOG_LOGIC("mmWaveCell " << cellIter->first << " sinr " <<  cellIter->second);
+      NS_LOG_LOGIC("Imsi " << imsiIter->first);
+      for(CellSinrMap::iterator cellIter = imsiIter->second.begin(); cellIter != imsiIter->second.end(); ++cellIter)
+      {
+        NS_LOG_LOGIC("mmWaveCell " << cellIter->first << " sinr " <<  cellIter->second);
+      }
     }
   }
 
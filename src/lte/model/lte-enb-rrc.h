@@ -682,8 +682,7 @@ private:
    */
   EventId m_handoverLeavingTimeout;
 
-  std::vector < Ptr<Packet> > m_x2forwardingBuffer;
-  uint32_t m_x2forwardingBufferSize;
+  LteRlcSduQueue m_x2forwardingBuffer;
   uint32_t m_maxx2forwardingBufferSize;
 
   // this variable is set to true if on initial access, for mc devices, all the mmWave eNBs are in outage
@@ -1905,6 +1904,9 @@ private:
   // for MmWave eNBs
   std::map<uint8_t, ImsiSinrMap> m_ueImsiSinrMap; // this map contains the ueImsiSinrMap reports sent by the CCs
   bool m_reportAllUeMeas; // if true, the MmWave eNB reports to the coordinator all the received UE measures, i.e. one per CC
+  bool m_deltaSinrReports; // if true, the MmWave eNB reports to the coordinator only the SINR which changed by more than m_sinrReportHysteresis
+  double m_sinrReportHysteresis; // in dB
+  ImsiSinrMap m_lastReportedSinrDbMap; // last SINR reported to the coordinator for each UE, in dB
 
   // for LTE eNBs
   std::map<uint16_t, ImsiSinrMap> m_cellSinrMap;
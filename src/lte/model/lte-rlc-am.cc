@@ -49,7 +49,6 @@ LteRlcAm::LteRlcAm ()
   NS_LOG_FUNCTION (this);
 
   // Buffers
-  m_txonBufferSize = 0;
   m_retxSegBuffer.resize (1024);
   m_retxBuffer.resize (1024);
   m_retxBufferSize = 0;
@@ -111,14 +110,14 @@ LteRlcAm::LteRlcAm ()
 void
 LteRlcAm::BufferSizeTrace()
 {
-  NS_LOG_LOGIC("BufferSizeTrace " << Simulator::Now().GetSeconds() << " " << m_rnti << " " << m_lcid << " " << m_txonBufferSize);
+  NS_LOG_LOGIC("BufferSizeTrace " << Simulator::Now().GetSeconds() << " " << m_rnti << " " << m_lcid << " " << m_txonBuffer.GetNBytes ());
   // write to file
   /*if(!m_bufferSizeFile.is_open())
   {
     m_bufferSizeFile.open(GetBufferSizeFilename().c_str(), std::ofstream::app);
     NS_LOG_LOGIC("File opened");
   }
-  m_bufferSizeFile << Simulator::Now().GetSeconds() << " " << m_rnti << " " << (uint16_t) m_lcid << " " << m_txonBufferSize << std::endl;
+  m_bufferSizeFile << Simulator::Now().GetSeconds() << " " << m_rnti << " " << (uint16_t) m_lcid << " " << m_txonBuffer.GetNBytes () << std::endl;
   */
   m_traceBufferSizeEvent = Simulator::Schedule(MilliSeconds(10), &LteRlcAm::BufferSizeTrace, this);
 }
@@ -203,8 +202,7 @@ LteRlcAm::DoDispose ()
   m_statusProhibitTimer.Cancel ();
   m_rbsTimer.Cancel ();
 
-  m_txonBuffer.clear ();
-  m_txonBufferSize = 0;
+  m_txonBuffer.Clear ();
   m_txedBuffer.clear ();
   m_txedBufferSize = 0;
   m_retxBuffer.clear ();
@@ -243,7 +241,7 @@ LteRlcAm::DoTransmitPdcpPdu (Ptr<Packet> p)
 
   if(m_enableAqm == false)
   {
-    if (m_txonBufferSize + p->GetSize () <= m_maxTxBufferSize)
+    if (m_txonBuffer.GetNBytes () + p->GetSize () <= m_maxTxBufferSize)
     {
       /** Store arrival time */
       Time now = Simulator::Now ();
@@ -257,17 +255,16 @@ LteRlcAm::DoTransmitPdcpPdu (Ptr<Packet> p)
       p->AddPacketTag (tag);
 
       NS_LOG_INFO ("Txon Buffer: New packet added");
-      m_txonBuffer.push_back (p);
-      m_txonBufferSize += p->GetSize ();
-      NS_LOG_LOGIC ("NumOfBuffers = " << m_txonBuffer.size() );
-      NS_LOG_LOGIC ("txonBufferSize = " << m_txonBufferSize);
+      m_txonBuffer.PushBack (p);
+      NS_LOG_LOGIC ("NumOfBuffers = " << m_txonBuffer.GetNPackets () );
+      NS_LOG_LOGIC ("txonBufferSize = " << m_txonBuffer.GetNBytes ());
     }
     else
     {
       // Discard full RLC SDU
       NS_LOG_LOGIC ("TxBuffer is full. RLC SDU discarded");
       NS_LOG_LOGIC ("MaxTxBufferSize = " << m_maxTxBufferSize);
-      NS_LOG_LOGIC ("txonBufferSize    = " << m_txonBufferSize);
+      NS_LOG_LOGIC ("txonBufferSize    = " << m_txonBuffer.GetNBytes ());
       NS_LOG_LOGIC ("packet size     = " << p->GetSize ());
     }
   }
@@ -467,10 +464,10 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
                   // Calculate the Polling Bit (5.2.2.1)
                   rlcAmHeader.SetPollingBit (LteRlcAmHeader::STATUS_REPORT_NOT_REQUESTED);
 
-                  NS_LOG_LOGIC ("polling conditions: m_txonBuffer.empty=" << m_txonBuffer.empty ()
+                  NS_LOG_LOGIC ("polling conditions: m_txonBuffer.empty=" << m_txonBuffer.IsEmpty ()
                                 << " retxBufferSize="  << m_retxBufferSize
                                 << " packet->GetSize ()=" << packet->GetSize ());
-                  if (((m_txonBuffer.empty ()) && (m_txonQueue->GetNPackets ()==0) && (m_retxBufferSize == packet->GetSize () + rlcAmHeader.GetSerializedSize ()))
+                  if (((m_txonBuffer.IsEmpty ()) && (m_txonQueue->GetNPackets ()==0) && (m_retxBufferSize == packet->GetSize () + rlcAmHeader.GetSerializedSize ()))
                       || (m_vtS >= m_vtMs)
                       || m_pollRetransmitTimerJustExpired)
                     {
@@ -558,10 +555,10 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
                   // Calculate the Polling Bit (5.2.2.1)
                   firstSegHdr.SetPollingBit (LteRlcAmHeader::STATUS_REPORT_NOT_REQUESTED);
 
-                  NS_LOG_LOGIC ("polling conditions: m_txonBuffer.empty=" << m_txonBuffer.empty ()
+                  NS_LOG_LOGIC ("polling conditions: m_txonBuffer.empty=" << m_txonBuffer.IsEmpty ()
                                 << " retxBufferSize="  << m_retxBufferSize
                                 << " packet->GetSize ()=" << packet->GetSize ());
-                  if (((m_txonBuffer.empty ()) && (m_txonQueue->GetNPackets () == 0) && (m_retxBufferSize == packet->GetSize () + firstSegHdr.GetSerializedSize ()))
+                  if (((m_txonBuffer.IsEmpty ()) && (m_txonQueue->GetNPackets () == 0) && (m_retxBufferSize == packet->GetSize () + firstSegHdr.GetSerializedSize ()))
                       || (m_vtS >= m_vtMs)
                       || m_pollRetransmitTimerJustExpired)
                   {
@@ -673,7 +670,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
         }
       NS_ASSERT_MSG (found, "m_retxBufferSize > 0, but no PDU considered for retx found");
     }
-  else if ( m_txonBufferSize + m_txonQueue->GetNBytes() > 0 )
+  else if ( m_txonBuffer.GetNBytes () + m_txonQueue->GetNBytes() > 0 )
     {
       if (txOpParams.bytes < 7)
       {
@@ -728,26 +725,24 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
 
   // Remove the first packet from the transmission buffer.
   // If only a segment of the packet is taken, then the remaining is given back later
-  if ( m_txonBuffer.size () + m_txonQueue->GetNBytes() == 0 )
+  if ( m_txonBuffer.GetNPackets () + m_txonQueue->GetNBytes() == 0 )
     {
       NS_LOG_LOGIC ("No data pending");
       return;
     }
 
-  NS_LOG_LOGIC ("SDUs in TxonBuffer  = " << m_txonBuffer.size ());
-  NS_LOG_LOGIC ("First SDU buffer  = " << *(m_txonBuffer.begin()));
-  NS_LOG_LOGIC ("First SDU size    = " << (*(m_txonBuffer.begin()))->GetSize ());
+  NS_LOG_LOGIC ("SDUs in TxonBuffer  = " << m_txonBuffer.GetNPackets ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
 
-  if (m_txonBuffer.empty())
+  if (m_txonBuffer.IsEmpty ())
   {
-    Ptr<Packet> tempP = m_txonQueue->Dequeue()->GetPacket();
-    m_txonBuffer.push_back (tempP);
-    m_txonBufferSize += tempP->GetSize ();
+    m_txonBuffer.PushBack (m_txonQueue->Dequeue()->GetPacket());
   }
 
-  Ptr<Packet> firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
+  NS_LOG_LOGIC ("First SDU buffer  = " << m_txonBuffer.Front ());
+  NS_LOG_LOGIC ("First SDU size    = " << m_txonBuffer.Front ()->GetSize ());
+  Ptr<Packet> firstSegment = m_txonBuffer.Front ()->Copy ();
 
   // LL HO
   // tricky: store the incomplete Rlc SDU for forwarding to
@@ -757,12 +752,11 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   // store complete the last complete SDU of the txonBuffer.
   if (!is_fragmented){
     NS_LOG_DEBUG ("Last complete SDU in txonBuffer size = " << firstSegment->GetSize() << " SEQ = " << m_vtS );
-    entireSdu = (*(m_txonBuffer.begin ()))->Copy ();
+    entireSdu = m_txonBuffer.Front ()->Copy ();
   }
 
-  m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
-  NS_LOG_LOGIC ("txBufferSize      = " << m_txonBufferSize );
-  m_txonBuffer.erase (m_txonBuffer.begin ());
+  m_txonBuffer.PopFront ();
+  NS_LOG_LOGIC ("txBufferSize      = " << m_txonBuffer.GetNBytes () );
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -816,23 +810,12 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
               //LL HO Mark the first SDU is txonBuffer is fragmented. This maybe not needed.
               is_fragmented = 1;
 
-              // m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
-
-              if(m_txonBuffer.empty())
-              {
-                m_txonBuffer.push_back(firstSegment);
-              }
-              else
-              {
-                m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
-              }
-
-              m_txonBufferSize += (*(m_txonBuffer.begin()))->GetSize ();
+              m_txonBuffer.PushFront (firstSegment);
 
               NS_LOG_LOGIC ("    Txon buffer: Give back the remaining segment");
-              NS_LOG_LOGIC ("    Txon buffers = " << m_txonBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << (*(m_txonBuffer.begin()))->GetSize ());
-              NS_LOG_LOGIC ("    txonBufferSize = " << m_txonBufferSize );
+              NS_LOG_LOGIC ("    Txon buffers = " << m_txonBuffer.GetNPackets ());
+              NS_LOG_LOGIC ("    Front buffer size = " << m_txonBuffer.Front ()->GetSize ());
+              NS_LOG_LOGIC ("    txonBufferSize = " << m_txonBuffer.GetNBytes () );
             }
           else
             {
@@ -873,7 +856,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           // break;
         }
       else if ( (nextSegmentSize - firstSegment->GetSize () <= 2)
-        || (m_txonBuffer.size () + m_txonQueue->GetNPackets() == 0) )
+        || (m_txonBuffer.GetNPackets () + m_txonQueue->GetNPackets() == 0) )
         {
           NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txonBuffer.size == 0");
 
@@ -891,11 +874,11 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           nextSegmentSize -= dataFieldAddedSize;
           nextSegmentId++;
 
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.size ());
-          if (m_txonBuffer.size () + m_txonQueue->GetNPackets() > 0)
+          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.GetNPackets ());
+          if (!m_txonBuffer.IsEmpty ())
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txonBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txonBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.Front ());
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.Front ()->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
 
@@ -921,31 +904,29 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + dataFieldAddedSize;
           nextSegmentId++;
 
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.size ());
-          if (m_txonBuffer.size () + m_txonQueue->GetNPackets() > 0)
+          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.GetNPackets ());
+          if (!m_txonBuffer.IsEmpty ())
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txonBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txonBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.Front ());
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.Front ()->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
 
-          if(m_txonBuffer.empty())
+          if(m_txonBuffer.IsEmpty ())
           {
-            Ptr<Packet> tempP = m_txonQueue->Dequeue()->GetPacket();
-            m_txonBuffer.push_back (tempP);
-            m_txonBufferSize += tempP->GetSize ();
+            m_txonBuffer.PushBack (m_txonQueue->Dequeue()->GetPacket());
           }
 
-          firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
+          firstSegment = m_txonBuffer.Front ()->Copy ();
 
           // LL HO
           // New complete SDU is taken from txonBuffer so reset the
           // status is_fragmented.
           is_fragmented = 0;
-          m_txedRlcSduBuffer.push_back((*(m_txonBuffer.begin()))->Copy());
+          m_txedRlcSduBuffer.push_back(m_txonBuffer.Front ()->Copy());
           NS_LOG_DEBUG ("m_txedRlcSduBuffer.size() = " << m_txedRlcSduBuffer.size());
           if (m_txedRlcSduBuffer.size() > 1024){
             NS_LOG_DEBUG ("m_txedRlcSduBuffer.size() = " << m_txedRlcSduBuffer.size() << " clear and resize");
@@ -954,11 +935,10 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
             NS_LOG_DEBUG ("m_txedRlcSduBuffer.size() = " << m_txedRlcSduBuffer.size() << " after clear and resize");
           }
           // Store the last complete SDU before segmentation in txonBuffer.
-          entireSdu = (*(m_txonBuffer.begin ()))->Copy ();
+          entireSdu = m_txonBuffer.Front ()->Copy ();
 
-          m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
-          m_txonBuffer.erase (m_txonBuffer.begin ());
-          NS_LOG_LOGIC ("        txBufferSize = " << m_txonBufferSize );
+          m_txonBuffer.PopFront ();
+          NS_LOG_LOGIC ("        txBufferSize = " << m_txonBuffer.GetNBytes () );
         }
     }
 
@@ -1045,7 +1025,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   //      || m_pollRetransmitTimerJustExpired
   //    )
   if ( (m_pduWithoutPoll >= m_pollPdu) || (m_byteWithoutPoll >= m_pollByte) ||
-       ( (m_txonBuffer.empty ()) && (m_txonQueue->GetNPackets () == 0) && (m_retxBufferSize == 0) ) ||
+       ( (m_txonBuffer.IsEmpty ()) && (m_txonQueue->GetNPackets () == 0) && (m_retxBufferSize == 0) ) ||
        (m_vtS >= m_vtMs)
        || m_pollRetransmitTimerJustExpired
      )
@@ -1105,28 +1085,27 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   m_macSapProvider->TransmitPdu (params);
 }
 
-std::vector < Ptr<Packet> >
-LteRlcAm::GetTxBuffer()
+LteRlcSduQueue
+LteRlcAm::TakeTxBuffer ()
 {
-  std::vector < Ptr<Packet> > toBeReturned;
+  LteRlcSduQueue toBeReturned;
   if(!m_enableAqm)
   {
-    toBeReturned.insert(toBeReturned.begin(), m_txonBuffer.begin(), m_txonBuffer.end());
-    m_txonBuffer.clear();
-    m_txonBufferSize = 0;
+    // the SDUs are handed over without copying them
+    toBeReturned.Swap (m_txonBuffer);
   }
   else
   {
     while(m_txonQueue->GetNBytes() > 0)
     {
-      toBeReturned.push_back(m_txonQueue->Dequeue()->GetPacket());
+      toBeReturned.PushBack (m_txonQueue->Dequeue()->GetPacket());
     }
   }
   return toBeReturned;
 }
 uint32_t LteRlcAm::GetTxBufferSize()
 {
-  return m_txonBufferSize + m_txonQueue->GetNBytes();
+  return m_txonBuffer.GetNBytes () + m_txonQueue->GetNBytes();
 }
 
 std::vector < LteRlcAm::RetxPdu >
@@ -2679,7 +2658,7 @@ LteRlcAm::DoReportBufferStatus (void)
 
   Time now = Simulator::Now ();
 
-  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBufferSize);
+  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBuffer.GetNBytes ());
   NS_LOG_LOGIC ("retxBufferSize = " << m_retxBufferSize);
   NS_LOG_LOGIC ("txedBufferSize = " << m_txedBufferSize);
   NS_LOG_LOGIC ("VT(A) = " << m_vtA);
@@ -2687,10 +2666,10 @@ LteRlcAm::DoReportBufferStatus (void)
 
   // Transmission Queue HOL time
   Time txonQueueHolDelay (0);
-  if ( m_txonBufferSize > 0 )
+  if ( m_txonBuffer.GetNBytes () > 0 )
     {
       RlcTag txonQueueHolTimeTag;
-      m_txonBuffer.front ()->PeekPacketTag (txonQueueHolTimeTag);
+      m_txonBuffer.Front ()->PeekPacketTag (txonQueueHolTimeTag);
       txonQueueHolDelay = now - txonQueueHolTimeTag.GetSenderTimestamp ();
     }
 
@@ -2717,21 +2696,22 @@ LteRlcAm::DoReportBufferStatus (void)
   LteMacSapProvider::ReportBufferStatusParameters r;
   r.rnti = m_rnti;
   r.lcid = m_lcid;
-  r.txQueueSize = m_txonBufferSize + m_txonQueue->GetNBytes();
+  r.txQueueSize = m_txonBuffer.GetNBytes () + m_txonQueue->GetNBytes();
   r.txQueueHolDelay = txonQueueHolDelay.GetMilliSeconds ();
   r.retxQueueSize = m_retxBufferSize;// + m_txedBufferSize;
   r.retxQueueHolDelay = retxQueueHolDelay.GetMilliSeconds ();
 
   // from UM low lat TODO check
-  for (unsigned i = 0; i < m_txonBuffer.size(); i++)
+  unsigned i = 0;
+  for (LteRlcSduQueue::ConstIterator it = m_txonBuffer.Begin (); it != m_txonBuffer.End (); ++it, ++i)
   {
     if (i == 20)  // only include up to the first 20 packets
     {
       break;
     }
-    r.txPacketSizes.push_back (m_txonBuffer[i]->GetSize ());
+    r.txPacketSizes.push_back ((*it)->GetSize ());
     RlcTag holTimeTag;
-    m_txonBuffer[i]->PeekPacketTag (holTimeTag);
+    (*it)->PeekPacketTag (holTimeTag);
     Time holDelay = Simulator::Now () - holTimeTag.GetSenderTimestamp ();
     r.txPacketDelays.push_back (holDelay.GetMicroSeconds ());
   }
@@ -2814,7 +2794,7 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
   NS_LOG_FUNCTION (this);
   NS_LOG_LOGIC ("PollRetransmit Timer has expired");
 
-  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBufferSize);
+  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBuffer.GetNBytes ());
   NS_LOG_LOGIC ("retxBufferSize = " << m_retxBufferSize);
   NS_LOG_LOGIC ("txedBufferSize = " << m_txedBufferSize);
   NS_LOG_LOGIC ("statusPduRequested = " << m_statusPduRequested);
@@ -2825,7 +2805,7 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
   // note the difference between Rel 8 and Rel 11 specs; we follow Rel 11 here
   NS_ASSERT (m_vtS <= m_vtMs);
   //if ((m_txonBufferSize == 0 && m_retxBufferSize == 0)
-  if ((m_txonBufferSize + m_txonQueue->GetNBytes() == 0 && m_retxBufferSize == 0)
+  if ((m_txonBuffer.GetNBytes () + m_txonQueue->GetNBytes() == 0 && m_retxBufferSize == 0)
       || (m_vtS == m_vtMs))
     {
       NS_LOG_INFO ("txonBuffer and retxBuffer empty. Move PDUs up to = " << m_vtS.GetValue () - 1 << " to retxBuffer");
@@ -2904,7 +2884,7 @@ LteRlcAm::ExpireRbsTimer (void)
 {
   NS_LOG_LOGIC ("RBS Timer expires");
 
-  if (m_txonBufferSize + m_txonQueue->GetNBytes() + m_txedBufferSize + m_retxBufferSize > 0)
+  if (m_txonBuffer.GetNBytes () + m_txonQueue->GetNBytes() + m_txedBufferSize + m_retxBufferSize > 0)
     {
       DoReportBufferStatus ();
       m_rbsTimer = Simulator::Schedule (m_rbsTimerValue, &LteRlcAm::ExpireRbsTimer, this);
@@ -32,6 +32,7 @@
 #include <ns3/lte-rlc.h>
 #include <ns3/epc-x2-sap.h>
 #include <ns3/lte-pdcp-header.h>
+#include <ns3/lte-rlc-sdu-queue.h>
 
 #include <vector>
 #include <map>
@@ -75,7 +76,7 @@ public:
   virtual void DoSendMcPdcpSdu(EpcX2Sap::UeDataParams params);
 
   // LL HO
-  std::vector < Ptr<Packet> > GetTxBuffer();
+  virtual LteRlcSduQueue TakeTxBuffer ();
   uint32_t GetTxBufferSize();
 
   std::vector < RetxPdu > GetTxedBuffer();
@@ -92,7 +93,7 @@ public:
   ///< and put the Rlc SDUs into m_transmittingRlcSdus.
   void  RlcPdusToRlcSdus (std::vector < RetxPdu >  Pdus);
 
-  std::vector < Ptr<Packet> > GetTxedRlcSduBuffer (){
+  const std::vector < Ptr<Packet> >& GetTxedRlcSduBuffer (){
     return m_txedRlcSduBuffer;
   }
 
@@ -176,7 +177,7 @@ private:
   void BufferSizeTrace();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
+    LteRlcSduQueue m_txonBuffer; ///< Transmission buffer, which also tracks its size in bytes
 
     struct RetxSegPdu
     {
@@ -205,7 +206,6 @@ private:
   uint32_t m_transmittingRlcSduBufferSize;
   std::map <uint32_t, Ptr <Packet> > m_transmittingRlcSduBuffer;
 
-    uint32_t m_txonBufferSize;  ///< transmit on buffer size
     uint32_t m_retxBufferSize;  ///< transmit on buffer size
     uint32_t m_txedBufferSize;  ///< transmit ed buffer size
 
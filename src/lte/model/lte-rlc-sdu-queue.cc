@@ -0,0 +1,128 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/lte-rlc-sdu-queue.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+LteRlcSduQueue::LteRlcSduQueue ()
+  : m_nBytes (0)
+{
+}
+
+void
+LteRlcSduQueue::PushBack (Ptr<Packet> p)
+{
+  m_sdus.push_back (p);
+  m_nBytes += p->GetSize ();
+}
+
+void
+LteRlcSduQueue::PushFront (Ptr<Packet> p)
+{
+  m_sdus.push_front (p);
+  m_nBytes += p->GetSize ();
+}
+
+Ptr<Packet>
+LteRlcSduQueue::PopFront (void)
+{
+  NS_ASSERT_MSG (!m_sdus.empty (), "The RLC SDU queue is empty");
+  Ptr<Packet> p = m_sdus.front ();
+  m_sdus.pop_front ();
+  m_nBytes -= p->GetSize ();
+  return p;
+}
+
+Ptr<Packet>
+LteRlcSduQueue::Front (void) const
+{
+  NS_ASSERT_MSG (!m_sdus.empty (), "The RLC SDU queue is empty");
+  return m_sdus.front ();
+}
+
+Ptr<Packet>
+LteRlcSduQueue::Get (uint32_t i) const
+{
+  NS_ASSERT (i < m_sdus.size ());
+  return m_sdus[i];
+}
+
+bool
+LteRlcSduQueue::IsEmpty (void) const
+{
+  return m_sdus.empty ();
+}
+
+uint32_t
+LteRlcSduQueue::GetNPackets (void) const
+{
+  return m_sdus.size ();
+}
+
+uint32_t
+LteRlcSduQueue::GetNBytes (void) const
+{
+  return m_nBytes;
+}
+
+void
+LteRlcSduQueue::Clear (void)
+{
+  m_sdus.clear ();
+  m_nBytes = 0;
+}
+
+void
+LteRlcSduQueue::Swap (LteRlcSduQueue &other)
+{
+  m_sdus.swap (other.m_sdus);
+  std::swap (m_nBytes, other.m_nBytes);
+}
+
+void
+LteRlcSduQueue::Append (LteRlcSduQueue &other)
+{
+  if (m_sdus.empty ())
+    {
+      Swap (other);
+      return;
+    }
+  m_sdus.insert (m_sdus.end (), other.m_sdus.begin (), other.m_sdus.end ());
+  m_nBytes += other.m_nBytes;
+  other.Clear ();
+}
+
+LteRlcSduQueue::ConstIterator
+LteRlcSduQueue::Begin (void) const
+{
+  return m_sdus.begin ();
+}
+
+LteRlcSduQueue::ConstIterator
+LteRlcSduQueue::End (void) const
+{
+  return m_sdus.end ();
+}
+
+std::vector<Ptr<Packet> >
+LteRlcSduQueue::ToVector (void) const
+{
+  return std::vector<Ptr<Packet> > (m_sdus.begin (), m_sdus.end ());
+}
+
+} // namespace ns3
@@ -47,7 +47,6 @@ uint32_t LteRlcUmLowLat::m_numArrivalsToAvg = 20;
 
 LteRlcUmLowLat::LteRlcUmLowLat ()
   : m_maxTxBufferSize (10 * 1024),
-    m_txBufferSize (0),
     m_sequenceNumber (0),
     m_vrUr (0),
     m_vrUx (0),
@@ -124,7 +123,7 @@ LteRlcUmLowLat::DoTransmitPdcpPdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
 
-  if (m_txBufferSize + p->GetSize () <= m_maxTxBufferSize)
+  if (m_txBuffer.GetNBytes () + p->GetSize () <= m_maxTxBufferSize)
     {
       /** Store arrival time */
       RlcTag timeTag (Simulator::Now ());
@@ -137,10 +136,9 @@ LteRlcUmLowLat::DoTransmitPdcpPdu (Ptr<Packet> p)
       p->AddPacketTag (tag);
 
       NS_LOG_LOGIC ("Tx Buffer: New packet added");
-      m_txBuffer.push_back (p);
-      m_txBufferSize += p->GetSize ();
-      NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.size() );
-      NS_LOG_LOGIC ("txBufferSize = " << m_txBufferSize);
+      m_txBuffer.PushBack (p);
+      NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.GetNPackets () );
+      NS_LOG_LOGIC ("txBufferSize = " << m_txBuffer.GetNBytes ());
 
       if (m_recentArrivalTimes.size () == m_numArrivalsToAvg)
       {
@@ -160,7 +158,7 @@ LteRlcUmLowLat::DoTransmitPdcpPdu (Ptr<Packet> p)
       // Discard full RLC SDU
       NS_LOG_LOGIC ("TxBuffer is full. RLC SDU discarded");
       NS_LOG_LOGIC ("MaxTxBufferSize = " << m_maxTxBufferSize);
-      NS_LOG_LOGIC ("txBufferSize    = " << m_txBufferSize);
+      NS_LOG_LOGIC ("txBufferSize    = " << m_txBuffer.GetNBytes ());
       NS_LOG_LOGIC ("packet size     = " << p->GetSize ());
     }
 
@@ -194,9 +192,9 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
       return;
     }
 
-  if (txOpParams.bytes > m_txBufferSize)
+  if (txOpParams.bytes > m_txBuffer.GetNBytes ())
    {
-     NS_LOG_DEBUG("LteRlcUmLowLat rnti " << m_rnti << " lcid " << m_lcid << " allocated " << txOpParams.bytes << " bufsize " << m_txBufferSize);
+     NS_LOG_DEBUG("LteRlcUmLowLat rnti " << m_rnti << " lcid " << m_lcid << " allocated " << txOpParams.bytes << " bufsize " << m_txBuffer.GetNBytes ());
    }
 
   Ptr<Packet> packet = Create<Packet> ();
@@ -211,21 +209,19 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
 
   // Remove the first packet from the transmission buffer.
   // If only a segment of the packet is taken, then the remaining is given back later
-  if ( m_txBuffer.size () == 0 )
+  if ( m_txBuffer.IsEmpty () )
     {
       NS_LOG_LOGIC ("No data pending");
       return;
     }
 
-  NS_LOG_LOGIC ("SDUs in TxBuffer  = " << m_txBuffer.size ());
-  NS_LOG_LOGIC ("First SDU buffer  = " << *(m_txBuffer.begin()));
-  NS_LOG_LOGIC ("First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
+  NS_LOG_LOGIC ("SDUs in TxBuffer  = " << m_txBuffer.GetNPackets ());
+  NS_LOG_LOGIC ("First SDU buffer  = " << m_txBuffer.Front ());
+  NS_LOG_LOGIC ("First SDU size    = " << m_txBuffer.Front ()->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Ptr<Packet> firstSegment = (*(m_txBuffer.begin ()))->Copy ();
-  m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
-  NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
-  m_txBuffer.erase (m_txBuffer.begin ());
+  Ptr<Packet> firstSegment = m_txBuffer.PopFront ()->Copy ();
+  NS_LOG_LOGIC ("txBufferSize      = " << m_txBuffer.GetNBytes () );
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -273,13 +269,12 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
             {
               firstSegment->AddPacketTag (oldTag);
 
-              m_txBuffer.insert (m_txBuffer.begin (), firstSegment);
-              m_txBufferSize += (*(m_txBuffer.begin()))->GetSize ();
+              m_txBuffer.PushFront (firstSegment);
 
               NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
-              NS_LOG_LOGIC ("    TX buffers = " << m_txBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << (*(m_txBuffer.begin()))->GetSize ());
-              NS_LOG_LOGIC ("    txBufferSize = " << m_txBufferSize );
+              NS_LOG_LOGIC ("    TX buffers = " << m_txBuffer.GetNPackets ());
+              NS_LOG_LOGIC ("    Front buffer size = " << m_txBuffer.Front ()->GetSize ());
+              NS_LOG_LOGIC ("    txBufferSize = " << m_txBuffer.GetNBytes () );
             }
           else
             {
@@ -319,7 +314,7 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
           // (NO more segments) → exit
           // break;
         }
-      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txBuffer.size () == 0) )
+      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txBuffer.IsEmpty ()) )
         {
           NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txBuffer.size == 0");
           // Add txBuffer.FirstBuffer to DataField
@@ -336,11 +331,11 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
           nextSegmentSize -= dataFieldAddedSize;
           nextSegmentId++;
 
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
-          if (m_txBuffer.size () > 0)
+          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.GetNPackets ());
+          if (!m_txBuffer.IsEmpty ())
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.Front ());
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.Front ()->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
 
@@ -366,20 +361,18 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
           nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + dataFieldAddedSize;
           nextSegmentId++;
 
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
-          if (m_txBuffer.size () > 0)
+          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.GetNPackets ());
+          if (!m_txBuffer.IsEmpty ())
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.Front ());
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.Front ()->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = (*(m_txBuffer.begin ()))->Copy ();
-          m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
-          m_txBuffer.erase (m_txBuffer.begin ());
-          NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
+          firstSegment = m_txBuffer.PopFront ()->Copy ();
+          NS_LOG_LOGIC ("        txBufferSize = " << m_txBuffer.GetNBytes () );
         }
 
     }
@@ -450,7 +443,7 @@ LteRlcUmLowLat::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters tx
 
   m_macSapProvider->TransmitPdu (params);
 
-  if (! m_txBuffer.empty ())
+  if (! m_txBuffer.IsEmpty ())
     {
       m_rbsTimer.Cancel ();
       m_rbsTimer = Simulator::Schedule (m_rbsTimerValue, &LteRlcUmLowLat::ExpireRbsTimer, this);
@@ -469,12 +462,20 @@ LteRlcUmLowLat::DoNotifyHarqDeliveryFailure ()
   NS_LOG_FUNCTION (this);
 }
 
-std::vector < Ptr<Packet> >
+const LteRlcSduQueue&
 LteRlcUmLowLat::GetTxBuffer()
 {
   return m_txBuffer;
 }
 
+LteRlcSduQueue
+LteRlcUmLowLat::TakeTxBuffer ()
+{
+  LteRlcSduQueue sdus;
+  sdus.Swap (m_txBuffer);
+  return sdus;
+}
+
 void
 LteRlcUmLowLat::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
 {
@@ -1193,13 +1194,13 @@ LteRlcUmLowLat::DoReportBufferStatus (void)
     Time holDelay (0);
     uint32_t queueSize = 0;
 
-    if (! m_txBuffer.empty ())
+    if (! m_txBuffer.IsEmpty ())
       {
         RlcTag holTimeTag;
-        m_txBuffer.front ()->PeekPacketTag (holTimeTag);
+        m_txBuffer.Front ()->PeekPacketTag (holTimeTag);
         holDelay = Simulator::Now () - holTimeTag.GetSenderTimestamp ();
 
-        queueSize = m_txBufferSize + 2 * m_txBuffer.size (); // Data in tx queue + estimated headers size
+        queueSize = m_txBuffer.GetNBytes () + 2 * m_txBuffer.GetNPackets (); // Data in tx queue + estimated headers size
       }
 
     LteMacSapProvider::ReportBufferStatusParameters r;
@@ -1211,15 +1212,16 @@ LteRlcUmLowLat::DoReportBufferStatus (void)
     r.retxQueueHolDelay = 0;
     r.statusPduSize = 0;
 
-    for (unsigned i = 0; i < m_txBuffer.size(); i++)
+    unsigned i = 0;
+    for (LteRlcSduQueue::ConstIterator it = m_txBuffer.Begin (); it != m_txBuffer.End (); ++it, ++i)
     {
       if (i == 20)  // only include up to the first 20 packets
       {
         break;
       }
-      r.txPacketSizes.push_back (m_txBuffer[i]->GetSize ());
+      r.txPacketSizes.push_back ((*it)->GetSize ());
       RlcTag holTimeTag;
-      m_txBuffer[i]->PeekPacketTag (holTimeTag);
+      (*it)->PeekPacketTag (holTimeTag);
       holDelay = Simulator::Now () - holTimeTag.GetSenderTimestamp ();
       r.txPacketDelays.push_back (holDelay.GetMicroSeconds ());
     }
@@ -1276,7 +1278,7 @@ LteRlcUmLowLat::ExpireRbsTimer (void)
 {
   NS_LOG_LOGIC ("RBS Timer expires");
 
-  if (! m_txBuffer.empty ())
+  if (! m_txBuffer.IsEmpty ())
     {
       DoReportBufferStatus ();
       m_rbsTimer = Simulator::Schedule (MilliSeconds (10), &LteRlcUmLowLat::ExpireRbsTimer, this);
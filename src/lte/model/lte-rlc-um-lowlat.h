@@ -31,6 +31,7 @@
 #include "ns3/lte-rlc-sequence-number.h"
 #include "ns3/lte-rlc.h"
 #include <ns3/epc-x2-sap.h>
+#include <ns3/lte-rlc-sdu-queue.h>
 
 #include <ns3/event-id.h>
 #include <map>
@@ -66,10 +67,11 @@ public:
   virtual void DoNotifyHarqDeliveryFailure ();
   virtual void DoReceivePdu (LteMacSapUser::ReceivePduParameters params);
 
-  std::vector < Ptr<Packet> > GetTxBuffer();
+  const LteRlcSduQueue& GetTxBuffer();
+  virtual LteRlcSduQueue TakeTxBuffer ();
   uint32_t GetTxBufferSize()
   {
-    return m_txBufferSize;
+    return m_txBuffer.GetNBytes ();
   }
 
 private:
@@ -88,8 +90,7 @@ private:
 
 private:
   uint32_t m_maxTxBufferSize;
-  uint32_t m_txBufferSize;
-  std::vector < Ptr<Packet> > m_txBuffer;       // Transmission buffer
+  LteRlcSduQueue m_txBuffer;                    // Transmission buffer
   std::map <uint16_t, Ptr<Packet> > m_rxBuffer; // Reception buffer
   std::vector < Ptr<Packet> > m_reasBuffer;     // Reassembling buffer
 
@@ -441,6 +441,19 @@ LteRlcUm::GetTxBuffer()
   return m_txBuffer;
 }
 
+LteRlcSduQueue
+LteRlcUm::TakeTxBuffer ()
+{
+  LteRlcSduQueue sdus;
+  for (std::vector < Ptr<Packet> >::iterator it = m_txBuffer.begin (); it != m_txBuffer.end (); ++it)
+    {
+      sdus.PushBack (*it);
+    }
+  m_txBuffer.clear ();
+  m_txBufferSize = 0;
+  return sdus;
+}
+
 void
 LteRlcUm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
 {
@@ -73,6 +73,7 @@ public:
   virtual void DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams);
 
   std::vector < Ptr<Packet> > GetTxBuffer();
+  virtual LteRlcSduQueue TakeTxBuffer ();
   uint32_t GetTxBufferSize()
   {
     return m_txBufferSize;
@@ -188,6 +188,13 @@ LteRlc::GetLteMacSapUser ()
   return m_macSapUser;
 }
 
+LteRlcSduQueue
+LteRlc::TakeTxBuffer ()
+{
+  NS_LOG_FUNCTION (this);
+  return LteRlcSduQueue ();
+}
+
 void
 LteRlc::DoNotifyHarqDeliveryFailure (uint8_t harqId)
 {
@@ -37,6 +37,7 @@
 
 #include "ns3/lte-rlc-sap.h"
 #include "ns3/lte-mac-sap.h"
+#include "ns3/lte-rlc-sdu-queue.h"
 
 namespace ns3 {
 
@@ -146,6 +147,15 @@ public:
    */
   LteMacSapUser* GetLteMacSapUser ();
 
+  /**
+   * Moves the SDUs waiting for transmission out of the RLC entity, e.g., to
+   * forward them to another cell during a handover. The SDUs are not copied,
+   * and the transmission buffer of the entity is left empty.
+   *
+   * \return the SDUs, from the head of the transmission buffer
+   */
+  virtual LteRlcSduQueue TakeTxBuffer ();
+
 
   /**
    * TracedCallback signature for NotifyTxOpportunity events.
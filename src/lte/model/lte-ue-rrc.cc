@@ -1629,12 +1629,10 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
   // RlcBuffers forwarding only for RlcAm bearers.
   if (0 != rlc->GetObject<LteRlcAm> ())
   {
-    //Copy lte-rlc-am.m_txOnBuffer to X2 forwarding buffer.
+    //Move lte-rlc-am.m_txOnBuffer to the forwarding buffer.
     Ptr<LteRlcAm> rlcAm = rlc->GetObject<LteRlcAm>();
-    uint32_t txonBufferSize = rlcAm->GetTxBufferSize();
-    std::vector < Ptr<Packet> > txonBuffer = rlcAm->GetTxBuffer();
-    //m_rlcBufferToBeForwardedSize =  drbIt->second->m_rlc->GetObject<LteRlcAm>()->GetTxBufferSize();
-    //m_rlcBufferToBeForwarded = drbIt->second->m_rlc->GetObject<LteRlcAm>()->GetTxBuffer();
+    LteRlcSduQueue txonBuffer = rlcAm->TakeTxBuffer();
+    uint32_t txonBufferSize = txonBuffer.GetNBytes();
     uint32_t txedBufferSize = rlcAm->GetTxedBufferSize();
     std::vector < LteRlcAm::RetxPdu > txedBuffer = rlcAm->GetTxedBuffer();
     uint32_t retxBufferSize = rlcAm->GetRetxBufferSize();
@@ -1665,7 +1663,7 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
     //{
       LtePdcpHeader pdcpHeader;
       uint32_t pos = 0;
-      for (std::vector< Ptr<Packet> >::iterator it = txonBuffer.begin(); it != txonBuffer.end(); ++it)
+      for (LteRlcSduQueue::ConstIterator it = txonBuffer.Begin(); it != txonBuffer.End(); ++it)
       {
         pos++;
         if((*it)->GetSize() > 3)
@@ -1692,7 +1690,7 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
           if (it->second != 0)
           {
             NS_LOG_DEBUG ( this << " add to forwarding buffer SEQ = " << it->first << " Ptr<Packet> = " << it->second );
-            m_rlcBufferToBeForwarded.push_back(it->second);
+            m_rlcBufferToBeForwarded.PushBack(it->second);
           }
         }
         NS_LOG_DEBUG(this << "UE RRC:  ADDING TXONBUFFER OF RLC AM " << m_rnti << " Size = " << txonBufferSize) ;
@@ -1703,17 +1701,17 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
           segmentedRlcsdu->PeekHeader(pdcpHeader);
           NS_LOG_DEBUG(this << "UE RRC: SegmentedRlcSdu = " << segmentedRlcsdu->GetSize() << " SEQ = " << pdcpHeader.GetSequenceNumber());
           //insert the complete version of the fragmented SDU to the front of txonBuffer.
-          txonBuffer.insert(txonBuffer.begin(),segmentedRlcsdu);
+          txonBuffer.PushFront(segmentedRlcsdu);
         }
-        m_rlcBufferToBeForwarded.insert(m_rlcBufferToBeForwarded.end(), txonBuffer.begin(), txonBuffer.end());
-        m_rlcBufferToBeForwardedSize += rlcAm->GetTransmittingRlcSduBufferSize() + txonBufferSize;
+        m_rlcBufferToBeForwarded.Append(txonBuffer);
 
         //Get the rlcAm
-        std::vector < Ptr <Packet> > rlcAmTxedSduBuffer = rlcAm->GetTxedRlcSduBuffer();
+        const std::vector < Ptr <Packet> > &rlcAmTxedSduBuffer = rlcAm->GetTxedRlcSduBuffer();
         LtePdcpHeader pdcpHeader_1;
-        m_rlcBufferToBeForwarded.at(0)->PeekHeader(pdcpHeader_1);
-        uint16_t i = 0;
-        for (std::vector< Ptr<Packet> >::iterator it = rlcAmTxedSduBuffer.begin(); it != rlcAmTxedSduBuffer.end(); ++it)
+        m_rlcBufferToBeForwarded.Front()->PeekHeader(pdcpHeader_1);
+        //the previous SDUs are added at the head of the forwarding buffer, in order
+        LteRlcSduQueue previousSdus;
+        for (std::vector< Ptr<Packet> >::const_iterator it = rlcAmTxedSduBuffer.begin(); it != rlcAmTxedSduBuffer.end(); ++it)
         {
           if ((*it) != NULL)
           {
@@ -1724,18 +1722,18 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
             if (pdcpHeader.GetSequenceNumber() >= (pdcpHeader_1.GetSequenceNumber() - 2) && pdcpHeader.GetSequenceNumber() <= (pdcpHeader_1.GetSequenceNumber()) )
             {
               NS_LOG_DEBUG("UE RRC: Added previous SDU to forwarding buffer SEQ = " << pdcpHeader.GetSequenceNumber() << " Size = " << (*it)->GetSize());
-              m_rlcBufferToBeForwarded.insert(m_rlcBufferToBeForwarded.begin()+i, (*it)->Copy());
-              ++i;
+              previousSdus.PushBack((*it)->Copy());
             }
           }
         }
+        previousSdus.Append(m_rlcBufferToBeForwarded);
+        m_rlcBufferToBeForwarded.Swap(previousSdus);
 
       }
       else
-      { //TransmittingBuffer is empty. Only copy TxonBuffer.
+      { //TransmittingBuffer is empty. Only move TxonBuffer.
         NS_LOG_DEBUG(this << " UE RRC: ADDING TXONBUFFER OF RLC AM " << m_rnti << " Size = " << txonBufferSize) ;
-        m_rlcBufferToBeForwarded = txonBuffer;
-        m_rlcBufferToBeForwardedSize += txonBufferSize;
+        m_rlcBufferToBeForwarded.Append(txonBuffer);
       }
     //}
   }
@@ -1743,30 +1741,22 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
   //However, as the LTE-UMTS book, PDCP txbuffer should be forwarded for seamless
   //HO. Enable this code for txbuffer forwarding in seamless HO (which is believe to
   //be correct).
-  else if (0 != rlc->GetObject<LteRlcUm> ())
+  else if (0 != rlc->GetObject<LteRlcUm> () || 0 != rlc->GetObject<LteRlcUmLowLat> ())
   {
-    //Copy lte-rlc-um.m_txOnBuffer to X2 forwarding buffer.
-    NS_LOG_DEBUG(this << " UE RRC: Copying txonBuffer from RLC UM " << m_rnti);
-    m_rlcBufferToBeForwarded = rlc->GetObject<LteRlcUm>()->GetTxBuffer();
-    m_rlcBufferToBeForwardedSize =  rlc->GetObject<LteRlcUm>()->GetTxBufferSize();
-  }
-  else if (0 != rlc->GetObject<LteRlcUmLowLat> ())
-  {
-    //Copy lte-rlc-um-low-lat.m_txOnBuffer to X2 forwarding buffer.
-    NS_LOG_DEBUG(this << " UE RRC: Copying txonBuffer from RLC UM " << m_rnti);
-    m_rlcBufferToBeForwarded = rlc->GetObject<LteRlcUmLowLat>()->GetTxBuffer();
-    m_rlcBufferToBeForwardedSize =  rlc->GetObject<LteRlcUmLowLat>()->GetTxBufferSize();
+    //Move the RLC UM transmission buffer to the forwarding buffer.
+    NS_LOG_DEBUG(this << " UE RRC: Moving txonBuffer from RLC UM " << m_rnti);
+    LteRlcSduQueue txBuffer = rlc->TakeTxBuffer();
+    m_rlcBufferToBeForwarded.Append(txBuffer);
   }
   //LteRlcAm m_txBuffer stores PDCP "PDU".
-  NS_LOG_DEBUG(this << " UE RRC: m_x2forw buffer size = " << m_rlcBufferToBeForwardedSize);
+  NS_LOG_DEBUG(this << " UE RRC: m_x2forw buffer size = " << m_rlcBufferToBeForwarded.GetNBytes());
     //Forwarding the packet inside m_rlcBufferToBeForwarded to target eNB.
 
-  while (!m_rlcBufferToBeForwarded.empty())
+  while (!m_rlcBufferToBeForwarded.IsEmpty())
   {
     NS_LOG_DEBUG(this << " UE RRC: Forwarding m_rlcBufferToBeForwarded to target eNB, lcid = " << lcid );
     //Remove tags to get PDCP SDU from PDCP PDU.
-    //Ptr<Packet> rlcSdu =  (*(m_rlcBufferToBeForwarded.begin()))->Copy();
-    Ptr<Packet> rlcSdu =  m_rlcBufferToBeForwarded.at(0);
+    Ptr<Packet> rlcSdu = m_rlcBufferToBeForwarded.PopFront();
     //Tags to be removed from rlcSdu (from outer to inner)
     //LteRlcSduStatusTag rlcSduStatusTag;
     //RlcTag  rlcTag; //rlc layer timestamp
@@ -1811,9 +1801,7 @@ LteUeRrc::CopyRlcBuffers(Ptr<LteRlc> rlc, Ptr<LtePdcp> pdcp, uint16_t lcid)
     {
       NS_LOG_UNCOND("UE RRC: Too small, not forwarded");
     }
-    m_rlcBufferToBeForwardedSize -= (*(m_rlcBufferToBeForwarded.begin()))->GetSize();
-    m_rlcBufferToBeForwarded.erase (m_rlcBufferToBeForwarded.begin());
-    NS_LOG_LOGIC(this << " UE RRC: After forwarding: buffer size = " << m_rlcBufferToBeForwardedSize );
+    NS_LOG_LOGIC(this << " UE RRC: After forwarding: buffer size = " << m_rlcBufferToBeForwarded.GetNBytes() );
   }
 }
 
@@ -1253,8 +1253,7 @@ private:
   bool m_ncRaStarted;
 
   // lossless HO
-  std::vector < Ptr<Packet> > m_rlcBufferToBeForwarded;
-  uint32_t m_rlcBufferToBeForwardedSize;
+  LteRlcSduQueue m_rlcBufferToBeForwarded;
 
 public:
   /**
@@ -30,6 +30,7 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/tcp-l4-protocol.h"
+#include "ns3/random-variable-stream.h"
 
 #include "ns3/epc-tft-classifier.h"
 
@@ -212,6 +213,131 @@ EpcTftClassifierTestCase::DoRun (void)
 
 
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that compares the classification of random UDP flows
+ * with the evaluation of the TFTs with EpcTft::Matches. Each packet is
+ * classified twice, so that the second classification uses the flow cache,
+ * and the flows are classified again after a TFT is deleted.
+ */
+class EpcTftClassifierRandomFlowsTestCase : public TestCase
+{
+public:
+  EpcTftClassifierRandomFlowsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Classify the flows and compare the result with EpcTft::Matches
+   * \param c the EPC TFT classifier
+   * \param tfts the TFTs of the classifier
+   */
+  void CheckFlows (EpcTftClassifier &c, const std::map<uint32_t, Ptr<EpcTft> > &tfts);
+
+  Ptr<UniformRandomVariable> m_rand; ///< random variable for the flows
+};
+
+EpcTftClassifierRandomFlowsTestCase::EpcTftClassifierRandomFlowsTestCase ()
+  : TestCase ("Classification of random flows against EpcTft::Matches")
+{
+}
+
+void
+EpcTftClassifierRandomFlowsTestCase::CheckFlows (EpcTftClassifier &c, const std::map<uint32_t, Ptr<EpcTft> > &tfts)
+{
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      EpcTft::Direction d = (m_rand->GetInteger (0, 1) == 0) ? EpcTft::UPLINK : EpcTft::DOWNLINK;
+      Ipv4Address source (m_rand->GetInteger (0x0a000000, 0x0a0000ff));
+      Ipv4Address destination (m_rand->GetInteger (0x07000000, 0x070000ff));
+      uint16_t sourcePort = m_rand->GetInteger (1000, 1100);
+      uint16_t destinationPort = m_rand->GetInteger (1000, 1100);
+      uint8_t tos = m_rand->GetInteger (0, 3) << 2;
+
+      uint32_t expected = 0;
+      for (std::map<uint32_t, Ptr<EpcTft> >::const_reverse_iterator it = tfts.rbegin (); it != tfts.rend (); ++it)
+        {
+          bool matches = (d == EpcTft::UPLINK)
+            ? it->second->Matches (d, destination, source, destinationPort, sourcePort, tos)
+            : it->second->Matches (d, source, destination, sourcePort, destinationPort, tos);
+          if (matches)
+            {
+              expected = it->first;
+              break;
+            }
+        }
+
+      Ptr<Packet> p = Create<Packet> (100);
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (sourcePort);
+      udpHeader.SetDestinationPort (destinationPort);
+      p->AddHeader (udpHeader);
+      Ipv4Header ipHeader;
+      ipHeader.SetSource (source);
+      ipHeader.SetDestination (destination);
+      ipHeader.SetTos (tos);
+      ipHeader.SetPayloadSize (p->GetSize ());
+      ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+      p->AddHeader (ipHeader);
+
+      for (uint32_t j = 0; j < 2; j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (c.Classify (p, d, Ipv4L3Protocol::PROT_NUMBER), expected,
+                                 "bad classification of " << source << ":" << sourcePort << " -> "
+                                 << destination << ":" << destinationPort << " tos " << (uint16_t) tos);
+        }
+    }
+}
+
+void
+EpcTftClassifierRandomFlowsTestCase::DoRun (void)
+{
+  m_rand = CreateObject<UniformRandomVariable> ();
+  m_rand->SetStream (1);
+
+  std::map<uint32_t, Ptr<EpcTft> > tfts;
+  tfts[1] = EpcTft::Default ();
+  for (uint32_t id = 2; id <= 8; id++)
+    {
+      tfts[id] = Create<EpcTft> ();
+      for (uint32_t i = 0; i < 4; i++)
+        {
+          EpcTft::PacketFilter pf;
+          pf.direction = static_cast<EpcTft::Direction> (m_rand->GetInteger (1, 3));
+          pf.remoteAddress = Ipv4Address (m_rand->GetInteger (0x07000000, 0x070000ff));
+          pf.remoteMask = Ipv4Mask (0xffffffff << m_rand->GetInteger (4, 8));
+          pf.localAddress = Ipv4Address (m_rand->GetInteger (0x0a000000, 0x0a0000ff));
+          pf.localMask = Ipv4Mask (0xffffffff << m_rand->GetInteger (5, 8));
+          pf.remotePortStart = m_rand->GetInteger (1000, 1100);
+          pf.remotePortEnd = pf.remotePortStart + m_rand->GetInteger (0, 50);
+          pf.localPortStart = m_rand->GetInteger (1000, 1050);
+          pf.localPortEnd = pf.localPortStart + m_rand->GetInteger (0, 50);
+          pf.typeOfService = m_rand->GetInteger (0, 3) << 2;
+          pf.typeOfServiceMask = m_rand->GetInteger (0, 1) ? 0xfc : 0;
+          tfts[id]->Add (pf);
+        }
+    }
+
+  EpcTftClassifier c;
+  for (std::map<uint32_t, Ptr<EpcTft> >::const_iterator it = tfts.begin (); it != tfts.end (); ++it)
+    {
+      c.Add (it->second, it->first);
+    }
+  CheckFlows (c, tfts);
+
+  // the flows classified with the deleted TFTs must be classified again
+  for (uint32_t id : {3, 6})
+    {
+      c.Delete (id);
+      tfts.erase (id);
+    }
+  CheckFlows (c, tfts);
+}
+
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -430,4 +556,6 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   "9.1.1.1", "8.1.1.1",     9,     5897,     0,    2, useIpv6), TestCase::QUICK);
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, "9.1.1.1", "8.1.1.1",  5897,       10,     0,    2, useIpv6), TestCase::QUICK);
     }
+
+  AddTestCase (new EpcTftClassifierRandomFlowsTestCase, TestCase::QUICK);
 }
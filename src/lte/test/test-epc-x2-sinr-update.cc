@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/epc-x2-header.h"
+
+#include <cmath>
+#include <limits>
+#include <set>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("EpcX2SinrUpdateTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test case for EpcX2UeImsiSinrDeltaUpdateHeader. It checks the size and
+ * the round trip of the compact encoding of the SINR reports, including
+ * IMSIs which need several bytes, SINR values outside the range of the
+ * fixed point encoding and UEs removed from the report.
+ */
+class EpcX2SinrDeltaUpdateHeaderTestCase : public TestCase
+{
+public:
+  EpcX2SinrDeltaUpdateHeaderTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+EpcX2SinrDeltaUpdateHeaderTestCase::EpcX2SinrDeltaUpdateHeaderTestCase ()
+  : TestCase ("Check the serialization of the compact X2 SINR update header")
+{
+}
+
+void
+EpcX2SinrDeltaUpdateHeaderTestCase::DoRun (void)
+{
+  std::map<uint64_t, double> sent;
+  sent[1] = std::pow (10.0, 1.234);      // 12.34 dB
+  sent[2] = std::pow (10.0, -0.5);       // -5 dB
+  sent[200] = 1.0;                      // 0 dB, IMSI delta on two bytes
+  sent[(1ULL << 40) + 7] = 1e-40;       // below the range, IMSI delta on six bytes
+  sent[(1ULL << 40) + 8] = 0.0;         // no signal
+  std::set<uint64_t> removed;
+  removed.insert (3);
+  removed.insert (1000);                // IMSI delta on two bytes
+
+  EpcX2UeImsiSinrDeltaUpdateHeader header;
+  header.SetSourceCellId (12);
+  header.SetRemovedImsis (removed);
+  header.SetUeImsiSinrMap (sent);
+  // cell ID and number of entries, then varint IMSI delta and 2 bytes of SINR per entry,
+  // with the removed UEs interleaved with the reported ones
+  uint32_t expectedSize = 2 + 2 + (1 + 2) + (1 + 2) + (1 + 2) + (2 + 2) + (2 + 2) + (6 + 2) + (1 + 2);
+  NS_TEST_ASSERT_MSG_EQ (header.GetSerializedSize (), expectedSize, "wrong serialized size");
+  NS_TEST_ASSERT_MSG_EQ (header.GetNumberOfIes (), 2 + sent.size () + removed.size (), "wrong number of IEs");
+
+  Ptr<Packet> p = Create<Packet> ();
+  p->AddHeader (header);
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), expectedSize, "wrong packet size");
+
+  EpcX2UeImsiSinrDeltaUpdateHeader received;
+  p->RemoveHeader (received);
+  NS_TEST_ASSERT_MSG_EQ (received.GetSourceCellId (), 12, "wrong source cell ID");
+  NS_TEST_ASSERT_MSG_EQ (received.GetSerializedSize (), expectedSize, "wrong deserialized size");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNumberOfIes (), 2 + sent.size () + removed.size (), "wrong deserialized number of IEs");
+  NS_TEST_ASSERT_MSG_EQ ((received.GetRemovedImsis () == removed), true, "wrong removed IMSIs");
+
+  std::map<uint64_t, double> map = received.GetUeImsiSinrMap ();
+  NS_TEST_ASSERT_MSG_EQ (map.size (), sent.size (), "wrong number of entries");
+  std::map<uint64_t, double>::const_iterator it = map.begin ();
+  for (std::map<uint64_t, double>::const_iterator sentIt = sent.begin (); sentIt != sent.end (); ++sentIt, ++it)
+    {
+      NS_TEST_ASSERT_MSG_EQ (it->first, sentIt->first, "wrong IMSI");
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (10 * std::log10 (map[1]), 12.34, 0.005, "wrong SINR");
+  NS_TEST_ASSERT_MSG_EQ_TOL (10 * std::log10 (map[2]), -5.0, 0.005, "wrong SINR");
+  NS_TEST_ASSERT_MSG_EQ_TOL (10 * std::log10 (map[200]), 0.0, 0.005, "wrong SINR");
+  NS_TEST_ASSERT_MSG_EQ_TOL (10 * std::log10 (map[(1ULL << 40) + 7]), -327.67, 0.005, "the SINR is not saturated");
+  NS_TEST_ASSERT_MSG_EQ_TOL (10 * std::log10 (map[(1ULL << 40) + 8]), -327.67, 0.005, "the SINR is not saturated");
+
+  NS_TEST_ASSERT_MSG_EQ (EpcX2UeImsiSinrDeltaUpdateHeader::EncodeSinr (1e40),
+                         std::numeric_limits<int16_t>::max (), "the SINR is not saturated");
+  NS_TEST_ASSERT_MSG_EQ (EpcX2UeImsiSinrDeltaUpdateHeader::EncodeSinr (std::pow (10.0, -0.001)), -1,
+                         "wrong rounding of the SINR");
+
+  // a new SINR map keeps the removed UEs, and vice versa
+  sent.erase (200);
+  received.SetUeImsiSinrMap (sent);
+  NS_TEST_ASSERT_MSG_EQ ((received.GetRemovedImsis () == removed), true, "the removed IMSIs were not kept");
+  removed.erase (3);
+  received.SetRemovedImsis (removed);
+  NS_TEST_ASSERT_MSG_EQ (received.GetUeImsiSinrMap ().size (), sent.size (), "the SINR map was not kept");
+  expectedSize = 2 + 2 + (1 + 2) + (1 + 2) + (2 + 2) + (6 + 2) + (1 + 2);
+  NS_TEST_ASSERT_MSG_EQ (received.GetSerializedSize (), expectedSize, "wrong serialized size after the update");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test suite for the X2 SINR update messages
+ */
+class EpcX2SinrUpdateTestSuite : public TestSuite
+{
+public:
+  EpcX2SinrUpdateTestSuite ();
+};
+
+EpcX2SinrUpdateTestSuite::EpcX2SinrUpdateTestSuite ()
+  : TestSuite ("epc-x2-sinr-update", UNIT)
+{
+  AddTestCase (new EpcX2SinrDeltaUpdateHeaderTestCase, TestCase::QUICK);
+}
+
+static EpcX2SinrUpdateTestSuite g_epcX2SinrUpdateTestSuite; //!< the test suite
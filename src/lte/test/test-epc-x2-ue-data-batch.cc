@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/epc-x2.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("EpcX2UeDataBatchTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * X2 SAP user which stores the UE data it receives
+ */
+class UeDataBatchTestX2SapUser : public EpcX2SapUser
+{
+public:
+  virtual void RecvHandoverRequest (HandoverRequestParams params) {}
+  virtual void RecvHandoverRequestAck (HandoverRequestAckParams params) {}
+  virtual void RecvHandoverPreparationFailure (HandoverPreparationFailureParams params) {}
+  virtual void RecvSnStatusTransfer (SnStatusTransferParams params) {}
+  virtual void RecvUeContextRelease (UeContextReleaseParams params) {}
+  virtual void RecvLoadInformation (LoadInformationParams params) {}
+  virtual void RecvResourceStatusUpdate (ResourceStatusUpdateParams params) {}
+  virtual void RecvRlcSetupRequest (RlcSetupRequest params) {}
+  virtual void RecvRlcSetupCompleted (UeDataParams params) {}
+  virtual void RecvUeData (UeDataParams params)
+  {
+    m_received.push_back (params);
+  }
+  virtual void RecvUeSinrUpdate (UeImsiSinrParams params) {}
+  virtual void RecvMcHandoverRequest (SecondaryHandoverParams params) {}
+  virtual void RecvLteMmWaveHandoverCompleted (SecondaryHandoverParams params) {}
+  virtual void RecvConnectionSwitchToMmWave (SwitchConnectionParams params) {}
+  virtual void RecvSecondaryCellHandoverCompleted (SecondaryHandoverCompletedParams params) {}
+
+  std::vector<UeDataParams> m_received; //!< the received UE data, in order
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test case for the batches of UE data sent through the X2-U interface.
+ * It checks that the GTP-U packets of a batch are packed in as few
+ * datagrams as allowed by MaxBatchDatagramSize, that a packet larger than
+ * that is sent alone, and that the receiver gets every packet, in order and
+ * unchanged, as with the packets sent one by one.
+ */
+class EpcX2UeDataBatchTestCase : public TestCase
+{
+public:
+  EpcX2UeDataBatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Sends a batch of packets from the first to the second eNB
+   * \param x2 the X2 entity of the first eNB
+   * \param sizes the sizes of the packets
+   */
+  void SendBatch (Ptr<EpcX2> x2, std::vector<uint32_t> sizes);
+
+  /**
+   * Counts the datagrams transmitted by the first eNB
+   * \param p the datagram
+   */
+  void MacTx (Ptr<const Packet> p);
+
+  /**
+   * Counts the GTP-U packets received by the second eNB
+   * \param sourceCellId the source cell ID
+   * \param targetCellId the target cell ID
+   * \param size the size of the packet
+   * \param delay the delay of the X2 interface in nanoseconds
+   * \param data true for the X2-U interface
+   */
+  void RxPdu (uint16_t sourceCellId, uint16_t targetCellId, uint32_t size, uint64_t delay, bool data);
+
+  uint32_t m_datagrams {0}; //!< the number of datagrams transmitted
+  uint32_t m_rxPdus {0}; //!< the number of GTP-U packets received
+};
+
+EpcX2UeDataBatchTestCase::EpcX2UeDataBatchTestCase ()
+  : TestCase ("Check the packing of the UE data batches in the X2-U datagrams")
+{
+}
+
+void
+EpcX2UeDataBatchTestCase::MacTx (Ptr<const Packet> p)
+{
+  m_datagrams++;
+}
+
+void
+EpcX2UeDataBatchTestCase::RxPdu (uint16_t sourceCellId, uint16_t targetCellId, uint32_t size, uint64_t delay, bool data)
+{
+  m_rxPdus++;
+}
+
+void
+EpcX2UeDataBatchTestCase::SendBatch (Ptr<EpcX2> x2, std::vector<uint32_t> sizes)
+{
+  EpcX2SapProvider::UeDataBatchParams params;
+  params.sourceCellId = 1;
+  params.targetCellId = 2;
+  params.gtpTeid = 7;
+  for (uint32_t i = 0; i < sizes.size (); i++)
+    {
+      // the content of each packet identifies it
+      std::vector<uint8_t> buffer (sizes[i], static_cast<uint8_t> (i));
+      params.ueData.push_back (Create<Packet> (buffer.data (), sizes[i]));
+    }
+  x2->GetEpcX2SapProvider ()->SendUeDataBatch (params);
+}
+
+void
+EpcX2UeDataBatchTestCase::DoRun (void)
+{
+  NodeContainer enbs;
+  enbs.Create (2);
+  InternetStackHelper internet;
+  internet.Install (enbs);
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("Mtu", UintegerValue (10000));
+  NetDeviceContainer devices = p2p.Install (enbs);
+  Ipv4AddressHelper addresses;
+  addresses.SetBase ("10.1.0.0", "255.255.255.252");
+  Ipv4InterfaceContainer interfaces = addresses.Assign (devices);
+  devices.Get (0)->TraceConnectWithoutContext ("MacTx", MakeCallback (&EpcX2UeDataBatchTestCase::MacTx, this));
+
+  std::vector<Ptr<EpcX2> > x2s;
+  for (uint32_t i = 0; i < enbs.GetN (); i++)
+    {
+      Ptr<EpcX2> x2 = CreateObject<EpcX2> ();
+      enbs.Get (i)->AggregateObject (x2);
+      x2s.push_back (x2);
+    }
+  x2s[0]->AddX2Interface (1, interfaces.GetAddress (0), 2, interfaces.GetAddress (1));
+  x2s[1]->AddX2Interface (2, interfaces.GetAddress (1), 1, interfaces.GetAddress (0));
+  UeDataBatchTestX2SapUser sapUser;
+  x2s[1]->SetEpcX2SapUser (&sapUser);
+  x2s[1]->TraceConnectWithoutContext ("RxPDU", MakeCallback (&EpcX2UeDataBatchTestCase::RxPdu, this));
+
+  // with the default MaxBatchDatagramSize of 2972 bytes, two GTP-U packets
+  // of 1012 bytes fit in a datagram, while the one of 4012 bytes is sent
+  // alone: the datagrams are [0, 1], [2, 3], [4], [5] and [6, 7]
+  std::vector<uint32_t> sizes = {1000, 1000, 1000, 1000, 1000, 4000, 500, 500};
+  Simulator::Schedule (MilliSeconds (1), &EpcX2UeDataBatchTestCase::SendBatch, this, x2s[0], sizes);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_datagrams, 5, "wrong number of datagrams");
+  NS_TEST_ASSERT_MSG_EQ (m_rxPdus, sizes.size (), "wrong number of GTP-U packets traced");
+  NS_TEST_ASSERT_MSG_EQ (sapUser.m_received.size (), sizes.size (), "wrong number of packets received");
+  for (uint32_t i = 0; i < sapUser.m_received.size (); i++)
+    {
+      const EpcX2SapUser::UeDataParams &params = sapUser.m_received[i];
+      NS_TEST_ASSERT_MSG_EQ (params.sourceCellId, 1, "wrong source cell of packet " << i);
+      NS_TEST_ASSERT_MSG_EQ (params.targetCellId, 2, "wrong target cell of packet " << i);
+      NS_TEST_ASSERT_MSG_EQ (params.gtpTeid, 7, "wrong TEID of packet " << i);
+      NS_TEST_ASSERT_MSG_EQ (params.ueData->GetSize (), sizes[i], "wrong size of packet " << i);
+      std::vector<uint8_t> buffer (sizes[i]);
+      params.ueData->CopyData (buffer.data (), sizes[i]);
+      NS_TEST_ASSERT_MSG_EQ ((buffer == std::vector<uint8_t> (sizes[i], static_cast<uint8_t> (i))), true,
+                             "wrong content of packet " << i);
+    }
+
+  // a single packet, sent as before the batches
+  m_datagrams = 0;
+  EpcX2SapProvider::UeDataParams params;
+  params.sourceCellId = 1;
+  params.targetCellId = 2;
+  params.gtpTeid = 7;
+  params.ueData = Create<Packet> (100);
+  x2s[0]->GetEpcX2SapProvider ()->SendUeData (params);
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (m_datagrams, 1, "wrong number of datagrams for a single packet");
+  NS_TEST_ASSERT_MSG_EQ (sapUser.m_received.size (), sizes.size () + 1, "the single packet was not received");
+  NS_TEST_ASSERT_MSG_EQ (sapUser.m_received.back ().ueData->GetSize (), 100, "wrong size of the single packet");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test suite for the batches of UE data sent through X2
+ */
+class EpcX2UeDataBatchTestSuite : public TestSuite
+{
+public:
+  EpcX2UeDataBatchTestSuite ();
+};
+
+EpcX2UeDataBatchTestSuite::EpcX2UeDataBatchTestSuite ()
+  : TestSuite ("epc-x2-ue-data-batch", UNIT)
+{
+  AddTestCase (new EpcX2UeDataBatchTestCase, TestCase::QUICK);
+}
+
+static EpcX2UeDataBatchTestSuite g_epcX2UeDataBatchTestSuite; //!< the test suite
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/lte-rlc-sdu-queue.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteRlcSduQueueTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test case for LteRlcSduQueue. It checks the number of SDUs, the number of
+ * bytes and the order of the SDUs after each operation, including the
+ * append of a queue to a non-empty one and the swap of two queues.
+ */
+class LteRlcSduQueueTestCase : public TestCase
+{
+public:
+  LteRlcSduQueueTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Checks the content of a queue
+   *
+   * \param queue the queue
+   * \param sizes the expected sizes of the SDUs, from the head to the tail
+   * \param step the description of the last operation
+   */
+  void CheckQueue (const LteRlcSduQueue &queue, std::vector<uint32_t> sizes, std::string step);
+};
+
+LteRlcSduQueueTestCase::LteRlcSduQueueTestCase ()
+  : TestCase ("Check the SDU and byte counts of the RLC SDU queue")
+{
+}
+
+void
+LteRlcSduQueueTestCase::CheckQueue (const LteRlcSduQueue &queue, std::vector<uint32_t> sizes, std::string step)
+{
+  uint32_t nBytes = 0;
+  for (uint32_t size : sizes)
+    {
+      nBytes += size;
+    }
+  NS_TEST_ASSERT_MSG_EQ (queue.GetNPackets (), sizes.size (), "wrong number of SDUs after " << step);
+  NS_TEST_ASSERT_MSG_EQ (queue.GetNBytes (), nBytes, "wrong number of bytes after " << step);
+  NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), sizes.empty (), "wrong emptiness after " << step);
+  uint32_t i = 0;
+  for (LteRlcSduQueue::ConstIterator it = queue.Begin (); it != queue.End (); ++it, ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*it)->GetSize (), sizes.at (i), "wrong SDU " << i << " after " << step);
+      NS_TEST_ASSERT_MSG_EQ (queue.Get (i), *it, "wrong indexed SDU " << i << " after " << step);
+    }
+  std::vector<Ptr<Packet> > sdus = queue.ToVector ();
+  NS_TEST_ASSERT_MSG_EQ (sdus.size (), sizes.size (), "wrong vector size after " << step);
+  if (!sizes.empty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (queue.Front ()->GetSize (), sizes.front (), "wrong head after " << step);
+    }
+}
+
+void
+LteRlcSduQueueTestCase::DoRun (void)
+{
+  LteRlcSduQueue queue;
+  CheckQueue (queue, {}, "construction");
+
+  queue.PushBack (Create<Packet> (100));
+  queue.PushBack (Create<Packet> (200));
+  CheckQueue (queue, {100, 200}, "PushBack");
+
+  // the segment left after the segmentation of the head SDU goes back to the head
+  Ptr<Packet> head = queue.PopFront ();
+  NS_TEST_ASSERT_MSG_EQ (head->GetSize (), 100, "wrong SDU popped");
+  CheckQueue (queue, {200}, "PopFront");
+  Ptr<Packet> segment = head->CreateFragment (60, 40);
+  queue.PushFront (segment);
+  CheckQueue (queue, {40, 200}, "PushFront");
+  NS_TEST_ASSERT_MSG_EQ (queue.Front (), segment, "the segment is not at the head");
+
+  // append to a non-empty queue
+  LteRlcSduQueue other;
+  other.PushBack (Create<Packet> (300));
+  other.PushBack (Create<Packet> (400));
+  queue.Append (other);
+  CheckQueue (queue, {40, 200, 300, 400}, "Append to a non-empty queue");
+  CheckQueue (other, {}, "Append, for the appended queue");
+
+  // append an empty queue
+  queue.Append (other);
+  CheckQueue (queue, {40, 200, 300, 400}, "Append of an empty queue");
+  CheckQueue (other, {}, "Append of an empty queue, for the appended queue");
+
+  // append to an empty queue
+  other.Append (queue);
+  CheckQueue (other, {40, 200, 300, 400}, "Append to an empty queue");
+  CheckQueue (queue, {}, "Append to an empty queue, for the appended queue");
+
+  // swap two non-empty queues
+  queue.PushBack (Create<Packet> (500));
+  queue.Swap (other);
+  CheckQueue (queue, {40, 200, 300, 400}, "Swap");
+  CheckQueue (other, {500}, "Swap, for the other queue");
+
+  // swap with an empty queue
+  LteRlcSduQueue empty;
+  other.Swap (empty);
+  CheckQueue (other, {}, "Swap with an empty queue");
+  CheckQueue (empty, {500}, "Swap with an empty queue, for the empty one");
+
+  while (!queue.IsEmpty ())
+    {
+      queue.PopFront ();
+    }
+  CheckQueue (queue, {}, "PopFront of all the SDUs");
+
+  empty.PushFront (Create<Packet> (50));
+  CheckQueue (empty, {50, 500}, "PushFront");
+  empty.Clear ();
+  CheckQueue (empty, {}, "Clear");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * Test suite for the RLC SDU queue
+ */
+class LteRlcSduQueueTestSuite : public TestSuite
+{
+public:
+  LteRlcSduQueueTestSuite ();
+};
+
+LteRlcSduQueueTestSuite::LteRlcSduQueueTestSuite ()
+  : TestSuite ("lte-rlc-sdu-queue", UNIT)
+{
+  AddTestCase (new LteRlcSduQueueTestCase, TestCase::QUICK);
+}
+
+static LteRlcSduQueueTestSuite g_lteRlcSduQueueTestSuite; //!< the test suite
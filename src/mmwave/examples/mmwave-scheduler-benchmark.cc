@@ -0,0 +1,229 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * This program measures the time needed by the MmWaveFlexTti schedulers to
+ * schedule a slot. The scheduler is driven directly through its SAPs, without
+ * PHY and MAC: a number of UEs with a single, always backlogged, downlink
+ * logical channel is configured, wideband CQIs are reported periodically and
+ * the scheduler is triggered for consecutive slots.
+ * The benchmark is repeated for the plain, PF, MaxRate and MaxWeight
+ * schedulers and for 50, 200 and 1000 UEs.
+ * The time per slot is reported in microseconds.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mmwave-mac-scheduler.h"
+#include "ns3/mmwave-phy-mac-common.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSchedulerBenchmark");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * Sched SAP user which counts and discards the slot allocations
+ */
+class BenchmarkSchedSapUser : public MmWaveMacSchedSapUser
+{
+public:
+  BenchmarkSchedSapUser ()
+    : m_numAllocs (0)
+  {
+  }
+  virtual void SchedConfigInd (const struct SchedConfigIndParameters& params)
+  {
+    m_numAllocs += params.m_slotAllocInfo.m_ttiAllocInfo.size ();
+  }
+  uint64_t m_numAllocs; //!< the number of allocations received
+};
+
+/**
+ * Csched SAP user which discards the confirmations
+ */
+class BenchmarkCschedSapUser : public MmWaveMacCschedSapUser
+{
+public:
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+  {
+  }
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+  {
+  }
+};
+
+/**
+ * Run the benchmark for a scheduler
+ * \param schedulerType the TypeId name of the scheduler
+ * \param numUes the number of UEs
+ * \param numSlots the number of slots to schedule
+ * \param numAllocs set to the number of allocations made by the scheduler
+ * \return the time per slot in microseconds
+ */
+static double
+RunScheduler (std::string schedulerType, uint16_t numUes, uint32_t numSlots, uint64_t &numAllocs)
+{
+  Ptr<MmWavePhyMacCommon> config = CreateObject<MmWavePhyMacCommon> ();
+  ObjectFactory factory;
+  factory.SetTypeId (schedulerType);
+  factory.Set ("HarqEnabled", BooleanValue (false));
+  Ptr<MmWaveMacScheduler> scheduler = factory.Create<MmWaveMacScheduler> ();
+  scheduler->ConfigureCommonParameters (config);
+  BenchmarkSchedSapUser schedSapUser;
+  BenchmarkCschedSapUser cschedSapUser;
+  scheduler->SetMacSchedSapUser (&schedSapUser);
+  scheduler->SetMacCschedSapUser (&cschedSapUser);
+  MmWaveMacSchedSapProvider *schedSap = scheduler->GetMacSchedSapProvider ();
+  MmWaveMacCschedSapProvider *cschedSap = scheduler->GetMacCschedSapProvider ();
+
+  std::list<uint16_t> ueList;
+  for (uint16_t rnti = 1; rnti <= numUes; rnti++)
+    {
+      MmWaveMacCschedSapProvider::CschedUeConfigReqParameters ueParams;
+      ueParams.m_rnti = rnti;
+      ueParams.m_transmissionMode = 0;
+      ueParams.m_reconfigureFlag = false;
+      cschedSap->CschedUeConfigReq (ueParams);
+
+      LogicalChannelConfigListElement_s lc;
+      lc.m_logicalChannelIdentity = 3;
+      lc.m_logicalChannelGroup = 1;
+      lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+      lc.m_qci = 9;
+      lc.m_eRabMaximulBitrateUl = 0;
+      lc.m_eRabMaximulBitrateDl = 0;
+      lc.m_eRabGuaranteedBitrateUl = 0;
+      lc.m_eRabGuaranteedBitrateDl = 0;
+      MmWaveMacCschedSapProvider::CschedLcConfigReqParameters lcParams;
+      lcParams.m_rnti = rnti;
+      lcParams.m_reconfigureFlag = false;
+      lcParams.m_logicalChannelConfigList.push_back (lc);
+      cschedSap->CschedLcConfigReq (lcParams);
+
+      ueList.push_back (rnti);
+    }
+
+  uint32_t slotsPerSf = config->GetSlotsPerSubframe ();
+  uint32_t sfPerFrame = config->GetSubframesPerFrame ();
+  auto start = std::chrono::high_resolution_clock::now ();
+  for (uint32_t slot = 0; slot < numSlots; slot++)
+    {
+      SfnSf sfnSf (slot / (slotsPerSf * sfPerFrame),
+                   (slot / slotsPerSf) % sfPerFrame,
+                   slot % slotsPerSf);
+      if (slot % 10 == 0)
+        {
+          MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiParams;
+          cqiParams.m_sfnsf = sfnSf;
+          for (uint16_t rnti = 1; rnti <= numUes; rnti++)
+            {
+              DlCqiInfo cqi;
+              cqi.m_rnti = rnti;
+              cqi.m_ri = 1;
+              cqi.m_cqiType = DlCqiInfo::WB;
+              cqi.m_wbCqi = 1 + (rnti * 7 + slot) % 15;
+              cqi.m_wbPmi = 0;
+              cqiParams.m_cqiList.push_back (cqi);
+            }
+          schedSap->SchedDlCqiInfoReq (cqiParams);
+
+          // keep the buffers of all the UEs backlogged
+          for (uint16_t rnti = 1; rnti <= numUes; rnti++)
+            {
+              MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters rlcParams;
+              rlcParams.m_rnti = rnti;
+              rlcParams.m_logicalChannelIdentity = 3;
+              rlcParams.m_rlcTransmissionQueueSize = 100000;
+              rlcParams.m_rlcTransmissionQueueHolDelay = 0;
+              rlcParams.m_rlcRetransmissionQueueSize = 0;
+              rlcParams.m_rlcRetransmissionHolDelay = 0;
+              rlcParams.m_rlcStatusPduSize = 0;
+              rlcParams.m_arrivalRate = 0;
+              // the MaxWeight scheduler serves the individual packets
+              for (uint32_t i = 0; i < 10; i++)
+                {
+                  rlcParams.m_txPacketSizes.push_back (10000);
+                  rlcParams.m_txPacketDelays.push_back ((rnti % 10) * 100.0 + i);
+                }
+              schedSap->SchedDlRlcBufferReq (rlcParams);
+            }
+        }
+
+      MmWaveMacSchedSapProvider::SchedTriggerReqParameters triggerParams;
+      triggerParams.m_snfSf = sfnSf;
+      triggerParams.m_ueList = ueList;
+      schedSap->SchedTriggerReq (triggerParams);
+    }
+  auto end = std::chrono::high_resolution_clock::now ();
+
+  numAllocs = schedSapUser.m_numAllocs;
+  scheduler->Dispose ();
+  return std::chrono::duration<double, std::micro> (end - start).count () / numSlots;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numSlots = 200;
+
+  CommandLine cmd;
+  cmd.AddValue ("numSlots", "Number of slots scheduled for each configuration", numSlots);
+  cmd.Parse (argc, argv);
+
+  std::vector<std::string> schedulerTypes = {"ns3::MmWaveFlexTtiMacScheduler",
+                                             "ns3::MmWaveFlexTtiPfMacScheduler",
+                                             "ns3::MmWaveFlexTtiMaxRateMacScheduler",
+                                             "ns3::MmWaveFlexTtiMaxWeightMacScheduler"};
+  std::vector<uint16_t> numUesList = {50, 200, 1000};
+
+  std::cout << std::setw (40) << "scheduler"
+            << std::setw (8) << "UEs"
+            << std::setw (16) << "us/slot"
+            << std::setw (16) << "allocations" << std::endl;
+  for (const std::string &schedulerType : schedulerTypes)
+    {
+      for (uint16_t numUes : numUesList)
+        {
+          uint64_t numAllocs = 0;
+          double time = RunScheduler (schedulerType, numUes, numSlots, numAllocs);
+          std::cout << std::setw (40) << schedulerType
+                    << std::setw (8) << numUes
+                    << std::setw (16) << std::fixed << std::setprecision (2) << time
+                    << std::setw (16) << numAllocs << std::endl;
+        }
+    }
+
+  return 0;
+}
@@ -63,6 +63,7 @@
 #include <ns3/three-gpp-spectrum-propagation-loss-model.h>
 #include <ns3/channel-condition-model.h>
 #include <ns3/three-gpp-propagation-loss-model.h>
+#include <ns3/three-gpp-channel-model.h>
 #include <ns3/mmwave-beamforming-model.h>
 
 
@@ -79,6 +80,7 @@ MmWaveHelper::MmWaveHelper (void)
   : m_imsiCounter (0),
     m_cellIdCounter (1),
     m_harqEnabled (false),
+    m_channelStreamsAssigned (false),
     m_rlcAmEnabled (false),
     m_snrTest (false),
     m_useIdealRrc (false)
@@ -502,6 +504,90 @@ MmWaveHelper::GetPathLossModel (uint8_t index)
   return m_pathlossModel.at (index)->GetObject<PropagationLossModel> ();
 }
 
+int64_t
+MmWaveHelper::AssignStreams (NetDeviceContainer c, int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  int64_t currentStream = stream;
+  if (!m_channelStreamsAssigned)
+    {
+      for (std::map<uint8_t, Ptr<SpectrumChannel> >::iterator it = m_channel.begin (); it != m_channel.end (); ++it)
+        {
+          // the channel condition model is shared by the propagation loss
+          // model and by the 3GPP channel model, assign its streams once
+          Ptr<ChannelConditionModel> ccm;
+          std::map<uint8_t, Ptr<Object> >::iterator plmIt = m_pathlossModel.find (it->first);
+          if (plmIt != m_pathlossModel.end () && plmIt->second)
+            {
+              Ptr<PropagationLossModel> plm = plmIt->second->GetObject<PropagationLossModel> ();
+              currentStream += plm->AssignStreams (currentStream);
+              Ptr<ThreeGppPropagationLossModel> threeGppPlm = DynamicCast<ThreeGppPropagationLossModel> (plm);
+              if (threeGppPlm)
+                {
+                  ccm = threeGppPlm->GetChannelConditionModel ();
+                }
+            }
+          Ptr<ThreeGppSpectrumPropagationLossModel> threeGppSplm = DynamicCast<ThreeGppSpectrumPropagationLossModel> (it->second->GetSpectrumPropagationLossModel ());
+          if (threeGppSplm)
+            {
+              Ptr<ThreeGppChannelModel> channelModel = DynamicCast<ThreeGppChannelModel> (threeGppSplm->GetChannelModel ());
+              if (channelModel)
+                {
+                  currentStream += channelModel->AssignStreams (currentStream);
+                  if (!ccm)
+                    {
+                      ccm = channelModel->GetChannelConditionModel ();
+                    }
+                }
+            }
+          if (ccm)
+            {
+              currentStream += ccm->AssignStreams (currentStream);
+            }
+        }
+      m_channelStreamsAssigned = true;
+    }
+
+  for (NetDeviceContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<NetDevice> netDevice = (*i);
+      Ptr<MmWaveEnbNetDevice> mmWaveEnb = DynamicCast<MmWaveEnbNetDevice> (netDevice);
+      if (mmWaveEnb)
+        {
+          std::map<uint8_t, Ptr<MmWaveComponentCarrier> > ccMap = mmWaveEnb->GetCcMap ();
+          for (std::map<uint8_t, Ptr<MmWaveComponentCarrier> >::iterator it = ccMap.begin (); it != ccMap.end (); ++it)
+            {
+              Ptr<MmWaveEnbPhy> phy = DynamicCast<MmWaveComponentCarrierEnb> (it->second)->GetPhy ();
+              currentStream += phy->GetDlSpectrumPhy ()->AssignStreams (currentStream);
+              currentStream += phy->GetUlSpectrumPhy ()->AssignStreams (currentStream);
+            }
+        }
+      std::map<uint8_t, Ptr<MmWaveComponentCarrierUe> > ueCcMap;
+      Ptr<MmWaveUeNetDevice> mmWaveUe = DynamicCast<MmWaveUeNetDevice> (netDevice);
+      if (mmWaveUe)
+        {
+          std::map<uint8_t, Ptr<MmWaveComponentCarrier> > ccMap = mmWaveUe->GetCcMap ();
+          for (std::map<uint8_t, Ptr<MmWaveComponentCarrier> >::iterator it = ccMap.begin (); it != ccMap.end (); ++it)
+            {
+              ueCcMap[it->first] = DynamicCast<MmWaveComponentCarrierUe> (it->second);
+            }
+        }
+      Ptr<McUeNetDevice> mcUe = DynamicCast<McUeNetDevice> (netDevice);
+      if (mcUe)
+        {
+          ueCcMap = mcUe->GetMmWaveCcMap ();
+        }
+      for (std::map<uint8_t, Ptr<MmWaveComponentCarrierUe> >::iterator it = ueCcMap.begin (); it != ueCcMap.end (); ++it)
+        {
+          Ptr<MmWaveUePhy> phy = it->second->GetPhy ();
+          currentStream += phy->GetDlSpectrumPhy ()->AssignStreams (currentStream);
+          currentStream += phy->GetUlSpectrumPhy ()->AssignStreams (currentStream);
+          currentStream += it->second->GetMac ()->AssignStreams (currentStream);
+        }
+    }
+  return (currentStream - stream);
+}
+
 void
 MmWaveHelper::SetChannelModelType (std::string type)
 {
@@ -224,6 +224,17 @@ public:
   bool GetSnrTest ();
   Ptr<PropagationLossModel> GetPathLossModel (uint8_t index);
 
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by the mmWave channels and by the mmWave devices of the container.
+   * The streams of the channels are assigned only by the first call.
+   *
+   * \param c NetDeviceContainer of the set of mmWave net devices
+   * \param stream first stream index to use
+   * \return the number of stream indices (possibly zero) that have been assigned
+   */
+  int64_t AssignStreams (NetDeviceContainer c, int64_t stream);
+
   /**
   * Set the type of FFR algorithm to be used by LTE eNodeB devices.
   *
@@ -408,6 +419,7 @@ private:
   Ptr<EpcHelper> m_epcHelper;
 
   bool m_harqEnabled;
+  bool m_channelStreamsAssigned;       // true if the streams of the mmWave channels have been assigned
   bool m_rlcAmEnabled;
   bool m_snrTest;
   bool m_useIdealRrc;       // Initialized as true in the constructor
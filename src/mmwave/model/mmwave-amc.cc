@@ -37,6 +37,7 @@
 #include <ns3/math.h>
 #include "ns3/enum.h"
 #include "mmwave-mi-error-model.h"
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("MmWaveAmc");
 
@@ -109,12 +110,16 @@ static const int ModulationSchemeForMcs[32] = {
 };
 
 MmWaveAmc::MmWaveAmc ()
+  : m_tbSizeTableRscPerSym (0),
+    m_tbSizeTableNumSym (0)
 {
   NS_LOG_ERROR ("This construcor should not be invoked");
 }
 
 MmWaveAmc::MmWaveAmc (Ptr<MmWavePhyMacCommon> ConfigParams)
-  : m_phyMacConfig (ConfigParams)
+  : m_tbSizeTableRscPerSym (0),
+    m_tbSizeTableNumSym (0),
+    m_phyMacConfig (ConfigParams)
 {
   NS_LOG_INFO ("Initialze AMC module");
 }
@@ -184,13 +189,10 @@ MmWaveAmc::GetTbSizeFromMcs (unsigned mcs, unsigned nprb)
 }
 
 int
-MmWaveAmc::GetTbSizeFromMcsSymbols (unsigned mcs, unsigned nsymb)
+MmWaveAmc::CalcTbSizeFromMcsSymbols (unsigned mcs, unsigned nsymb, int rscElementPerSym)
 {
-  NS_LOG_FUNCTION (mcs);
-  NS_ASSERT_MSG (mcs < 29, "MCS=" << mcs);
   //unsigned itb = McsToItbs[mcs];
-  int rscElement = (m_phyMacConfig->GetNumSCperChunk () * m_phyMacConfig->GetNumChunks ()
-                    - m_phyMacConfig->GetNumRefScPerSym ()) * nsymb;
+  int rscElement = rscElementPerSym * nsymb;
   double Rcode = McsEcrTable[mcs];
   double Qm = ModulationSchemeForMcs[mcs];
 
@@ -204,25 +206,79 @@ MmWaveAmc::GetTbSizeFromMcsSymbols (unsigned mcs, unsigned nsymb)
   return tbSize;
 }
 
+void
+MmWaveAmc::UpdateTbSizeTable ()
+{
+  int rscElementPerSym = m_phyMacConfig->GetNumSCperChunk () * m_phyMacConfig->GetNumChunks ()
+    - m_phyMacConfig->GetNumRefScPerSym ();
+  unsigned numSym = m_phyMacConfig->GetSymbPerSlot ();
+  if (!m_tbSizeTable.empty () && rscElementPerSym == m_tbSizeTableRscPerSym && numSym == m_tbSizeTableNumSym)
+    {
+      return;
+    }
+
+  NS_LOG_LOGIC ("Building the TB size table for " << rscElementPerSym << " resource elements per symbol and " << numSym << " symbols");
+  m_tbSizeTableRscPerSym = rscElementPerSym;
+  m_tbSizeTableNumSym = numSym;
+  m_tbSizeTable.resize (29 * (numSym + 1));
+  for (unsigned mcs = 0; mcs < 29; mcs++)
+    {
+      for (unsigned nsymb = 0; nsymb <= numSym; nsymb++)
+        {
+          m_tbSizeTable[mcs * (numSym + 1) + nsymb] = CalcTbSizeFromMcsSymbols (mcs, nsymb, rscElementPerSym);
+        }
+    }
+}
+
+int
+MmWaveAmc::GetTbSizeFromMcsSymbols (unsigned mcs, unsigned nsymb)
+{
+  NS_LOG_FUNCTION (mcs);
+  NS_ASSERT_MSG (mcs < 29, "MCS=" << mcs);
+  UpdateTbSizeTable ();
+  if (nsymb <= m_tbSizeTableNumSym)
+    {
+      return m_tbSizeTable[mcs * (m_tbSizeTableNumSym + 1) + nsymb];
+    }
+  return CalcTbSizeFromMcsSymbols (mcs, nsymb, m_tbSizeTableRscPerSym);
+}
+
 int
 MmWaveAmc::GetNumSymbolsFromTbsMcs (unsigned tbSize, unsigned mcs)
 {
   NS_LOG_FUNCTION (mcs);
   NS_ASSERT_MSG (mcs < 29, "MCS=" << mcs);
-  //unsigned itb = McsToItbs[mcs];
-  int rscElementPerSym = (m_phyMacConfig->GetNumSCperChunk () * m_phyMacConfig->GetNumChunks ()
-                          - m_phyMacConfig->GetNumRefScPerSym ());
-  double Rcode = McsEcrTable[mcs];
-  double Qm = ModulationSchemeForMcs[mcs];
-  uint16_t cbSize = 6144;        //max size of a code-block (including m_crcLen)
-  if (tbSize > cbSize)
+  UpdateTbSizeTable ();
+
+  // the TB size grows linearly with the number of symbols, apart from the
+  // CRC bits: the number of symbols is estimated from the bits carried by a
+  // symbol, and then corrected with the exact TB sizes, so that the smallest
+  // number of symbols with a TB of at least tbSize bits is returned
+  double bitsPerSym = m_tbSizeTableRscPerSym * ModulationSchemeForMcs[mcs] * McsEcrTable[mcs];
+  unsigned numSym = std::max (1.0, ceil ((tbSize + m_crcLen) / bitsPerSym));
+  while (numSym > 1 && GetTbSizeFromMcsSymbols (mcs, numSym - 1) >= (int64_t) tbSize)
     {
-      int C = ceil ((double)tbSize / ((double)(6144)));
-      tbSize += C * m_crcLen;           //subtract bits of m_crcLen used in code-blocks.
+      numSym--;
+    }
+  while (GetTbSizeFromMcsSymbols (mcs, numSym) < (int64_t) tbSize)
+    {
+      numSym++;
     }
-  int reqRscElement = (tbSize + m_crcLen) / (Qm * Rcode);
+  return numSym;
+}
 
-  return ceil ((double)reqRscElement / (double)rscElementPerSym);
+unsigned
+MmWaveAmc::GetMinNumSymbolsFromBufSize (unsigned mcs, unsigned bufSize, unsigned &tbSize)
+{
+  NS_LOG_FUNCTION (mcs << bufSize);
+  unsigned numSym = m_phyMacConfig->GetSymbPerSlot ();
+  tbSize = GetTbSizeFromMcsSymbols (mcs, numSym) / 8;
+  if (tbSize > bufSize)
+    {
+      numSym = GetNumSymbolsFromTbsMcs (bufSize * 8, mcs);
+      tbSize = GetTbSizeFromMcsSymbols (mcs, numSym) / 8;
+    }
+  return numSym;
 }
 
 std::vector<int>
@@ -268,6 +324,16 @@ MmWaveAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
     }
   else if (m_amcModel == MiErrorModel)
     {
+      std::map<uint8_t, std::vector<double> >::iterator thresholdsIt = m_miThresholdsRbg.find (rbgSize);
+      if (thresholdsIt == m_miThresholdsRbg.end ())
+        {
+          std::vector<uint32_t> tbSizes;
+          for (uint8_t mcs = 0; mcs <= 28; mcs++)
+            {
+              tbSizes.push_back (GetTbSizeFromMcs (mcs, rbgSize / 18) / 8);
+            }
+          thresholdsIt = m_miThresholdsRbg.insert (std::make_pair (rbgSize, CreateMiThresholds (tbSizes))).first;
+        }
       std::vector <int> rbgMap;
       int rbId = 0;
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
@@ -276,41 +342,7 @@ MmWaveAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
           if ((rbId % rbgSize == 0)||((it + 1) == sinr.ConstValuesEnd ()))
             {
               uint8_t mcs = 0;
-              MmWaveTbStats_t tbStats;
-              while (mcs <= 28)
-                {
-                  MmWaveHarqProcessInfoList_t harqInfoList;
-                  tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, GetTbSizeFromMcs (mcs, rbgSize / 18) / 8, mcs, harqInfoList);
-                  if (tbStats.tbler > 0.1)
-                    {
-                      break;
-                    }
-                  mcs++;
-
-                }
-              if (mcs > 0)
-                {
-                  mcs--;
-                }
-              NS_LOG_DEBUG (this << "\t RBG " << rbId << " MCS " << (uint16_t)mcs << " TBLER " << tbStats.tbler);
-              int rbgCqi = 0;
-              if ((tbStats.tbler > 0.1)&&(mcs == 0))
-                {
-                  rbgCqi = 0;
-                }
-              else if (mcs == 28)
-                {
-                  rbgCqi = 15;                       // all MCSs can guarantee the 10 % of BER
-                }
-              else
-                {
-                  double s = SpectralEfficiencyForMcs[mcs];
-                  rbgCqi = 0;
-                  while ((rbgCqi < 15) && (SpectralEfficiencyForCqi[rbgCqi + 1] < s))
-                    {
-                      ++rbgCqi;
-                    }
-                }
+              int rbgCqi = GetCqiFromFirstFailingMcs (GetFirstFailingMcs (sinr, rbgMap, thresholdsIt->second), true, mcs);
               NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << "-> CQI " << rbgCqi);
               // fill the cqi vector (per RB basis)
               for (uint8_t j = 0; j < rbgSize; j++)
@@ -368,47 +400,24 @@ MmWaveAmc::CreateCqiFeedbacksTdma (const SpectrumValue& sinr, uint8_t numSym)
     }
   else if (m_amcModel == MiErrorModel)
     {
+      std::map<uint8_t, std::vector<double> >::iterator thresholdsIt = m_miThresholdsSym.find (numSym);
+      if (thresholdsIt == m_miThresholdsSym.end ())
+        {
+          std::vector<uint32_t> tbSizes;
+          for (uint8_t mcs = 0; mcs <= 28; mcs++)
+            {
+              tbSizes.push_back (GetTbSizeFromMcsSymbols (mcs, numSym) / 8);
+            }
+          thresholdsIt = m_miThresholdsSym.insert (std::make_pair (numSym, CreateMiThresholds (tbSizes))).first;
+        }
+      const std::vector<double> &miThresholds = thresholdsIt->second;
       int chunkId = 0;
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
         {
           uint8_t mcs = 0;
-          MmWaveTbStats_t tbStats;
           std::vector <int> chunkMap;
           chunkMap.push_back (chunkId++);
-          while (mcs <= 28)
-            {
-              MmWaveHarqProcessInfoList_t harqInfoList;
-              tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, GetTbSizeFromMcsSymbols (mcs, numSym) / 8, mcs, harqInfoList);
-              if (tbStats.tbler > 0.1)
-                {
-                  break;
-                }
-              mcs++;
-
-            }
-          if (mcs > 0)
-            {
-              mcs--;
-            }
-          NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << " TBLER " << tbStats.tbler);
-          int chunkCqi = 0;
-          if ((tbStats.tbler > 0.1)&&(mcs == 0))
-            {
-              chunkCqi = 0;
-            }
-          else if (mcs == 28)
-            {
-              chunkCqi = 15;                   // all MCSs can guarantee the 10 % of BER
-            }
-          else
-            {
-              double s = SpectralEfficiencyForMcs[mcs];
-              chunkCqi = 0;
-              while ((chunkCqi < 15) && (SpectralEfficiencyForCqi[chunkCqi + 1] <= s))
-                {
-                  ++chunkCqi;
-                }
-            }
+          int chunkCqi = GetCqiFromFirstFailingMcs (GetFirstFailingMcs (sinr, chunkMap, miThresholds), false, mcs);
           NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << "-> CQI " << chunkCqi);
           cqi.push_back (chunkCqi);
         }
@@ -483,45 +492,95 @@ MmWaveAmc::CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t numSym, u
         }
       sinrAvg /= chunkId;
 
-      mcs = 0;
-      MmWaveTbStats_t tbStats;
-      while (mcs <= 28)
+      std::map<uint32_t, std::vector<double> >::iterator thresholdsIt = m_miThresholdsTbs.find (tbSize);
+      if (thresholdsIt == m_miThresholdsTbs.end ())
         {
-          MmWaveHarqProcessInfoList_t harqInfoList;
-          tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, tbSize, mcs, harqInfoList);
-          if (tbStats.tbler > 0.1)
-            {
-              break;
-            }
-          mcs++;
+          thresholdsIt = m_miThresholdsTbs.insert (std::make_pair (tbSize, CreateMiThresholds (std::vector<uint32_t> (29, tbSize)))).first;
         }
-      if (mcs > 0)
-        {
-          mcs--;
-        }
-//		MmWaveHarqProcessInfoList_t harqInfoList;
-//		MmWaveTbStats_t tbStatsFinal = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, tbSize, mcs, harqInfoList);
-//		NS_LOG_UNCOND ("TBLER " << tbStatsFinal.tbler << " for chunks " << chunkMap.size () << " numSym "
-//		               << (unsigned)numSym << " tbSize " << tbSize << " mcs " << (unsigned)mcs << " sinr " << sinrAvg);
-//		NS_LOG_UNCOND (sinr);
-      if ((tbStats.tbler > 0.1)&&(mcs == 0))
+      uint8_t mcsWb = 0;
+      cqi = GetCqiFromFirstFailingMcs (GetFirstFailingMcs (sinr, chunkMap, thresholdsIt->second), false, mcsWb);
+      mcs = mcsWb;
+      NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << "-> CQI " << cqi);
+    }
+  return cqi;
+}
+
+std::vector<double>
+MmWaveAmc::CreateMiThresholds (const std::vector<uint32_t> &tbSizes)
+{
+  NS_LOG_FUNCTION (tbSizes.size ());
+  NS_ASSERT (tbSizes.size () == 29);
+  std::vector<double> miThresholds (29);
+  for (uint8_t mcs = 0; mcs <= 28; mcs++)
+    {
+      miThresholds[mcs] = MmWaveMiErrorModel::GetMiThreshold (mcs, tbSizes[mcs], 0.1);
+      // the MCSs are tested in increasing order and the search stops at the
+      // first one which does not meet the target, therefore an MCS is
+      // selectable only if all the lower MCSs with the same modulation are
+      if (mcs != 0 && mcs != MMWAVE_MI_QPSK_MAX_ID + 1 && mcs != MMWAVE_MI_16QAM_MAX_ID + 1)
         {
-          cqi = 0;
+          miThresholds[mcs] = std::max (miThresholds[mcs], miThresholds[mcs - 1]);
         }
-      else if (mcs == 28)
+    }
+  return miThresholds;
+}
+
+uint8_t
+MmWaveAmc::GetFirstFailingMcs (const SpectrumValue& sinr, const std::vector<int>& map, const std::vector<double> &miThresholds)
+{
+  static const uint8_t firstMcs[3] = {0, MMWAVE_MI_QPSK_MAX_ID + 1, MMWAVE_MI_16QAM_MAX_ID + 1};
+  static const uint8_t lastMcs[3] = {MMWAVE_MI_QPSK_MAX_ID, MMWAVE_MI_16QAM_MAX_ID, MMWAVE_MI_64QAM_MAX_ID};
+
+  for (uint8_t mod = 0; mod < 3; mod++)
+    {
+      // the MI only depends on the modulation
+      double mi = MmWaveMiErrorModel::Mib (sinr, map, firstMcs[mod]);
+      if (mi >= miThresholds[lastMcs[mod]])
         {
-          cqi = 15;               // all MCSs can guarantee the 10 % of BER
+          continue;
         }
-      else
+      // find the first MCS of this modulation whose threshold is higher than the MI
+      uint8_t low = firstMcs[mod];
+      uint8_t high = lastMcs[mod];
+      while (low < high)
         {
-          double s = SpectralEfficiencyForMcs[mcs];
-          cqi = 0;
-          while ((cqi < 15) && (SpectralEfficiencyForCqi[cqi + 1] <= s))
+          uint8_t mid = (low + high) / 2;
+          if (mi >= miThresholds[mid])
+            {
+              low = mid + 1;
+            }
+          else
             {
-              ++cqi;
+              high = mid;
             }
         }
-      NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << "-> CQI " << cqi);
+      return low;
+    }
+  return MMWAVE_MI_64QAM_MAX_ID + 1;
+}
+
+int
+MmWaveAmc::GetCqiFromFirstFailingMcs (uint8_t firstFailingMcs, bool strict, uint8_t &mcs)
+{
+  mcs = firstFailingMcs > 0 ? firstFailingMcs - 1 : 0;
+  bool failed = firstFailingMcs <= MMWAVE_MI_64QAM_MAX_ID;
+  int cqi = 0;
+  if (failed && mcs == 0)
+    {
+      cqi = 0;
+    }
+  else if (mcs == 28)
+    {
+      cqi = 15;                   // all MCSs can guarantee the 10 % of BER
+    }
+  else
+    {
+      double s = SpectralEfficiencyForMcs[mcs];
+      cqi = 0;
+      while ((cqi < 15) && ((SpectralEfficiencyForCqi[cqi + 1] < s) || (!strict && SpectralEfficiencyForCqi[cqi + 1] == s)))
+        {
+          ++cqi;
+        }
     }
   return cqi;
 }
@@ -32,6 +32,7 @@
 #include <ns3/object.h>
 #include <ns3/spectrum-value.h>
 #include <ns3/mmwave-phy-mac-common.h>
+#include <map>
 
 namespace ns3 {
 
@@ -54,6 +55,16 @@ public:
   int GetTbSizeFromMcs (unsigned mcs, unsigned nprb);
   int GetTbSizeFromMcsSymbols (unsigned mcs, unsigned nsym);        // for TDMA
   int GetNumSymbolsFromTbsMcs (unsigned tbSize, unsigned mcs);
+  /**
+   * Returns the minimum number of symbols of a slot needed to transmit a
+   * buffer with a given MCS, or all the symbols of the slot if the buffer
+   * does not fit in a slot
+   * \param mcs the MCS
+   * \param bufSize the size of the buffer in bytes
+   * \param tbSize set to the size in bytes of the TB with the returned number of symbols
+   * \return the number of symbols
+   */
+  unsigned GetMinNumSymbolsFromBufSize (unsigned mcs, unsigned bufSize, unsigned &tbSize);
   std::vector<int> CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize);
   std::vector<int> CreateCqiFeedbacksTdma (const SpectrumValue& sinr, uint8_t numSym);
   int CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t numSym, uint32_t tbs, int &mcsWb);
@@ -63,9 +74,63 @@ public:
   static const unsigned int m_crcLen = 24;
 
 private:
+  /**
+   * Builds the table of the minimum MI which guarantees a TBLER lower than
+   * 10 % for each MCS. Within each modulation, the threshold of an MCS is
+   * not lower than the thresholds of the lower MCSs, so that the MCSs which
+   * meet the target are contiguous.
+   * \param tbSizes the size in bytes of the TB for each MCS
+   * \return the MI thresholds
+   */
+  static std::vector<double> CreateMiThresholds (const std::vector<uint32_t> &tbSizes);
+
+  /**
+   * Finds the first MCS which does not guarantee a TBLER lower than 10 %,
+   * with a binary search within each modulation
+   * \param sinr the SINR
+   * \param map the RBs (or chunks) of the TB
+   * \param miThresholds the table built by CreateMiThresholds
+   * \return the first MCS which does not meet the target, or 29 if all of them do
+   */
+  static uint8_t GetFirstFailingMcs (const SpectrumValue& sinr, const std::vector<int>& map, const std::vector<double> &miThresholds);
+
+  /**
+   * Maps the first MCS which does not meet the target TBLER to the
+   * selected MCS and CQI
+   * \param firstFailingMcs the value returned by GetFirstFailingMcs
+   * \param strict if true, select the highest CQI with a spectral efficiency
+   *        strictly lower than the one of the MCS
+   * \param mcs the selected MCS
+   * \return the CQI
+   */
+  static int GetCqiFromFirstFailingMcs (uint8_t firstFailingMcs, bool strict, uint8_t &mcs);
+
+  /**
+   * Computes the TB size for an MCS and a number of symbols
+   * \param mcs the MCS
+   * \param nsymb the number of symbols
+   * \param rscElementPerSym the number of resource elements per symbol
+   * \return the TB size in bits
+   */
+  static int CalcTbSizeFromMcsSymbols (unsigned mcs, unsigned nsymb, int rscElementPerSym);
+
+  /**
+   * Builds the table of the TB sizes for each MCS and number of symbols of a
+   * slot, if it has not been built yet or if the configuration has changed
+   */
+  void UpdateTbSizeTable ();
+
   double m_ber;
   AmcModel m_amcModel;
 
+  std::map<uint8_t, std::vector<double> > m_miThresholdsRbg; //!< the MI thresholds used by CreateCqiFeedbacks, for each RBG size
+  std::map<uint8_t, std::vector<double> > m_miThresholdsSym; //!< the MI thresholds used by CreateCqiFeedbacksTdma, for each number of symbols
+  std::map<uint32_t, std::vector<double> > m_miThresholdsTbs; //!< the MI thresholds used by CreateCqiFeedbackWbTdma, for each TB size
+
+  std::vector<int> m_tbSizeTable; //!< the TB size in bits for each MCS and number of symbols between 0 and m_tbSizeTableNumSym
+  int m_tbSizeTableRscPerSym; //!< the number of resource elements per symbol used to build m_tbSizeTable
+  unsigned m_tbSizeTableNumSym; //!< the number of symbols per slot used to build m_tbSizeTable
+
   Ptr<MmWavePhyMacCommon> m_phyMacConfig;
   Ptr<SpectrumModel> m_lteRbModel;
 };
@@ -138,6 +138,15 @@ MmWaveDftBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice,
 {
   NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
 
+  // configure the antenna to use the new beamforming vector
+  m_antenna->SetBeamformingVector (GetBeamformingVectorForDevice (otherDevice, otherAntenna));
+}
+
+ThreeGppAntennaArrayModel::ComplexVector
+MmWaveDftBeamforming::GetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna)
+{
+  NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
+
   ThreeGppAntennaArrayModel::ComplexVector antennaWeights;
 
   // retrieve the position of the two devices
@@ -174,8 +183,7 @@ MmWaveDftBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice,
       antennaWeights.push_back (exp (std::complex<double> (0, phase)) * power);
     }
 
-  // configure the antenna to use the new beamforming vector
-  m_antenna->SetBeamformingVector (antennaWeights);
+  return antennaWeights;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -237,6 +245,35 @@ MmWaveSvdBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice,
 {
   NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
 
+  std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> bfVectors = GetBeamformingVectors (otherDevice, otherAntenna);
+
+  // configure the antenna to use the new beamforming vector
+  m_antenna->SetBeamformingVector (std::get<0> (bfVectors));
+  NS_LOG_LOGIC ("antenna " << m_antenna
+                           << " set BF vector"
+                           << " numAntennaElem " << m_antenna->GetNumberOfElements ()
+                           << " this device ID=" << m_device->GetNode ()->GetId ()
+                           << " otherDevice ID=" << otherDevice->GetNode ()->GetId ());
+  otherAntenna->SetBeamformingVector (std::get<1> (bfVectors));
+  NS_LOG_LOGIC ("antenna " << otherAntenna
+                           << " set BF vector"
+                           << " numAntennaElem " << otherAntenna->GetNumberOfElements ()
+                           << " this device ID=" << otherDevice->GetNode ()->GetId ()
+                           << " otherDevice ID=" << m_device->GetNode ()->GetId ());
+}
+
+ThreeGppAntennaArrayModel::ComplexVector
+MmWaveSvdBeamforming::GetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna)
+{
+  NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
+  return std::get<0> (GetBeamformingVectors (otherDevice, otherAntenna));
+}
+
+std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector>
+MmWaveSvdBeamforming::GetBeamformingVectors (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna)
+{
+  NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
+
   Ptr<MobilityModel> thisMob = m_device->GetNode ()->GetObject<MobilityModel> ();
   NS_ASSERT_MSG (thisMob, "This device " << m_device << " does not have a mobility model");
   Ptr<MobilityModel> otherMob = otherDevice->GetNode ()->GetObject<MobilityModel> ();
@@ -266,7 +303,7 @@ MmWaveSvdBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice,
 
   if (!m_useCache || toCache)
     {
-      if (channelMatrix->m_channel[0][0].size () == 0)
+      if (channelMatrix->m_channel.GetNSize () == 0)
         {
           NS_LOG_LOGIC ("Channel has no MPCs");
 
@@ -293,20 +330,6 @@ MmWaveSvdBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice,
         }
     }
 
-  // configure the antenna to use the new beamforming vector
-  m_antenna->SetBeamformingVector (std::get<0> (bfVectors));
-  NS_LOG_LOGIC ("antenna " << m_antenna
-                           << " set BF vector"
-                           << " numAntennaElem " << m_antenna->GetNumberOfElements ()
-                           << " this device ID=" << m_device->GetNode ()->GetId ()
-                           << " otherDevice ID=" << otherDevice->GetNode ()->GetId ());
-  otherAntenna->SetBeamformingVector (std::get<1> (bfVectors));
-  NS_LOG_LOGIC ("antenna " << otherAntenna
-                           << " set BF vector"
-                           << " numAntennaElem " << otherAntenna->GetNumberOfElements ()
-                           << " this device ID=" << otherDevice->GetNode ()->GetId ()
-                           << " otherDevice ID=" << m_device->GetNode ()->GetId ());
-
   if (toCache)
     {
       auto entry {m_cacheChannelMap.find (otherDevice)};
@@ -322,15 +345,17 @@ MmWaveSvdBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice,
           m_cacheBfVectors.insert (std::make_pair (otherDevice, bfVectors));
         }
     }
+
+  return bfVectors;
 }
 
 std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector>
 MmWaveSvdBeamforming::ComputeBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params) const
 {
   //generate transmitter side spatial correlation matrix
-  uint16_t aSize = params->m_channel.size ();
-  uint16_t bSize = params->m_channel[0].size ();
-  uint16_t clusterSize = params->m_channel[0][0].size ();
+  uint16_t aSize = params->m_channel.GetUSize ();
+  uint16_t bSize = params->m_channel.GetSSize ();
+  uint16_t clusterSize = params->m_channel.GetNSize ();
 
   // compute narrowband channel by summing over the cluster index
   MatrixBasedChannelModel::Complex2DVector narrowbandChannel;
@@ -341,16 +366,16 @@ MmWaveSvdBeamforming::ComputeBeamformingVectors (Ptr<const MatrixBasedChannelMod
       narrowbandChannel[aIndex].resize (bSize);
     }
 
-  for (uint16_t aIndex = 0; aIndex < aSize; aIndex++)
+  // each cluster is stored as a contiguous column-major matrix
+  for (uint16_t cIndex = 0; cIndex < clusterSize; cIndex++)
     {
+      const std::complex<double> *page = params->m_channel.GetPage (cIndex);
       for (uint16_t bIndex = 0; bIndex < bSize; bIndex++)
         {
-          std::complex<double> cSum (0, 0);
-          for (uint16_t cIndex = 0; cIndex < clusterSize; cIndex++)
+          for (uint16_t aIndex = 0; aIndex < aSize; aIndex++)
             {
-              cSum += params->m_channel[aIndex][bIndex][cIndex];
+              narrowbandChannel[aIndex][bIndex] += page[bIndex * aSize + aIndex];
             }
-          narrowbandChannel[aIndex][bIndex] = cSum;
         }
     }
 
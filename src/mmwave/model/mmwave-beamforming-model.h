@@ -88,6 +88,15 @@ public:
    */
   virtual void SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) = 0;
 
+  /**
+   * Computes the beamforming vector to communicate with the target device and antenna,
+   * without configuring any antenna
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   * \return the beamforming vector of this device
+   */
+  virtual ThreeGppAntennaArrayModel::ComplexVector GetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) = 0;
+
 protected:
   virtual void DoDispose (void) override;
 
@@ -126,6 +135,15 @@ public:
    * \param otherAntenna the target antenna of otherDevice
    */
   void SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) override;
+
+  /**
+   * Computes the DFT beamforming vector to communicate with the target
+   * device, without configuring the antenna
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   * \return the beamforming vector of this device
+   */
+  ThreeGppAntennaArrayModel::ComplexVector GetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) override;
 };
 
 
@@ -163,8 +181,27 @@ public:
    */
   void SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) override;
 
+  /**
+   * Computes the SVD beamforming vector to communicate with the target
+   * device, without configuring the antennas
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   * \return the beamforming vector of this device
+   */
+  ThreeGppAntennaArrayModel::ComplexVector GetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) override;
+
 private:
   void DoDispose (void) override;
+
+  /**
+   * Computes the beamforming vectors of this device and of the target
+   * device, using the cached vectors if the channel did not change
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   * \return a pair with the beamforming vectors of this device and of the target device
+   */
+  std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> GetBeamformingVectors (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna);
+
   /**
    * Compute the beamforming vectors using SVD
    * \param params the channel matrix
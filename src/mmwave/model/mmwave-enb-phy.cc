@@ -54,6 +54,7 @@
 #include <ns3/pointer.h>
 #include <math.h>
 #include <ns3/random-variable-stream.h>
+#include <ns3/three-gpp-spectrum-propagation-loss-model.h>
 #include <complex.h>
 
 #include <iostream>
@@ -81,10 +82,12 @@ MmWaveEnbPhy::MmWaveEnbPhy (Ptr<MmWaveSpectrumPhy> dlPhy, Ptr<MmWaveSpectrumPhy>
   : MmWavePhy (dlPhy, ulPhy),
   m_prevSlot (0),
   m_prevTtiDir (TtiAllocInfo::NA),
-  m_currSymStart (0)
+  m_currSymStart (0),
+  m_coalescedSlotTiming (false)
 {
   m_enbCphySapProvider = new MemberLteEnbCphySapProvider<MmWaveEnbPhy> (this);
   m_roundFromLastUeSinrUpdate = 0;
+  m_sinrNoiseFigure = 0;
   Simulator::ScheduleNow (&MmWaveEnbPhy::StartSlot, this);
 }
 
@@ -157,6 +160,12 @@ MmWaveEnbPhy::GetTypeId (void)
                      "Report the allocation info for the current DL transmission",
                      MakeTraceSourceAccessor (&MmWaveEnbPhy::m_dlPhyTrace),
                      "ns3::DlPhyTransmission::TracedCallback")
+    .AddAttribute ("CoalescedSlotTiming",
+                   "If true, each TTI schedules the start of the next one (or the end of the slot) "
+                   "directly from the allocation of the slot, instead of going through an EndTti event",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveEnbPhy::m_coalescedSlotTiming),
+                   MakeBooleanChecker ())
 
   ;
   return tid;
@@ -560,6 +569,7 @@ void
 MmWaveEnbPhy::SetSubChannels (std::vector<int> mask )
 {
   m_listOfSubchannels = mask;
+  m_sinrTxPsdMap.clear ();
   Ptr<SpectrumValue> txPsd = CreateTxPowerSpectralDensity ();
   NS_ASSERT (txPsd);
   m_downlinkSpectrumPhy->SetTxPowerSpectralDensity (txPsd);
@@ -585,10 +595,26 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
   m_sinrMap.clear ();
   m_rxPsdMap.clear ();
 
-
-  Ptr<SpectrumValue> noisePsd = MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
+  // the noise PSD only depends on the noise figure and on the configuration,
+  // recompute it only if the noise figure changed
+  if (m_sinrNoisePsd == 0 || m_sinrNoiseFigure != m_noiseFigure)
+    {
+      m_sinrNoisePsd = MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
+      m_sinrNoiseFigure = m_noiseFigure;
+    }
+  Ptr<SpectrumValue> noisePsd = m_sinrNoisePsd;
   Ptr<SpectrumValue> totalReceivedPsd = Create <SpectrumValue> (SpectrumValue (noisePsd->GetSpectrumModel ()));
 
+  // if the 3GPP model is used, the gain is computed for the beams the
+  // devices would use, without reconfiguring their antennas. The pairs are
+  // not evaluated in a single batch across the cells: the channel matrix of
+  // each pair is already cached by the channel model, the long term component
+  // depends on the beams of both devices of the pair, and each eNB updates its
+  // estimate on its own schedule, so batching would not save any computation
+  Ptr<ThreeGppSpectrumPropagationLossModel> threeGppSplm = DynamicCast<ThreeGppSpectrumPropagationLossModel> (m_spectrumPropagationLossModel);
+  Ptr<MobilityModel> enbMob = m_netDevice->GetNode ()->GetObject<MobilityModel> ();
+  NS_LOG_LOGIC ("eNB mobility " << enbMob->GetPosition ());
+
   for (std::map<uint64_t, Ptr<NetDevice> >::iterator ue = m_ueAttachedImsiMap.begin (); ue != m_ueAttachedImsiMap.end (); ++ue)
     {
       // distinguish between MC and MmWaveNetDevice
@@ -613,29 +639,28 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
           NS_FATAL_ERROR ("Unrecognized device");
         }
       NS_LOG_LOGIC ("UE Tx power = " << ueTxPower);
-      double powerTxW = std::pow (10., (ueTxPower - 30) / 10);
-      double txPowerDensity = 0;
-      txPowerDensity = (powerTxW / (m_phyMacConfig->GetBandwidth ()));
-      NS_LOG_LOGIC ("Linear UE Tx power = " << powerTxW);
-      NS_LOG_LOGIC ("System bandwidth = " << m_phyMacConfig->GetBandwidth ());
-      NS_LOG_LOGIC ("txPowerDensity = " << txPowerDensity);
-      // create tx psd
-      Ptr<SpectrumValue> txPsd =                                                        // it is the eNB that dictates the conf, m_listOfSubchannels contains all the subch
-        MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (m_phyMacConfig, ueTxPower, m_listOfSubchannels);
+
+      // create tx psd, the template is shared by the UEs with the same tx power
+      Ptr<SpectrumValue> txPsd;
+      std::map<double, Ptr<SpectrumValue> >::const_iterator txPsdIt = m_sinrTxPsdMap.find (ueTxPower);
+      if (txPsdIt != m_sinrTxPsdMap.end ())
+        {
+          txPsd = txPsdIt->second;
+        }
+      else
+        {
+          // it is the eNB that dictates the conf, m_listOfSubchannels contains all the subch
+          txPsd = MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (m_phyMacConfig, ueTxPower, m_listOfSubchannels);
+          m_sinrTxPsdMap[ueTxPower] = txPsd;
+        }
       NS_LOG_LOGIC ("TxPsd " << *txPsd);
 
-      // get this node and remote node mobility
-      Ptr<MobilityModel> enbMob = m_netDevice->GetNode ()->GetObject<MobilityModel> ();
-      NS_LOG_LOGIC ("eNB mobility " << enbMob->GetPosition ());
+      // get remote node mobility
       Ptr<MobilityModel> ueMob = ue->second->GetNode ()->GetObject<MobilityModel> ();
       NS_LOG_DEBUG ("UE mobility " << ueMob->GetPosition ());
 
       // compute rx psd
 
-      // adjuts beamforming of antenna model wrt user
-      m_downlinkSpectrumPhy->ConfigureBeamforming (ue->second);
-      uePhy->GetDlSpectrumPhy ()->ConfigureBeamforming (m_netDevice);
-
       // TODO remove, the antenna gains are taken into account by the channel
       // model. Should we support other kinds of antennas?
       Ptr<AntennaModel> rxAntenna = GetDlSpectrumPhy ()->GetRxAntenna ();
@@ -667,32 +692,40 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
       Ptr<SpectrumValue> rxPsd = txPsd->Copy ();
       *(rxPsd) *= pathGainLinear;
 
-      rxPsd = m_spectrumPropagationLossModel->CalcRxPowerSpectralDensity (rxPsd, ueMob, enbMob);
-      NS_LOG_LOGIC ("RxPsd " << *rxPsd);
+      if (threeGppSplm)
+        {
+          ThreeGppAntennaArrayModel::ComplexVector enbW = m_downlinkSpectrumPhy->GetBeamformingVectorForDevice (ue->second);
+          ThreeGppAntennaArrayModel::ComplexVector ueW = uePhy->GetDlSpectrumPhy ()->GetBeamformingVectorForDevice (m_netDevice);
+          rxPsd = threeGppSplm->CalcRxPowerSpectralDensityForBeams (rxPsd, ueMob, enbMob, ueW, enbW);
+        }
+      else
+        {
+          // adjuts beamforming of antenna model wrt user
+          m_downlinkSpectrumPhy->ConfigureBeamforming (ue->second);
+          uePhy->GetDlSpectrumPhy ()->ConfigureBeamforming (m_netDevice);
 
-      m_rxPsdMap[ue->first] = rxPsd;
-      *totalReceivedPsd += *rxPsd;
+          rxPsd = m_spectrumPropagationLossModel->CalcRxPowerSpectralDensity (rxPsd, ueMob, enbMob);
 
-      // set back the bf vector to the main eNB
-      if (ueNetDevice != 0)
-        {                                                                                                                       // target not set yet
-          if ((ueNetDevice->GetTargetEnb () != m_netDevice) && (ueNetDevice->GetTargetEnb () != 0))
-            {
-              uePhy->GetDlSpectrumPhy ()->ConfigureBeamforming (ueNetDevice->GetTargetEnb ());
+          // set back the bf vector to the main eNB
+          if (ueNetDevice != 0)
+            {                                                                                                                       // target not set yet
+              if ((ueNetDevice->GetTargetEnb () != m_netDevice) && (ueNetDevice->GetTargetEnb () != 0))
+                {
+                  uePhy->GetDlSpectrumPhy ()->ConfigureBeamforming (ueNetDevice->GetTargetEnb ());
+                }
             }
-        }
-      else if (mcUeDev != 0)           // it may be a MC device
-        {                                                                                                                               // target not set yet
-          if ((mcUeDev->GetMmWaveTargetEnb () != m_netDevice) && (mcUeDev->GetMmWaveTargetEnb () != 0))
-            {
-              uePhy->GetDlSpectrumPhy ()->ConfigureBeamforming (mcUeDev->GetMmWaveTargetEnb ());
+          else if (mcUeDev != 0)           // it may be a MC device
+            {                                                                                                                               // target not set yet
+              if ((mcUeDev->GetMmWaveTargetEnb () != m_netDevice) && (mcUeDev->GetMmWaveTargetEnb () != 0))
+                {
+                  uePhy->GetDlSpectrumPhy ()->ConfigureBeamforming (mcUeDev->GetMmWaveTargetEnb ());
+                }
             }
         }
-      else
-        {
-          NS_FATAL_ERROR ("Unrecognized device");
-        }
+      NS_LOG_LOGIC ("RxPsd " << *rxPsd);
 
+      m_rxPsdMap[ue->first] = rxPsd;
+      *totalReceivedPsd += *rxPsd;
     }
 
   for (std::map<uint64_t, Ptr<SpectrumValue> >::iterator ue = m_rxPsdMap.begin (); ue != m_rxPsdMap.end (); ++ue)
@@ -1102,7 +1135,33 @@ MmWaveEnbPhy::StartTti (void)
   NS_ASSERT (m_ttiIndex != 0 || currTti.m_dci.m_symStart == m_ttiIndex);
   m_phySapUser->SlotIndication (SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));  // trigger MAC
 
-  Simulator::Schedule (ttiPeriod, &MmWaveEnbPhy::EndTti, this);
+  if (m_coalescedSlotTiming)
+    {
+      // the allocation of the slot is fixed at its start, hence the next
+      // TTI boundary is already known and EndTti can be skipped
+      if (m_ttiIndex == m_currSlotNumTti - 1)
+        {
+          Simulator::Schedule (MmWavePhy::GetNextSlotDelay (), &MmWaveEnbPhy::EndSlot, this);
+        }
+      else
+        {
+          Time nextTtiStart = m_phyMacConfig->GetSymbolPeriod () *
+                                           m_currSlotAllocInfo.m_ttiAllocInfo[m_ttiIndex + 1].m_dci.m_symStart;
+          Simulator::Schedule (nextTtiStart + m_lastSlotStart - Simulator::Now (), &MmWaveEnbPhy::StartNextTti, this);
+        }
+    }
+  else
+    {
+      Simulator::Schedule (ttiPeriod, &MmWaveEnbPhy::EndTti, this);
+    }
+}
+
+void
+MmWaveEnbPhy::StartNextTti (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_ttiIndex++;
+  StartTti ();
 }
 
 void
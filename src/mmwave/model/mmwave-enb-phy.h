@@ -44,6 +44,8 @@
 #include <ns3/lte-enb-cphy-sap.h>
 #include <ns3/mmwave-harq-phy.h>
 
+class MmWaveSinrEstimateTestCase;
+
 namespace ns3 {
 
 typedef std::pair<uint64_t, uint64_t > pairDevices_t;
@@ -59,6 +61,8 @@ class MmWaveEnbMac;
 class MmWaveEnbPhy : public MmWavePhy
 {
   friend class MemberLteEnbCphySapProvider<MmWaveEnbPhy>;
+  /// Allow the test case of the SINR estimate to access private members
+  friend class ::MmWaveSinrEstimateTestCase;
 public:
   MmWaveEnbPhy ();
 
@@ -122,6 +126,15 @@ public:
    */
   void EndSlot (void);
 
+  /**
+   * Moves to the next TTI of the current slot and starts it.
+   *
+   * Used in place of \ref EndTti when the CoalescedSlotTiming attribute is set: the TTIs of the slot
+   * are then started directly one after the other, following the allocation of the slot.
+   *
+   */
+  void StartNextTti (void);
+
   SlotAllocInfo m_currSlotAllocInfo;  //!< Holds the allocation info for the current NR slot
 
   void SendDataChannels (Ptr<PacketBurst> pb, Time slotPrd, TtiAllocInfo& slotInfo);
@@ -215,6 +228,9 @@ private:
   std::map <uint64_t, Ptr<NetDevice> > m_ueAttachedImsiMap;
   std::map <uint64_t, double > m_sinrMap;
   std::map <uint64_t, Ptr<SpectrumValue> > m_rxPsdMap;
+  Ptr<SpectrumValue> m_sinrNoisePsd;       // the noise PSD used for the SINR estimate
+  double m_sinrNoiseFigure;       // the noise figure used to compute m_sinrNoisePsd
+  std::map <double, Ptr<SpectrumValue> > m_sinrTxPsdMap;       // the UE tx PSD used for the SINR estimate, for each tx power
   std::map <pairDevices_t, std::vector<double> > m_sinrVector;        // array containing all SINR values for a specific pair (UE-eNB)
   std::map <pairDevices_t, std::vector<double> > m_sinrVectorToFilter;        // array containing the  SINR values that must be filtered
   std::map <pairDevices_t, std::vector<double> > m_sinrVectorNoisy;        // array containing the  noisy SINR values that must be filteredF
@@ -236,6 +252,8 @@ private:
   TracedCallback< uint64_t, SpectrumValue&, SpectrumValue& > m_ulSinrTrace;
 
   TracedCallback<PhyTransmissionTraceParams> m_dlPhyTrace;   //!< Traces the current TTI allocation info, from the eNB side
+
+  bool m_coalescedSlotTiming;     //!< If true, skip the EndTti events and chain the TTIs of the slot directly
 };
 
 } // namespace mmwave
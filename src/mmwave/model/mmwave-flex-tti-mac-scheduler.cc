@@ -337,13 +337,13 @@ MmWaveFlexTtiMacScheduler::DoSchedDlCqiInfoReq (const struct MmWaveMacSchedSapPr
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint8_t>::iterator it;
+  MmWaveRntiTable<uint8_t>::iterator it;
   for (unsigned int i = 0; i < params.m_cqiList.size (); i++)
     {
       if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::WB )
         {
           // wideband CQI reporting
-          std::map <uint16_t,uint8_t>::iterator it;
+          MmWaveRntiTable<uint8_t>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
           it = m_wbCqiRxed.find (rnti);
           if (it == m_wbCqiRxed.end ())
@@ -358,7 +358,7 @@ MmWaveFlexTtiMacScheduler::DoSchedDlCqiInfoReq (const struct MmWaveMacSchedSapPr
               // update the CQI value
               (*it).second = params.m_cqiList.at (i).m_wbCqi;
               // update correspondent timer
-              std::map <uint16_t,uint32_t>::iterator itTimers;
+              MmWaveRntiTable<uint32_t>::iterator itTimers;
               itTimers = m_wbCqiTimers.find (rnti);
               (*itTimers).second = m_cqiTimersThreshold;
             }
@@ -391,7 +391,7 @@ MmWaveFlexTtiMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapPr
     case UlCqiInfo::PUSCH:
       {
         std::map <uint32_t, struct AllocMapElem>::iterator itMap;
-        std::map <uint16_t, struct UlCqiMapElem>::iterator itCqi;
+        MmWaveRntiTable<struct UlCqiMapElem>::iterator itCqi;
         itMap = m_ulAllocationMap.find (params.m_sfnSf.Encode ());
         if (itMap == m_ulAllocationMap.end ())
           {
@@ -435,7 +435,7 @@ MmWaveFlexTtiMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapPr
                 (*itCqi).second.m_numSym = itMap->second.m_numSym;
                 (*itCqi).second.m_tbSize = itMap->second.m_tbSize;
                 // update correspondent timer
-                std::map <uint16_t, uint32_t>::iterator itTimers;
+                MmWaveRntiTable<uint32_t>::iterator itTimers;
                 itTimers = m_ueCqiTimers.find (itMap->second.m_rntiPerChunk.at (i));
                 (*itTimers).second = m_cqiTimersThreshold;
 
@@ -461,7 +461,7 @@ MmWaveFlexTtiMacScheduler::RefreshHarqProcesses ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itTimers;
+  MmWaveRntiTable<DlHarqProcessesTimer_t>::iterator itTimers;
   for (itTimers = m_dlHarqProcessesTimer.begin (); itTimers != m_dlHarqProcessesTimer.end (); itTimers++)
     {
       for (uint16_t i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
@@ -469,7 +469,7 @@ MmWaveFlexTtiMacScheduler::RefreshHarqProcesses ()
           if ((*itTimers).second.at (i) == m_phyMacConfig->GetHarqTimeout ())
             {             // reset HARQ process
               NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers).first);
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
+              MmWaveRntiTable<DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
               if (itStat == m_dlHarqProcessesStatus.end ())
                 {
                   NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers).first);
@@ -484,7 +484,7 @@ MmWaveFlexTtiMacScheduler::RefreshHarqProcesses ()
         }
     }
 
-  std::map <uint16_t, UlHarqProcessesTimer_t>::iterator itTimers2;
+  MmWaveRntiTable<UlHarqProcessesTimer_t>::iterator itTimers2;
   for (itTimers2 = m_ulHarqProcessesTimer.begin (); itTimers2 != m_ulHarqProcessesTimer.end (); itTimers2++)
     {
       for (uint16_t i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
@@ -492,7 +492,7 @@ MmWaveFlexTtiMacScheduler::RefreshHarqProcesses ()
           if ((*itTimers2).second.at (i) == m_phyMacConfig->GetHarqTimeout ())
             {             // reset HARQ process
               NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers2).first);
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find ((*itTimers2).first);
+              MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find ((*itTimers2).first);
               if (itStat == m_ulHarqProcessesStatus.end ())
                 {
                   NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers2).first);
@@ -527,7 +527,7 @@ MmWaveFlexTtiMacScheduler::UpdateDlHarqProcessId (uint16_t rnti)
 //	{
 //		NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
 //	}
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
+  MmWaveRntiTable<DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
   if (itStat == m_dlHarqProcessesStatus.end ())
     {
       NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
@@ -582,7 +582,7 @@ MmWaveFlexTtiMacScheduler::UpdateUlHarqProcessId (uint16_t rnti)
 //	{
 //		NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
 //	}
-  std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
+  MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
   if (itStat == m_ulHarqProcessesStatus.end ())
     {
       NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
@@ -602,57 +602,6 @@ MmWaveFlexTtiMacScheduler::UpdateUlHarqProcessId (uint16_t rnti)
   return harqId;
 }
 
-unsigned MmWaveFlexTtiMacScheduler::CalcMinTbSizeNumSym (unsigned mcs, unsigned bufSize, unsigned &tbSize)
-{
-  // Bisection line search is used to find the minimum number of slots (OFDM symbols)
-  // needed to encode entire buffer.
-  MmWaveMacPduHeader dummyMacHeader;
-  //unsigned macHdrSize = 10; //dummyMacHeader.GetSerializedSize ();
-  int numSymLow = 0;
-  int numSymHigh = m_phyMacConfig->GetSymbPerSlot ();
-
-  int diff = 0;
-  tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8); // start with max value, in number of bytes
-  while ((unsigned)tbSize > bufSize)
-  {
-      diff = abs(numSymHigh-numSymLow)/2;
-      if (diff == 0)
-      {
-          tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-          return numSymHigh;
-      }
-      tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh - diff) / 8);
-      if ((unsigned)tbSize >= bufSize)
-      {
-          numSymHigh -= diff;
-      }
-      if ((unsigned) tbSize == bufSize)
-      {
-          return numSymHigh;
-      }
-      while ((unsigned)tbSize < bufSize)
-      {
-          diff = abs(numSymHigh-numSymLow)/2;
-          if (diff == 0)
-          {
-              tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-              return numSymHigh;
-          }
-          tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymLow + diff) / 8);
-          if ((unsigned)tbSize <= bufSize)
-          {
-              numSymLow += diff;
-          }
-          if ((unsigned) tbSize == bufSize)
-          {
-              return numSymLow;
-          }
-      }
-  }
-  tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-  return (unsigned)numSymHigh;
-}
-
 void
 MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
 {
@@ -690,8 +639,10 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
   // number of DL/UL flows for new transmissions (not HARQ RETX)
   int nFlowsDl = 0;
   int nFlowsUl = 0;
-  std::map <uint16_t, struct UeSchedInfo> ueInfo;
-  std::map <uint16_t, struct UeSchedInfo>::iterator itUeInfo;
+  // the table is reused across slots to avoid reallocating it
+  MmWaveRntiTable<struct UeSchedInfo> &ueInfo = m_ueSchedInfo;
+  ueInfo.clear ();
+  MmWaveRntiTable<struct UeSchedInfo>::iterator itUeInfo;
   std::list<MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itRlcBuf;
 
   // retrieve past HARQ retx buffered
@@ -731,12 +682,12 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
           uint8_t harqId = m_dlHarqInfoList.at (i).m_harqProcessId;
           uint16_t rnti = m_dlHarqInfoList.at (i).m_rnti;
           itUeInfo = ueInfo.find (rnti);
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
+          MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
           if (itStat == m_dlHarqProcessesStatus.end ())
             {
               NS_FATAL_ERROR ("No HARQ status info found for UE " << rnti);
             }
-          std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (rnti);
+          MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (rnti);
           if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
             {
               NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << m_dlHarqInfoList.at (i).m_rnti);
@@ -753,7 +704,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
             }
           else if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::NACK)
             {
-              std::map <uint16_t, DlHarqProcessesDciInfoList_t>::iterator itHarq = m_dlHarqProcessesDciInfoMap.find (rnti);
+              MmWaveRntiTable<DlHarqProcessesDciInfoList_t>::iterator itHarq = m_dlHarqProcessesDciInfoMap.find (rnti);
               if (itHarq == m_dlHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("No DCI/HARQ buffer entry found for UE " << rnti);
@@ -850,7 +801,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
                                 " rv " << (unsigned)dciInfoReTx.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum << " slot " <<
                                 (unsigned)ret.m_sfnSf.m_slotNum << " RETX");
 
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcList =  m_dlHarqProcessesRlcPduMap.find (rnti);
+                  MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcList =  m_dlHarqProcessesRlcPduMap.find (rnti);
                   if (itRlcList == m_dlHarqProcessesRlcPduMap.end ())
                     {
                       NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << rnti);
@@ -889,7 +840,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
           uint8_t harqId = harqInfo.m_harqProcessId;
           uint16_t rnti = harqInfo.m_rnti;
           itUeInfo = ueInfo.find (rnti);
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
+          MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
           if (itStat == m_ulHarqProcessesStatus.end ())
             {
               NS_LOG_ERROR ("No info found in HARQ buffer for UE (might have changed eNB) " << rnti);
@@ -904,7 +855,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
             }
           else if (harqInfo.m_receptionStatus == UlHarqInfo::NotOk)
             {
-              std::map <uint16_t, UlHarqProcessesDciInfoList_t>::iterator itHarq = m_ulHarqProcessesDciInfoMap.find (rnti);
+              MmWaveRntiTable<UlHarqProcessesDciInfoList_t>::iterator itHarq = m_ulHarqProcessesDciInfoMap.find (rnti);
               if (itHarq == m_ulHarqProcessesDciInfoMap.end ())
                 {
                   NS_LOG_ERROR ("No info found in UL-HARQ buffer for UE (might have changed eNB) " << rnti);
@@ -975,7 +926,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
             {
               NS_LOG_INFO (this << " User " << itRlcBuf->m_rnti << " LC " << (uint16_t)itRlcBuf->m_logicalChannelIdentity << " is active, status  "
                            << (*itRlcBuf).m_rlcStatusPduSize << " retx " << (*itRlcBuf).m_rlcRetransmissionQueueSize << " tx " << (*itRlcBuf).m_rlcTransmissionQueueSize);
-              std::map <uint16_t,uint8_t>::iterator itCqi = m_wbCqiRxed.find (itRlcBuf->m_rnti);
+              MmWaveRntiTable<uint8_t>::iterator itCqi = m_wbCqiRxed.find (itRlcBuf->m_rnti);
               uint8_t cqi = 0;
               if (itCqi != m_wbCqiRxed.end ())
                 {
@@ -1050,12 +1001,12 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
   // get info on active UL flows
   if (symAvail > 0 && !m_dlOnly)        // remaining symbols in future UL subframe after HARQ retx sched
     {
-      std::map <uint16_t,uint32_t>::iterator ceBsrIt;
+      MmWaveRntiTable<uint32_t>::iterator ceBsrIt;
       for (ceBsrIt = m_ceBsrRxed.begin (); ceBsrIt != m_ceBsrRxed.end (); ceBsrIt++)
         {
           if (ceBsrIt->second > 0)                // UL buffer size > 0
             {
-              std::map <uint16_t, struct UlCqiMapElem>::iterator itCqi = m_ueUlCqi.find (ceBsrIt->first);
+              MmWaveRntiTable<struct UlCqiMapElem>::iterator itCqi = m_ueUlCqi.find (ceBsrIt->first);
               int cqi = 0;
               int mcs = 0;
               if (itCqi == m_ueUlCqi.end ())                   // no cqi info for this UE
@@ -1129,7 +1080,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
       unsigned ulTbSize = 0;
       if (itUeInfo->second.m_maxDlBufSize > 0)
         {
-          itUeInfo->second.m_maxDlSymbols = CalcMinTbSizeNumSym (itUeInfo->second.m_dlMcs, itUeInfo->second.m_maxDlBufSize, dlTbSize);
+          itUeInfo->second.m_maxDlSymbols = m_amc->GetMinNumSymbolsFromBufSize (itUeInfo->second.m_dlMcs, itUeInfo->second.m_maxDlBufSize, dlTbSize);
           itUeInfo->second.m_maxDlBufSize = dlTbSize;
           if (m_fixedTti)
             {
@@ -1139,7 +1090,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
         }
       if (itUeInfo->second.m_maxUlBufSize > 0)
         {
-          itUeInfo->second.m_maxUlSymbols = CalcMinTbSizeNumSym (itUeInfo->second.m_ulMcs, itUeInfo->second.m_maxUlBufSize + 10, ulTbSize);
+          itUeInfo->second.m_maxUlSymbols = m_amc->GetMinNumSymbolsFromBufSize (itUeInfo->second.m_ulMcs, itUeInfo->second.m_maxUlBufSize + 10, ulTbSize);
           itUeInfo->second.m_maxUlBufSize = ulTbSize;
           if (m_fixedTti)
             {
@@ -1149,7 +1100,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
         }
     }
 
-  std::map <uint16_t, struct UeSchedInfo>::iterator itUeInfoStart;
+  MmWaveRntiTable<struct UeSchedInfo>::iterator itUeInfoStart;
   if (m_nextRnti != 0)          // start with RNTI at which the scheduler left off
     {
       itUeInfoStart = ueInfo.find (m_nextRnti);
@@ -1342,14 +1293,14 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
 
           if (m_harqOn == true)
             {                   // store DCI for HARQ buffer
-              std::map <uint16_t, DlHarqProcessesDciInfoList_t>::iterator itDciInfo = m_dlHarqProcessesDciInfoMap.find (dci.m_rnti);
+              MmWaveRntiTable<DlHarqProcessesDciInfoList_t>::iterator itDciInfo = m_dlHarqProcessesDciInfoMap.find (dci.m_rnti);
               if (itDciInfo == m_dlHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find RNTI entry in DCI HARQ buffer for RNTI " << dci.m_rnti);
                 }
               (*itDciInfo).second.at (dci.m_harqProcess) = dci;
               // refresh timer
-              std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (dci.m_rnti);
+              MmWaveRntiTable<DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (dci.m_rnti);
               if (itHarqTimer == m_dlHarqProcessesTimer.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)dci.m_rnti);
@@ -1401,7 +1352,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
               if (m_harqOn == true)
                 {
                   // store RLC PDU list for HARQ
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
+                  MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
                   if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
                     {
                       NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << dci.m_rnti);
@@ -1478,17 +1429,17 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
           if (m_harqOn == true)
             {
               uint8_t harqId = dci.m_harqProcess;
-              std::map <uint16_t, UlHarqProcessesDciInfoList_t>::iterator itHarqTbInfo = m_ulHarqProcessesDciInfoMap.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesDciInfoList_t>::iterator itHarqTbInfo = m_ulHarqProcessesDciInfoMap.find (dci.m_rnti);
               if (itHarqTbInfo == m_ulHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << dci.m_rnti);
                 }
               (*itHarqTbInfo).second.at (harqId) = dci;
               // Update HARQ process status (RV 0)
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (dci.m_rnti);
               NS_ASSERT (itStat->second[dci.m_harqProcess] > 0);
               // refresh timer
-              std::map <uint16_t, UlHarqProcessesTimer_t>::iterator itHarqTimer =  m_ulHarqProcessesTimer.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesTimer_t>::iterator itHarqTimer =  m_ulHarqProcessesTimer.find (dci.m_rnti);
               if (itHarqTimer == m_ulHarqProcessesTimer.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)dci.m_rnti);
@@ -1519,7 +1470,7 @@ MmWaveFlexTtiMacScheduler::DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSchedS
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint32_t>::iterator it;
+  MmWaveRntiTable<uint32_t>::iterator it;
 
   for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
     {
@@ -1581,20 +1532,19 @@ MmWaveFlexTtiMacScheduler::RefreshDlCqiMaps (void)
 {
   NS_LOG_FUNCTION (this << m_wbCqiTimers.size ());
   // refresh DL CQI P01 Map
-  std::map <uint16_t,uint32_t>::iterator itP10 = m_wbCqiTimers.begin ();
+  MmWaveRntiTable<uint32_t>::iterator itP10 = m_wbCqiTimers.begin ();
   while (itP10 != m_wbCqiTimers.end ())
     {
       NS_LOG_INFO (this << " P10-CQI for user " << (*itP10).first << " is " << (uint32_t)(*itP10).second << " thr " << (uint32_t)m_cqiTimersThreshold);
       if ((*itP10).second == 0)
         {
           // delete correspondent entries
-          std::map <uint16_t,uint8_t>::iterator itMap = m_wbCqiRxed.find ((*itP10).first);
+          MmWaveRntiTable<uint8_t>::iterator itMap = m_wbCqiRxed.find ((*itP10).first);
           NS_ASSERT_MSG (itMap != m_wbCqiRxed.end (), " Does not find CQI report for user " << (*itP10).first);
           NS_LOG_INFO (this << " P10-CQI exired for user " << (*itP10).first);
           m_wbCqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itP10;
-          itP10++;
-          m_wbCqiTimers.erase (temp);
+          // the erasure invalidates the iterators, erase returns the next entry
+          itP10 = m_wbCqiTimers.erase (itP10);
         }
       else
         {
@@ -1611,21 +1561,20 @@ void
 MmWaveFlexTtiMacScheduler::RefreshUlCqiMaps (void)
 {
   // refresh UL CQI  Map
-  std::map <uint16_t,uint32_t>::iterator itUl = m_ueCqiTimers.begin ();
+  MmWaveRntiTable<uint32_t>::iterator itUl = m_ueCqiTimers.begin ();
   while (itUl != m_ueCqiTimers.end ())
     {
       NS_LOG_INFO (this << " UL-CQI for user " << (*itUl).first << " is " << (uint32_t)(*itUl).second << " thr " << (uint32_t)m_cqiTimersThreshold);
       if ((*itUl).second == 0)
         {
           // delete correspondent entries
-          std::map <uint16_t, struct UlCqiMapElem>::iterator itMap = m_ueUlCqi.find ((*itUl).first);
+          MmWaveRntiTable<struct UlCqiMapElem>::iterator itMap = m_ueUlCqi.find ((*itUl).first);
           NS_ASSERT_MSG (itMap != m_ueUlCqi.end (), " Does not find CQI report for user " << (*itUl).first);
           NS_LOG_INFO (this << " UL-CQI expired for user " << (*itUl).first);
           itMap->second.m_ueUlCqi.clear ();
           m_ueUlCqi.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itUl;
-          itUl++;
-          m_ueCqiTimers.erase (temp);
+          // the erasure invalidates the iterators, erase returns the next entry
+          itUl = m_ueCqiTimers.erase (itUl);
         }
       else
         {
@@ -1701,7 +1650,7 @@ MmWaveFlexTtiMacScheduler::UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size)
 {
 
   size = size - 2; // remove the minimum RLC overhead
-  std::map <uint16_t,uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
+  MmWaveRntiTable<uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
   if (it != m_ceBsrRxed.end ())
     {
       NS_LOG_INFO (this << " Update RLC BSR UE " << rnti << " size " << size << " BSR " << (*it).second);
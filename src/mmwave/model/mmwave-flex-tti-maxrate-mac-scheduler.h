@@ -13,6 +13,7 @@
 #include "mmwave-mac-csched-sap.h"
 #include "mmwave-mac-scheduler.h"
 #include "mmwave-amc.h"
+#include "mmwave-rnti-table.h"
 #include "string"
 #include <vector>
 #include <set>
@@ -213,8 +214,6 @@ private:
   }
 
 
-  unsigned CalcMinTbSizeNumSym (unsigned mcs, unsigned bufSize, unsigned &tbSize);
-
   uint32_t
   BsrId2BufferSize (uint8_t val)
   {
@@ -304,11 +303,11 @@ private:
   /*
    * Map of UE's DL CQI WB received
    */
-  std::map <uint16_t,uint8_t> m_wbCqiRxed;
+  MmWaveRntiTable<uint8_t> m_wbCqiRxed;
   /*
    * Map of UE's timers on DL CQI WB received
    */
-  std::map <uint16_t,uint32_t> m_wbCqiTimers;
+  MmWaveRntiTable<uint32_t> m_wbCqiTimers;
 
   uint32_t m_cqiTimersThreshold;       // # of TTIs for which a CQI can be considered valid
 
@@ -317,6 +316,11 @@ private:
    */
   struct UlCqiMapElem
   {
+    UlCqiMapElem ()
+      : m_numSym (0),
+        m_tbSize (0)
+    {
+    }
     UlCqiMapElem (std::vector<double> ulCqi, uint8_t nSym, uint32_t tbs)
       : m_ueUlCqi (ulCqi),
         m_numSym (nSym),
@@ -328,16 +332,16 @@ private:
     uint32_t        m_tbSize;
   };
 
-  std::map <uint16_t, struct UlCqiMapElem> m_ueUlCqi;
+  MmWaveRntiTable<struct UlCqiMapElem> m_ueUlCqi;
   /*
    * Map of UEs' timers on UL-CQI per RBG
    */
-  std::map <uint16_t, uint32_t> m_ueCqiTimers;
+  MmWaveRntiTable<uint32_t> m_ueCqiTimers;
 
   /*
    * Map of UE's buffer status reports received
    */
-  std::map <uint16_t,uint32_t> m_ceBsrRxed;
+  MmWaveRntiTable<uint32_t> m_ceBsrRxed;
 
   uint16_t m_nextRnti;
   uint64_t m_nextRntiDl;
@@ -382,24 +386,24 @@ private:
   uint8_t m_numHarqProcess;
   uint8_t m_harqTimeout;
 
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId;
+  MmWaveRntiTable<uint8_t> m_dlHarqCurrentProcessId;
   //HARQ status
   // 0: process Id available
   // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus;
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;
-  std::map <uint16_t, DlHarqProcessesDciInfoList_t> m_dlHarqProcessesDciInfoMap;
-  std::map <uint16_t, DlHarqRlcPduList_t> m_dlHarqProcessesRlcPduMap;
+  MmWaveRntiTable<DlHarqProcessesStatus_t> m_dlHarqProcessesStatus;
+  MmWaveRntiTable<DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;
+  MmWaveRntiTable<DlHarqProcessesDciInfoList_t> m_dlHarqProcessesDciInfoMap;
+  MmWaveRntiTable<DlHarqRlcPduList_t> m_dlHarqProcessesRlcPduMap;
   std::vector <DlHarqInfo> m_dlHarqInfoList;       // HARQ retx buffered
   std::vector <UlHarqInfo> m_ulHarqInfoList;       // HARQ retx buffered
 
-  std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId;
+  MmWaveRntiTable<uint8_t> m_ulHarqCurrentProcessId;
   //HARQ status
   // 0: process Id available
   // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, UlHarqProcessesStatus_t>    m_ulHarqProcessesStatus;
-  std::map <uint16_t, UlHarqProcessesTimer_t>     m_ulHarqProcessesTimer;
-  std::map <uint16_t, UlHarqProcessesDciInfoList_t> m_ulHarqProcessesDciInfoMap;
+  MmWaveRntiTable<UlHarqProcessesStatus_t>    m_ulHarqProcessesStatus;
+  MmWaveRntiTable<UlHarqProcessesTimer_t>     m_ulHarqProcessesTimer;
+  MmWaveRntiTable<UlHarqProcessesDciInfoList_t> m_ulHarqProcessesDciInfoMap;
 
   // needed to keep track of uplink allocations in later slots
   std::list <struct SlotAllocInfo> m_ulSfAllocInfo;
@@ -422,7 +426,7 @@ private:
   //typedef std::priority_queue <FlowStats, std::vector<FlowStats*>, CompareWeightDesc> flowQueue_t;
   //flowQueue_t m_flowQueue;
 
-  std::map<uint16_t, UeSchedInfo> m_ueSchedInfoMap;
+  MmWaveRntiTable<UeSchedInfo> m_ueSchedInfoMap;
   std::vector <UeSchedInfo*> m_ueSchedInfoHeap;
 
   bool m_fixedTti;                      // one slot per TTI
@@ -431,7 +435,6 @@ private:
   double m_timeWindow;
 
   std::vector <FlowStats*> m_flowHeap;
-  std::vector <UeSchedInfo*> m_ueStatHeap;
 };
 
 } // namespace mmwave
@@ -152,7 +152,8 @@ MmWaveFlexTtiMaxWeightMacScheduler::MmWaveFlexTtiMaxWeightMacScheduler ()
   : m_nextRnti (0),
     m_tbUid (0),
     m_macSchedSapUser (0),
-    m_macCschedSapUser (0)
+    m_macCschedSapUser (0),
+    m_flowPriorityHeap (&MmWaveFlexTtiMaxWeightMacScheduler::CompareFlowWeightsEdf)
 {
   NS_LOG_FUNCTION (this);
   m_macSchedSapProvider = new MmWaveFlexTtiMaxWeightMacSchedSapProvider (this);
@@ -288,7 +289,7 @@ void
 MmWaveFlexTtiMaxWeightMacScheduler::DoSchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
 {
   NS_LOG_FUNCTION (this << params.m_rnti << (uint32_t) params.m_logicalChannelIdentity);
-  std::map <uint16_t, struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  MmWaveRntiTable<struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
   if (itUe == m_ueSchedInfoMap.end ())
     {
       NS_LOG_ERROR ("UE entry not found in sched info map");
@@ -350,7 +351,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedUlMacCtrlInfoReq (const struct MmWave
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint32_t>::iterator it;
+  MmWaveRntiTable<uint32_t>::iterator it;
 
   for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
     {
@@ -363,7 +364,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedUlMacCtrlInfoReq (const struct MmWave
           // Hence the BSR of different LCGs are just summed up to get
           // a total queue size that is used for allocation purposes.
           uint16_t rnti = params.m_macCeList.at (i).m_rnti;
-          std::map <uint16_t, struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (rnti);
+          MmWaveRntiTable<struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (rnti);
 
           uint32_t buffer = 0;
           for (uint8_t lcg = 1; lcg <= 3; ++lcg)
@@ -407,13 +408,13 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedDlCqiInfoReq (const struct MmWaveMacS
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint8_t>::iterator it;
+  MmWaveRntiTable<uint8_t>::iterator it;
   for (unsigned int i = 0; i < params.m_cqiList.size (); i++)
     {
       if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::WB )
         {
           // wideband CQI reporting
-          std::map <uint16_t,uint8_t>::iterator it;
+          MmWaveRntiTable<uint8_t>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
           it = m_wbCqiRxed.find (rnti);
           if (it == m_wbCqiRxed.end ())
@@ -428,7 +429,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedDlCqiInfoReq (const struct MmWaveMacS
               // update the CQI value
               (*it).second = params.m_cqiList.at (i).m_wbCqi;
               // update correspondent timer
-              std::map <uint16_t,uint32_t>::iterator itTimers;
+              MmWaveRntiTable<uint32_t>::iterator itTimers;
               itTimers = m_wbCqiTimers.find (rnti);
               (*itTimers).second = m_cqiTimersThreshold;
             }
@@ -461,7 +462,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacS
     case UlCqiInfo::PUSCH:
       {
         std::map <uint32_t, struct AllocMapElem>::iterator itMap;
-        std::map <uint16_t, struct UlCqiMapElem>::iterator itCqi;
+        MmWaveRntiTable<struct UlCqiMapElem>::iterator itCqi;
         itMap = m_ulAllocationMap.find (params.m_sfnSf.Encode ());
         if (itMap == m_ulAllocationMap.end ())
           {
@@ -505,7 +506,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacS
                 (*itCqi).second.m_numSym = itMap->second.m_numSym;
                 (*itCqi).second.m_tbSize = itMap->second.m_tbSize;
                 // update correspondent timer
-                std::map <uint16_t, uint32_t>::iterator itTimers;
+                MmWaveRntiTable<uint32_t>::iterator itTimers;
                 itTimers = m_ueCqiTimers.find (itMap->second.m_rntiPerChunk.at (i));
                 (*itTimers).second = m_cqiTimersThreshold;
 
@@ -540,7 +541,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::RefreshHarqProcesses ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itTimers;
+  MmWaveRntiTable<DlHarqProcessesTimer_t>::iterator itTimers;
   for (itTimers = m_dlHarqProcessesTimer.begin (); itTimers != m_dlHarqProcessesTimer.end (); itTimers++)
     {
       for (uint16_t i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
@@ -548,7 +549,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::RefreshHarqProcesses ()
           if ((*itTimers).second.at (i) == m_phyMacConfig->GetHarqTimeout ())
             {             // reset HARQ process
               NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers).first);
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
+              MmWaveRntiTable<DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
               if (itStat == m_dlHarqProcessesStatus.end ())
                 {
                   NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers).first);
@@ -563,7 +564,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::RefreshHarqProcesses ()
         }
     }
 
-  std::map <uint16_t, UlHarqProcessesTimer_t>::iterator itTimers2;
+  MmWaveRntiTable<UlHarqProcessesTimer_t>::iterator itTimers2;
   for (itTimers2 = m_ulHarqProcessesTimer.begin (); itTimers2 != m_ulHarqProcessesTimer.end (); itTimers2++)
     {
       for (uint16_t i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
@@ -571,7 +572,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::RefreshHarqProcesses ()
           if ((*itTimers2).second.at (i) == m_phyMacConfig->GetHarqTimeout ())
             {             // reset HARQ process
               NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers2).first);
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find ((*itTimers2).first);
+              MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find ((*itTimers2).first);
               if (itStat == m_ulHarqProcessesStatus.end ())
                 {
                   NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers2).first);
@@ -606,7 +607,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::UpdateDlHarqProcessId (uint16_t rnti)
 //	{
 //		NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
 //	}
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
+  MmWaveRntiTable<DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
   if (itStat == m_dlHarqProcessesStatus.end ())
     {
       NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
@@ -661,7 +662,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::UpdateUlHarqProcessId (uint16_t rnti)
 //	{
 //		NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
 //	}
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
+  MmWaveRntiTable<DlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
   if (itStat == m_ulHarqProcessesStatus.end ())
     {
       NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
@@ -697,57 +698,6 @@ MmWaveFlexTtiMaxWeightMacScheduler::UpdateUlHarqProcessId (uint16_t rnti)
 //	return ((*it).second);
 }
 
-unsigned MmWaveFlexTtiMaxWeightMacScheduler::CalcMinTbSizeNumSym (unsigned mcs, unsigned bufSize, unsigned &tbSize)
-{
-  // Bisection line search is used to find the minimum number of slots (OFDM symbols)
-  // needed to encode entire buffer.
-  MmWaveMacPduHeader dummyMacHeader;
-  //unsigned macHdrSize = 10; //dummyMacHeader.GetSerializedSize ();
-  int numSymLow = 0;
-  int numSymHigh = m_phyMacConfig->GetSymbPerSlot();
-
-  int diff = 0;
-  tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8); // start with max value, in number of bytes
-  while ((unsigned)tbSize > bufSize)
-  {
-      diff = abs(numSymHigh-numSymLow)/2;
-      if (diff == 0)
-      {
-          tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-          return numSymHigh;
-      }
-      tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh - diff) / 8);
-      if ((unsigned)tbSize >= bufSize)
-      {
-          numSymHigh -= diff;
-      }
-      if ((unsigned) tbSize == bufSize)
-      {
-          return numSymHigh;
-      }
-      while ((unsigned)tbSize < bufSize)
-      {
-          diff = abs(numSymHigh-numSymLow)/2;
-          if (diff == 0)
-          {
-              tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-              return numSymHigh;
-          }
-          tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymLow + diff) / 8);
-          if ((unsigned)tbSize <= bufSize)
-          {
-              numSymLow += diff;
-          }
-          if ((unsigned) tbSize == bufSize)
-          {
-              return numSymLow;
-          }
-      }
-  }
-  tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-  return (unsigned)numSymHigh;
-}
-
 void
 MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
 {
@@ -795,7 +745,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
   // number of DL/UL flows for new transmissions (not HARQ RETX)
   std::map <uint16_t, UeSchedInfo*> ueAllocMap;                 // map of allocated users for this SF
   std::map <uint16_t, UeSchedInfo*>::iterator itUeAllocMap;
-  std::map <uint16_t, UeSchedInfo>::iterator itUeSchedInfoMap;
+  MmWaveRntiTable<UeSchedInfo>::iterator itUeSchedInfoMap;
   std::map <uint8_t, FlowStats>::iterator itFlow;
   std::list<MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itRlcBuf;
 
@@ -837,12 +787,12 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
           uint16_t rnti = m_dlHarqInfoList.at (i).m_rnti;
           itUeSchedInfoMap = m_ueSchedInfoMap.find (rnti);
           NS_ASSERT (itUeSchedInfoMap != m_ueSchedInfoMap.end ());
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
+          MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
           if (itStat == m_dlHarqProcessesStatus.end ())
             {
               NS_FATAL_ERROR ("No HARQ status info found for UE " << rnti);
             }
-          std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (rnti);
+          MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (rnti);
           if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
             {
               NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << m_dlHarqInfoList.at (i).m_rnti);
@@ -859,7 +809,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
             }
           else if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::NACK)
             {
-              std::map <uint16_t, DlHarqProcessesDciInfoList_t>::iterator itHarq = m_dlHarqProcessesDciInfoMap.find (rnti);
+              MmWaveRntiTable<DlHarqProcessesDciInfoList_t>::iterator itHarq = m_dlHarqProcessesDciInfoMap.find (rnti);
               if (itHarq == m_dlHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("No DCI/HARQ buffer entry found for UE " << rnti);
@@ -895,7 +845,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
                   NS_LOG_DEBUG ("UE" << dciInfoReTx.m_rnti << " gets DL slots " << (unsigned)dciInfoReTx.m_symStart << "-" << (unsigned)(dciInfoReTx.m_symStart + dciInfoReTx.m_numSym - 1) <<
                                 " tbs " << dciInfoReTx.m_tbSize << " harqId " << (unsigned)dciInfoReTx.m_harqProcess << " harqId " << (unsigned)dciInfoReTx.m_harqProcess <<
                                 " rv " << (unsigned)dciInfoReTx.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum << " RETX");
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcList =  m_dlHarqProcessesRlcPduMap.find (rnti);
+                  MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcList =  m_dlHarqProcessesRlcPduMap.find (rnti);
                   if (itRlcList == m_dlHarqProcessesRlcPduMap.end ())
                     {
                       NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << rnti);
@@ -937,7 +887,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
           uint16_t rnti = harqInfo.m_rnti;
           itUeSchedInfoMap = m_ueSchedInfoMap.find (rnti);
           NS_ASSERT (itUeSchedInfoMap != m_ueSchedInfoMap.end ());
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
+          MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
           if (itStat == m_ulHarqProcessesStatus.end ())
             {
               NS_LOG_ERROR ("No info found in HARQ buffer for UE (might have changed eNB) " << rnti);
@@ -952,7 +902,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
             }
           else if (harqInfo.m_receptionStatus == UlHarqInfo::NotOk)
             {
-              std::map <uint16_t, UlHarqProcessesDciInfoList_t>::iterator itHarq = m_ulHarqProcessesDciInfoMap.find (rnti);
+              MmWaveRntiTable<UlHarqProcessesDciInfoList_t>::iterator itHarq = m_ulHarqProcessesDciInfoMap.find (rnti);
               if (itHarq == m_ulHarqProcessesDciInfoMap.end ())
                 {
                   NS_LOG_ERROR ("No info found in UL-HARQ buffer for UE (might have changed eNB) " << rnti);
@@ -1033,214 +983,202 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
     {
       // first allocate symbols in DL and UL subframes to flows based on deadlines, then assign symbol indices
       std::vector<FlowStats*>::iterator flowIt;
-      while (symAvail > 0)
+      // order the flows by relative deadline; the flow served at each step
+      // is moved to its new position, without sorting all the flows again
+      m_flowPriorityHeap.Assign (m_flowHeap.begin (), m_flowHeap.end ());
+      while (symAvail > 0 && !m_flowPriorityHeap.Empty ())                             // find flow with CQI in range (not in outage)
         {
-          std::sort (m_flowHeap.begin (), m_flowHeap.end (),
-                     MmWaveFlexTtiMaxWeightMacScheduler::CompareFlowWeightsEdf);                                                        // Sort flow heap by relative deadline
-          flowIt = m_flowHeap.begin ();
-          bool flowFound = false;
-          while (!flowFound && flowIt != m_flowHeap.end () && symAvail > 0)                             // find flow with CQI in range (not in outage)
+          FlowStats* flow = m_flowPriorityHeap.Top ();                                // get Earliest Deadline flow
+          if (flow->m_txPacketSizes.empty ())
+            {
+              m_flowPriorityHeap.Pop ();
+              continue;
+            }
+
+          UeSchedInfo* ueInfo = flow->m_ueSchedInfo;
+          if (!flow->m_isUplink)
             {
-              FlowStats* flow = *flowIt;                                // get Earliest Deadline flow
-              if (flow->m_txPacketSizes.empty ())
+              MmWaveRntiTable<uint8_t>::iterator itCqi = m_wbCqiRxed.find (ueInfo->m_rnti);
+              uint8_t cqi = 0;
+              if (itCqi != m_wbCqiRxed.end ())
                 {
-                  flowIt++;
-                  continue;
+                  cqi = itCqi->second;
                 }
-
-              UeSchedInfo* ueInfo = flow->m_ueSchedInfo;
-              if (!flow->m_isUplink && symAvail > 0)
+              else                       // no CQI available
                 {
-                  std::map <uint16_t,uint8_t>::iterator itCqi = m_wbCqiRxed.find (ueInfo->m_rnti);
-                  uint8_t cqi = 0;
-                  if (itCqi != m_wbCqiRxed.end ())
-                    {
-                      cqi = itCqi->second;
-                    }
-                  else                       // no CQI available
+                  NS_LOG_INFO (this << " UE " << ueInfo->m_rnti << " does not have DL-CQI");
+                  cqi = 1;                           // lowest value for trying a transmission
+                }
+              if (cqi != 0)
+                {
+                  itUeAllocMap = ueAllocMap.find (ueInfo->m_rnti);
+                  if (itUeAllocMap == ueAllocMap.end ())
                     {
-                      NS_LOG_INFO (this << " UE " << ueInfo->m_rnti << " does not have DL-CQI");
-                      cqi = 1;                           // lowest value for trying a transmission
+                      itUeAllocMap = ueAllocMap.insert (std::pair <uint16_t, struct UeSchedInfo*> (ueInfo->m_rnti, ueInfo)).first;
                     }
-                  if (cqi != 0)
+                  ueInfo->m_dlMcs = m_amc->GetMcsFromCqi (cqi);                            // get MCS
+                  // compute total TB size if we send whole RLC PDU
+                  uint32_t pduSize = flow->m_txPacketSizes.front () + m_rlcHdrSize + m_subHdrSize;
+                  // get required symbols to send whole RLC PDU
+                  // (could be zero additional symbols if enough resources already allocated)
+                  uint32_t numSymReq = m_amc->GetNumSymbolsFromTbsMcs ((ueInfo->m_dlTbSize + pduSize) * 8, ueInfo->m_dlMcs) - ueInfo->m_dlSymbols;
+                  if (numSymReq <= (unsigned)symAvail)                              // sufficient symbols to TX whole RLC PDU at this MCS
                     {
-                      flowFound = true;
-                      itUeAllocMap = ueAllocMap.find (ueInfo->m_rnti);
-                      if (itUeAllocMap == ueAllocMap.end ())
+                      flow->m_txPacketSizes.pop_front ();
+                      // fixed TTI: slot must be multiple of m_symPerSlot symbols
+                      // (for last slot, can be less due to control period)
+                      if (m_fixedTti)
                         {
-                          itUeAllocMap = ueAllocMap.insert (std::pair <uint16_t, struct UeSchedInfo*> (ueInfo->m_rnti, ueInfo)).first;
-                        }
-                      ueInfo->m_dlMcs = m_amc->GetMcsFromCqi (cqi);                            // get MCS
-                      // compute total TB size if we send whole RLC PDU
-                      uint32_t pduSize = flow->m_txPacketSizes.front () + m_rlcHdrSize + m_subHdrSize;
-                      // get required symbols to send whole RLC PDU
-                      // (could be zero additional symbols if enough resources already allocated)
-                      uint32_t numSymReq = m_amc->GetNumSymbolsFromTbsMcs ((ueInfo->m_dlTbSize + pduSize) * 8, ueInfo->m_dlMcs) - ueInfo->m_dlSymbols;
-                      if (numSymReq <= (unsigned)symAvail)                              // sufficient symbols to TX whole RLC PDU at this MCS
-                        {
-                          flow->m_txPacketSizes.pop_front ();
-                          // fixed TTI: slot must be multiple of m_symPerSlot symbols
-                          // (for last slot, can be less due to control period)
-                          if (m_fixedTti)
+                          uint32_t numSymFixed = m_symPerSlot * ceil ((double)numSymReq / (double)m_symPerSlot);
+                          if (numSymFixed > (unsigned)symAvail)
                             {
-                              uint32_t numSymFixed = m_symPerSlot * ceil ((double)numSymReq / (double)m_symPerSlot);
-                              if (numSymFixed > (unsigned)symAvail)
-                                {
-                                  numSymFixed = symAvail;
-                                }
-                              if (numSymFixed > numSymReq)
-                                {
-                                  numSymReq = numSymFixed;
-                                  // recalculate TB size in case numSymReq increased
-                                  pduSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols + numSymReq) / 8 - ueInfo->m_dlTbSize;
-                                }
+                              numSymFixed = symAvail;
                             }
-                          ueInfo->m_dlSymbols += numSymReq;                                             // add to total symbols/bits for UE
-                          ueInfo->m_dlTbSize += pduSize;
-                          symAvail -= numSymReq;
-                          flow->m_txPacketDelays.pop_front ();
-                          if (flow->m_txPacketDelays.size () > 0)
+                          if (numSymFixed > numSymReq)
                             {
-                              // add the difference in delays/arrival times between the old and new HOL packet to the deadline
-                              // assume all packets have the same initial deadline
-                              flow->m_txQueueHolDelay = flow->m_txPacketDelays.front ();
-                              //flow->m_deadlineUs += oldHolDelay - flow->m_txQueueHolDelay;
+                              numSymReq = numSymFixed;
+                              // recalculate TB size in case numSymReq increased
+                              pduSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols + numSymReq) / 8 - ueInfo->m_dlTbSize;
                             }
                         }
-                      else                              // insufficient symbols, allocate remaining symbols (must segment RLC PDU)
+                      ueInfo->m_dlSymbols += numSymReq;                                             // add to total symbols/bits for UE
+                      ueInfo->m_dlTbSize += pduSize;
+                      symAvail -= numSymReq;
+                      flow->m_txPacketDelays.pop_front ();
+                      if (flow->m_txPacketDelays.size () > 0)
                         {
-                          // get maximum TB size from MCS and available symbols
-                          uint32_t tbSizeBits = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols + symAvail);
-                          pduSize = ceil (tbSizeBits / 8.0) - ueInfo->m_dlTbSize - (m_rlcHdrSize + m_subHdrSize);
-                          //NS_ASSERT (pduSize <= flow->m_txPacketSizes.front ());
-                          flow->m_txPacketSizes.front () -= pduSize;                                            // subtract from HOL packet
-                          ueInfo->m_dlSymbols += symAvail;
-                          ueInfo->m_dlTbSize += pduSize;
-                          symAvail = 0;
+                          // add the difference in delays/arrival times between the old and new HOL packet to the deadline
+                          // assume all packets have the same initial deadline
+                          flow->m_txQueueHolDelay = flow->m_txPacketDelays.front ();
+                          //flow->m_deadlineUs += oldHolDelay - flow->m_txQueueHolDelay;
                         }
-                      NS_LOG_DEBUG ("UE" << ueInfo->m_rnti << " LCID " << (unsigned)flow->m_lcid << " assigned " << (unsigned)ueInfo->m_dlSymbols <<
-                                    " DL symbols at MCS " << (unsigned)ueInfo->m_dlMcs << " (remaining == " << symAvail << ")");
-                      RlcPduInfo rlcInfo (flow->m_lcid, pduSize);
-                      ueInfo->m_rlcPduInfo.push_back (rlcInfo);
-                      uint32_t sduSize = pduSize - (m_rlcHdrSize + m_subHdrSize);
-                      //flow->m_totalSchedSize += sduSize;
-                      flow->m_totalBufSize -= sduSize;
-                      /*flow->m_schedPacketSizes.push_front (sduSize);
-                      if (flow->m_schedPacketSizes.size () > m_phyMacConfig->GetL1L2CtrlLatency ())
-                      {
-                              flow->m_totalSchedSize -= flow->m_schedPacketSizes.back ();
-                              flow->m_schedPacketSizes.pop_back ();
-                      }*/
                     }
-                  else
+                  else                              // insufficient symbols, allocate remaining symbols (must segment RLC PDU)
                     {
-                      // out of range (SINR too low)
-                      NS_LOG_INFO ("*** RNTI " << ueInfo->m_rnti << " DL-CQI out of range, skipping allocation in UL");
-                      flowIt++;                           // try next flow
+                      // get maximum TB size from MCS and available symbols
+                      uint32_t tbSizeBits = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols + symAvail);
+                      pduSize = ceil (tbSizeBits / 8.0) - ueInfo->m_dlTbSize - (m_rlcHdrSize + m_subHdrSize);
+                      //NS_ASSERT (pduSize <= flow->m_txPacketSizes.front ());
+                      flow->m_txPacketSizes.front () -= pduSize;                                            // subtract from HOL packet
+                      ueInfo->m_dlSymbols += symAvail;
+                      ueInfo->m_dlTbSize += pduSize;
+                      symAvail = 0;
                     }
+                  NS_LOG_DEBUG ("UE" << ueInfo->m_rnti << " LCID " << (unsigned)flow->m_lcid << " assigned " << (unsigned)ueInfo->m_dlSymbols <<
+                                " DL symbols at MCS " << (unsigned)ueInfo->m_dlMcs << " (remaining == " << symAvail << ")");
+                  RlcPduInfo rlcInfo (flow->m_lcid, pduSize);
+                  ueInfo->m_rlcPduInfo.push_back (rlcInfo);
+                  uint32_t sduSize = pduSize - (m_rlcHdrSize + m_subHdrSize);
+                  //flow->m_totalSchedSize += sduSize;
+                  flow->m_totalBufSize -= sduSize;
+                  /*flow->m_schedPacketSizes.push_front (sduSize);
+                  if (flow->m_schedPacketSizes.size () > m_phyMacConfig->GetL1L2CtrlLatency ())
+                  {
+                          flow->m_totalSchedSize -= flow->m_schedPacketSizes.back ();
+                          flow->m_schedPacketSizes.pop_back ();
+                  }*/
+                  m_flowPriorityHeap.Update (flow);
                 }
-              else if (flow->m_isUplink && symAvail > 0)
+              else
                 {
-                  std::map <uint16_t, struct UlCqiMapElem>::iterator itCqi = m_ueUlCqi.find (ueInfo->m_rnti);
-                  int cqi = 0;
-                  int mcs = 0;
-                  if (itCqi != m_ueUlCqi.end ())                       // no cqi info for this UE
+                  // out of range (SINR too low)
+                  NS_LOG_INFO ("*** RNTI " << ueInfo->m_rnti << " DL-CQI out of range, skipping allocation in UL");
+                  m_flowPriorityHeap.Pop ();                       // try next flow
+                }
+            }
+          else
+            {
+              MmWaveRntiTable<struct UlCqiMapElem>::iterator itCqi = m_ueUlCqi.find (ueInfo->m_rnti);
+              int cqi = 0;
+              int mcs = 0;
+              if (itCqi != m_ueUlCqi.end ())                       // no cqi info for this UE
+                {
+                  // translate vector of doubles to SpectrumValue's
+                  SpectrumValue specVals (MmWaveSpectrumValueHelper::GetSpectrumModel (m_phyMacConfig));
+                  Values::iterator specIt = specVals.ValuesBegin ();
+                  for (uint32_t ichunk = 0; ichunk < m_phyMacConfig->GetNumChunks (); ichunk++)
                     {
-                      // translate vector of doubles to SpectrumValue's
-                      SpectrumValue specVals (MmWaveSpectrumValueHelper::GetSpectrumModel (m_phyMacConfig));
-                      Values::iterator specIt = specVals.ValuesBegin ();
-                      for (uint32_t ichunk = 0; ichunk < m_phyMacConfig->GetNumChunks (); ichunk++)
-                        {
-                          NS_ASSERT (specIt != specVals.ValuesEnd ());
-                          *specIt = itCqi->second.m_ueUlCqi.at (ichunk);                               //sinrLin;
-                          specIt++;
-                        }
-                      // for UL CQI, we need to know the TB size previously allocated to accurately compute CQI/MCS
-                      cqi = m_amc->CreateCqiFeedbackWbTdma (specVals, itCqi->second.m_numSym, itCqi->second.m_tbSize, mcs);
+                      NS_ASSERT (specIt != specVals.ValuesEnd ());
+                      *specIt = itCqi->second.m_ueUlCqi.at (ichunk);                               //sinrLin;
+                      specIt++;
                     }
-                  else
+                  // for UL CQI, we need to know the TB size previously allocated to accurately compute CQI/MCS
+                  cqi = m_amc->CreateCqiFeedbackWbTdma (specVals, itCqi->second.m_numSym, itCqi->second.m_tbSize, mcs);
+                }
+              else
+                {
+                  NS_LOG_INFO (this << " UE " << ueInfo->m_rnti << " does not have UL-CQI");
+                  cqi = 1;
+                  mcs = 0;
+                }
+              if (cqi != 0)
+                {
+                  itUeAllocMap = ueAllocMap.find (ueInfo->m_rnti);
+                  if (itUeAllocMap == ueAllocMap.end ())
                     {
-                      NS_LOG_INFO (this << " UE " << ueInfo->m_rnti << " does not have UL-CQI");
-                      cqi = 1;
-                      mcs = 0;
+                      itUeAllocMap = ueAllocMap.insert (std::pair <uint16_t, struct UeSchedInfo*> (ueInfo->m_rnti, ueInfo)).first;
                     }
-                  if (cqi != 0)
+                  ueInfo->m_ulMcs = mcs;
+                  uint32_t pduSize = flow->m_txPacketSizes.front () + m_rlcHdrSize + m_subHdrSize;
+                  // get required additional symbols to send whole RLC PDU given current TB size (new total - prev. allocation)
+                  uint32_t numSymReq = m_amc->GetNumSymbolsFromTbsMcs ((ueInfo->m_ulTbSize + pduSize) * 8, ueInfo->m_ulMcs) - ueInfo->m_ulSymbols;
+                  if (numSymReq <= (unsigned)symAvail)                              // sufficient symbols to TX whole RLC PDU at this MCS
                     {
-                      flowFound = true;
-                      itUeAllocMap = ueAllocMap.find (ueInfo->m_rnti);
-                      if (itUeAllocMap == ueAllocMap.end ())
+                      flow->m_txPacketSizes.pop_front ();
+                      if (m_fixedTti)
                         {
-                          itUeAllocMap = ueAllocMap.insert (std::pair <uint16_t, struct UeSchedInfo*> (ueInfo->m_rnti, ueInfo)).first;
-                        }
-                      ueInfo->m_ulMcs = mcs;
-                      uint32_t pduSize = flow->m_txPacketSizes.front () + m_rlcHdrSize + m_subHdrSize;
-                      // get required additional symbols to send whole RLC PDU given current TB size (new total - prev. allocation)
-                      uint32_t numSymReq = m_amc->GetNumSymbolsFromTbsMcs ((ueInfo->m_ulTbSize + pduSize) * 8, ueInfo->m_ulMcs) - ueInfo->m_ulSymbols;
-                      if (numSymReq <= (unsigned)symAvail)                              // sufficient symbols to TX whole RLC PDU at this MCS
-                        {
-                          flow->m_txPacketSizes.pop_front ();
-                          if (m_fixedTti)
+                          uint32_t numSymFixed = m_symPerSlot * ceil ((double)numSymReq / (double)m_symPerSlot);
+                          if (numSymFixed > (unsigned)symAvail)
                             {
-                              uint32_t numSymFixed = m_symPerSlot * ceil ((double)numSymReq / (double)m_symPerSlot);
-                              if (numSymFixed > (unsigned)symAvail)
-                                {
-                                  numSymFixed = symAvail;
-                                }
-                              if (numSymFixed > numSymReq)
-                                {
-                                  numSymReq = numSymFixed;
-                                  // recalculate TB size in case numSymReq increased
-                                  pduSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols + numSymReq) / 8 - ueInfo->m_ulTbSize;
-                                }
+                              numSymFixed = symAvail;
                             }
-                          ueInfo->m_ulSymbols += numSymReq;                                             // add to total symbols/bits for UE
-                          ueInfo->m_ulTbSize += pduSize;
-                          symAvail -= numSymReq;
-                          flow->m_txPacketDelays.pop_front ();
-                          if (flow->m_txPacketDelays.size () > 0)
+                          if (numSymFixed > numSymReq)
                             {
-                              flow->m_txQueueHolDelay = flow->m_txPacketDelays.front ();
-                              //flow->m_deadlineUs += oldHolDelay - flow->m_txQueueHolDelay;
+                              numSymReq = numSymFixed;
+                              // recalculate TB size in case numSymReq increased
+                              pduSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols + numSymReq) / 8 - ueInfo->m_ulTbSize;
                             }
                         }
-                      else                              // insufficient symbols, allocate remaining symbols (must segment RLC PDU)
+                      ueInfo->m_ulSymbols += numSymReq;                                             // add to total symbols/bits for UE
+                      ueInfo->m_ulTbSize += pduSize;
+                      symAvail -= numSymReq;
+                      flow->m_txPacketDelays.pop_front ();
+                      if (flow->m_txPacketDelays.size () > 0)
                         {
-                          // get maximum TB size from MCS and available symbols
-                          uint32_t tbSizeBits = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols + symAvail);
-                          pduSize = ceil (tbSizeBits / 8.0) - ueInfo->m_ulTbSize - (m_rlcHdrSize + m_subHdrSize);
-                          NS_ASSERT (pduSize <= flow->m_txPacketSizes.front ());
-                          flow->m_txPacketSizes.front () -= pduSize;                                            // subtract from HOL packet
-                          ueInfo->m_ulSymbols += symAvail;
-                          ueInfo->m_ulTbSize += pduSize;
-                          symAvail = 0;
-                        }
-                      NS_LOG_DEBUG ("UE" << ueInfo->m_rnti << " LCID " << (unsigned)flow->m_lcid << " assigned " << (unsigned)ueInfo->m_ulSymbols <<
-                                    " UL symbols at MCS " << (unsigned)ueInfo->m_ulMcs << " (remaining == " << symAvail << ")");
-                      uint32_t sduSize = pduSize - (m_rlcHdrSize + m_subHdrSize);
-                      //flow->m_totalSchedSize += sduSize;
-                      flow->m_totalBufSize -= sduSize;
-                      flow->m_schedPacketSizes.push_front (sduSize);
-                      if (1 || flow->m_schedPacketSizes.size () > m_phyMacConfig->GetUlSchedDelay ())
-                        {
-                          //flow->m_totalSchedSize -= flow->m_schedPacketSizes.back ();
-                          flow->m_schedPacketSizes.pop_back ();
+                          flow->m_txQueueHolDelay = flow->m_txPacketDelays.front ();
+                          //flow->m_deadlineUs += oldHolDelay - flow->m_txQueueHolDelay;
                         }
                     }
-                  else
+                  else                              // insufficient symbols, allocate remaining symbols (must segment RLC PDU)
+                    {
+                      // get maximum TB size from MCS and available symbols
+                      uint32_t tbSizeBits = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols + symAvail);
+                      pduSize = ceil (tbSizeBits / 8.0) - ueInfo->m_ulTbSize - (m_rlcHdrSize + m_subHdrSize);
+                      NS_ASSERT (pduSize <= flow->m_txPacketSizes.front ());
+                      flow->m_txPacketSizes.front () -= pduSize;                                            // subtract from HOL packet
+                      ueInfo->m_ulSymbols += symAvail;
+                      ueInfo->m_ulTbSize += pduSize;
+                      symAvail = 0;
+                    }
+                  NS_LOG_DEBUG ("UE" << ueInfo->m_rnti << " LCID " << (unsigned)flow->m_lcid << " assigned " << (unsigned)ueInfo->m_ulSymbols <<
+                                " UL symbols at MCS " << (unsigned)ueInfo->m_ulMcs << " (remaining == " << symAvail << ")");
+                  uint32_t sduSize = pduSize - (m_rlcHdrSize + m_subHdrSize);
+                  //flow->m_totalSchedSize += sduSize;
+                  flow->m_totalBufSize -= sduSize;
+                  flow->m_schedPacketSizes.push_front (sduSize);
+                  if (1 || flow->m_schedPacketSizes.size () > m_phyMacConfig->GetUlSchedDelay ())
                     {
-                      // out of range (SINR too low)
-                      NS_LOG_INFO ("*** RNTI " << ueInfo->m_rnti << " UL-CQI out of range, skipping allocation in UL");
-                      flowIt++;                           // try next flow
+                      //flow->m_totalSchedSize -= flow->m_schedPacketSizes.back ();
+                      flow->m_schedPacketSizes.pop_back ();
                     }
+                  m_flowPriorityHeap.Update (flow);
                 }
               else
                 {
-                  flowIt++;
+                  // out of range (SINR too low)
+                  NS_LOG_INFO ("*** RNTI " << ueInfo->m_rnti << " UL-CQI out of range, skipping allocation in UL");
+                  m_flowPriorityHeap.Pop ();                       // try next flow
                 }
-            }             // end while
-          if (!flowFound)               // no active flows found
-            {
-              break;
             }
         }         //end while
 
@@ -1317,14 +1255,14 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
 
           if (m_harqOn == true)
             {                   // store DCI for HARQ buffer
-              std::map <uint16_t, DlHarqProcessesDciInfoList_t>::iterator itDciInfo = m_dlHarqProcessesDciInfoMap.find (dci.m_rnti);
+              MmWaveRntiTable<DlHarqProcessesDciInfoList_t>::iterator itDciInfo = m_dlHarqProcessesDciInfoMap.find (dci.m_rnti);
               if (itDciInfo == m_dlHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find RNTI entry in DCI HARQ buffer for RNTI " << dci.m_rnti);
                 }
               (*itDciInfo).second.at (dci.m_harqProcess) = dci;
               // refresh timer
-              std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (dci.m_rnti);
+              MmWaveRntiTable<DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (dci.m_rnti);
               if (itHarqTimer == m_dlHarqProcessesTimer.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)dci.m_rnti);
@@ -1350,7 +1288,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
               if (m_harqOn == true)
                 {
                   // store RLC PDU list for HARQ
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
+                  MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
                   if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
                     {
                       NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << dci.m_rnti);
@@ -1437,17 +1375,17 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSch
           if (m_harqOn == true)
             {
               uint8_t harqId = dci.m_harqProcess;
-              std::map <uint16_t, UlHarqProcessesDciInfoList_t>::iterator itHarqTbInfo = m_ulHarqProcessesDciInfoMap.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesDciInfoList_t>::iterator itHarqTbInfo = m_ulHarqProcessesDciInfoMap.find (dci.m_rnti);
               if (itHarqTbInfo == m_ulHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << dci.m_rnti);
                 }
               (*itHarqTbInfo).second.at (harqId) = dci;
               // Update HARQ process status (RV 0)
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (dci.m_rnti);
               NS_ASSERT (itStat->second[dci.m_harqProcess] > 0);
               // refresh timer
-              std::map <uint16_t, UlHarqProcessesTimer_t>::iterator itHarqTimer =  m_ulHarqProcessesTimer.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesTimer_t>::iterator itHarqTimer =  m_ulHarqProcessesTimer.find (dci.m_rnti);
               if (itHarqTimer == m_ulHarqProcessesTimer.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)dci.m_rnti);
@@ -1494,20 +1432,19 @@ MmWaveFlexTtiMaxWeightMacScheduler::RefreshDlCqiMaps (void)
 {
   NS_LOG_FUNCTION (this << m_wbCqiTimers.size ());
   // refresh DL CQI P01 Map
-  std::map <uint16_t,uint32_t>::iterator itP10 = m_wbCqiTimers.begin ();
+  MmWaveRntiTable<uint32_t>::iterator itP10 = m_wbCqiTimers.begin ();
   while (itP10 != m_wbCqiTimers.end ())
     {
       NS_LOG_INFO (this << " P10-CQI for user " << (*itP10).first << " is " << (uint32_t)(*itP10).second << " thr " << (uint32_t)m_cqiTimersThreshold);
       if ((*itP10).second == 0)
         {
           // delete correspondent entries
-          std::map <uint16_t,uint8_t>::iterator itMap = m_wbCqiRxed.find ((*itP10).first);
+          MmWaveRntiTable<uint8_t>::iterator itMap = m_wbCqiRxed.find ((*itP10).first);
           NS_ASSERT_MSG (itMap != m_wbCqiRxed.end (), " Does not find CQI report for user " << (*itP10).first);
           NS_LOG_INFO (this << " P10-CQI exired for user " << (*itP10).first);
           m_wbCqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itP10;
-          itP10++;
-          m_wbCqiTimers.erase (temp);
+          // the erasure invalidates the iterators, erase returns the next entry
+          itP10 = m_wbCqiTimers.erase (itP10);
         }
       else
         {
@@ -1524,21 +1461,20 @@ void
 MmWaveFlexTtiMaxWeightMacScheduler::RefreshUlCqiMaps (void)
 {
   // refresh UL CQI  Map
-  std::map <uint16_t,uint32_t>::iterator itUl = m_ueCqiTimers.begin ();
+  MmWaveRntiTable<uint32_t>::iterator itUl = m_ueCqiTimers.begin ();
   while (itUl != m_ueCqiTimers.end ())
     {
       NS_LOG_INFO (this << " UL-CQI for user " << (*itUl).first << " is " << (uint32_t)(*itUl).second << " thr " << (uint32_t)m_cqiTimersThreshold);
       if ((*itUl).second == 0)
         {
           // delete correspondent entries
-          std::map <uint16_t, struct UlCqiMapElem>::iterator itMap = m_ueUlCqi.find ((*itUl).first);
+          MmWaveRntiTable<struct UlCqiMapElem>::iterator itMap = m_ueUlCqi.find ((*itUl).first);
           NS_ASSERT_MSG (itMap != m_ueUlCqi.end (), " Does not find CQI report for user " << (*itUl).first);
           NS_LOG_INFO (this << " UL-CQI expired for user " << (*itUl).first);
           itMap->second.m_ueUlCqi.clear ();
           m_ueUlCqi.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itUl;
-          itUl++;
-          m_ueCqiTimers.erase (temp);
+          // the erasure invalidates the iterators, erase returns the next entry
+          itUl = m_ueCqiTimers.erase (itUl);
         }
       else
         {
@@ -1606,7 +1542,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::UpdateUlRlcBufferInfo (uint16_t rnti, uint16
 {
 
   size = size - 2; // remove the minimum RLC overhead
-  std::map <uint16_t,uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
+  MmWaveRntiTable<uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
   if (it != m_ceBsrRxed.end ())
     {
       NS_LOG_INFO (this << " Update RLC BSR UE " << rnti << " size " << size << " BSR " << (*it).second);
@@ -1645,7 +1581,7 @@ MmWaveFlexTtiMaxWeightMacScheduler::DoCschedUeConfigReq (const struct MmWaveMacC
 {
   NS_LOG_FUNCTION (this << " RNTI " << params.m_rnti << " txMode " << (uint16_t)params.m_transmissionMode);
 
-  std::map <uint16_t, struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  MmWaveRntiTable<struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
   if (itUe == m_ueSchedInfoMap.end ())
     {
       itUe = m_ueSchedInfoMap.insert (std::pair <uint16_t, struct UeSchedInfo> (params.m_rnti, UeSchedInfo (params.m_rnti))).first;
@@ -1692,7 +1628,7 @@ void
 MmWaveFlexTtiMaxWeightMacScheduler::DoCschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params)
 {
   NS_LOG_FUNCTION (this);
-  std::map <uint16_t, struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  MmWaveRntiTable<struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
   if (itUe != m_ueSchedInfoMap.end ())
     {
       for (uint16_t i = 0; i < params.m_logicalChannelConfigList.size (); i++)
@@ -13,6 +13,8 @@
 #include "mmwave-mac-csched-sap.h"
 #include "mmwave-mac-scheduler.h"
 #include "mmwave-amc.h"
+#include "mmwave-rnti-table.h"
+#include "mmwave-indexed-heap.h"
 #include "string"
 #include <vector>
 #include <set>
@@ -87,7 +89,8 @@ private:
         m_probErr (0.0),
         m_deadlineUs (0),
         m_totalBufSize (0),
-        m_totalSchedSize (0)
+        m_totalSchedSize (0),
+        m_heapIndex (0)
     {
       NS_ASSERT (ueSchedInfo != 0);
     }
@@ -115,6 +118,7 @@ private:
     // data that has been scheduled but not yet extracted from the DL or UL queue.
     std::list<uint32_t> m_schedPacketSizes;
     uint32_t        m_totalSchedSize;                           // total of last M elements in list
+    uint32_t        m_heapIndex;                                // position of the flow in m_flowPriorityHeap
   };
 
   struct UeSchedInfo
@@ -215,7 +219,20 @@ private:
   {
     int lRelDeadline = lflow->m_deadlineUs - lflow->m_txQueueHolDelay;
     int rRelDeadline = rflow->m_deadlineUs - rflow->m_txQueueHolDelay;
-    return (lRelDeadline < rRelDeadline);               // earlier deadline = greater weight
+    if (lRelDeadline != rRelDeadline)
+      {
+        return (lRelDeadline < rRelDeadline);               // earlier deadline = greater weight
+      }
+    // ties are broken in the order in which the flows are configured
+    if (lflow->m_ueSchedInfo->m_rnti != rflow->m_ueSchedInfo->m_rnti)
+      {
+        return (lflow->m_ueSchedInfo->m_rnti < rflow->m_ueSchedInfo->m_rnti);
+      }
+    if (lflow->m_lcid != rflow->m_lcid)
+      {
+        return (lflow->m_lcid < rflow->m_lcid);
+      }
+    return (!lflow->m_isUplink && rflow->m_isUplink);
   }
 
   static bool CompareFlowWeightsDeliveryDebt (FlowStats* lflow, FlowStats* rflow)
@@ -225,8 +242,6 @@ private:
     return (lflowDebt > rflowDebt);
   }
 
-  unsigned CalcMinTbSizeNumSym (unsigned mcs, unsigned bufSize, unsigned &tbSize);
-
   uint32_t
   BsrId2BufferSize (uint8_t val)
   {
@@ -316,11 +331,11 @@ private:
   /*
    * Map of UE's DL CQI WB received
    */
-  std::map <uint16_t,uint8_t> m_wbCqiRxed;
+  MmWaveRntiTable<uint8_t> m_wbCqiRxed;
   /*
    * Map of UE's timers on DL CQI WB received
    */
-  std::map <uint16_t,uint32_t> m_wbCqiTimers;
+  MmWaveRntiTable<uint32_t> m_wbCqiTimers;
 
   uint32_t m_cqiTimersThreshold;       // # of TTIs for which a CQI can be considered valid
 
@@ -329,6 +344,11 @@ private:
    */
   struct UlCqiMapElem
   {
+    UlCqiMapElem ()
+      : m_numSym (0),
+        m_tbSize (0)
+    {
+    }
     UlCqiMapElem (std::vector<double> ulCqi, uint8_t nSym, uint32_t tbs)
       : m_ueUlCqi (ulCqi),
         m_numSym (nSym),
@@ -340,16 +360,16 @@ private:
     uint32_t        m_tbSize;
   };
 
-  std::map <uint16_t, struct UlCqiMapElem> m_ueUlCqi;
+  MmWaveRntiTable<struct UlCqiMapElem> m_ueUlCqi;
   /*
    * Map of UEs' timers on UL-CQI per RBG
    */
-  std::map <uint16_t, uint32_t> m_ueCqiTimers;
+  MmWaveRntiTable<uint32_t> m_ueCqiTimers;
 
   /*
    * Map of UE's buffer status reports received
    */
-  std::map <uint16_t,uint32_t> m_ceBsrRxed;
+  MmWaveRntiTable<uint32_t> m_ceBsrRxed;
 
   uint16_t m_nextRnti;
   uint64_t m_nextRntiDl;
@@ -394,24 +414,24 @@ private:
   uint8_t m_numHarqProcess;
   uint8_t m_harqTimeout;
 
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId;
+  MmWaveRntiTable<uint8_t> m_dlHarqCurrentProcessId;
   //HARQ status
   // 0: process Id available
   // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus;
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;
-  std::map <uint16_t, DlHarqProcessesDciInfoList_t> m_dlHarqProcessesDciInfoMap;
-  std::map <uint16_t, DlHarqRlcPduList_t> m_dlHarqProcessesRlcPduMap;
+  MmWaveRntiTable<DlHarqProcessesStatus_t> m_dlHarqProcessesStatus;
+  MmWaveRntiTable<DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;
+  MmWaveRntiTable<DlHarqProcessesDciInfoList_t> m_dlHarqProcessesDciInfoMap;
+  MmWaveRntiTable<DlHarqRlcPduList_t> m_dlHarqProcessesRlcPduMap;
   std::vector <DlHarqInfo> m_dlHarqInfoList;       // HARQ retx buffered
   std::vector <UlHarqInfo> m_ulHarqInfoList;       // HARQ retx buffered
 
-  std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId;
+  MmWaveRntiTable<uint8_t> m_ulHarqCurrentProcessId;
   //HARQ status
   // 0: process Id available
   // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, UlHarqProcessesStatus_t>    m_ulHarqProcessesStatus;
-  std::map <uint16_t, UlHarqProcessesTimer_t>     m_ulHarqProcessesTimer;
-  std::map <uint16_t, UlHarqProcessesDciInfoList_t> m_ulHarqProcessesDciInfoMap;
+  MmWaveRntiTable<UlHarqProcessesStatus_t>    m_ulHarqProcessesStatus;
+  MmWaveRntiTable<UlHarqProcessesTimer_t>     m_ulHarqProcessesTimer;
+  MmWaveRntiTable<UlHarqProcessesDciInfoList_t> m_ulHarqProcessesDciInfoMap;
 
   // needed to keep track of uplink allocations in later slots
   std::list <struct SlotAllocInfo> m_ulSfAllocInfo;
@@ -430,7 +450,7 @@ private:
   bool m_dlOnly;
   bool m_ulOnly;
 
-  std::map<uint16_t, UeSchedInfo> m_ueSchedInfoMap;
+  MmWaveRntiTable<UeSchedInfo> m_ueSchedInfoMap;
 
   enum AlgType
   {
@@ -440,6 +460,7 @@ private:
   //flowQueue_t m_flowQueue;
 
   std::vector <FlowStats*> m_flowHeap;
+  MmWaveIndexedHeap<FlowStats, &FlowStats::m_heapIndex> m_flowPriorityHeap; //!< the flows which can still be allocated in the current slot, ordered by relative deadline
 
   bool m_fixedTti;                      // one slot per TTI
   uint8_t m_symPerSlot;       // symbols per slot
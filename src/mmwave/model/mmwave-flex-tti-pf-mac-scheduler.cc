@@ -153,7 +153,8 @@ MmWaveFlexTtiPfMacScheduler::MmWaveFlexTtiPfMacScheduler ()
     m_tbUid (0),
     m_macSchedSapUser (0),
     m_macCschedSapUser (0),
-    m_timeWindow (99.0)
+    m_timeWindow (99.0),
+    m_ueHeap (&MmWaveFlexTtiPfMacScheduler::CompareUeWeightsPf)
 {
   NS_LOG_FUNCTION (this);
   m_macSchedSapProvider = new MmWaveFlexTtiPfMacSchedSapProvider (this);
@@ -288,7 +289,7 @@ void
 MmWaveFlexTtiPfMacScheduler::DoSchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
 {
   NS_LOG_FUNCTION (this << params.m_rnti << (uint32_t) params.m_logicalChannelIdentity);
-  std::map <uint16_t, struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  MmWaveRntiTable<struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
   if (itUe == m_ueSchedInfoMap.end ())
     {
       NS_LOG_ERROR ("UE entry not found in sched info map");
@@ -354,7 +355,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSche
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint32_t>::iterator it;
+  MmWaveRntiTable<uint32_t>::iterator it;
 
   for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
     {
@@ -367,7 +368,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSche
           // Hence the BSR of different LCGs are just summed up to get
           // a total queue size that is used for allocation purposes.
           uint16_t rnti = params.m_macCeList.at (i).m_rnti;
-          std::map <uint16_t, struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (rnti);
+          MmWaveRntiTable<struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (rnti);
 
           uint32_t buffer = 0;
           for (uint8_t lcg = 1; lcg <= 3; ++lcg)
@@ -411,13 +412,13 @@ MmWaveFlexTtiPfMacScheduler::DoSchedDlCqiInfoReq (const struct MmWaveMacSchedSap
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint8_t>::iterator it;
+  MmWaveRntiTable<uint8_t>::iterator it;
   for (unsigned int i = 0; i < params.m_cqiList.size (); i++)
     {
       if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::WB )
         {
           // wideband CQI reporting
-          std::map <uint16_t,uint8_t>::iterator it;
+          MmWaveRntiTable<uint8_t>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
           it = m_wbCqiRxed.find (rnti);
           if (it == m_wbCqiRxed.end ())
@@ -432,7 +433,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedDlCqiInfoReq (const struct MmWaveMacSchedSap
               // update the CQI value
               (*it).second = params.m_cqiList.at (i).m_wbCqi;
               // update correspondent timer
-              std::map <uint16_t,uint32_t>::iterator itTimers;
+              MmWaveRntiTable<uint32_t>::iterator itTimers;
               itTimers = m_wbCqiTimers.find (rnti);
               (*itTimers).second = m_cqiTimersThreshold;
             }
@@ -465,7 +466,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSap
     case UlCqiInfo::PUSCH:
       {
         std::map <uint32_t, struct AllocMapElem>::iterator itMap;
-        std::map <uint16_t, struct UlCqiMapElem>::iterator itCqi;
+        MmWaveRntiTable<struct UlCqiMapElem>::iterator itCqi;
         itMap = m_ulAllocationMap.find (params.m_sfnSf.Encode ());
         if (itMap == m_ulAllocationMap.end ())
           {
@@ -509,7 +510,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSap
                 (*itCqi).second.m_numSym = itMap->second.m_numSym;
                 (*itCqi).second.m_tbSize = itMap->second.m_tbSize;
                 // update correspondent timer
-                std::map <uint16_t, uint32_t>::iterator itTimers;
+                MmWaveRntiTable<uint32_t>::iterator itTimers;
                 itTimers = m_ueCqiTimers.find (itMap->second.m_rntiPerChunk.at (i));
                 (*itTimers).second = m_cqiTimersThreshold;
 
@@ -544,7 +545,7 @@ MmWaveFlexTtiPfMacScheduler::RefreshHarqProcesses ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itTimers;
+  MmWaveRntiTable<DlHarqProcessesTimer_t>::iterator itTimers;
   for (itTimers = m_dlHarqProcessesTimer.begin (); itTimers != m_dlHarqProcessesTimer.end (); itTimers++)
     {
       for (uint16_t i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
@@ -552,7 +553,7 @@ MmWaveFlexTtiPfMacScheduler::RefreshHarqProcesses ()
           if ((*itTimers).second.at (i) == m_phyMacConfig->GetHarqTimeout ())
             {             // reset HARQ process
               NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers).first);
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
+              MmWaveRntiTable<DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
               if (itStat == m_dlHarqProcessesStatus.end ())
                 {
                   NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers).first);
@@ -567,7 +568,7 @@ MmWaveFlexTtiPfMacScheduler::RefreshHarqProcesses ()
         }
     }
 
-  std::map <uint16_t, UlHarqProcessesTimer_t>::iterator itTimers2;
+  MmWaveRntiTable<UlHarqProcessesTimer_t>::iterator itTimers2;
   for (itTimers2 = m_ulHarqProcessesTimer.begin (); itTimers2 != m_ulHarqProcessesTimer.end (); itTimers2++)
     {
       for (uint16_t i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
@@ -575,7 +576,7 @@ MmWaveFlexTtiPfMacScheduler::RefreshHarqProcesses ()
           if ((*itTimers2).second.at (i) == m_phyMacConfig->GetHarqTimeout ())
             {             // reset HARQ process
               NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers2).first);
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find ((*itTimers2).first);
+              MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find ((*itTimers2).first);
               if (itStat == m_ulHarqProcessesStatus.end ())
                 {
                   NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers2).first);
@@ -610,7 +611,7 @@ MmWaveFlexTtiPfMacScheduler::UpdateDlHarqProcessId (uint16_t rnti)
 //	{
 //		NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
 //	}
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
+  MmWaveRntiTable<DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
   if (itStat == m_dlHarqProcessesStatus.end ())
     {
       NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
@@ -665,7 +666,7 @@ MmWaveFlexTtiPfMacScheduler::UpdateUlHarqProcessId (uint16_t rnti)
 //	{
 //		NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
 //	}
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
+  MmWaveRntiTable<DlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
   if (itStat == m_ulHarqProcessesStatus.end ())
     {
       NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
@@ -701,57 +702,6 @@ MmWaveFlexTtiPfMacScheduler::UpdateUlHarqProcessId (uint16_t rnti)
 //	return ((*it).second);
 }
 
-unsigned MmWaveFlexTtiPfMacScheduler::CalcMinTbSizeNumSym (unsigned mcs, unsigned bufSize, unsigned &tbSize)
-{
-  // Bisection line search is used to find the minimum number of slots (OFDM symbols)
-  // needed to encode entire buffer.
-  MmWaveMacPduHeader dummyMacHeader;
-  //unsigned macHdrSize = 10; //dummyMacHeader.GetSerializedSize ();
-  int numSymLow = 0;
-  int numSymHigh = m_phyMacConfig->GetSymbPerSlot();
-
-  int diff = 0;
-  tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8); // start with max value, in number of bytes
-  while ((unsigned)tbSize > bufSize)
-  {
-      diff = abs(numSymHigh-numSymLow)/2;
-      if (diff == 0)
-      {
-          tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-          return numSymHigh;
-      }
-      tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh - diff) / 8);
-      if ((unsigned)tbSize >= bufSize)
-      {
-          numSymHigh -= diff;
-      }
-      if ((unsigned) tbSize == bufSize)
-      {
-          return numSymHigh;
-      }
-      while ((unsigned)tbSize < bufSize)
-      {
-          diff = abs(numSymHigh-numSymLow)/2;
-          if (diff == 0)
-          {
-              tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-              return numSymHigh;
-          }
-          tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymLow + diff) / 8);
-          if ((unsigned)tbSize <= bufSize)
-          {
-              numSymLow += diff;
-          }
-          if ((unsigned) tbSize == bufSize)
-          {
-              return numSymLow;
-          }
-      }
-  }
-  tbSize = (m_amc->GetTbSizeFromMcsSymbols (mcs, numSymHigh) / 8);
-  return (unsigned)numSymHigh;
-}
-
 void
 MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
 {
@@ -787,7 +737,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
   // number of DL/UL flows for new transmissions (not HARQ RETX)
   std::map <uint16_t, UeSchedInfo*> ueAllocMap;                 // map of allocated users for this SF
   std::map <uint16_t, UeSchedInfo*>::iterator itUeAllocMap;
-  std::map <uint16_t, UeSchedInfo>::iterator itUeSchedInfoMap;
+  MmWaveRntiTable<UeSchedInfo>::iterator itUeSchedInfoMap;
   std::map <uint8_t, FlowStats>::iterator itFlow;
   std::list<MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itRlcBuf;
 
@@ -829,12 +779,12 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
           uint16_t rnti = m_dlHarqInfoList.at (i).m_rnti;
           itUeSchedInfoMap = m_ueSchedInfoMap.find (rnti);
           NS_ASSERT (itUeSchedInfoMap != m_ueSchedInfoMap.end ());
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
+          MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
           if (itStat == m_dlHarqProcessesStatus.end ())
             {
               NS_FATAL_ERROR ("No HARQ status info found for UE " << rnti);
             }
-          std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (rnti);
+          MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (rnti);
           if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
             {
               NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << m_dlHarqInfoList.at (i).m_rnti);
@@ -851,7 +801,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
             }
           else if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::NACK)
             {
-              std::map <uint16_t, DlHarqProcessesDciInfoList_t>::iterator itHarq = m_dlHarqProcessesDciInfoMap.find (rnti);
+              MmWaveRntiTable<DlHarqProcessesDciInfoList_t>::iterator itHarq = m_dlHarqProcessesDciInfoMap.find (rnti);
               if (itHarq == m_dlHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("No DCI/HARQ buffer entry found for UE " << rnti);
@@ -887,7 +837,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
                   NS_LOG_DEBUG ("UE" << dciInfoReTx.m_rnti << " gets DL slots " << (unsigned)dciInfoReTx.m_symStart << "-" << (unsigned)(dciInfoReTx.m_symStart + dciInfoReTx.m_numSym - 1) <<
                                 " tbs " << dciInfoReTx.m_tbSize << " harqId " << (unsigned)dciInfoReTx.m_harqProcess << " harqId " << (unsigned)dciInfoReTx.m_harqProcess <<
                                 " rv " << (unsigned)dciInfoReTx.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum << " RETX");
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcList =  m_dlHarqProcessesRlcPduMap.find (rnti);
+                  MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcList =  m_dlHarqProcessesRlcPduMap.find (rnti);
                   if (itRlcList == m_dlHarqProcessesRlcPduMap.end ())
                     {
                       NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << rnti);
@@ -929,7 +879,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
           uint16_t rnti = harqInfo.m_rnti;
           itUeSchedInfoMap = m_ueSchedInfoMap.find (rnti);
           NS_ASSERT (itUeSchedInfoMap != m_ueSchedInfoMap.end ());
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
+          MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
           if (itStat == m_ulHarqProcessesStatus.end ())
             {
               NS_LOG_ERROR ("No info found in HARQ buffer for UE (might have changed eNB) " << rnti);
@@ -944,7 +894,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
             }
           else if (harqInfo.m_receptionStatus == UlHarqInfo::NotOk)
             {
-              std::map <uint16_t, UlHarqProcessesDciInfoList_t>::iterator itHarq = m_ulHarqProcessesDciInfoMap.find (rnti);
+              MmWaveRntiTable<UlHarqProcessesDciInfoList_t>::iterator itHarq = m_ulHarqProcessesDciInfoMap.find (rnti);
               if (itHarq == m_ulHarqProcessesDciInfoMap.end ())
                 {
                   NS_LOG_ERROR ("No info found in UL-HARQ buffer for UE (might have changed eNB) " << rnti);
@@ -1024,13 +974,14 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
   // ********************* END OF HARQ SECTION, START OF NEW DATA SCHEDULING ********************* //
 
   // compute achievable rates in current subframe
-  for (std::map<uint16_t, UeSchedInfo>::iterator ueIt = m_ueSchedInfoMap.begin (); ueIt != m_ueSchedInfoMap.end (); ueIt++)
+  m_ueStatHeap.clear ();
+  for (MmWaveRntiTable<UeSchedInfo>::iterator ueIt = m_ueSchedInfoMap.begin (); ueIt != m_ueSchedInfoMap.end (); ueIt++)
     {
       UeSchedInfo* ueInfo = &ueIt->second;
 
       // get DL-CQI and compute DL rate per symbol
       bool dlAdded = false;
-      std::map <uint16_t,uint8_t>::iterator itCqiDl = m_wbCqiRxed.find (ueInfo->m_rnti);
+      MmWaveRntiTable<uint8_t>::iterator itCqiDl = m_wbCqiRxed.find (ueInfo->m_rnti);
       uint8_t cqi = 0;
       if (itCqiDl != m_wbCqiRxed.end ())
         {
@@ -1072,7 +1023,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
         }
 
       // get UL-CQI and compute UL rate per symbol
-      std::map <uint16_t, struct UlCqiMapElem>::iterator itCqiUl = m_ueUlCqi.find (ueInfo->m_rnti);
+      MmWaveRntiTable<struct UlCqiMapElem>::iterator itCqiUl = m_ueUlCqi.find (ueInfo->m_rnti);
       int mcs = 0;
       if (itCqiUl != m_ueUlCqi.end ())           // no cqi info for this UE
         {
@@ -1124,81 +1075,63 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
 //		std::cout << frameNum << " " << sfNum << " " << itUeAllocMap->second->m_rlcPduInfo.size () << std::endl;
 //	}
 
-  // allocate each slot to UE with highest PF metric, then update PF metrics
-  while (symAvail > 0)
+  // allocate each symbol to the UE with the highest PF metric, then update
+  // its PF metric and its position in the heap
+  m_ueHeap.Assign (m_ueStatHeap.begin (), m_ueStatHeap.end ());
+  while (symAvail > 0 && !m_ueHeap.Empty ())
     {
-      std::sort (m_ueStatHeap.begin (), m_ueStatHeap.end (),
-                 MmWaveFlexTtiPfMacScheduler::CompareUeWeightsPf);
       // evenly distribute symbols between DL and UL flows of same UE
-      bool ueAlloc = false;
-      std::vector<UeSchedInfo*>::iterator ueHeapIt = m_ueStatHeap.begin ();
-//		for (itUeAllocMap = ueAllocMap.begin (); itUeAllocMap != ueAllocMap.end(); itUeAllocMap++)
-//		{
-//			UeSchedInfo* ueInfo = itUeAllocMap->second;
-//			double pfMetric = std::max(ueInfo->m_currTputDl,ueInfo->m_currTputUl) / std::max(1E-9,(ueInfo->m_avgTputDl + ueInfo->m_avgTputDl));
-//			std::cout << ueInfo->m_rnti << "=" << pfMetric << " ";
-//		}
-//		std::cout << std::endl;
-
-      while (!ueAlloc && ueHeapIt != m_ueStatHeap.end ())
+      UeSchedInfo* ueInfo = m_ueHeap.Top ();
+
+      if (ueInfo->m_totBufDl == 0)
+        {
+          ueInfo->m_dlAllocDone = true;
+        }
+      if (ueInfo->m_totBufUl == 0)
         {
-          UeSchedInfo* ueInfo = *ueHeapIt;
+          ueInfo->m_ulAllocDone = true;
+        }
 
-          if (ueInfo->m_totBufDl == 0)
-            {
-              ueInfo->m_dlAllocDone = true;
-            }
-          if (ueInfo->m_totBufUl == 0)
+      if ((ueInfo->m_allocUlLast || ueInfo->m_dlAllocDone) && !ueInfo->m_ulAllocDone)
+        {
+          ueInfo->m_ulSymbols++;
+          symAvail--;
+          ueInfo->m_ulTbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols) / 8;
+          if (ueInfo->m_ulTbSize >= ueInfo->m_totBufUl)
             {
               ueInfo->m_ulAllocDone = true;
+              ueInfo->m_lastAvgTputUl = ueInfo->m_avgTputUl;
             }
+          ueInfo->m_allocUlLast = true;
 
-          if ((ueInfo->m_allocUlLast || ueInfo->m_dlAllocDone) && !ueInfo->m_ulAllocDone)
-            {
-
-              ueInfo->m_ulSymbols++;
-              symAvail--;
-              ueInfo->m_ulTbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols) / 8;
-              if (ueInfo->m_ulTbSize >= ueInfo->m_totBufUl)
-                {
-                  ueInfo->m_ulAllocDone = true;
-                  ueInfo->m_lastAvgTputUl = ueInfo->m_avgTputUl;
-                }
-              ueInfo->m_allocUlLast = true;
-
-              uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols);
-              ueInfo->m_currTputUl = std::min (ueInfo->m_totBufUl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds());
-              ueInfo->m_avgTputUl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputUl) +
-                ((1.0 / m_timeWindow) * ((double)ueInfo->m_ulTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds())));
-              ueAlloc = true;
-
-            }
-          else if (!ueInfo->m_dlAllocDone)
+          uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_ulMcs, ueInfo->m_ulSymbols);
+          ueInfo->m_currTputUl = std::min (ueInfo->m_totBufUl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds());
+          ueInfo->m_avgTputUl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputUl) +
+            ((1.0 / m_timeWindow) * ((double)ueInfo->m_ulTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds())));
+          m_ueHeap.Update (ueInfo);
+        }
+      else if (!ueInfo->m_dlAllocDone)
+        {
+          ueInfo->m_dlSymbols++;
+          symAvail--;
+          ueInfo->m_dlTbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols) / 8;
+          if (ueInfo->m_dlTbSize >= ueInfo->m_totBufDl)
             {
-
-              ueInfo->m_dlSymbols++;
-              symAvail--;
-              ueInfo->m_dlTbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols) / 8;
-              if (ueInfo->m_dlTbSize >= ueInfo->m_totBufDl)
-                {
-                  ueInfo->m_dlAllocDone = true;
-                  ueInfo->m_lastAvgTputDl = ueInfo->m_avgTputDl;
-                }
-              ueInfo->m_allocUlLast = false;
-
-              uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols);
-              ueInfo->m_currTputDl = std::min (ueInfo->m_totBufDl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds());
-              ueInfo->m_avgTputDl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputDl) +
-                ((1.0 / m_timeWindow) * ((double)ueInfo->m_dlTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds())));
-              ueAlloc = true;
+              ueInfo->m_dlAllocDone = true;
+              ueInfo->m_lastAvgTputDl = ueInfo->m_avgTputDl;
             }
+          ueInfo->m_allocUlLast = false;
 
-          ueHeapIt++;
+          uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ueInfo->m_dlMcs, ueInfo->m_dlSymbols);
+          ueInfo->m_currTputDl = std::min (ueInfo->m_totBufDl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds());
+          ueInfo->m_avgTputDl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputDl) +
+            ((1.0 / m_timeWindow) * ((double)ueInfo->m_dlTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds())));
+          m_ueHeap.Update (ueInfo);
         }
-
-      if (!ueAlloc)
+      else
         {
-          break;
+          // nothing else can be allocated to this UE in this slot
+          m_ueHeap.Pop ();
         }
     }
 
@@ -1270,14 +1203,14 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
 
           if (m_harqOn == true)
             {                   // store DCI for HARQ buffer
-              std::map <uint16_t, DlHarqProcessesDciInfoList_t>::iterator itDciInfo = m_dlHarqProcessesDciInfoMap.find (dci.m_rnti);
+              MmWaveRntiTable<DlHarqProcessesDciInfoList_t>::iterator itDciInfo = m_dlHarqProcessesDciInfoMap.find (dci.m_rnti);
               if (itDciInfo == m_dlHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find RNTI entry in DCI HARQ buffer for RNTI " << dci.m_rnti);
                 }
               (*itDciInfo).second.at (dci.m_harqProcess) = dci;
               // refresh timer
-              std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (dci.m_rnti);
+              MmWaveRntiTable<DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (dci.m_rnti);
               if (itHarqTimer == m_dlHarqProcessesTimer.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)dci.m_rnti);
@@ -1329,7 +1262,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
               if (m_harqOn == true)
                 {
                   // store RLC PDU list for HARQ
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
+                  MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
                   if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
                     {
                       NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << dci.m_rnti);
@@ -1345,7 +1278,7 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
               if (m_harqOn == true)
                 {
                   // store RLC PDU list for HARQ
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
+                  MmWaveRntiTable<DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
                   if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
                     {
                       NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << dci.m_rnti);
@@ -1433,17 +1366,17 @@ MmWaveFlexTtiPfMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapPr
           if (m_harqOn == true)
             {
               uint8_t harqId = dci.m_harqProcess;
-              std::map <uint16_t, UlHarqProcessesDciInfoList_t>::iterator itHarqTbInfo = m_ulHarqProcessesDciInfoMap.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesDciInfoList_t>::iterator itHarqTbInfo = m_ulHarqProcessesDciInfoMap.find (dci.m_rnti);
               if (itHarqTbInfo == m_ulHarqProcessesDciInfoMap.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << dci.m_rnti);
                 }
               (*itHarqTbInfo).second.at (harqId) = dci;
               // Update HARQ process status (RV 0)
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (dci.m_rnti);
               NS_ASSERT (itStat->second[dci.m_harqProcess] > 0);
               // refresh timer
-              std::map <uint16_t, UlHarqProcessesTimer_t>::iterator itHarqTimer =  m_ulHarqProcessesTimer.find (dci.m_rnti);
+              MmWaveRntiTable<UlHarqProcessesTimer_t>::iterator itHarqTimer =  m_ulHarqProcessesTimer.find (dci.m_rnti);
               if (itHarqTimer == m_ulHarqProcessesTimer.end ())
                 {
                   NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)dci.m_rnti);
@@ -1498,20 +1431,19 @@ MmWaveFlexTtiPfMacScheduler::RefreshDlCqiMaps (void)
 {
   NS_LOG_FUNCTION (this << m_wbCqiTimers.size ());
   // refresh DL CQI P01 Map
-  std::map <uint16_t,uint32_t>::iterator itP10 = m_wbCqiTimers.begin ();
+  MmWaveRntiTable<uint32_t>::iterator itP10 = m_wbCqiTimers.begin ();
   while (itP10 != m_wbCqiTimers.end ())
     {
       NS_LOG_INFO (this << " P10-CQI for user " << (*itP10).first << " is " << (uint32_t)(*itP10).second << " thr " << (uint32_t)m_cqiTimersThreshold);
       if ((*itP10).second == 0)
         {
           // delete correspondent entries
-          std::map <uint16_t,uint8_t>::iterator itMap = m_wbCqiRxed.find ((*itP10).first);
+          MmWaveRntiTable<uint8_t>::iterator itMap = m_wbCqiRxed.find ((*itP10).first);
           NS_ASSERT_MSG (itMap != m_wbCqiRxed.end (), " Does not find CQI report for user " << (*itP10).first);
           NS_LOG_INFO (this << " P10-CQI exired for user " << (*itP10).first);
           m_wbCqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itP10;
-          itP10++;
-          m_wbCqiTimers.erase (temp);
+          // the erasure invalidates the iterators, erase returns the next entry
+          itP10 = m_wbCqiTimers.erase (itP10);
         }
       else
         {
@@ -1528,21 +1460,20 @@ void
 MmWaveFlexTtiPfMacScheduler::RefreshUlCqiMaps (void)
 {
   // refresh UL CQI  Map
-  std::map <uint16_t,uint32_t>::iterator itUl = m_ueCqiTimers.begin ();
+  MmWaveRntiTable<uint32_t>::iterator itUl = m_ueCqiTimers.begin ();
   while (itUl != m_ueCqiTimers.end ())
     {
       NS_LOG_INFO (this << " UL-CQI for user " << (*itUl).first << " is " << (uint32_t)(*itUl).second << " thr " << (uint32_t)m_cqiTimersThreshold);
       if ((*itUl).second == 0)
         {
           // delete correspondent entries
-          std::map <uint16_t, struct UlCqiMapElem>::iterator itMap = m_ueUlCqi.find ((*itUl).first);
+          MmWaveRntiTable<struct UlCqiMapElem>::iterator itMap = m_ueUlCqi.find ((*itUl).first);
           NS_ASSERT_MSG (itMap != m_ueUlCqi.end (), " Does not find CQI report for user " << (*itUl).first);
           NS_LOG_INFO (this << " UL-CQI expired for user " << (*itUl).first);
           itMap->second.m_ueUlCqi.clear ();
           m_ueUlCqi.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itUl;
-          itUl++;
-          m_ueCqiTimers.erase (temp);
+          // the erasure invalidates the iterators, erase returns the next entry
+          itUl = m_ueCqiTimers.erase (itUl);
         }
       else
         {
@@ -1610,7 +1541,7 @@ MmWaveFlexTtiPfMacScheduler::UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size
 {
 
   size = size - 2; // remove the minimum RLC overhead
-  std::map <uint16_t,uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
+  MmWaveRntiTable<uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
   if (it != m_ceBsrRxed.end ())
     {
       NS_LOG_INFO (this << " Update RLC BSR UE " << rnti << " size " << size << " BSR " << (*it).second);
@@ -1649,7 +1580,7 @@ MmWaveFlexTtiPfMacScheduler::DoCschedUeConfigReq (const struct MmWaveMacCschedSa
 {
   NS_LOG_FUNCTION (this << " RNTI " << params.m_rnti << " txMode " << (uint16_t)params.m_transmissionMode);
 
-  std::map <uint16_t, struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  MmWaveRntiTable<struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
   if (itUe == m_ueSchedInfoMap.end ())
     {
       itUe = m_ueSchedInfoMap.insert (std::pair <uint16_t, struct UeSchedInfo> (params.m_rnti, UeSchedInfo (params.m_rnti))).first;
@@ -1696,7 +1627,7 @@ void
 MmWaveFlexTtiPfMacScheduler::DoCschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params)
 {
   NS_LOG_FUNCTION (this);
-  std::map <uint16_t, struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  MmWaveRntiTable<struct UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
   if (itUe != m_ueSchedInfoMap.end ())
     {
       for (uint16_t i = 0; i < params.m_logicalChannelConfigList.size (); i++)
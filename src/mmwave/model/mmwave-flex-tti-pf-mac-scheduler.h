@@ -13,6 +13,8 @@
 #include "mmwave-mac-csched-sap.h"
 #include "mmwave-mac-scheduler.h"
 #include "mmwave-amc.h"
+#include "mmwave-rnti-table.h"
+#include "mmwave-indexed-heap.h"
 #include "string"
 #include <vector>
 #include <set>
@@ -143,7 +145,8 @@ private:
         m_currTputUl (0.0),
         m_totBufDl (0),
         m_totBufUl (0),
-        m_allocUlLast (false)
+        m_allocUlLast (false),
+        m_heapIndex (0)
     {
     }
 
@@ -171,7 +174,8 @@ private:
         m_currTputUl (0.0),
         m_totBufDl (0),
         m_totBufUl (0),
-        m_allocUlLast (false)
+        m_allocUlLast (false),
+        m_heapIndex (0)
     {
     }
 
@@ -202,19 +206,21 @@ private:
     uint32_t        m_totBufDl;
     uint32_t        m_totBufUl;
     bool                    m_allocUlLast;
-
+    uint32_t        m_heapIndex; //!< the position of the UE in m_ueHeap
   };
 
   static bool CompareUeWeightsPf (UeSchedInfo* lue, UeSchedInfo* rue)
   {
     double lPfMetric = std::max (lue->m_currTputDl,lue->m_currTputUl) / std::max (1E-9,(lue->m_avgTputDl + lue->m_avgTputDl));
     double rPfMetric = std::max (rue->m_currTputDl,rue->m_currTputUl) / std::max (1E-9,(rue->m_avgTputDl + rue->m_avgTputDl));
-    return (lPfMetric > rPfMetric);
+    if (lPfMetric != rPfMetric)
+      {
+        return (lPfMetric > rPfMetric);
+      }
+    return (lue->m_rnti < rue->m_rnti);         // ties are broken in favour of the lowest RNTI
   }
 
 
-  unsigned CalcMinTbSizeNumSym (unsigned mcs, unsigned bufSize, unsigned &tbSize);
-
   uint32_t
   BsrId2BufferSize (uint8_t val)
   {
@@ -304,11 +310,11 @@ private:
   /*
    * Map of UE's DL CQI WB received
    */
-  std::map <uint16_t,uint8_t> m_wbCqiRxed;
+  MmWaveRntiTable<uint8_t> m_wbCqiRxed;
   /*
    * Map of UE's timers on DL CQI WB received
    */
-  std::map <uint16_t,uint32_t> m_wbCqiTimers;
+  MmWaveRntiTable<uint32_t> m_wbCqiTimers;
 
   uint32_t m_cqiTimersThreshold;       // # of TTIs for which a CQI can be considered valid
 
@@ -317,6 +323,11 @@ private:
    */
   struct UlCqiMapElem
   {
+    UlCqiMapElem ()
+      : m_numSym (0),
+        m_tbSize (0)
+    {
+    }
     UlCqiMapElem (std::vector<double> ulCqi, uint8_t nSym, uint32_t tbs)
       : m_ueUlCqi (ulCqi),
         m_numSym (nSym),
@@ -328,16 +339,16 @@ private:
     uint32_t        m_tbSize;
   };
 
-  std::map <uint16_t, struct UlCqiMapElem> m_ueUlCqi;
+  MmWaveRntiTable<struct UlCqiMapElem> m_ueUlCqi;
   /*
    * Map of UEs' timers on UL-CQI per RBG
    */
-  std::map <uint16_t, uint32_t> m_ueCqiTimers;
+  MmWaveRntiTable<uint32_t> m_ueCqiTimers;
 
   /*
    * Map of UE's buffer status reports received
    */
-  std::map <uint16_t,uint32_t> m_ceBsrRxed;
+  MmWaveRntiTable<uint32_t> m_ceBsrRxed;
 
   uint16_t m_nextRnti;
   uint64_t m_nextRntiDl;
@@ -382,24 +393,24 @@ private:
   uint8_t m_numHarqProcess;
   uint8_t m_harqTimeout;
 
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId;
+  MmWaveRntiTable<uint8_t> m_dlHarqCurrentProcessId;
   //HARQ status
   // 0: process Id available
   // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus;
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;
-  std::map <uint16_t, DlHarqProcessesDciInfoList_t> m_dlHarqProcessesDciInfoMap;
-  std::map <uint16_t, DlHarqRlcPduList_t> m_dlHarqProcessesRlcPduMap;
+  MmWaveRntiTable<DlHarqProcessesStatus_t> m_dlHarqProcessesStatus;
+  MmWaveRntiTable<DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;
+  MmWaveRntiTable<DlHarqProcessesDciInfoList_t> m_dlHarqProcessesDciInfoMap;
+  MmWaveRntiTable<DlHarqRlcPduList_t> m_dlHarqProcessesRlcPduMap;
   std::vector <DlHarqInfo> m_dlHarqInfoList;       // HARQ retx buffered
   std::vector <UlHarqInfo> m_ulHarqInfoList;       // HARQ retx buffered
 
-  std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId;
+  MmWaveRntiTable<uint8_t> m_ulHarqCurrentProcessId;
   //HARQ status
   // 0: process Id available
   // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, UlHarqProcessesStatus_t>    m_ulHarqProcessesStatus;
-  std::map <uint16_t, UlHarqProcessesTimer_t>     m_ulHarqProcessesTimer;
-  std::map <uint16_t, UlHarqProcessesDciInfoList_t> m_ulHarqProcessesDciInfoMap;
+  MmWaveRntiTable<UlHarqProcessesStatus_t>    m_ulHarqProcessesStatus;
+  MmWaveRntiTable<UlHarqProcessesTimer_t>     m_ulHarqProcessesTimer;
+  MmWaveRntiTable<UlHarqProcessesDciInfoList_t> m_ulHarqProcessesDciInfoMap;
 
   // needed to keep track of uplink allocations in later slots
   std::list <struct SlotAllocInfo> m_ulSfAllocInfo;
@@ -422,7 +433,7 @@ private:
   //typedef std::priority_queue <FlowStats, std::vector<FlowStats*>, CompareWeightDesc> flowQueue_t;
   //flowQueue_t m_flowQueue;
 
-  std::map<uint16_t, UeSchedInfo> m_ueSchedInfoMap;
+  MmWaveRntiTable<UeSchedInfo> m_ueSchedInfoMap;
   std::vector <UeSchedInfo*> m_ueSchedInfoHeap;
 
   bool m_fixedTti;                      // one slot per TTI
@@ -431,7 +442,8 @@ private:
   double m_timeWindow;
 
   std::vector <FlowStats*> m_flowHeap;
-  std::vector <UeSchedInfo*> m_ueStatHeap;
+  std::vector <UeSchedInfo*> m_ueStatHeap; //!< the UEs with data to transmit in the current slot
+  MmWaveIndexedHeap<UeSchedInfo, &UeSchedInfo::m_heapIndex> m_ueHeap; //!< the UEs of m_ueStatHeap which can still be allocated, ordered by PF metric
 };
 
 }
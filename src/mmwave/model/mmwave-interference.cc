@@ -64,6 +64,7 @@ mmWaveInterference::DoDispose ()
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
+  m_sinrIntegral = 0;
   Object::DoDispose ();
 }
 
@@ -86,6 +87,15 @@ mmWaveInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
     {
       NS_LOG_LOGIC ("first signal");
       m_rxSignal = rxPsd->Copy ();
+      if (m_sinrIntegral == 0 || m_sinrIntegral->GetSpectrumModelUid () != rxPsd->GetSpectrumModelUid ())
+        {
+          m_sinrIntegral = Create<SpectrumValue> (rxPsd->GetSpectrumModel ());
+        }
+      else
+        {
+          (*m_sinrIntegral) = 0.0;
+        }
+      m_rxStartTime = Now ();
       m_lastChangeTime = Now ();
       m_receiving = true;
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_PowerChunkProcessorList.begin (); it != m_PowerChunkProcessorList.end (); ++it)
@@ -121,12 +131,28 @@ mmWaveInterference::EndRx ()
     {
       ConditionallyEvaluateChunk ();
       m_receiving = false;
+      // the chunk processors get a single chunk with the average SINR of
+      // the reception, which gives them the same time-weighted average
+      Time duration = Now () - m_rxStartTime;
+      SpectrumValue sinr = (*m_sinrIntegral);
+      if (duration.IsStrictlyPositive ())
+        {
+          sinr /= duration.GetSeconds ();
+        }
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_PowerChunkProcessorList.begin (); it != m_PowerChunkProcessorList.end (); ++it)
         {
+          if (duration.IsStrictlyPositive ())
+            {
+              (*it)->EvaluateChunk (*m_rxSignal, duration);
+            }
           (*it)->End ();
         }
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
         {
+          if (duration.IsStrictlyPositive ())
+            {
+              (*it)->EvaluateChunk (sinr, duration);
+            }
           (*it)->End ();
         }
     }
@@ -152,11 +178,24 @@ mmWaveInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration
 }
 
 
+bool
+mmWaveInterference::OverlapsRxSignal (Ptr<const SpectrumValue> spd) const
+{
+  // a signal outside the bands of the received signal does not change its
+  // SINR, so the current chunk can go on
+  return m_receiving
+         && spd->GetOccupiedBegin () < m_rxSignal->GetOccupiedEnd ()
+         && m_rxSignal->GetOccupiedBegin () < spd->GetOccupiedEnd ();
+}
+
 void
 mmWaveInterference::DoAddSignal (Ptr<const SpectrumValue> spd)
 {
   NS_LOG_FUNCTION (this << *spd);
-  ConditionallyEvaluateChunk ();
+  if (OverlapsRxSignal (spd))
+    {
+      ConditionallyEvaluateChunk ();
+    }
   (*m_allSignals) += (*spd);
 }
 
@@ -164,7 +203,10 @@ void
 mmWaveInterference::DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId)
 {
   NS_LOG_FUNCTION (this << *spd);
-  ConditionallyEvaluateChunk ();
+  if (OverlapsRxSignal (spd))
+    {
+      ConditionallyEvaluateChunk ();
+    }
   int32_t deltaSignalId = signalId - m_lastSignalIdBeforeReset;
   if (deltaSignalId > 0)
     {
@@ -189,16 +231,16 @@ mmWaveInterference::ConditionallyEvaluateChunk ()
   if (m_receiving && (Now () > m_lastChangeTime))
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
-      SpectrumValue sinr = (*m_rxSignal) / interf;
-      Time duration = Now () - m_lastChangeTime;
-      for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_PowerChunkProcessorList.begin (); it != m_PowerChunkProcessorList.end (); ++it)
-        {
-          (*it)->EvaluateChunk (*m_rxSignal, duration);
-        }
-      for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
+      // add signal / (allSignals - signal + noise) * duration to the SINR
+      // integral, over the bands of the signal
+      double duration = (Now () - m_lastChangeTime).GetSeconds ();
+      double *integral = m_sinrIntegral->ValuesData (m_rxSignal->GetOccupiedBegin (), m_rxSignal->GetOccupiedEnd ());
+      Values::const_iterator signal = m_rxSignal->ConstValuesBegin ();
+      Values::const_iterator allSignals = m_allSignals->ConstValuesBegin ();
+      Values::const_iterator noise = m_noise->ConstValuesBegin ();
+      for (size_t i = m_rxSignal->GetOccupiedBegin (); i < m_rxSignal->GetOccupiedEnd (); i++)
         {
-          (*it)->EvaluateChunk (sinr, duration);
+          integral[i] += signal[i] / (allSignals[i] - signal[i] + noise[i]) * duration;
         }
       m_lastChangeTime = Now ();
     }
@@ -58,6 +58,7 @@ public:
 
 private:
   void ConditionallyEvaluateChunk ();
+  bool OverlapsRxSignal (Ptr<const SpectrumValue> spd) const;
   void DoAddSignal (Ptr<const SpectrumValue> spd);
   void DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId);
   std::list<Ptr<mmWaveChunkProcessor> > m_PowerChunkProcessorList;
@@ -70,6 +71,11 @@ private:
   Ptr<SpectrumValue> m_allSignals;
   Ptr<const SpectrumValue> m_noise;
 
+  // time integral of the SINR of the current reception, updated at the end
+  // of each chunk and passed to the chunk processors at the end of the rx
+  Ptr<SpectrumValue> m_sinrIntegral;
+
+  Time m_rxStartTime;
   Time m_lastChangeTime;
 
   uint32_t m_lastSignalId;
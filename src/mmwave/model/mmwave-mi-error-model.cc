@@ -31,6 +31,7 @@
 
 
 
+#include <algorithm>
 #include <list>
 #include <vector>
 #include <ns3/log.h>
@@ -50,86 +51,76 @@ namespace ns3 {
 namespace mmwave {
 
 
-double
-MmWaveMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/**
+ * Computes the mean MI of the RBs of a TB, for the modulation whose MI map
+ * is passed as argument
+ * \param miMap the MI map of the modulation
+ * \param axis the SINR axis of the MI map
+ * \param sinr the perceived sinrs in the whole bandwidth
+ * \param map the actives RBs for the TB
+ * \return the mean MI
+ */
+template <uint16_t Size>
+static double
+MibKernel (const double (&miMap)[Size], const double (&axis)[Size], const SpectrumValue& sinr, const std::vector<int>& map)
 {
-  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+  // since the values in the axis are uniformly spaced, we have
+  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+  const double scalingCoeff = (Size - 1) / (axis[Size - 1] - axis[0]);
+  const double axisMin = axis[0];
+  const double axisMax = axis[Size - 1];
 
-  double MI;
+  // the RBs are processed in blocks: the SINR values are gathered and the
+  // indexes in the MI map are computed without branches, so that the loop
+  // can be vectorized by the compiler
+  static const size_t blockSize = 64;
+  double sinrBlock[blockSize];
+  uint32_t indexBlock[blockSize];
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-
-  for (uint32_t i = 0; i < map.size (); i++)
+  for (size_t start = 0; start < map.size (); start += blockSize)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MMWAVE_MI_QPSK_MAX_ID) // QPSK
+      size_t len = std::min (blockSize, map.size () - start);
+      for (size_t i = 0; i < len; i++)
         {
-
-          if (sinrLin > MI_map_qpsk_axis[MMWAVE_MI_MAP_QPSK_SIZE - 1])
-            {
-              MI = 1;
-            }
-          else
-            {
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk =
-                (MMWAVE_MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MMWAVE_MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
+          sinrBlock[i] = sinr[map[start + i]];
         }
-      else
+      for (size_t i = 0; i < len; i++)
         {
-          if (mcs > MMWAVE_MI_QPSK_MAX_ID && mcs <= MMWAVE_MI_16QAM_MAX_ID )    // 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MMWAVE_MI_MAP_16QAM_SIZE - 1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam =
-                    (MMWAVE_MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MMWAVE_MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MMWAVE_MI_MAP_64QAM_SIZE - 1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam =
-                    (MMWAVE_MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MMWAVE_MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
+          double sinrIndexDouble = std::floor ((sinrBlock[i] - axisMin) * scalingCoeff + 1);
+          // values above the axis are saturated to MI = 1 below, the index
+          // is only clamped to stay within the map, and a NaN SINR, which
+          // would survive the clamp, is mapped to the first index
+          sinrIndexDouble = sinrIndexDouble == sinrIndexDouble ? sinrIndexDouble : 0.0;
+          indexBlock[i] = static_cast<uint32_t> (std::min (std::max (sinrIndexDouble, 0.0), Size - 1.0));
+        }
+      for (size_t i = 0; i < len; i++)
+        {
+          double MI = sinrBlock[i] > axisMax ? 1.0 : miMap[indexBlock[i]];
+          NS_LOG_LOGIC (" RB " << map[start + i] << "Minimum SNR = " << 10 * std::log10 (sinrBlock[i]) << " dB, " << sinrBlock[i] << " V, MI = " << MI);
+          MIsum += MI;
         }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
-      MIsum += MI;
     }
-  MI = MIsum / map.size ();
+  return MIsum / map.size ();
+}
+
+double
+MmWaveMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+
+  double MI;
+  if (mcs <= MMWAVE_MI_QPSK_MAX_ID) // QPSK
+    {
+      MI = MibKernel (MI_map_qpsk, MI_map_qpsk_axis, sinr, map);
+    }
+  else if (mcs <= MMWAVE_MI_16QAM_MAX_ID) // 16-QAM
+    {
+      MI = MibKernel (MI_map_16qam, MI_map_16qam_axis, sinr, map);
+    }
+  else // 64-QAM
+    {
+      MI = MibKernel (MI_map_64qam, MI_map_64qam_axis, sinr, map);
+    }
   NS_LOG_LOGIC (" MI = " << MI);
   return MI;
 }
@@ -180,7 +171,7 @@ MmWaveMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint32_t cbSize)
 }
 
 MmWaveTbStats_t
-MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint32_t size, uint8_t mcs, MmWaveHarqProcessInfoList_t miHistory)
+MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint32_t size, uint8_t mcs, const MmWaveHarqProcessInfoList_t& miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
@@ -193,15 +184,16 @@ MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const s
       // evaluate R_eff and MI_eff
       uint32_t codeBitsSum = 0;
       double miSum = 0.0;
-      for (uint16_t i = 0; i < miHistory.size (); i++)
+      for (const MmWaveHarqProcessInfoElement_t &harqInfo : miHistory)
         {
-          NS_LOG_DEBUG (" Sum MI " << miHistory.at (i).m_mi << " Ci " << miHistory.at (i).m_codeBits);
-          codeBitsSum += miHistory.at (i).m_codeBits;
-          miSum += (miHistory.at (i).m_mi * miHistory.at (i).m_codeBits);
+          NS_LOG_DEBUG (" Sum MI " << harqInfo.m_mi << " Ci " << harqInfo.m_codeBits);
+          codeBitsSum += harqInfo.m_codeBits;
+          miSum += (harqInfo.m_mi * harqInfo.m_codeBits);
         }
-      codeBitsSum += (((double)size * 8.0) / McsEcrTable [mcs]);
-      miSum += (tbMi * (((double)size * 8.0) / McsEcrTable [mcs]));
-      Reff = miHistory.at (0).m_infoBits / (double)codeBitsSum; // information bits are the size of the first TB
+      double codeBits = ((double)size * 8.0) / McsEcrTable [mcs];
+      codeBitsSum += codeBits;
+      miSum += (tbMi * codeBits);
+      Reff = miHistory.front ().m_infoBits / (double)codeBitsSum; // information bits are the size of the first TB
       MI = miSum / (double)codeBitsSum;
     }
   else
@@ -209,6 +201,66 @@ MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const s
       MI = tbMi;
     }
   NS_LOG_DEBUG (" MI " << MI << " Reff " << Reff << " HARQ " << miHistory.size ());
+
+  uint8_t ecrId = 0;
+  if (miHistory.size () == 0)
+    {
+      // first tx -> get ECR from MCS
+      ecrId = McsEcrBlerTableMapping[mcs];
+      NS_LOG_DEBUG ("NO HARQ MCS " << (uint16_t)mcs << " ECR id " << (uint16_t)ecrId);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("HARQ block no. " << miHistory.size ());
+      // harq retx -> get closest ECR to Reff from available ones
+      if (mcs <= MMWAVE_MI_QPSK_MAX_ID)
+        {
+          // Modulation order 2
+          uint8_t i = MMWAVE_MI_QPSK_BLER_MAX_ID;
+          while ((BlerCurvesEcrMap[i] > Reff)&&(i > 0))
+            {
+              i--;
+            }
+          ecrId = i;
+        }
+      else if (mcs <= MMWAVE_MI_16QAM_MAX_ID)
+        {
+          // Modulation order 4
+          uint8_t i = MMWAVE_MI_16QAM_BLER_MAX_ID;
+          while ((BlerCurvesEcrMap[i] > Reff)&&(i > MMWAVE_MI_QPSK_BLER_MAX_ID + 1))
+            {
+              i--;
+            }
+          ecrId = i;
+        }
+      else
+        {
+          // Modulation order 6
+          uint8_t i = MMWAVE_MI_64QAM_BLER_MAX_ID;
+          while ((BlerCurvesEcrMap[i] > Reff)&&(i > MMWAVE_MI_16QAM_BLER_MAX_ID + 1))
+            {
+              i--;
+            }
+          ecrId = i;
+        }
+      NS_LOG_DEBUG ("HARQ ECR " << (uint16_t)ecrId);
+    }
+
+  double errorRate = MappingMiTbler (MI, ecrId, size);
+  NS_LOG_LOGIC (" Error rate " << errorRate);
+  MmWaveTbStats_t ret;
+  ret.tbler = errorRate;
+  ret.mi = tbMi;
+  ret.miTotal = MI;
+  return ret;
+}
+
+
+double
+MmWaveMiErrorModel::MappingMiTbler (double mi, uint8_t ecrId, uint32_t size)
+{
+  NS_LOG_FUNCTION (mi << (uint32_t) ecrId << size);
+  double MI = mi;
   // estimate CB size (according to sec 5.1.2 of TS 36.212)
   uint16_t Z = 6144; // max size of a codeblock (including CRC)
   uint32_t B = size * 8;
@@ -303,50 +355,6 @@ MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const s
   NS_LOG_INFO ("--------------------LteMiErrorModel: TB size of " << B << " needs of " << B1 << " bits reparted in " << C << " CBs as " << Cplus << " block(s) of " << Kplus << " and " << Cminus << " of " << Kminus);
 
   double errorRate = 1.0;
-  uint8_t ecrId = 0;
-  if (miHistory.size () == 0)
-    {
-      // first tx -> get ECR from MCS
-      ecrId = McsEcrBlerTableMapping[mcs];
-      NS_LOG_DEBUG ("NO HARQ MCS " << (uint16_t)mcs << " ECR id " << (uint16_t)ecrId);
-    }
-  else
-    {
-      NS_LOG_DEBUG ("HARQ block no. " << miHistory.size ());
-      // harq retx -> get closest ECR to Reff from available ones
-      if (mcs <= MMWAVE_MI_QPSK_MAX_ID)
-        {
-          // Modulation order 2
-          uint8_t i = MMWAVE_MI_QPSK_BLER_MAX_ID;
-          while ((BlerCurvesEcrMap[i] > Reff)&&(i > 0))
-            {
-              i--;
-            }
-          ecrId = i;
-        }
-      else if (mcs <= MMWAVE_MI_16QAM_MAX_ID)
-        {
-          // Modulation order 4
-          uint8_t i = MMWAVE_MI_16QAM_BLER_MAX_ID;
-          while ((BlerCurvesEcrMap[i] > Reff)&&(i > MMWAVE_MI_QPSK_BLER_MAX_ID + 1))
-            {
-              i--;
-            }
-          ecrId = i;
-        }
-      else
-        {
-          // Modulation order 6
-          uint8_t i = MMWAVE_MI_64QAM_BLER_MAX_ID;
-          while ((BlerCurvesEcrMap[i] > Reff)&&(i > MMWAVE_MI_16QAM_BLER_MAX_ID + 1))
-            {
-              i--;
-            }
-          ecrId = i;
-        }
-      NS_LOG_DEBUG ("HARQ ECR " << (uint16_t)ecrId);
-    }
-
   if (C != 1)
     {
       double cbler = MappingMiBler (MI, ecrId, Kplus);
@@ -360,12 +368,47 @@ MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const s
       errorRate = MappingMiBler (MI, ecrId, Kplus);
     }
 
-  NS_LOG_LOGIC (" Error rate " << errorRate);
-  MmWaveTbStats_t ret;
-  ret.tbler = errorRate;
-  ret.mi = tbMi;
-  ret.miTotal = MI;
-  return ret;
+  return errorRate;
+}
+
+double
+MmWaveMiErrorModel::GetMiThreshold (uint8_t mcs, uint32_t size, double tbler)
+{
+  NS_LOG_FUNCTION ((uint32_t) mcs << size << tbler);
+  NS_ASSERT (mcs < 29);
+  uint8_t ecrId = McsEcrBlerTableMapping[mcs];
+
+  // the MI is normalized, and the error rate decreases with the MI
+  if (MappingMiTbler (1.0, ecrId, size) > tbler)
+    {
+      return 2.0;
+    }
+  double low = 0.0;
+  double high = 1.0;
+  if (MappingMiTbler (low, ecrId, size) <= tbler)
+    {
+      return low;
+    }
+  // bisect until the interval can not be further reduced, so that high is
+  // the smallest representable MI which meets the target
+  while (true)
+    {
+      double mid = low + (high - low) / 2;
+      if (mid <= low || mid >= high)
+        {
+          break;
+        }
+      if (MappingMiTbler (mid, ecrId, size) <= tbler)
+        {
+          high = mid;
+        }
+      else
+        {
+          low = mid;
+        }
+    }
+  NS_LOG_LOGIC ("MCS " << (uint32_t) mcs << " size " << size << " MI threshold " << high);
+  return high;
 }
 
 
@@ -351,9 +351,28 @@ public:
    * \param map the actives RBs for the TB
    * \param size the size in bytes of the TB
    * \param mcs the MCS of the TB
+   * \param miHistory the MI and code bits of the previous transmissions of the TB (HARQ)
    * \return the TB error rate and MI
    */
-  static MmWaveTbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint32_t size, uint8_t mcs, MmWaveHarqProcessInfoList_t miHistory);
+  static MmWaveTbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint32_t size, uint8_t mcs, const MmWaveHarqProcessInfoList_t& miHistory);
+
+  /**
+   * \brief map the MI of a TB to its error rate, accounting for the code block segmentation
+   * \param mi the (effective) MI of the TB
+   * \param ecrId Effective Code Rate ID
+   * \param size the size in bytes of the TB
+   * \return the TB error rate
+   */
+  static double MappingMiTbler (double mi, uint8_t ecrId, uint32_t size);
+
+  /**
+   * \brief find the minimum MI which guarantees the target error rate at the first transmission of a TB
+   * \param mcs the MCS of the TB
+   * \param size the size in bytes of the TB
+   * \param tbler the target TB error rate
+   * \return the minimum MI, or a value greater than 1 if the target can not be met
+   */
+  static double GetMiThreshold (uint8_t mcs, uint32_t size, double tbler);
 
 
 //private:
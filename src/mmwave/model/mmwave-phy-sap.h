@@ -61,6 +61,16 @@ public:
    * \param slotAllocInfo the slot allocation info created by the scheduler.
    */
   virtual void SetSlotAllocInfo (SlotAllocInfo slotAllocInfo) = 0;
+
+  /**
+   * Asks the PHY to deliver the slot indications of the next slot to the MAC.
+   *
+   * A PHY which stops its slot timing while idle (see the CoalescedSlotTiming attribute of
+   * MmWaveUePhy) is woken up, so that the MAC can send its pending reports. Waking up may deliver
+   * at once a slot indication which only updates the slot counters of the MAC, hence the MAC should
+   * request the indications before flagging the reports, which are sent at the next TTI.
+   */
+  virtual void RequestSlotIndication (void) = 0;
 };
 
 /* Phy to Mac comm */
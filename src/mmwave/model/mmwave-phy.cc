@@ -67,6 +67,8 @@ public:
 
   virtual void SetSlotAllocInfo (SlotAllocInfo slotAllocInfo);
 
+  virtual void RequestSlotIndication (void);
+
 private:
   MmWavePhy* m_phy;
 };
@@ -101,6 +103,12 @@ MmWaveMemberPhySapProvider::SetSlotAllocInfo (SlotAllocInfo slotAllocInfo)
   m_phy->DoSetSlotAllocInfo (slotAllocInfo);
 }
 
+void
+MmWaveMemberPhySapProvider::RequestSlotIndication (void)
+{
+  m_phy->DoRequestSlotIndication ();
+}
+
 TypeId
 MmWavePhy::GetTypeId ()
 {
@@ -267,6 +275,26 @@ MmWavePhy::SetControlMessage (Ptr<MmWaveControlMessage> m)
     }
 }
 
+bool
+MmWavePhy::HasPendingControlMessages (void) const
+{
+  for (std::vector< std::list<Ptr<MmWaveControlMessage> > >::const_iterator it = m_controlMessageQueue.begin ();
+       it != m_controlMessageQueue.end (); ++it)
+    {
+      if (!it->empty ())
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+MmWavePhy::DoRequestSlotIndication (void)
+{
+  // the slot indications are never stopped by default
+}
+
 std::list<Ptr<MmWaveControlMessage> >
 MmWavePhy::GetControlMessages (void)
 {
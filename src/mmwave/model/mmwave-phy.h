@@ -106,9 +106,21 @@ public:
   void SetNoiseFigure (double nf);
   double GetNoiseFigure (void) const;
 
-  void SetControlMessage (Ptr<MmWaveControlMessage> m);
+  virtual void SetControlMessage (Ptr<MmWaveControlMessage> m);
   std::list<Ptr<MmWaveControlMessage> > GetControlMessages (void);
 
+  /**
+   * \returns true if some control messages are waiting to be transmitted
+   */
+  bool HasPendingControlMessages (void) const;
+
+  /**
+   * Called by the MAC, through the PHY SAP, when it needs the slot indications of the next slot.
+   *
+   * The default implementation does nothing, since the slot indications are delivered at every TTI.
+   */
+  virtual void DoRequestSlotIndication (void);
+
   virtual void SetMacPdu (Ptr<Packet> pb);
 
   virtual void SendRachPreamble (uint32_t PreambleId, uint32_t Rnti);
@@ -0,0 +1,427 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef MMWAVE_RNTI_TABLE_H
+#define MMWAVE_RNTI_TABLE_H
+
+#include <ns3/abort.h>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * \brief Table of per-UE values, indexed by RNTI
+ *
+ * The schedulers keep several pieces of per-UE state, each in its own
+ * table, i.e., as a struct of arrays indexed by RNTI. The values are stored
+ * in RNTI order in fixed-size pages of consecutive RNTIs, with a bit mask of
+ * the RNTIs in use in each page, so that a lookup, an insertion or an
+ * erasure is a direct access, and the iteration visits the values in
+ * increasing RNTI order, as for a std::map, which the round robin resume
+ * and the tie-breaking of the schedulers depend on. A page is allocated by
+ * the first insertion of one of its RNTIs and freed by the erasure of the
+ * last one, so that the memory depends on the RNTIs in the table, not on the
+ * largest RNTI ever allocated.
+ *
+ * The values never move: the references to a value, and the iterators to
+ * it, stay valid until the value is erased or the table is cleared. This is
+ * relied upon by the PF, MaxRate and MaxWeight flow lists, which point to
+ * the value of their UE. The interface mimics the subset of std::map used
+ * by the schedulers.
+ */
+template <class T>
+class MmWaveRntiTable
+{
+public:
+  typedef uint16_t key_type;
+  typedef T mapped_type;
+  typedef std::pair<uint16_t, T> value_type;
+
+private:
+  /// Number of RNTIs in a page, one per bit of the mask
+  static const uint32_t PAGE_SIZE = 64;
+  /// Position of the end, after the largest RNTI
+  static const uint32_t END = 65536;
+
+  /**
+   * The values of PAGE_SIZE consecutive RNTIs
+   */
+  struct Page
+  {
+    /**
+     * Constructor
+     * \param first the first RNTI of the page
+     */
+    Page (uint32_t first)
+      : m_used (0)
+    {
+      for (uint32_t i = 0; i < PAGE_SIZE; i++)
+        {
+          m_values[i].first = first + i;
+        }
+    }
+
+    uint64_t m_used; //!< the mask of the RNTIs in the table
+    value_type m_values[PAGE_SIZE]; //!< the values, used or free
+  };
+
+  /**
+   * Iterator over the values, in RNTI order
+   */
+  template <class Table, class Value>
+  class Iterator
+  {
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    Iterator ()
+      : m_table (0),
+        m_rnti (END)
+    {
+    }
+    Iterator (Table *table, uint32_t rnti)
+      : m_table (table),
+        m_rnti (rnti)
+    {
+    }
+    /**
+     * Conversion from iterator to const_iterator
+     * \param o the iterator
+     */
+    template <class OtherTable, class OtherValue>
+    Iterator (const Iterator<OtherTable, OtherValue> &o)
+      : m_table (o.m_table),
+        m_rnti (o.m_rnti)
+    {
+    }
+
+    reference operator* () const
+    {
+      return m_table->m_pages[m_rnti / PAGE_SIZE]->m_values[m_rnti % PAGE_SIZE];
+    }
+    pointer operator-> () const
+    {
+      return &m_table->m_pages[m_rnti / PAGE_SIZE]->m_values[m_rnti % PAGE_SIZE];
+    }
+    Iterator& operator++ ()
+    {
+      m_rnti = m_table->Next (m_rnti + 1);
+      return *this;
+    }
+    Iterator operator++ (int)
+    {
+      Iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    template <class OtherTable, class OtherValue>
+    bool operator== (const Iterator<OtherTable, OtherValue> &o) const
+    {
+      return m_rnti == o.m_rnti;
+    }
+    template <class OtherTable, class OtherValue>
+    bool operator!= (const Iterator<OtherTable, OtherValue> &o) const
+    {
+      return m_rnti != o.m_rnti;
+    }
+
+    Table *m_table; //!< the table
+    uint32_t m_rnti; //!< the RNTI of the value, or END
+  };
+
+public:
+  typedef Iterator<MmWaveRntiTable<T>, value_type> iterator;
+  typedef Iterator<const MmWaveRntiTable<T>, const value_type> const_iterator;
+
+  MmWaveRntiTable ()
+    : m_size (0)
+  {
+  }
+  MmWaveRntiTable (const MmWaveRntiTable<T> &o)
+    : m_size (0)
+  {
+    *this = o;
+  }
+  ~MmWaveRntiTable ()
+  {
+    for (uint32_t i = 0; i < m_pages.size (); i++)
+      {
+        delete m_pages[i];
+      }
+  }
+  MmWaveRntiTable<T>& operator= (const MmWaveRntiTable<T> &o)
+  {
+    if (this != &o)
+      {
+        clear ();
+        for (const_iterator it = o.begin (); it != o.end (); ++it)
+          {
+            insert (*it);
+          }
+      }
+    return *this;
+  }
+
+  iterator begin ()
+  {
+    return iterator (this, Next (0));
+  }
+  iterator end ()
+  {
+    return iterator (this, END);
+  }
+  const_iterator begin () const
+  {
+    return const_iterator (this, Next (0));
+  }
+  const_iterator end () const
+  {
+    return const_iterator (this, END);
+  }
+
+  /**
+   * \return the number of UEs in the table
+   */
+  size_t size () const
+  {
+    return m_size;
+  }
+  /**
+   * \return true if there are no UEs in the table
+   */
+  bool empty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return an iterator to the value of the UE, or end () if not found
+   */
+  iterator find (uint16_t rnti)
+  {
+    return iterator (this, Contains (rnti) ? rnti : END);
+  }
+  /**
+   * \param rnti the RNTI
+   * \return an iterator to the value of the UE, or end () if not found
+   */
+  const_iterator find (uint16_t rnti) const
+  {
+    return const_iterator (this, Contains (rnti) ? rnti : END);
+  }
+  /**
+   * \param rnti the RNTI
+   * \return 1 if the UE is in the table, 0 otherwise
+   */
+  size_t count (uint16_t rnti) const
+  {
+    return Contains (rnti) ? 1 : 0;
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return the value of the UE, which must be in the table
+   */
+  T& at (uint16_t rnti)
+  {
+    NS_ABORT_MSG_UNLESS (Contains (rnti), "RNTI " << rnti << " not found");
+    return m_pages[rnti / PAGE_SIZE]->m_values[rnti % PAGE_SIZE].second;
+  }
+  /**
+   * \param rnti the RNTI
+   * \return the value of the UE, which must be in the table
+   */
+  const T& at (uint16_t rnti) const
+  {
+    NS_ABORT_MSG_UNLESS (Contains (rnti), "RNTI " << rnti << " not found");
+    return m_pages[rnti / PAGE_SIZE]->m_values[rnti % PAGE_SIZE].second;
+  }
+  /**
+   * \param rnti the RNTI
+   * \return the value of the UE, which is default constructed if the UE is not in the table
+   */
+  T& operator[] (uint16_t rnti)
+  {
+    if (Contains (rnti))
+      {
+        return m_pages[rnti / PAGE_SIZE]->m_values[rnti % PAGE_SIZE].second;
+      }
+    return insert (value_type (rnti, T ())).first->second;
+  }
+
+  /**
+   * Inserts the value of a UE, if the UE is not in the table yet
+   * \param value a pair with the RNTI and the value
+   * \return a pair with an iterator to the value of the UE, and true if the value was inserted
+   */
+  template <class Pair>
+  std::pair<iterator, bool> insert (const Pair &value)
+  {
+    uint16_t rnti = value.first;
+    if (Contains (rnti))
+      {
+        return std::make_pair (iterator (this, rnti), false);
+      }
+    uint32_t page = rnti / PAGE_SIZE;
+    if (page >= m_pages.size ())
+      {
+        m_pages.resize (page + 1, 0);
+      }
+    if (m_pages[page] == 0)
+      {
+        m_pages[page] = new Page (page * PAGE_SIZE);
+      }
+    m_pages[page]->m_used |= Bit (rnti);
+    m_pages[page]->m_values[rnti % PAGE_SIZE].second = value.second;
+    m_size++;
+    return std::make_pair (iterator (this, rnti), true);
+  }
+
+  /**
+   * Removes the value of a UE
+   * \param rnti the RNTI
+   * \return the number of removed values
+   */
+  size_t erase (uint16_t rnti)
+  {
+    if (!Contains (rnti))
+      {
+        return 0;
+      }
+    Remove (rnti);
+    return 1;
+  }
+  /**
+   * Removes the value pointed by an iterator
+   * \param it the iterator
+   * \return an iterator to the value with the next RNTI, or end ()
+   */
+  iterator erase (iterator it)
+  {
+    Remove (it.m_rnti);
+    return iterator (this, Next (it.m_rnti + 1));
+  }
+
+  /**
+   * Removes all the values. The pages are kept, and so are the values,
+   * which are overwritten when their RNTI is inserted again, so that a
+   * table refilled at each slot does not allocate.
+   */
+  void clear ()
+  {
+    for (uint32_t i = 0; i < m_pages.size (); i++)
+      {
+        if (m_pages[i] != 0)
+          {
+            m_pages[i]->m_used = 0;
+          }
+      }
+    m_size = 0;
+  }
+
+private:
+  /**
+   * \param rnti the RNTI
+   * \return the bit of the RNTI in the mask of its page
+   */
+  static uint64_t Bit (uint32_t rnti)
+  {
+    return static_cast<uint64_t> (1) << (rnti % PAGE_SIZE);
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return true if the UE is in the table
+   */
+  bool Contains (uint32_t rnti) const
+  {
+    uint32_t page = rnti / PAGE_SIZE;
+    return page < m_pages.size () && m_pages[page] != 0 && (m_pages[page]->m_used & Bit (rnti)) != 0;
+  }
+
+  /**
+   * \param rnti the RNTI to start from
+   * \return the lowest RNTI in the table not lower than rnti, or END
+   */
+  uint32_t Next (uint32_t rnti) const
+  {
+    for (uint32_t page = rnti / PAGE_SIZE; page < m_pages.size (); page++)
+      {
+        if (m_pages[page] == 0)
+          {
+            continue;
+          }
+        uint64_t used = m_pages[page]->m_used;
+        if (page == rnti / PAGE_SIZE)
+          {
+            // skip the RNTIs before rnti
+            used &= ~(Bit (rnti) - 1);
+          }
+        if (used != 0)
+          {
+            return page * PAGE_SIZE + __builtin_ctzll (used);
+          }
+      }
+    return END;
+  }
+
+  /**
+   * Removes the value of a UE in the table, and frees its page if it was
+   * the last one. The other values do not move.
+   * \param rnti the RNTI
+   */
+  void Remove (uint32_t rnti)
+  {
+    Page *page = m_pages[rnti / PAGE_SIZE];
+    page->m_used &= ~Bit (rnti);
+    m_size--;
+    if (page->m_used == 0)
+      {
+        delete page;
+        m_pages[rnti / PAGE_SIZE] = 0;
+      }
+    else
+      {
+        // release the resources of the value
+        page->m_values[rnti % PAGE_SIZE].second = T ();
+      }
+  }
+
+  std::vector<Page*> m_pages; //!< the pages, indexed by RNTI / PAGE_SIZE, or 0 if none of their RNTIs is in the table
+  size_t m_size; //!< the number of UEs in the table
+};
+
+template <class T>
+const uint32_t MmWaveRntiTable<T>::PAGE_SIZE;
+template <class T>
+const uint32_t MmWaveRntiTable<T>::END;
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* MMWAVE_RNTI_TABLE_H */
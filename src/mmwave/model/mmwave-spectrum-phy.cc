@@ -98,7 +98,8 @@ static const double EffectiveCodingRate[29] = {
 MmWaveSpectrumPhy::MmWaveSpectrumPhy ()
   : m_cellId (0),
     m_state (IDLE),
-    m_componentCarrierId (0)
+    m_componentCarrierId (0),
+    m_rxOfInterestOnly (false)
 {
   m_interferenceData = CreateObject<mmWaveInterference> ();
   m_random = CreateObject<UniformRandomVariable> ();
@@ -130,6 +131,13 @@ MmWaveSpectrumPhy::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&MmWaveSpectrumPhy::m_dataErrorModelEnabled),
                    MakeBooleanChecker ())
+    .AddAttribute ("RxOfInterestOnly",
+                   "If true, the SINR of a data reception is evaluated only if a TB is expected in it, "
+                   "i.e., if the PHY is going to decode it. Otherwise, the SINR of all the data signals "
+                   "of the cell is evaluated and reported to the chunk processors, e.g., for the CQI.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveSpectrumPhy::m_rxOfInterestOnly),
+                   MakeBooleanChecker ())
 
     .AddAttribute ("FileName",
                    "file name",
@@ -307,8 +315,8 @@ MmWaveSpectrumPhy::SetPhyUlHarqFeedbackCallback (MmWavePhyUlHarqFeedbackCallback
   m_phyUlHarqFeedbackCallback = c;
 }
 
-void
-MmWaveSpectrumPhy::ConfigureBeamforming (Ptr<NetDevice> device)
+Ptr<ThreeGppAntennaArrayModel>
+MmWaveSpectrumPhy::GetDeviceAntenna (Ptr<NetDevice> device) const
 {
   NS_LOG_FUNCTION (this << device);
   Ptr<ThreeGppAntennaArrayModel> antenna;
@@ -326,8 +334,22 @@ MmWaveSpectrumPhy::ConfigureBeamforming (Ptr<NetDevice> device)
     {
       antenna = mcUeNetDevice->GetAntenna (m_componentCarrierId);
     }
-  
-  m_beamforming->SetBeamformingVectorForDevice (device, antenna);
+
+  return antenna;
+}
+
+void
+MmWaveSpectrumPhy::ConfigureBeamforming (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  m_beamforming->SetBeamformingVectorForDevice (device, GetDeviceAntenna (device));
+}
+
+ThreeGppAntennaArrayModel::ComplexVector
+MmWaveSpectrumPhy::GetBeamformingVectorForDevice (Ptr<NetDevice> device) const
+{
+  NS_LOG_FUNCTION (this << device);
+  return m_beamforming->GetBeamformingVectorForDevice (device, GetDeviceAntenna (device));
 }
 
 void
@@ -434,7 +456,10 @@ MmWaveSpectrumPhy::StartRxData (Ptr<MmwaveSpectrumSignalParametersDataFrame> par
       case IDLE:
         {
           // this is a useful signal
-          m_interferenceData->StartRx (params->psd);
+          if (!m_rxOfInterestOnly || !m_expectedTbs.empty ())
+            {
+              m_interferenceData->StartRx (params->psd);
+            }
 
           if (m_rxPacketBurstList.empty ())
             {
@@ -557,9 +582,14 @@ MmWaveSpectrumPhy::EndRxData ()
 
   m_interferenceData->EndRx (); // trigger the SINR computation
 
-  // compute the average SINR
-  double sinrAvg = Sum (m_sinrPerceived) / (m_sinrPerceived.GetSpectrumModel ()->GetNumBands ());
-  NS_LOG_DEBUG ("m_sinrPerceived=" << m_sinrPerceived << ", sinrAvg=" << sinrAvg << ", SINR dB=" << 10*std::log10(sinrAvg) << ", GetNumBands=" << m_sinrPerceived.GetSpectrumModel ()->GetNumBands ());
+  // compute the average SINR, which is not evaluated for a reception
+  // without expected TBs if RxOfInterestOnly is set
+  double sinrAvg = 0.0;
+  if (!m_expectedTbs.empty ())
+    {
+      sinrAvg = Sum (m_sinrPerceived) / (m_sinrPerceived.GetSpectrumModel ()->GetNumBands ());
+      NS_LOG_DEBUG ("m_sinrPerceived=" << m_sinrPerceived << ", sinrAvg=" << sinrAvg << ", SINR dB=" << 10*std::log10(sinrAvg) << ", GetNumBands=" << m_sinrPerceived.GetSpectrumModel ()->GetNumBands ());
+    }
 
   // check if the transmissions succeeded or failed
   ExpectedTbMap_t::iterator itTb = m_expectedTbs.begin ();
@@ -917,6 +947,14 @@ MmWaveSpectrumPhy::SetHarqPhyModule (Ptr<MmWaveHarqPhy> harq)
   m_harqPhyModule = harq;
 }
 
+int64_t
+MmWaveSpectrumPhy::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_random->SetStream (stream);
+  return 1;
+}
+
 
 }
 
@@ -151,6 +151,14 @@ public:
   */
   void ConfigureBeamforming (Ptr<NetDevice> device);
 
+  /**
+  * Compute the beamforming vector to point the beam towards the target
+  * device, without updating the antenna configuration.
+  * \param device target device
+  * \return the beamforming vector
+  */
+  ThreeGppAntennaArrayModel::ComplexVector GetBeamformingVectorForDevice (Ptr<NetDevice> device) const;
+
   void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
   void SetTxPowerSpectralDensity (Ptr<SpectrumValue> TxPsd);
   void StartRx (Ptr<SpectrumSignalParameters> params) override;
@@ -200,8 +208,26 @@ public:
 
   void SetHarqPhyModule (Ptr<MmWaveHarqPhy> harq);
 
+  /**
+  * Assign a fixed random variable stream number to the random variables
+  * used by this model.  Return the number of streams (possibly zero) that
+  * have been assigned.
+  *
+  * \param stream first stream index to use
+  * \return the number of stream indices assigned by this model
+  */
+  int64_t AssignStreams (int64_t stream);
+
 
 private:
+  /**
+  * Returns the antenna of the target device associated to the same
+  * component carrier of this instance
+  * \param device target device
+  * \return the antenna of the target device
+  */
+  Ptr<ThreeGppAntennaArrayModel> GetDeviceAntenna (Ptr<NetDevice> device) const;
+
 
   /**
    * \brief change the state
@@ -250,6 +276,7 @@ private:
   Ptr<UniformRandomVariable> m_random;
 
   bool m_dataErrorModelEnabled;       // when true (default) the phy error model is enabled
+  bool m_rxOfInterestOnly;            // when true the SINR is only evaluated for the receptions with expected TBs
   bool m_ctrlErrorModelEnabled;       // when true (default) the phy error model is enabled for DL ctrl frame
 
   Ptr<MmWaveHarqPhy> m_harqPhyModule;
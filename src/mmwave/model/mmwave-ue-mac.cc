@@ -398,6 +398,8 @@ MmWaveUeMac::DoReportBufferStatus (LteMacSapProvider::ReportBufferStatusParamete
         }
       m_ulBsrReceived.insert (std::pair<uint8_t, LteMacSapProvider::ReportBufferStatusParameters> (params.lcid, params));
     }
+  // wake up the PHY first, so that the BSR is sent at the next TTI
+  m_phySapProvider->RequestSlotIndication ();
   m_freshUlBsr = true;
 }
 
@@ -521,6 +523,11 @@ MmWaveUeMac::DoSlotIndication (SfnSf sfn)
       m_freshUlBsr = false;
       //m_harqProcessId = (m_harqProcessId + 1) % m_phyMacConfig->GetHarqTimeout();
     }
+  else if (m_freshUlBsr)
+    {
+      // the BSR periodicity has not expired yet
+      m_phySapProvider->RequestSlotIndication ();
+    }
 }
 
 void
@@ -865,6 +872,7 @@ MmWaveUeMac::DoReceiveControlMessage  (Ptr<MmWaveControlMessage> msg)
                                   {
                                     // resend BSR info for updating eNB peer MAC
                                     m_freshUlBsr = true;
+                                    m_phySapProvider->RequestSlotIndication ();
                                   }
                               }
                             NS_LOG_LOGIC (this << "\t" << bytesPerActiveLc << "\t new queues " << (uint32_t)(*lcIt).first << " statusQueue " << (*itBsr).second.statusPduSize << " retxQueue" << (*itBsr).second.retxQueueSize << " txQueue" <<  (*itBsr).second.txQueueSize);
@@ -39,12 +39,14 @@
 #include <cmath>
 #include <ns3/simulator.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include "mmwave-ue-phy.h"
 #include "mmwave-ue-net-device.h"
 #include "mc-ue-net-device.h"
 #include "mmwave-spectrum-value-helper.h"
 #include <ns3/pointer.h>
 #include <ns3/node.h>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -63,7 +65,10 @@ MmWaveUePhy::MmWaveUePhy ()
 MmWaveUePhy::MmWaveUePhy (Ptr<MmWaveSpectrumPhy> dlPhy, Ptr<MmWaveSpectrumPhy> ulPhy)
   : MmWavePhy (dlPhy, ulPhy),
   m_prevSlot (0),
-  m_rnti (0)
+  m_rnti (0),
+  m_coalescedSlotTiming (false),
+  m_sleeping (false),
+  m_slotIndicationRequested (false)
 {
   NS_LOG_FUNCTION (this);
   m_wbCqiLast = Simulator::Now ();
@@ -139,6 +144,14 @@ MmWaveUePhy::GetTypeId (void)
                    UintegerValue (2),
                    MakeUintegerAccessor (&MmWaveUePhy::m_n310),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("CoalescedSlotTiming",
+                   "If true, the TTIs of each slot are started directly one after the other, following "
+                   "the allocation of the slot, and the UE skips the TTIs in which it has nothing to do. "
+                   "A connected UE without DCIs, UL grants or pending control messages stops its slot "
+                   "timing and is woken up by the next DL control message of the eNB or by its MAC",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveUePhy::m_coalescedSlotTiming),
+                   MakeBooleanChecker ())
   ;
 
   return tid;
@@ -372,6 +385,12 @@ MmWaveUePhy::ReceiveControlMessageList (std::list<Ptr<MmWaveControlMessage> > ms
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_sleeping)
+    {
+      // the DL control of the eNB marks the beginning of the slot for the sleeping UE
+      WakeUp ();
+    }
+
   std::list<Ptr<MmWaveControlMessage> >::iterator it;
   for (it = msgList.begin (); it != msgList.end (); it++)
     {
@@ -620,41 +639,206 @@ MmWaveUePhy::StartTti ()
   m_prevTtiDir = currTti.m_tddMode;
 
   NS_ASSERT (m_ttiIndex != 0 || currTti.m_dci.m_symStart == m_ttiIndex);
+  m_slotIndicationRequested = false;
   m_phySapUser->SlotIndication (SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));            // trigger mac
 
-  NS_LOG_DEBUG ("MmWaveUePhy: Scheduling TTI end after " << currTtiDuration);
-  Simulator::Schedule (currTtiDuration, &MmWaveUePhy::EndTti, this);
+  if (m_coalescedSlotTiming && m_ttiIndex > 0)
+    {
+      ScheduleNextTti (currTtiDuration);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("MmWaveUePhy: Scheduling TTI end after " << currTtiDuration);
+      Simulator::Schedule (currTtiDuration, &MmWaveUePhy::EndTti, this);
+    }
 }
 
+void
+MmWaveUePhy::StartNextTti (uint8_t ttiIndex)
+{
+  m_ttiIndex = ttiIndex;
+  StartTti ();
+}
 
 void
-MmWaveUePhy::EndTti ()
+MmWaveUePhy::ScheduleNextTti (Time currTtiDuration)
 {
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("MmWave UE " << m_rnti << " frame " << m_frameNum << " subframe " << (uint16_t) m_sfNum << " slot "
-                            << (uint16_t) m_slotNum << " TTI index " << (uint16_t) m_ttiIndex );
+  NS_LOG_FUNCTION (this << currTtiDuration);
 
-  if (m_ttiIndex == m_currSlotAllocInfo.m_ttiAllocInfo.size () - 1) // End of this slot, as last TTI always happens at the last OFDM symbol
+  Time now = Simulator::Now ();
+  uint8_t lastTti = m_currSlotAllocInfo.m_ttiAllocInfo.size () - 1;
+  // the UL control TTI is skipped when the UE has nothing to report
+  bool ulCtrlNeeded = m_rnti == 0 || m_cellId == 0 || m_slotIndicationRequested || HasPendingControlMessages ();
+
+  for (uint8_t i = m_ttiIndex + 1; i <= lastTti; i++)
     {
-      uint16_t frameNum = m_frameNum;
-      uint8_t sfNum = m_sfNum;
-      uint8_t slotNum {0};
-      if (m_slotNum == m_phyMacConfig->GetSlotsPerSubframe () - 1) // End of this subframe
+      if (i == lastTti && !ulCtrlNeeded)
         {
-          if (m_sfNum == m_phyMacConfig->GetSubframesPerFrame () - 1) // End of the frame as well
+          break;
+        }
+      Time ttiStart = m_lastSlotStart + m_phyMacConfig->GetSymbolPeriod () * m_currSlotAllocInfo.m_ttiAllocInfo[i].m_dci.m_symStart;
+      if (ttiStart >= now)
+        {
+          if (m_receptionEnabled && ttiStart > now + currTtiDuration)
             {
-              sfNum = 0;
-              frameNum = m_frameNum + 1;
+              Simulator::Schedule (currTtiDuration, &MmWaveUePhy::ResetReception, this);
             }
-          else // End of the current subframe only
+          Simulator::Schedule (ttiStart - now, &MmWaveUePhy::StartNextTti, this, i);
+          return;
+        }
+    }
+
+  if (m_receptionEnabled)
+    {
+      Simulator::Schedule (currTtiDuration, &MmWaveUePhy::ResetReception, this);
+    }
+
+  bool ulGrants = false;
+  for (std::vector<SlotAllocInfo>::const_iterator it = m_slotAllocInfo.begin (); it != m_slotAllocInfo.end (); ++it)
+    {
+      // besides the DL and UL control TTIs
+      ulGrants = ulGrants || it->m_ttiAllocInfo.size () > 2;
+    }
+
+  if (ulCtrlNeeded || ulGrants)
+    {
+      uint16_t frameNum = m_frameNum;
+      uint8_t sfNum = m_sfNum;
+      uint8_t slotNum = m_slotNum;
+      AdvanceSlot (frameNum, sfNum, slotNum);
+      Simulator::Schedule (MmWavePhy::GetNextSlotDelay (), &MmWaveUePhy::SlotIndication, this, frameNum, sfNum, slotNum);
+    }
+  else
+    {
+      NS_LOG_LOGIC ("UE " << m_rnti << " idle, stopping the slot timing");
+      m_sleeping = true;
+    }
+}
+
+void
+MmWaveUePhy::WakeUp (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_sleeping);
+  m_sleeping = false;
+
+  // the slots keep starting every slot period, whether the UE follows them or not
+  int64_t slots = (Simulator::Now () - m_lastSlotStart).GetTimeStep () / m_slotPeriod.GetTimeStep ();
+  if (slots > 0)
+    {
+      for (int64_t i = 0; i < slots; i++)
+        {
+          // the skipped slots had no allocation, but their entries must be moved to the next subframe
+          AdvanceSlot (m_frameNum, m_sfNum, m_slotNum);
+          if (i == slots - 1)
             {
-              sfNum = m_sfNum + 1;
+              m_currSlotAllocInfo = m_slotAllocInfo[m_slotNum];
             }
+          InitializeSlotAllocation (m_frameNum, m_sfNum, m_slotNum);
+        }
+      m_ttiIndex = 0;
+      m_lastSlotStart += m_slotPeriod * slots;
+
+      NS_ASSERT ((m_currSlotAllocInfo.m_sfnSf.m_frameNum == m_frameNum));
+      NS_ASSERT ((m_currSlotAllocInfo.m_sfnSf.m_sfNum == m_sfNum));
+      NS_ASSERT ((m_currSlotAllocInfo.m_sfnSf.m_slotNum == m_slotNum));
+
+      if (m_cellId > 0)
+        {
+          m_downlinkSpectrumPhy->ConfigureBeamforming (m_registeredEnb.find (m_cellId)->second.second);
         }
-      else // End of just the slot
+      if (m_lastSlotStart == Simulator::Now ())
         {
-          slotNum = m_slotNum + 1;
+          // woken up at the beginning of a slot, start it as usual once the
+          // event which woke the UE up has been handled
+          Simulator::ScheduleNow (&MmWaveUePhy::StartNextTti, this, 0);
+          return;
         }
+      // the MAC uses the counters of the last slot indication to tag its UL PDUs
+      m_slotIndicationRequested = false;
+      m_phySapUser->SlotIndication (SfnSf (m_frameNum, m_sfNum, m_slotNum, 0));
+    }
+
+  if (m_ttiIndex == 0)
+    {
+      // resume at the end of the DL control TTI, once the DL DCIs of the slot are known
+      Time dlCtrlEnd = m_lastSlotStart + m_phyMacConfig->GetDlCtrlSymbols () * m_phyMacConfig->GetSymbolPeriod ();
+      Simulator::Schedule (std::max (dlCtrlEnd - Simulator::Now (), Seconds (0)), &MmWaveUePhy::EndTti, this);
+    }
+  else
+    {
+      // woken up in the same slot in which the UE fell asleep, after its last TTI
+      ScheduleNextTti (Seconds (0));
+    }
+}
+
+void
+MmWaveUePhy::AdvanceSlot (uint16_t &frameNum, uint8_t &sfNum, uint8_t &slotNum) const
+{
+  if (slotNum == m_phyMacConfig->GetSlotsPerSubframe () - 1) // End of this subframe
+    {
+      slotNum = 0;
+      if (sfNum == m_phyMacConfig->GetSubframesPerFrame () - 1) // End of the frame as well
+        {
+          sfNum = 0;
+          frameNum++;
+        }
+      else // End of the current subframe only
+        {
+          sfNum++;
+        }
+    }
+  else // End of just the slot
+    {
+      slotNum++;
+    }
+}
+
+void
+MmWaveUePhy::SetControlMessage (Ptr<MmWaveControlMessage> m)
+{
+  MmWavePhy::SetControlMessage (m);
+  if (m_sleeping)
+    {
+      WakeUp ();
+    }
+}
+
+void
+MmWaveUePhy::DoRequestSlotIndication (void)
+{
+  if (m_sleeping)
+    {
+      WakeUp ();
+    }
+  // the catch-up slot indication of WakeUp does not serve the request, the
+  // MAC gets its indication at the next TTI, as with the regular slot timing
+  m_slotIndicationRequested = true;
+}
+
+
+void
+MmWaveUePhy::EndTti ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_LOG_INFO ("MmWave UE " << m_rnti << " frame " << m_frameNum << " subframe " << (uint16_t) m_sfNum << " slot "
+                            << (uint16_t) m_slotNum << " TTI index " << (uint16_t) m_ttiIndex );
+
+  if (m_coalescedSlotTiming)
+    {
+      // only the DL control TTI ends with an event, since the DL DCIs received
+      // during it complete the allocation of the slot
+      NS_ASSERT (m_ttiIndex == 0);
+      ScheduleNextTti (Seconds (0));
+      return;
+    }
+
+  if (m_ttiIndex == m_currSlotAllocInfo.m_ttiAllocInfo.size () - 1) // End of this slot, as last TTI always happens at the last OFDM symbol
+    {
+      uint16_t frameNum = m_frameNum;
+      uint8_t sfNum = m_sfNum;
+      uint8_t slotNum = m_slotNum;
+      AdvanceSlot (frameNum, sfNum, slotNum);
 
       m_ttiIndex = 0; // Start of a new NR slot
       Time nextSlotDelay = MmWavePhy::GetNextSlotDelay ();
@@ -867,6 +1051,12 @@ MmWaveUePhy::DoReset ()
   // clear DCI
   m_phyReset = true;
 
+  if (m_sleeping)
+    {
+      // follow the slots again until the UE is connected
+      WakeUp ();
+    }
+
   //m_currSfAllocInfo.m_slotAllocInfo.clear();
   //m_currSfAllocInfo.m_slotAllocInfo.clear();
 }
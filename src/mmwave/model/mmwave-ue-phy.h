@@ -174,6 +174,15 @@ public:
 
   void UpdateSinrEstimate (uint16_t cellId, double sinr);
 
+  /**
+   * Queues a control message for the next UL control TTI, waking up the UE if its slot timing is stopped.
+   *
+   * \param m the control message.
+   */
+  virtual void SetControlMessage (Ptr<MmWaveControlMessage> m) override;
+
+  virtual void DoRequestSlotIndication (void) override;
+
 
 private:
   void DoReset ();
@@ -199,6 +208,42 @@ private:
   */
   void TraceUlPhyTransmission (DciInfoElementTdma dciInfo, uint8_t tddType);
 
+  /**
+   * Moves to the given TTI of the current slot and starts it.
+   *
+   * \param ttiIndex the index of the TTI within the allocation of the current slot.
+   */
+  void StartNextTti (uint8_t ttiIndex);
+
+  /**
+   * Schedules the next TTI of the current slot which needs the UE, when the CoalescedSlotTiming attribute is set.
+   *
+   * The DL and UL data TTIs of the UE are always started, while the UL control TTI is skipped when the UE has
+   * nothing to report. If no TTI is left in the slot, the next slot is scheduled or, if the UE is connected
+   * and has neither UL grants nor control messages pending, the slot timing is stopped until \ref WakeUp.
+   *
+   * \param currTtiDuration the duration of the current TTI.
+   */
+  void ScheduleNextTti (Time currTtiDuration);
+
+  /**
+   * Restarts the slot timing of a sleeping UE.
+   *
+   * The counters and the allocation info skipped while sleeping are brought to the current slot, as if
+   * \ref SlotIndication had been called at its beginning, and the TTIs left in the slot are scheduled
+   * from the end of its DL control TTI. A UE woken up exactly at the beginning of a slot starts it as usual.
+   */
+  void WakeUp (void);
+
+  /**
+   * Moves the given counters to the next slot.
+   *
+   * \param frameNum the frame number.
+   * \param sfNum the subframe number.
+   * \param slotNum the slot number.
+   */
+  void AdvanceSlot (uint16_t &frameNum, uint8_t &sfNum, uint8_t &slotNum) const;
+
   void ReceiveDataPeriod (uint32_t slotNum);
 
   MmWaveUePhySapUser* m_phySapUser;
@@ -255,6 +300,10 @@ private:
   long double m_outageThreshold;
   uint8_t m_n310;
 
+  bool m_coalescedSlotTiming;       //!< If true, chain the needed TTIs directly and stop the slot timing when idle
+  bool m_sleeping;                  //!< True if the slot timing is stopped until the next wake up
+  bool m_slotIndicationRequested;   //!< True if the MAC asked for the slot indications of the next slot
+
 };
 
 
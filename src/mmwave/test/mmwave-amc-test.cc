@@ -0,0 +1,321 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-amc.h"
+#include "ns3/mmwave-mi-error-model.h"
+#include "ns3/mmwave-spectrum-value-helper.h"
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/enum.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveAmcTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+// spectral efficiency of each CQI and MCS, as in mmwave-amc.cc
+static const double SpectralEfficiencyForCqi[16] = {
+  0.0,
+  0.15, 0.23, 0.38, 0.6, 0.88, 1.18,
+  1.48, 1.91, 2.41,
+  2.73, 3.32, 3.9, 4.52, 5.12, 5.55
+};
+
+static const double SpectralEfficiencyForMcs[29] = {
+  0.15, 0.19, 0.23, 0.31, 0.38, 0.49, 0.6, 0.74, 0.88, 1.03, 1.18,
+  1.33, 1.48, 1.7, 1.91, 2.16, 2.41, 2.57,
+  2.73, 3.03, 3.32, 3.61, 3.9, 4.21, 4.52, 4.82, 5.12, 5.33, 5.55
+};
+
+/**
+* This test case checks that the CQI and MCS selected by MmWaveAmc with the
+* MI error model are the same obtained by testing each MCS in increasing
+* order with MmWaveMiErrorModel::GetTbDecodificationStats
+*/
+class MmWaveAmcMiErrorModelTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveAmcMiErrorModelTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveAmcMiErrorModelTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Returns the highest MCS which guarantees a TBLER lower than 10 %, testing
+  * each MCS in increasing order
+  * \param sinr the SINR
+  * \param map the chunks of the TB
+  * \param tbSizes the TB size in bytes for each MCS
+  * \param failed set to true if the MCS following the returned one does not meet the target
+  * \return the MCS
+  */
+  static uint8_t GetReferenceMcs (const SpectrumValue &sinr, const std::vector<int> &map, const std::vector<uint32_t> &tbSizes, bool &failed);
+
+  /**
+  * Returns the CQI reported for an MCS
+  * \param mcs the MCS returned by GetReferenceMcs
+  * \param failed the flag set by GetReferenceMcs
+  * \param strict true for the mapping of the RBG feedbacks, which selects
+  * the highest CQI with a spectral efficiency strictly lower than the MCS one,
+  * false for the TDMA feedbacks, which also accept an equal one
+  * \return the CQI
+  */
+  static int GetReferenceCqi (uint8_t mcs, bool failed, bool strict = false);
+};
+
+MmWaveAmcMiErrorModelTestCase::MmWaveAmcMiErrorModelTestCase ()
+  : TestCase ("Checks the MCS selection of MmWaveAmc with the MI error model")
+{
+}
+
+MmWaveAmcMiErrorModelTestCase::~MmWaveAmcMiErrorModelTestCase ()
+{
+}
+
+uint8_t
+MmWaveAmcMiErrorModelTestCase::GetReferenceMcs (const SpectrumValue &sinr, const std::vector<int> &map, const std::vector<uint32_t> &tbSizes, bool &failed)
+{
+  uint8_t mcs = 0;
+  failed = false;
+  while (mcs <= 28)
+    {
+      MmWaveHarqProcessInfoList_t harqInfoList;
+      MmWaveTbStats_t tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, map, tbSizes[mcs], mcs, harqInfoList);
+      if (tbStats.tbler > 0.1)
+        {
+          failed = true;
+          break;
+        }
+      mcs++;
+    }
+  if (mcs > 0)
+    {
+      mcs--;
+    }
+  return mcs;
+}
+
+int
+MmWaveAmcMiErrorModelTestCase::GetReferenceCqi (uint8_t mcs, bool failed, bool strict)
+{
+  if (failed && mcs == 0)
+    {
+      return 0;
+    }
+  if (mcs == 28)
+    {
+      return 15;
+    }
+  int cqi = 0;
+  while ((cqi < 15) && (strict ? SpectralEfficiencyForCqi[cqi + 1] < SpectralEfficiencyForMcs[mcs]
+                               : SpectralEfficiencyForCqi[cqi + 1] <= SpectralEfficiencyForMcs[mcs]))
+    {
+      ++cqi;
+    }
+  return cqi;
+}
+
+void
+MmWaveAmcMiErrorModelTestCase::DoRun (void)
+{
+  Ptr<MmWavePhyMacCommon> config = CreateObject<MmWavePhyMacCommon> ();
+  Ptr<MmWaveAmc> amc = CreateObject<MmWaveAmc> (config);
+  amc->SetAttribute ("AmcModel", EnumValue (MmWaveAmc::MiErrorModel));
+  Ptr<SpectrumModel> sm = MmWaveSpectrumValueHelper::GetSpectrumModel (config);
+  uint32_t numChunks = sm->GetNumBands ();
+
+  std::vector<uint32_t> tbSizesList = {10, 100, 800, 3000, 20000};
+  uint8_t numSym = 12;
+  std::vector<uint32_t> symTbSizes;
+  for (uint8_t mcs = 0; mcs <= 28; mcs++)
+    {
+      symTbSizes.push_back (amc->GetTbSizeFromMcsSymbols (mcs, numSym) / 8);
+    }
+
+  // the RBG CQIs are computed by a single instance for alternating RBG
+  // sizes, so that the thresholds cached for each RBG size are checked
+  std::vector<uint8_t> rbgSizes = {18, 72};
+  std::map<uint8_t, std::vector<uint32_t> > rbgTbSizes;
+  for (uint8_t rbgSize : rbgSizes)
+    {
+      for (uint8_t mcs = 0; mcs <= 28; mcs++)
+        {
+          rbgTbSizes[rbgSize].push_back (amc->GetTbSizeFromMcs (mcs, rbgSize / 18) / 8);
+        }
+    }
+
+  // sweep the SINR from -10 dB to 35 dB, with a small frequency selectivity
+  for (double sinrDb = -10; sinrDb <= 35; sinrDb += 0.25)
+    {
+      SpectrumValue sinr (sm);
+      for (uint32_t i = 0; i < numChunks; i++)
+        {
+          sinr[i] = std::pow (10, (sinrDb + 2 * std::sin (i * 0.1)) / 10);
+        }
+      std::vector<int> chunkMap;
+      for (uint32_t i = 0; i < numChunks; i++)
+        {
+          chunkMap.push_back (i);
+        }
+
+      // wideband CQI
+      for (uint32_t tbSize : tbSizesList)
+        {
+          bool failed;
+          uint8_t refMcs = GetReferenceMcs (sinr, chunkMap, std::vector<uint32_t> (29, tbSize), failed);
+          int mcs = 0;
+          int cqi = amc->CreateCqiFeedbackWbTdma (sinr, numSym, tbSize, mcs);
+          NS_TEST_ASSERT_MSG_EQ (mcs, refMcs, "Unexpected wideband MCS for SINR " << sinrDb << " dB and TB size " << tbSize);
+          NS_TEST_ASSERT_MSG_EQ (cqi, GetReferenceCqi (refMcs, failed), "Unexpected wideband CQI for SINR " << sinrDb << " dB and TB size " << tbSize);
+        }
+
+      // per chunk CQI
+      std::vector<int> cqis = amc->CreateCqiFeedbacksTdma (sinr, numSym);
+      NS_TEST_ASSERT_MSG_EQ (cqis.size (), numChunks, "Unexpected number of CQIs");
+      for (uint32_t i = 0; i < numChunks; i += 17)
+        {
+          bool failed;
+          uint8_t refMcs = GetReferenceMcs (sinr, std::vector<int> (1, i), symTbSizes, failed);
+          NS_TEST_ASSERT_MSG_EQ (cqis[i], GetReferenceCqi (refMcs, failed), "Unexpected CQI for chunk " << i << " and SINR " << sinrDb << " dB");
+        }
+
+      // per RBG CQI
+      for (uint8_t rbgSize : rbgSizes)
+        {
+          std::vector<int> rbgCqis = amc->CreateCqiFeedbacks (sinr, rbgSize);
+          uint32_t numRbgs = (numChunks + rbgSize - 1) / rbgSize;
+          NS_TEST_ASSERT_MSG_EQ (rbgCqis.size (), numRbgs * rbgSize, "Unexpected number of RBG CQIs");
+          for (uint32_t rbg = 0; rbg < numRbgs; rbg++)
+            {
+              std::vector<int> rbgMap;
+              for (uint32_t i = rbg * rbgSize; i < std::min ((rbg + 1) * rbgSize, numChunks); i++)
+                {
+                  rbgMap.push_back (i);
+                }
+              bool failed;
+              uint8_t refMcs = GetReferenceMcs (sinr, rbgMap, rbgTbSizes[rbgSize], failed);
+              int refCqi = GetReferenceCqi (refMcs, failed, true);
+              for (uint32_t j = rbg * rbgSize; j < (rbg + 1) * rbgSize; j++)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (rbgCqis[j], refCqi, "Unexpected CQI for RBG " << rbg << " of size " << (uint16_t) rbgSize
+                                                                                       << " and SINR " << sinrDb << " dB");
+                }
+            }
+        }
+    }
+}
+
+/**
+* This test case checks that the number of symbols returned by
+* MmWaveAmc::GetNumSymbolsFromTbsMcs and MmWaveAmc::GetMinNumSymbolsFromBufSize
+* is the minimum one with a large enough TB size
+*/
+class MmWaveAmcTbSizeTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveAmcTbSizeTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveAmcTbSizeTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveAmcTbSizeTestCase::MmWaveAmcTbSizeTestCase ()
+  : TestCase ("Checks the number of symbols computed by MmWaveAmc for a TB size")
+{
+}
+
+MmWaveAmcTbSizeTestCase::~MmWaveAmcTbSizeTestCase ()
+{
+}
+
+void
+MmWaveAmcTbSizeTestCase::DoRun (void)
+{
+  Ptr<MmWavePhyMacCommon> config = CreateObject<MmWavePhyMacCommon> ();
+  Ptr<MmWaveAmc> amc = CreateObject<MmWaveAmc> (config);
+  unsigned numSymPerSlot = config->GetSymbPerSlot ();
+
+  for (unsigned mcs = 0; mcs <= 28; mcs++)
+    {
+      for (unsigned tbSize = 0; tbSize < 100000; tbSize += 37)
+        {
+          int numSym = amc->GetNumSymbolsFromTbsMcs (tbSize, mcs);
+          NS_TEST_ASSERT_MSG_GT_OR_EQ (amc->GetTbSizeFromMcsSymbols (mcs, numSym), (int) tbSize,
+                                       "TB too small for MCS " << mcs << " and " << tbSize << " bits");
+          NS_TEST_ASSERT_MSG_LT (amc->GetTbSizeFromMcsSymbols (mcs, numSym - 1), (int) tbSize,
+                                 "Not the minimum number of symbols for MCS " << mcs << " and " << tbSize << " bits");
+
+          unsigned bufSize = tbSize / 8;
+          unsigned bufTbSize = 0;
+          unsigned bufNumSym = amc->GetMinNumSymbolsFromBufSize (mcs, bufSize, bufTbSize);
+          unsigned maxTbSize = amc->GetTbSizeFromMcsSymbols (mcs, numSymPerSlot) / 8;
+          NS_TEST_ASSERT_MSG_EQ (bufTbSize, (unsigned) (amc->GetTbSizeFromMcsSymbols (mcs, bufNumSym) / 8), "Unexpected TB size");
+          if (bufSize >= maxTbSize)
+            {
+              NS_TEST_ASSERT_MSG_EQ (bufNumSym, numSymPerSlot, "The whole slot should be used");
+            }
+          else
+            {
+              NS_TEST_ASSERT_MSG_GT_OR_EQ (bufTbSize, bufSize, "TB too small for a buffer of " << bufSize << " bytes");
+              NS_TEST_ASSERT_MSG_LT (amc->GetTbSizeFromMcsSymbols (mcs, bufNumSym - 1), (int) bufSize * 8,
+                                     "Not the minimum number of symbols for a buffer of " << bufSize << " bytes");
+            }
+        }
+    }
+}
+
+/**
+* This suite tests the adaptive modulation and coding module
+*/
+class MmWaveAmcTest : public TestSuite
+{
+public:
+  MmWaveAmcTest ();
+};
+
+MmWaveAmcTest::MmWaveAmcTest ()
+  : TestSuite ("mmwave-amc", UNIT)
+{
+  // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
+  AddTestCase (new MmWaveAmcMiErrorModelTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveAmcTbSizeTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveAmcTest mmwaveAmcTestSuite;
@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-indexed-heap.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveIndexedHeapTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* Element of the heap used by the test
+*/
+struct HeapTestElement
+{
+  uint32_t m_key; //!< the priority, the highest first
+  uint32_t m_id; //!< the identifier, used to break the ties
+  uint32_t m_heapIndex; //!< the position in the heap
+};
+
+/**
+* This test case checks that MmWaveIndexedHeap returns the elements in the
+* same order obtained with std::sort, also after the priority of some
+* elements is changed or some elements are removed
+*/
+class MmWaveIndexedHeapTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveIndexedHeapTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveIndexedHeapTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Compares two elements
+  * \param lhs the first element
+  * \param rhs the second element
+  * \return true if the first element has a higher priority
+  */
+  static bool Compare (HeapTestElement* lhs, HeapTestElement* rhs);
+};
+
+MmWaveIndexedHeapTestCase::MmWaveIndexedHeapTestCase ()
+  : TestCase ("Checks the order of the elements of MmWaveIndexedHeap")
+{
+}
+
+MmWaveIndexedHeapTestCase::~MmWaveIndexedHeapTestCase ()
+{
+}
+
+bool
+MmWaveIndexedHeapTestCase::Compare (HeapTestElement* lhs, HeapTestElement* rhs)
+{
+  if (lhs->m_key != rhs->m_key)
+    {
+      return lhs->m_key > rhs->m_key;
+    }
+  return lhs->m_id < rhs->m_id;
+}
+
+void
+MmWaveIndexedHeapTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  rv->SetStream (1);
+
+  std::vector<uint32_t> sizes = {0, 1, 2, 5, 17, 100, 1000};
+  for (uint32_t size : sizes)
+    {
+      std::vector<HeapTestElement> elements (size);
+      std::vector<HeapTestElement*> pointers;
+      for (uint32_t i = 0; i < size; i++)
+        {
+          // few distinct keys, so that there are ties
+          elements[i].m_key = rv->GetInteger (0, 20);
+          elements[i].m_id = i;
+          pointers.push_back (&elements[i]);
+        }
+
+      MmWaveIndexedHeap<HeapTestElement, &HeapTestElement::m_heapIndex> heap (&MmWaveIndexedHeapTestCase::Compare);
+      heap.Assign (pointers.begin (), pointers.end ());
+      NS_TEST_ASSERT_MSG_EQ (heap.Size (), size, "Unexpected heap size");
+
+      // change the priority of some elements and remove some others
+      std::vector<HeapTestElement*> expected;
+      for (uint32_t i = 0; i < size; i++)
+        {
+          uint32_t action = rv->GetInteger (0, 3);
+          if (action == 0)
+            {
+              heap.Remove (&elements[i]);
+              NS_TEST_ASSERT_MSG_EQ (heap.Contains (&elements[i]), false, "Removed element still in the heap");
+              continue;
+            }
+          if (action == 1)
+            {
+              elements[i].m_key = rv->GetInteger (0, 20);
+              heap.Update (&elements[i]);
+            }
+          expected.push_back (&elements[i]);
+        }
+      std::sort (expected.begin (), expected.end (), &MmWaveIndexedHeapTestCase::Compare);
+
+      std::vector<HeapTestElement*> topK;
+      heap.GetTopK (10, topK);
+      NS_TEST_ASSERT_MSG_EQ (topK.size (), std::min<size_t> (10, expected.size ()), "Unexpected number of top elements");
+      for (uint32_t i = 0; i < topK.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (topK[i]->m_id, expected[i]->m_id, "Unexpected top element " << i << " for size " << size);
+        }
+
+      for (uint32_t i = 0; i < expected.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (heap.Empty (), false, "Heap empty too early");
+          NS_TEST_ASSERT_MSG_EQ (heap.Top ()->m_id, expected[i]->m_id, "Unexpected element " << i << " for size " << size);
+          heap.Pop ();
+        }
+      NS_TEST_ASSERT_MSG_EQ (heap.Empty (), true, "Heap not empty");
+
+      // insert the elements one by one
+      for (uint32_t i = 0; i < expected.size (); i++)
+        {
+          heap.Push (expected[expected.size () - 1 - i]);
+        }
+      for (uint32_t i = 0; i < expected.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (heap.Top ()->m_id, expected[i]->m_id, "Unexpected pushed element " << i << " for size " << size);
+          heap.Pop ();
+        }
+    }
+}
+
+/**
+* This suite tests the indexed heap used by the schedulers
+*/
+class MmWaveIndexedHeapTest : public TestSuite
+{
+public:
+  MmWaveIndexedHeapTest ();
+};
+
+MmWaveIndexedHeapTest::MmWaveIndexedHeapTest ()
+  : TestSuite ("mmwave-indexed-heap", UNIT)
+{
+  // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
+  AddTestCase (new MmWaveIndexedHeapTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveIndexedHeapTest mmwaveIndexedHeapTestSuite;
@@ -0,0 +1,299 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-interference.h"
+#include "ns3/mmwave-chunk-processor.h"
+#include "ns3/mmwave-spectrum-phy.h"
+#include "ns3/mmwave-spectrum-signal-parameters.h"
+#include "ns3/mmwave-enb-net-device.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/boolean.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/log.h"
+
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveInterferenceTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks that the SINR delivered by mmWaveInterference to the
+* chunk processors at the end of a reception is the time-weighted average of
+* the SINR over the reception, with interferers which start and end during
+* it, before it or after it, in the bands of the received signal or outside
+*/
+class MmWaveInterferenceTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveInterferenceTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveInterferenceTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Store the SINR reported by the chunk processor
+  * \param sinr the SINR
+  */
+  void ReportSinr (const SpectrumValue& sinr);
+
+  std::vector<SpectrumValue> m_sinrReports;     //!< The SINR values reported by the chunk processor
+};
+
+MmWaveInterferenceTestCase::MmWaveInterferenceTestCase ()
+  : TestCase ("Check the average SINR of mmWaveInterference with staggered interferers")
+{
+}
+
+MmWaveInterferenceTestCase::~MmWaveInterferenceTestCase ()
+{
+}
+
+void
+MmWaveInterferenceTestCase::ReportSinr (const SpectrumValue& sinr)
+{
+  m_sinrReports.push_back (sinr);
+}
+
+void
+MmWaveInterferenceTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      freqs.push_back (28e9 + i * 1e6);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+
+  Ptr<SpectrumValue> noise = Create<SpectrumValue> (sm);
+  (*noise) = 0.1;
+
+  // the received signal in bands 0 and 1, between 2 and 12 us
+  Ptr<SpectrumValue> signal = Create<SpectrumValue> (sm);
+  (*signal)[0] = 1.0;
+  (*signal)[1] = 1.0;
+
+  // an interferer in all the bands, which ends before the reception
+  Ptr<SpectrumValue> i0 = Create<SpectrumValue> (sm);
+  (*i0) = 4.0;
+  // an interferer in bands 0 and 1, between 4 and 8 us
+  Ptr<SpectrumValue> i1 = Create<SpectrumValue> (sm);
+  (*i1)[0] = 0.5;
+  (*i1)[1] = 0.5;
+  // an interferer in bands 1 and 2, between 6 and 16 us, after the reception
+  Ptr<SpectrumValue> i2 = Create<SpectrumValue> (sm);
+  (*i2)[1] = 0.25;
+  (*i2)[2] = 0.25;
+  // an interferer in band 3 only, between 5 and 7 us
+  Ptr<SpectrumValue> i3 = Create<SpectrumValue> (sm);
+  (*i3)[3] = 2.0;
+
+  Ptr<mmWaveInterference> interference = CreateObject<mmWaveInterference> ();
+  Ptr<mmWaveChunkProcessor> processor = Create<mmWaveChunkProcessor> ();
+  processor->AddCallback (MakeCallback (&MmWaveInterferenceTestCase::ReportSinr, this));
+  interference->AddSinrChunkProcessor (processor);
+  interference->SetNoisePowerSpectralDensity (noise);
+
+  // signals are added and the reception starts as in MmWaveSpectrumPhy
+  Simulator::Schedule (MicroSeconds (0), &mmWaveInterference::AddSignal, interference, i0, MicroSeconds (1));
+  Simulator::Schedule (MicroSeconds (2), &mmWaveInterference::AddSignal, interference, signal, MicroSeconds (10));
+  Simulator::Schedule (MicroSeconds (2), &mmWaveInterference::StartRx, interference, signal);
+  Simulator::Schedule (MicroSeconds (4), &mmWaveInterference::AddSignal, interference, i1, MicroSeconds (4));
+  Simulator::Schedule (MicroSeconds (5), &mmWaveInterference::AddSignal, interference, i3, MicroSeconds (2));
+  Simulator::Schedule (MicroSeconds (6), &mmWaveInterference::AddSignal, interference, i2, MicroSeconds (10));
+  Simulator::Schedule (MicroSeconds (12), &mmWaveInterference::EndRx, interference);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_sinrReports.size (), 1, "The chunk processor should report the SINR once");
+
+  // band 0: S/N for 2 us, S/(I1+N) for 4 us, S/N for 4 us
+  // band 1: S/N for 2 us, S/(I1+N) for 2 us, S/(I1+I2+N) for 2 us, S/(I2+N) for 4 us
+  // bands 2 and 3: no signal
+  std::vector<double> expected (4, 0.0);
+  expected[0] = (2.0 * 1.0 / 0.1 + 4.0 * 1.0 / 0.6 + 4.0 * 1.0 / 0.1) / 10.0;
+  expected[1] = (2.0 * 1.0 / 0.1 + 2.0 * 1.0 / 0.6 + 2.0 * 1.0 / 0.85 + 4.0 * 1.0 / 0.35) / 10.0;
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_sinrReports[0][i], expected[i], 1e-9 * expected[i], "Unexpected SINR in band " << i);
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+* This test case checks the SINR evaluation of a data reception without
+* expected TBs by MmWaveSpectrumPhy, which is skipped only if the
+* RxOfInterestOnly attribute is set
+*/
+class MmWaveRxOfInterestOnlyTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  * \param rxOfInterestOnly the value of the RxOfInterestOnly attribute
+  * \param expectedTb true if a TB is expected in the reception
+  */
+  MmWaveRxOfInterestOnlyTestCase (bool rxOfInterestOnly, bool expectedTb);
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveRxOfInterestOnlyTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Build the name of the test case
+  * \param rxOfInterestOnly the value of the RxOfInterestOnly attribute
+  * \param expectedTb true if a TB is expected in the reception
+  * \return the name of the test case
+  */
+  static std::string BuildNameString (bool rxOfInterestOnly, bool expectedTb);
+
+  /**
+  * Store the SINR reported by the chunk processor
+  * \param sinr the SINR
+  */
+  void ReportSinr (const SpectrumValue& sinr);
+
+  bool m_rxOfInterestOnly;                      //!< The value of the RxOfInterestOnly attribute
+  bool m_expectedTb;                            //!< True if a TB is expected in the reception
+  std::vector<SpectrumValue> m_sinrReports;     //!< The SINR values reported by the chunk processor
+};
+
+MmWaveRxOfInterestOnlyTestCase::MmWaveRxOfInterestOnlyTestCase (bool rxOfInterestOnly, bool expectedTb)
+  : TestCase (BuildNameString (rxOfInterestOnly, expectedTb)),
+    m_rxOfInterestOnly (rxOfInterestOnly),
+    m_expectedTb (expectedTb)
+{
+}
+
+MmWaveRxOfInterestOnlyTestCase::~MmWaveRxOfInterestOnlyTestCase ()
+{
+}
+
+std::string
+MmWaveRxOfInterestOnlyTestCase::BuildNameString (bool rxOfInterestOnly, bool expectedTb)
+{
+  std::ostringstream oss;
+  oss << "Check the SINR evaluation with RxOfInterestOnly " << (rxOfInterestOnly ? "on" : "off")
+      << (expectedTb ? " and an expected TB" : " and no expected TB");
+  return oss.str ();
+}
+
+void
+MmWaveRxOfInterestOnlyTestCase::ReportSinr (const SpectrumValue& sinr)
+{
+  m_sinrReports.push_back (sinr);
+}
+
+void
+MmWaveRxOfInterestOnlyTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      freqs.push_back (28e9 + i * 1e6);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (freqs);
+
+  Ptr<SpectrumValue> noise = Create<SpectrumValue> (sm);
+  (*noise) = 0.1;
+  Ptr<SpectrumValue> signal = Create<SpectrumValue> (sm);
+  (*signal)[0] = 1.0;
+  (*signal)[1] = 1.0;
+
+  // the signal is received by an eNB, as the data of a UE of its cell
+  Ptr<MmWaveSpectrumPhy> phy = CreateObject<MmWaveSpectrumPhy> ();
+  phy->SetDevice (CreateObject<MmWaveEnbNetDevice> ());
+  phy->SetAttribute ("RxOfInterestOnly", BooleanValue (m_rxOfInterestOnly));
+  phy->SetNoisePowerSpectralDensity (noise);
+  phy->SetCellId (1);
+  Ptr<mmWaveChunkProcessor> processor = Create<mmWaveChunkProcessor> ();
+  processor->AddCallback (MakeCallback (&MmWaveSpectrumPhy::UpdateSinrPerceived, phy));
+  processor->AddCallback (MakeCallback (&MmWaveRxOfInterestOnlyTestCase::ReportSinr, this));
+  phy->AddDataSinrChunkProcessor (processor);
+
+  if (m_expectedTb)
+    {
+      std::vector<int> rbMap;
+      rbMap.push_back (0);
+      rbMap.push_back (1);
+      phy->AddExpectedTb (1, 1, 100, 0, rbMap, 0, 0, false, 1, 4);
+    }
+
+  // the first data reception of the PHY, so that no SINR was perceived before
+  Ptr<MmwaveSpectrumSignalParametersDataFrame> params = Create<MmwaveSpectrumSignalParametersDataFrame> ();
+  params->psd = signal;
+  params->duration = MicroSeconds (10);
+  params->cellId = 1;
+  params->txPhy = CreateObject<MmWaveSpectrumPhy> ();
+  phy->StartRx (params);
+  Simulator::Run ();
+
+  if (m_rxOfInterestOnly && !m_expectedTb)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_sinrReports.size (), 0, "The SINR of a reception without expected TBs should not be evaluated");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_sinrReports.size (), 1, "The SINR of the reception should be evaluated");
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_sinrReports[0][0], 10.0, 1e-9, "Unexpected SINR");
+    }
+
+  phy->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+* This suite tests the SINR evaluation of mmWaveInterference
+*/
+class MmWaveInterferenceTest : public TestSuite
+{
+public:
+  MmWaveInterferenceTest ();
+};
+
+MmWaveInterferenceTest::MmWaveInterferenceTest ()
+  : TestSuite ("mmwave-interference-test", UNIT)
+{
+  // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
+  AddTestCase (new MmWaveInterferenceTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveRxOfInterestOnlyTestCase (false, false), TestCase::QUICK);
+  AddTestCase (new MmWaveRxOfInterestOnlyTestCase (true, false), TestCase::QUICK);
+  AddTestCase (new MmWaveRxOfInterestOnlyTestCase (true, true), TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveInterferenceTest mmwaveInterferenceTestSuite;
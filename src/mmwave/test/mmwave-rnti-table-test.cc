@@ -0,0 +1,196 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-rnti-table.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+#include "ns3/log.h"
+
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveRntiTableTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks that MmWaveRntiTable contains and iterates the same
+* values as a std::map after random insertions and erasures, with RNTIs
+* which grow as allocated by the RRC, that the references to the values
+* stay valid until they are erased, and that erasing while iterating visits
+* every value once
+*/
+class MmWaveRntiTableTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveRntiTableTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveRntiTableTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Check that the table and the map contain the same values
+  * \param table the table
+  * \param map the reference map
+  */
+  void CheckContent (const MmWaveRntiTable<uint32_t> &table, const std::map<uint16_t, uint32_t> &map);
+};
+
+MmWaveRntiTableTestCase::MmWaveRntiTableTestCase ()
+  : TestCase ("Check MmWaveRntiTable against std::map")
+{
+}
+
+MmWaveRntiTableTestCase::~MmWaveRntiTableTestCase ()
+{
+}
+
+void
+MmWaveRntiTableTestCase::CheckContent (const MmWaveRntiTable<uint32_t> &table, const std::map<uint16_t, uint32_t> &map)
+{
+  NS_TEST_ASSERT_MSG_EQ (table.size (), map.size (), "Wrong size");
+  // the values are iterated in RNTI order, as in the map
+  std::map<uint16_t, uint32_t>::const_iterator mapIt = map.begin ();
+  for (MmWaveRntiTable<uint32_t>::const_iterator it = table.begin (); it != table.end (); ++it, ++mapIt)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((mapIt != map.end ()), true, "Too many values");
+      NS_TEST_ASSERT_MSG_EQ (it->first, mapIt->first, "Wrong RNTI order");
+      NS_TEST_ASSERT_MSG_EQ (it->second, mapIt->second, "Wrong value for RNTI " << it->first);
+    }
+  for (std::map<uint16_t, uint32_t>::const_iterator it = map.begin (); it != map.end (); ++it)
+    {
+      NS_TEST_ASSERT_MSG_EQ (table.count (it->first), 1, "RNTI " << it->first << " not found");
+      NS_TEST_ASSERT_MSG_EQ (table.find (it->first)->second, it->second, "Wrong value for RNTI " << it->first);
+    }
+}
+
+void
+MmWaveRntiTableTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  MmWaveRntiTable<uint32_t> table;
+  std::map<uint16_t, uint32_t> map;
+  // the address of the value of each RNTI, at insertion
+  std::map<uint16_t, uint32_t*> refs;
+  uint16_t lastRnti = 0;
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      if (rand->GetValue () < 0.5 || map.empty ())
+        {
+          // a new UE, with the next RNTI
+          lastRnti = lastRnti % 65535 + 1;
+          uint32_t value = rand->GetInteger (0, 1000);
+          NS_TEST_ASSERT_MSG_EQ (table.insert (std::make_pair (lastRnti, value)).second, true, "RNTI " << lastRnti << " not inserted");
+          map[lastRnti] = value;
+          refs[lastRnti] = &table.at (lastRnti);
+        }
+      else
+        {
+          // remove a random UE
+          std::map<uint16_t, uint32_t>::iterator it = map.begin ();
+          std::advance (it, rand->GetInteger (0, map.size () - 1));
+          NS_TEST_ASSERT_MSG_EQ (table.erase (it->first), 1, "RNTI " << it->first << " not erased");
+          refs.erase (it->first);
+          map.erase (it);
+        }
+      if (i % 1000 == 0)
+        {
+          CheckContent (table, map);
+          for (std::map<uint16_t, uint32_t*>::const_iterator it = refs.begin (); it != refs.end (); ++it)
+            {
+              NS_TEST_ASSERT_MSG_EQ ((it->second == &table.at (it->first)), true, "The value of RNTI " << it->first << " moved");
+            }
+        }
+    }
+  CheckContent (table, map);
+  NS_TEST_ASSERT_MSG_EQ (table.erase (lastRnti + 1), 0, "Erased a missing RNTI");
+  NS_TEST_ASSERT_MSG_EQ ((table.find (lastRnti + 1) == table.end ()), true, "Found a missing RNTI");
+
+  // decrement the values while iterating, and erase the values which reach 0
+  for (uint32_t round = 0; !map.empty (); round++)
+    {
+      uint32_t visited = 0;
+      MmWaveRntiTable<uint32_t>::iterator it = table.begin ();
+      while (it != table.end ())
+        {
+          visited++;
+          if (it->second <= round)
+            {
+              it = table.erase (it);
+            }
+          else
+            {
+              ++it;
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (visited, map.size (), "Wrong number of values visited in round " << round);
+      for (std::map<uint16_t, uint32_t>::iterator mapIt = map.begin (); mapIt != map.end (); )
+        {
+          if (mapIt->second <= round)
+            {
+              mapIt = map.erase (mapIt);
+            }
+          else
+            {
+              ++mapIt;
+            }
+        }
+      CheckContent (table, map);
+    }
+
+  // the table is reused after clear
+  table[5] = 7;
+  table.clear ();
+  NS_TEST_ASSERT_MSG_EQ (table.empty (), true, "The table is not empty");
+  table[3] = 4;
+  NS_TEST_ASSERT_MSG_EQ (table.at (3), 4, "Wrong value after clear");
+  NS_TEST_ASSERT_MSG_EQ (table.size (), 1, "Wrong size after clear");
+  NS_TEST_ASSERT_MSG_EQ (table[5], 0, "The value cleared is not reset when inserted again");
+  NS_TEST_ASSERT_MSG_EQ (table.size (), 2, "Wrong size after the insertion of a cleared RNTI");
+}
+
+/**
+* This suite tests the table of per-UE values used by the schedulers
+*/
+class MmWaveRntiTableTest : public TestSuite
+{
+public:
+  MmWaveRntiTableTest ();
+};
+
+MmWaveRntiTableTest::MmWaveRntiTableTest ()
+  : TestSuite ("mmwave-rnti-table", UNIT)
+{
+  // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
+  AddTestCase (new MmWaveRntiTableTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveRntiTableTest mmwaveRntiTableTestSuite;
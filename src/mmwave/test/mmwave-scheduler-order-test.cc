@@ -0,0 +1,378 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-mac-scheduler.h"
+#include "ns3/mmwave-phy-mac-common.h"
+#include "ns3/boolean.h"
+#include "ns3/test.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSchedulerOrderTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* Sched SAP user which records the allocations of each slot as a string,
+* with an entry D|U<rnti>:<first symbol>+<number of symbols>:m<MCS>:t<TB size>
+* for each DCI
+*/
+class OrderTestSchedSapUser : public MmWaveMacSchedSapUser
+{
+public:
+  virtual void SchedConfigInd (const struct SchedConfigIndParameters& params)
+  {
+    std::ostringstream slot;
+    for (std::deque<TtiAllocInfo>::const_iterator it = params.m_slotAllocInfo.m_ttiAllocInfo.begin ();
+         it != params.m_slotAllocInfo.m_ttiAllocInfo.end (); ++it)
+      {
+        const DciInfoElementTdma &dci = it->m_dci;
+        slot << (dci.m_format == DciInfoElementTdma::DL_dci ? "D" : "U") << dci.m_rnti
+             << ":" << (uint32_t) dci.m_symStart << "+" << (uint32_t) dci.m_numSym
+             << ":m" << (uint32_t) dci.m_mcs << ":t" << dci.m_tbSize << " ";
+      }
+    m_slots.push_back (slot.str ());
+  }
+  std::vector<std::string> m_slots; //!< the allocations of each slot
+};
+
+/**
+* Csched SAP user which discards the confirmations
+*/
+class OrderTestCschedSapUser : public MmWaveMacCschedSapUser
+{
+public:
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+  {
+  }
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+  {
+  }
+};
+
+/**
+* Configures a UE with a single logical channel
+* \param cschedSap the Csched SAP of the scheduler
+* \param rnti the RNTI
+*/
+static void
+AddOrderTestUe (MmWaveMacCschedSapProvider *cschedSap, uint16_t rnti)
+{
+  MmWaveMacCschedSapProvider::CschedUeConfigReqParameters ueParams;
+  ueParams.m_rnti = rnti;
+  ueParams.m_transmissionMode = 0;
+  ueParams.m_reconfigureFlag = false;
+  cschedSap->CschedUeConfigReq (ueParams);
+
+  LogicalChannelConfigListElement_s lc;
+  lc.m_logicalChannelIdentity = 3;
+  lc.m_logicalChannelGroup = 1;
+  lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+  lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+  lc.m_qci = 9;
+  lc.m_eRabMaximulBitrateUl = 0;
+  lc.m_eRabMaximulBitrateDl = 0;
+  lc.m_eRabGuaranteedBitrateUl = 0;
+  lc.m_eRabGuaranteedBitrateDl = 0;
+  MmWaveMacCschedSapProvider::CschedLcConfigReqParameters lcParams;
+  lcParams.m_rnti = rnti;
+  lcParams.m_reconfigureFlag = false;
+  lcParams.m_logicalChannelConfigList.push_back (lc);
+  cschedSap->CschedLcConfigReq (lcParams);
+}
+
+/**
+* Drives a scheduler through its SAPs with a multi-UE trigger sequence, in
+* which the UEs are configured, report their buffers and are released in
+* an order different from the RNTI order, and records the allocations
+* \param schedulerType the TypeId name of the scheduler
+* \return the allocations of each slot
+*/
+static std::vector<std::string>
+ReplayOrderTestSchedule (std::string schedulerType)
+{
+  Ptr<MmWavePhyMacCommon> config = CreateObject<MmWavePhyMacCommon> ();
+  ObjectFactory factory;
+  factory.SetTypeId (schedulerType);
+  factory.Set ("HarqEnabled", BooleanValue (false));
+  Ptr<MmWaveMacScheduler> scheduler = factory.Create<MmWaveMacScheduler> ();
+  scheduler->ConfigureCommonParameters (config);
+  OrderTestSchedSapUser schedSapUser;
+  OrderTestCschedSapUser cschedSapUser;
+  scheduler->SetMacSchedSapUser (&schedSapUser);
+  scheduler->SetMacCschedSapUser (&cschedSapUser);
+  MmWaveMacSchedSapProvider *schedSap = scheduler->GetMacSchedSapProvider ();
+  MmWaveMacCschedSapProvider *cschedSap = scheduler->GetMacCschedSapProvider ();
+
+  // the UEs are not configured in RNTI order
+  std::vector<uint16_t> ues = {5, 2, 7, 1, 4, 3, 6};
+  for (uint16_t rnti : ues)
+    {
+      AddOrderTestUe (cschedSap, rnti);
+    }
+
+  uint32_t slotsPerSf = config->GetSlotsPerSubframe ();
+  uint32_t sfPerFrame = config->GetSubframesPerFrame ();
+  for (uint32_t slot = 0; slot < 16; slot++)
+    {
+      SfnSf sfnSf (slot / (slotsPerSf * sfPerFrame),
+                   (slot / slotsPerSf) % sfPerFrame,
+                   slot % slotsPerSf);
+      if (slot == 6)
+        {
+          // release two UEs, and add two UEs in decreasing RNTI order
+          for (uint16_t rnti : {2, 7})
+            {
+              MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters releaseParams;
+              releaseParams.m_rnti = rnti;
+              cschedSap->CschedUeReleaseReq (releaseParams);
+              ues.erase (std::find (ues.begin (), ues.end (), rnti));
+            }
+          for (uint16_t rnti : {9, 8})
+            {
+              AddOrderTestUe (cschedSap, rnti);
+              ues.push_back (rnti);
+            }
+        }
+      if (slot % 8 == 0 || slot == 6)
+        {
+          // several UEs share the same CQI, so that the schedulers break ties
+          MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiParams;
+          cqiParams.m_sfnsf = sfnSf;
+          for (uint16_t rnti : ues)
+            {
+              DlCqiInfo cqi;
+              cqi.m_rnti = rnti;
+              cqi.m_ri = 1;
+              cqi.m_cqiType = DlCqiInfo::WB;
+              cqi.m_wbCqi = 8 + (rnti + slot) % 3;
+              cqi.m_wbPmi = 0;
+              cqiParams.m_cqiList.push_back (cqi);
+            }
+          schedSap->SchedDlCqiInfoReq (cqiParams);
+        }
+
+      // the buffer reports arrive in a different order at each slot
+      std::vector<uint16_t> reportOrder = ues;
+      std::rotate (reportOrder.begin (), reportOrder.begin () + slot % reportOrder.size (), reportOrder.end ());
+      if (slot % 2 == 1)
+        {
+          std::reverse (reportOrder.begin (), reportOrder.end ());
+        }
+      for (uint16_t rnti : reportOrder)
+        {
+          MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters rlcParams;
+          rlcParams.m_rnti = rnti;
+          rlcParams.m_logicalChannelIdentity = 3;
+          rlcParams.m_rlcTransmissionQueueSize = 2000 + 3000 * ((rnti + slot) % 4);
+          rlcParams.m_rlcTransmissionQueueHolDelay = 0;
+          rlcParams.m_rlcRetransmissionQueueSize = 0;
+          rlcParams.m_rlcRetransmissionHolDelay = 0;
+          rlcParams.m_rlcStatusPduSize = 0;
+          rlcParams.m_arrivalRate = 0;
+          rlcParams.m_txPacketSizes.push_back (rlcParams.m_rlcTransmissionQueueSize);
+          rlcParams.m_txPacketDelays.push_back (10.0 * ((rnti + slot) % 2));
+          schedSap->SchedDlRlcBufferReq (rlcParams);
+        }
+
+      if (slot % 4 == 1)
+        {
+          MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters bsrParams;
+          bsrParams.m_sfnSf = sfnSf;
+          for (uint16_t rnti : {6, 1, 3})
+            {
+              MacCeElement bsr;
+              bsr.m_rnti = rnti;
+              bsr.m_macCeType = MacCeElement::BSR;
+              bsr.m_macCeValue.m_bufferStatus.resize (4, 0);
+              bsr.m_macCeValue.m_bufferStatus.at (1) = 20 + rnti + slot;
+              bsrParams.m_macCeList.push_back (bsr);
+            }
+          schedSap->SchedUlMacCtrlInfoReq (bsrParams);
+        }
+
+      MmWaveMacSchedSapProvider::SchedTriggerReqParameters triggerParams;
+      triggerParams.m_snfSf = sfnSf;
+      triggerParams.m_ueList = std::list<uint16_t> (ues.begin (), ues.end ());
+      schedSap->SchedTriggerReq (triggerParams);
+    }
+
+  scheduler->Dispose ();
+  return schedSapUser.m_slots;
+}
+
+/**
+* This test case checks that a FlexTti scheduler allocates the UEs as the
+* std::map-based implementation did, i.e., that the round robin resumes
+* and wraps around in RNTI order, and that the ties are broken in RNTI order.
+* The reference allocations were recorded with the schedulers keeping the
+* per-UE state in std::map.
+*/
+class MmWaveSchedulerOrderTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  * \param schedulerType the TypeId name of the scheduler
+  * \param reference the reference allocations of each slot
+  */
+  MmWaveSchedulerOrderTestCase (std::string schedulerType, std::vector<std::string> reference);
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveSchedulerOrderTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  std::string m_schedulerType; //!< the TypeId name of the scheduler
+  std::vector<std::string> m_reference; //!< the reference allocations
+};
+
+MmWaveSchedulerOrderTestCase::MmWaveSchedulerOrderTestCase (std::string schedulerType, std::vector<std::string> reference)
+  : TestCase ("Check the allocations of " + schedulerType + " against std::map"),
+    m_schedulerType (schedulerType),
+    m_reference (reference)
+{
+}
+
+MmWaveSchedulerOrderTestCase::~MmWaveSchedulerOrderTestCase ()
+{
+}
+
+void
+MmWaveSchedulerOrderTestCase::DoRun (void)
+{
+  std::vector<std::string> slots = ReplayOrderTestSchedule (m_schedulerType);
+  NS_TEST_ASSERT_MSG_EQ (slots.size (), m_reference.size (), "Wrong number of slots");
+  for (uint32_t i = 0; i < slots.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (slots.at (i), m_reference.at (i), "Wrong allocations in slot " << i);
+    }
+}
+
+/**
+* This suite tests the order in which the schedulers serve the UEs
+*/
+class MmWaveSchedulerOrderTest : public TestSuite
+{
+public:
+  MmWaveSchedulerOrderTest ();
+};
+
+MmWaveSchedulerOrderTest::MmWaveSchedulerOrderTest ()
+  : TestSuite ("mmwave-scheduler-order", UNIT)
+{
+  // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
+  AddTestCase (new MmWaveSchedulerOrderTestCase ("ns3::MmWaveFlexTtiMacScheduler", {
+    "D0:0+1:m0:t0 D1:1+2:m16:t1879 D2:3+2:m18:t2115 D3:5+2:m14:t1503 D4:7+2:m16:t1879 D5:9+2:m18:t2115 D6:11+1:m14:t753 D7:12+1:m16:t936 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D6:1+2:m14:t1503 D7:3+1:m16:t936 D1:4+1:m16:t936 D2:5+1:m18:t1054 D3:6+1:m14:t753 D4:7+1:m16:t936 D5:8+1:m18:t1054 U6:9+2:m0:t123 U1:11+1:m0:t60 U3:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D7:1+2:m16:t1879 D1:3+2:m16:t1879 D2:5+1:m18:t1054 D3:6+1:m14:t753 D4:7+1:m16:t936 D5:8+1:m18:t1054 D6:9+1:m14:t753 U1:10+1:m0:t60 U3:11+1:m0:t60 U6:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D2:1+2:m18:t2115 D3:3+2:m14:t1503 D4:5+1:m16:t936 D5:6+1:m18:t1054 D6:7+1:m14:t753 D7:8+1:m16:t936 D1:9+1:m16:t936 U3:10+1:m0:t60 U6:11+1:m0:t60 U1:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D4:1+2:m16:t1879 D5:3+2:m18:t2115 D6:5+1:m14:t753 D7:6+1:m16:t936 D1:7+1:m16:t936 D2:8+1:m18:t1054 D3:9+1:m14:t753 U6:10+1:m0:t60 U1:11+1:m0:t60 U3:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D6:1+2:m14:t1503 D7:3+1:m16:t936 D1:4+1:m16:t936 D2:5+1:m18:t1054 D3:6+1:m14:t753 D4:7+1:m16:t936 D5:8+1:m18:t1054 U6:9+2:m0:t123 U1:11+1:m0:t60 U3:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+2:m16:t1879 D3:3+1:m14:t753 D4:4+1:m16:t936 D5:5+1:m18:t1054 D6:6+1:m14:t753 D8:7+1:m18:t1054 D9:8+1:m14:t753 U1:9+2:m0:t123 U3:11+1:m0:t60 U6:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D3:1+2:m14:t1503 D4:3+1:m16:t936 D5:4+1:m18:t1054 D6:5+1:m14:t753 D8:6+1:m18:t1054 D9:7+1:m14:t753 D1:8+1:m16:t936 U3:9+2:m0:t123 U6:11+1:m0:t60 U1:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D4:1+2:m14:t1503 D5:3+2:m16:t1879 D6:5+1:m18:t1054 D8:6+1:m16:t936 D9:7+1:m18:t1054 D1:8+1:m14:t753 D3:9+1:m18:t1054 U6:10+1:m0:t60 U1:11+1:m0:t60 U3:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D6:1+2:m18:t2115 D8:3+1:m16:t936 D9:4+1:m18:t1054 D1:5+1:m14:t753 D3:6+1:m18:t1054 D4:7+1:m14:t753 D5:8+1:m16:t936 U6:9+2:m0:t123 U1:11+1:m0:t60 U3:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D8:1+2:m16:t1879 D9:3+2:m18:t2115 D1:5+1:m14:t753 D3:6+1:m18:t1054 D4:7+1:m14:t753 D5:8+1:m16:t936 D6:9+1:m18:t1054 U1:10+1:m0:t60 U3:11+1:m0:t60 U6:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+2:m14:t1503 D3:3+1:m18:t1054 D4:4+1:m14:t753 D5:5+1:m16:t936 D6:6+1:m18:t1054 D8:7+1:m16:t936 D9:8+1:m18:t1054 U1:9+2:m0:t123 U3:11+1:m0:t60 U6:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D3:1+2:m18:t2115 D4:3+1:m14:t753 D5:4+1:m16:t936 D6:5+1:m18:t1054 D8:6+1:m16:t936 D9:7+1:m18:t1054 D1:8+1:m14:t753 U3:9+2:m0:t123 U6:11+1:m0:t60 U1:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D4:1+2:m14:t1503 D5:3+2:m16:t1879 D6:5+1:m18:t1054 D8:6+1:m16:t936 D9:7+1:m18:t1054 D1:8+1:m14:t753 D3:9+1:m18:t1054 U6:10+1:m0:t60 U1:11+1:m0:t60 U3:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D6:1+2:m18:t2115 D8:3+1:m16:t936 D9:4+1:m18:t1054 D1:5+1:m14:t753 D3:6+1:m18:t1054 D4:7+1:m14:t753 D5:8+1:m16:t936 U6:9+2:m0:t123 U1:11+1:m0:t60 U3:12+1:m0:t60 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D8:1+2:m16:t1879 D9:3+2:m18:t2115 D1:5+1:m14:t753 D3:6+1:m18:t1054 D4:7+1:m14:t753 D5:8+1:m16:t936 D6:9+1:m18:t1054 U1:10+1:m0:t60 U3:11+1:m0:t60 U6:12+1:m0:t60 D0:13+1:m0:t0 "
+  }), TestCase::QUICK);
+  AddTestCase (new MmWaveSchedulerOrderTestCase ("ns3::MmWaveFlexTtiPfMacScheduler", {
+    "D0:0+1:m0:t0 D1:1+1:m16:t936 D2:2+2:m18:t2115 D3:4+3:m14:t2257 D4:7+1:m16:t936 D5:8+1:m18:t1054 D6:9+2:m14:t1503 D7:11+2:m16:t1879 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+2:m16:t1879 D2:3+2:m18:t2115 D3:5+1:m14:t753 D4:6+1:m16:t936 D5:7+2:m18:t2115 D6:9+3:m14:t2257 D7:12+1:m16:t936 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+3:m16:t2821 D2:4+1:m18:t1054 D3:5+2:m14:t1503 D4:7+2:m16:t1879 D5:9+2:m18:t2115 D6:11+1:m14:t753 D7:12+1:m16:t936 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m16:t936 D2:2+1:m18:t1054 D3:3+2:m14:t1503 D4:5+3:m16:t2821 D5:8+1:m18:t1054 D6:9+2:m14:t1503 D7:11+2:m16:t1879 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m16:t936 D2:2+2:m18:t2115 D3:4+3:m14:t2257 D4:7+1:m16:t936 D5:8+1:m18:t1054 D6:9+2:m14:t1503 D7:11+2:m16:t1879 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+2:m16:t1879 D2:3+2:m18:t2115 D3:5+1:m14:t753 D4:6+1:m16:t936 D5:7+2:m18:t2115 D6:9+3:m14:t2257 D7:12+1:m16:t936 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+2:m16:t1879 D2:3+2:m18:t2115 D3:5+1:m14:t753 D4:6+1:m16:t936 D5:7+2:m18:t2115 D6:9+1:m14:t753 D7:10+1:m16:t936 D8:11+1:m18:t1054 D9:12+1:m14:t753 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m16:t936 D2:2+2:m18:t2115 D3:4+1:m14:t753 D4:5+2:m16:t1879 D5:7+1:m18:t1054 D6:8+1:m14:t753 D7:9+1:m16:t936 D8:10+2:m18:t2115 D9:12+1:m14:t753 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m14:t753 D2:2+2:m18:t2115 D3:4+2:m18:t2115 D4:6+1:m14:t753 D5:7+1:m16:t936 D6:8+2:m18:t2115 D7:10+1:m16:t936 D8:11+1:m16:t936 D9:12+1:m18:t1054 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m14:t753 D2:2+2:m18:t2115 D3:4+1:m18:t1054 D4:5+1:m14:t753 D5:6+2:m16:t1879 D6:8+2:m18:t2115 D7:10+1:m16:t936 D8:11+1:m16:t936 D9:12+1:m18:t1054 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m14:t753 D2:2+2:m18:t2115 D3:4+1:m18:t1054 D4:5+1:m14:t753 D5:6+2:m16:t1879 D6:8+1:m18:t1054 D7:9+1:m16:t936 D8:10+1:m16:t936 D9:11+2:m18:t2115 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m14:t753 D2:2+2:m18:t2115 D3:4+1:m18:t1054 D4:5+2:m14:t1503 D5:7+1:m16:t936 D6:8+1:m18:t1054 D7:9+1:m16:t936 D8:10+2:m16:t1879 D9:12+1:m18:t1054 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m14:t753 D2:2+2:m18:t2115 D3:4+2:m18:t2115 D4:6+1:m14:t753 D5:7+1:m16:t936 D6:8+2:m18:t2115 D7:10+1:m16:t936 D8:11+1:m16:t936 D9:12+1:m18:t1054 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m14:t753 D2:2+2:m18:t2115 D3:4+1:m18:t1054 D4:5+1:m14:t753 D5:6+2:m16:t1879 D6:8+2:m18:t2115 D7:10+1:m16:t936 D8:11+1:m16:t936 D9:12+1:m18:t1054 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m14:t753 D2:2+2:m18:t2115 D3:4+1:m18:t1054 D4:5+1:m14:t753 D5:6+2:m16:t1879 D6:8+1:m18:t1054 D7:9+1:m16:t936 D8:10+1:m16:t936 D9:11+2:m18:t2115 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+1:m14:t753 D2:2+2:m18:t2115 D3:4+1:m18:t1054 D4:5+2:m14:t1503 D5:7+1:m16:t936 D6:8+1:m18:t1054 D7:9+1:m16:t936 D8:10+2:m16:t1879 D9:12+1:m18:t1054 D0:13+1:m0:t0 "
+  }), TestCase::QUICK);
+  AddTestCase (new MmWaveSchedulerOrderTestCase ("ns3::MmWaveFlexTtiMaxRateMacScheduler", {
+    "D0:0+1:m0:t0 D2:1+7:m18:t7413 D5:8+5:m18:t5295 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D2:1+6:m18:t6352 D5:7+6:m18:t6352 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D2:1+2:m18:t2115 D5:3+10:m18:t10593 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+2:m16:t1879 D2:3+5:m18:t5295 D4:8+2:m16:t1879 D5:10+2:m18:t2115 D7:12+1:m16:t936 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D2:1+7:m18:t7413 D5:8+5:m18:t5295 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D2:1+6:m18:t6352 D5:7+6:m18:t6352 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D5:1+6:m18:t6352 D8:7+6:m18:t6352 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D5:1+2:m18:t2115 D8:3+10:m18:t10593 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D3:1+4:m18:t4234 D6:5+4:m18:t4234 D9:9+4:m18:t4234 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D3:1+2:m18:t2115 D6:3+4:m18:t4234 D9:7+4:m18:t4234 U3:11+2:m0:t123 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D6:1+2:m18:t2115 D9:3+4:m18:t4234 U3:7+4:m0:t249 U6:11+2:m0:t123 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D9:1+2:m18:t2115 U3:3+5:m0:t312 U6:8+5:m0:t312 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D9:1+4:m18:t4234 U3:5+4:m0:t249 U6:9+4:m0:t249 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D9:1+4:m18:t4234 U3:5+4:m0:t249 U6:9+4:m0:t249 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D9:1+4:m18:t4234 U3:5+4:m0:t249 U6:9+4:m0:t249 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D9:1+2:m18:t2115 U3:3+5:m0:t312 U6:8+5:m0:t312 D0:13+1:m0:t0 "
+  }), TestCase::QUICK);
+  AddTestCase (new MmWaveSchedulerOrderTestCase ("ns3::MmWaveFlexTtiMaxWeightMacScheduler", {
+    "D0:0+1:m0:t0 D1:1+6:m16:t5646 D3:7+6:m14:t4517 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D2:1+11:m18:t11650 D4:12+1:m16:t936 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+12:m16:t11299 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D2:1+5:m18:t5295 D4:6+7:m16:t6589 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+6:m16:t5646 D3:7+6:m14:t4517 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D2:1+11:m18:t11650 D4:12+1:m16:t936 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+9:m16:t8471 D7:10+3:m16:t2821 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D4:1+12:m16:t11299 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+7:m14:t5271 D3:8+5:m18:t5295 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D4:1+7:m14:t5271 D6:8+5:m18:t5295 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+12:m14:t9038 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D4:1+12:m14:t9038 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+7:m14:t5271 D3:8+5:m18:t5295 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D4:1+7:m14:t5271 D6:8+5:m18:t5295 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D1:1+12:m14:t9038 D0:13+1:m0:t0 ",
+    "D0:0+1:m0:t0 D4:1+12:m14:t9038 D0:13+1:m0:t0 "
+  }), TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveSchedulerOrderTest mmwaveSchedulerOrderTestSuite;
@@ -0,0 +1,224 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-helper.h"
+#include "ns3/mmwave-spectrum-value-helper.h"
+#include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSinrEstimateTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks that the SINR estimate of the attached UEs, computed
+* by MmWaveEnbPhy::UpdateUeSinrEstimate for the beams the devices would use,
+* matches the one obtained by pointing the antennas towards each other, and
+* that it does not modify the beams of the eNBs and of the UEs
+*/
+class MmWaveSinrEstimateTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveSinrEstimateTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveSinrEstimateTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveSinrEstimateTestCase::MmWaveSinrEstimateTestCase ()
+  : TestCase ("Checks the per-UE SINR estimate of the eNBs")
+{
+}
+
+MmWaveSinrEstimateTestCase::~MmWaveSinrEstimateTestCase ()
+{
+}
+
+void
+MmWaveSinrEstimateTestCase::DoRun (void)
+{
+  // Create two BSs, attach two UEs to BS1 and one UE to BS2. Each BS
+  // estimates the SINR of all the UEs.
+
+  //  (-10,20,1.6)  (10,20,1.6)           (100,20,1.6)
+  //      UE1          UE2                     UE3
+  //           BS1-----------------------------BS2
+  //        (0,0,25)----------------------(100,0,25)
+
+  Ptr<MmWaveHelper> helper = CreateObject<MmWaveHelper> ();
+  helper->SetPathlossModelType ("ns3::ThreeGppUmaPropagationLossModel");
+  helper->SetChannelConditionModelType ("ns3::ThreeGppUmaChannelConditionModel");
+  helper->SetChannelModelType ("ns3::ThreeGppSpectrumPropagationLossModel");
+
+  NodeContainer bsNodes;
+  bsNodes.Create (2);
+  Ptr<ListPositionAllocator> bsPositionAlloc = CreateObject<ListPositionAllocator> ();
+  bsPositionAlloc->Add (Vector (0.0, 0.0, 25.0));
+  bsPositionAlloc->Add (Vector (100.0, 0.0, 25.0));
+  MobilityHelper bsMobility;
+  bsMobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  bsMobility.SetPositionAllocator (bsPositionAlloc);
+  bsMobility.Install (bsNodes);
+  NetDeviceContainer bsNetDevs = helper->InstallEnbDevice (bsNodes);
+
+  NodeContainer ueNodes;
+  ueNodes.Create (3);
+  Ptr<ListPositionAllocator> uePositionAlloc = CreateObject<ListPositionAllocator> ();
+  uePositionAlloc->Add (Vector (-10.0, 20.0, 1.6));
+  uePositionAlloc->Add (Vector (10.0, 20.0, 1.6));
+  uePositionAlloc->Add (Vector (100.0, 20.0, 1.6));
+  MobilityHelper ueMobility;
+  ueMobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  ueMobility.SetPositionAllocator (uePositionAlloc);
+  ueMobility.Install (ueNodes);
+  NetDeviceContainer ueNetDevs = helper->InstallUeDevice (ueNodes);
+
+  helper->AttachToClosestEnb (ueNetDevs, bsNetDevs);
+
+  Ptr<MmWaveUeNetDevice> ue1 = DynamicCast<MmWaveUeNetDevice> (ueNetDevs.Get (0));
+
+  // run a first estimate: the shadowing of each link is redrawn the second
+  // time it is evaluated, and it is stable afterwards
+  for (uint32_t b = 0; b < bsNetDevs.GetN (); b++)
+    {
+      DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (b))->GetPhy ()->UpdateUeSinrEstimate ();
+    }
+
+  // point the beams of the BSs towards UE1, the first UE whose SINR they
+  // estimate, so that a beam left towards the last UE would be detected
+  for (uint32_t i = 0; i < bsNetDevs.GetN (); i++)
+    {
+      DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (i))->GetPhy ()->GetDlSpectrumPhy ()->ConfigureBeamforming (ue1);
+    }
+
+  // store the current beams
+  std::vector<Ptr<ThreeGppAntennaArrayModel> > antennas;
+  for (uint32_t i = 0; i < bsNetDevs.GetN (); i++)
+    {
+      antennas.push_back (DynamicCast<MmWaveNetDevice> (bsNetDevs.Get (i))->GetAntenna (0));
+    }
+  for (uint32_t i = 0; i < ueNetDevs.GetN (); i++)
+    {
+      antennas.push_back (DynamicCast<MmWaveNetDevice> (ueNetDevs.Get (i))->GetAntenna (0));
+    }
+  std::vector<ThreeGppAntennaArrayModel::ComplexVector> beams;
+  std::vector<bool> omni;
+  for (Ptr<ThreeGppAntennaArrayModel> antenna : antennas)
+    {
+      beams.push_back (antenna->GetBeamformingVector ());
+      omni.push_back (antenna->IsOmniTx ());
+    }
+
+  // compute the SINR estimate again, the beams must not change
+  for (uint32_t b = 0; b < bsNetDevs.GetN (); b++)
+    {
+      DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (b))->GetPhy ()->UpdateUeSinrEstimate ();
+    }
+  for (uint32_t i = 0; i < antennas.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((antennas[i]->GetBeamformingVector () == beams[i]), true, "The beam of antenna " << i << " changed");
+      NS_TEST_ASSERT_MSG_EQ (antennas[i]->IsOmniTx (), omni[i], "The omni configuration of antenna " << i << " changed");
+    }
+
+  // compare the rx PSD of each UE with the one obtained by pointing the
+  // antennas towards each other, as done before the beams were preserved
+  for (uint32_t b = 0; b < bsNetDevs.GetN (); b++)
+    {
+      Ptr<MmWaveEnbNetDevice> bs = DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (b));
+      Ptr<MmWaveEnbPhy> bsPhy = bs->GetPhy ();
+      Ptr<MmWaveSpectrumPhy> bsSpectrumPhy = bsPhy->GetDlSpectrumPhy ();
+      Ptr<SpectrumPropagationLossModel> splm = bsSpectrumPhy->GetSpectrumChannel ()->GetSpectrumPropagationLossModel ();
+      NS_TEST_ASSERT_MSG_NE (DynamicCast<ThreeGppSpectrumPropagationLossModel> (splm), 0, "The 3GPP spectrum propagation loss model should be used");
+      Ptr<MobilityModel> bsMob = bs->GetNode ()->GetObject<MobilityModel> ();
+      NS_TEST_ASSERT_MSG_EQ (bsPhy->m_rxPsdMap.size (), ueNetDevs.GetN (), "BS " << b << " should estimate the SINR of all the UEs");
+
+      for (uint32_t u = 0; u < ueNetDevs.GetN (); u++)
+        {
+          Ptr<MmWaveUeNetDevice> ue = DynamicCast<MmWaveUeNetDevice> (ueNetDevs.Get (u));
+          std::map<uint64_t, Ptr<SpectrumValue> >::const_iterator rxPsdIt = bsPhy->m_rxPsdMap.find (ue->GetImsi ());
+          NS_TEST_ASSERT_MSG_EQ ((rxPsdIt != bsPhy->m_rxPsdMap.end ()), true, "No SINR estimate for BS " << b << " and UE " << u);
+          Ptr<MmWaveSpectrumPhy> ueSpectrumPhy = ue->GetPhy ()->GetDlSpectrumPhy ();
+          Ptr<MobilityModel> ueMob = ue->GetNode ()->GetObject<MobilityModel> ();
+
+          std::vector<int> chunks;
+          for (uint32_t i = 0; i < bsPhy->GetConfigurationParameters ()->GetNumChunks (); i++)
+            {
+              chunks.push_back (i);
+            }
+          Ptr<SpectrumValue> txPsd = MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (bsPhy->GetConfigurationParameters (),
+                                                                                               ue->GetPhy ()->GetTxPower (), chunks);
+          *txPsd *= std::pow (10.0, bsPhy->m_propagationLoss->CalcRxPower (0, ueMob, bsMob) / 10.0);
+
+          bsSpectrumPhy->ConfigureBeamforming (ue);
+          ueSpectrumPhy->ConfigureBeamforming (bs);
+          Ptr<SpectrumValue> refRxPsd = splm->CalcRxPowerSpectralDensity (txPsd, ueMob, bsMob);
+          for (uint32_t i = 0; i < antennas.size (); i++)
+            {
+              if (omni[i])
+                {
+                  antennas[i]->ChangeToOmniTx ();
+                }
+              else
+                {
+                  antennas[i]->SetBeamformingVector (beams[i]);
+                }
+            }
+
+          for (uint32_t i = 0; i < refRxPsd->GetSpectrumModel ()->GetNumBands (); i++)
+            {
+              NS_TEST_ASSERT_MSG_EQ_TOL ((*rxPsdIt->second)[i], (*refRxPsd)[i], 1e-9 * (*refRxPsd)[i],
+                                         "Unexpected rx PSD in band " << i << " for BS " << b << " and UE " << u);
+            }
+        }
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+* This suite tests the per-UE SINR estimate of the eNBs
+*/
+class MmWaveSinrEstimateTest : public TestSuite
+{
+public:
+  MmWaveSinrEstimateTest ();
+};
+
+MmWaveSinrEstimateTest::MmWaveSinrEstimateTest ()
+  : TestSuite ("mmwave-sinr-estimate-test", UNIT)
+{
+  // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
+  AddTestCase (new MmWaveSinrEstimateTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveSinrEstimateTest mmwaveSinrEstimateTestSuite;
@@ -20,8 +20,11 @@
 #include "channel-condition-model.h"
 #include "ns3/log.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/mobility-model.h"
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 
@@ -181,6 +184,12 @@ ThreeGppChannelConditionModel::GetTypeId (void)
                    TimeValue (MilliSeconds (0)),
                    MakeTimeAccessor (&ThreeGppChannelConditionModel::m_updatePeriod),
                    MakeTimeChecker ())
+    .AddAttribute ("BulkUpdate", "If true and UpdatePeriod is not 0, the channel conditions of all the links in use are recomputed "
+                   "together at each multiple of UpdatePeriod, and the links not used since the previous update are removed from the cache. "
+                   "Otherwise, each channel condition is recomputed on the first request after it expired.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ThreeGppChannelConditionModel::m_bulkUpdate),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -199,10 +208,36 @@ ThreeGppChannelConditionModel::~ThreeGppChannelConditionModel ()
 
 void ThreeGppChannelConditionModel::DoDispose ()
 {
+  m_bulkUpdateEvent.Cancel ();
   m_channelConditionMap.clear ();
   m_updatePeriod = Seconds (0.0);
 }
 
+Ptr<ChannelCondition>
+ThreeGppChannelConditionModel::ComputeChannelCondition (Ptr<const MobilityModel> a,
+                                                        Ptr<const MobilityModel> b) const
+{
+  // compute the LOS probability (see 3GPP TR 38.901, Sec. 7.4.2)
+  double pLos = ComputePlos (a, b);
+
+  // draw a random value
+  double pRef = m_uniformVar->GetValue ();
+
+  // get the channel condition
+  Ptr<ChannelCondition> cond = CreateObject<ChannelCondition> ();
+  if (pRef <= pLos)
+    {
+      // LOS
+      cond->SetLosCondition (ChannelCondition::LosConditionValue::LOS);
+    }
+  else
+    {
+      // NLOS
+      cond->SetLosCondition (ChannelCondition::LosConditionValue::NLOS);
+    }
+  return cond;
+}
+
 Ptr<ChannelCondition>
 ThreeGppChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
                                                     Ptr<const MobilityModel> b) const
@@ -212,6 +247,7 @@ ThreeGppChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
   // get the key for this channel
   uint32_t key = GetKey (a, b);
 
+  bool bulkUpdate = m_bulkUpdate && !m_updatePeriod.IsZero ();
   bool notFound = false; // indicates if the channel condition is not present in the map
   bool update = false; // indicates if the channel condition has to be updated
 
@@ -222,8 +258,14 @@ ThreeGppChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
       NS_LOG_DEBUG ("found the channel condition in the map");
       cond = mapItem->second.m_condition;
 
+      if (bulkUpdate)
+        {
+          // the condition is kept up to date by UpdateChannelConditions,
+          // only record that the link is still in use
+          const_cast<Item&> (mapItem->second).m_accessed = true;
+        }
       // check if it has to be updated
-      if (!m_updatePeriod.IsZero () && Simulator::Now () - mapItem->second.m_generatedTime > m_updatePeriod)
+      else if (!m_updatePeriod.IsZero () && Simulator::Now () - mapItem->second.m_generatedTime > m_updatePeriod)
         {
           NS_LOG_DEBUG ("it has to be updated");
           update = true;
@@ -239,38 +281,78 @@ ThreeGppChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
   // generate a new channel condition
   if (notFound || update)
     {
-      // compute the LOS probability (see 3GPP TR 38.901, Sec. 7.4.2)
-      double pLos = ComputePlos (a, b);
-
-      // draw a random value
-      double pRef = m_uniformVar->GetValue ();
-
-      // get the channel condition
-      cond = CreateObject<ChannelCondition> ();
-      if (pRef <= pLos)
-        {
-          // LOS
-          cond->SetLosCondition (ChannelCondition::LosConditionValue::LOS);
-        }
-      else
-        {
-          // NLOS
-          cond->SetLosCondition (ChannelCondition::LosConditionValue::NLOS);
-        }
+      cond = ComputeChannelCondition (a, b);
 
       {
         // store the channel condition in m_channelConditionMap, used as cache.
         // For this reason you see a const_cast.
+        ThreeGppChannelConditionModel *model = const_cast<ThreeGppChannelConditionModel*> (this);
         Item mapItem;
         mapItem.m_condition = cond;
         mapItem.m_generatedTime = Simulator::Now ();
-        const_cast<ThreeGppChannelConditionModel*> (this)->m_channelConditionMap [key] = mapItem;
+        if (bulkUpdate)
+          {
+            mapItem.m_a = a;
+            mapItem.m_b = b;
+            mapItem.m_accessed = true;
+            if (!m_bulkUpdateEvent.IsRunning ())
+              {
+                // align the updates to the multiples of the update period
+                int64_t period = m_updatePeriod.GetTimeStep ();
+                Time next = TimeStep ((Simulator::Now ().GetTimeStep () / period + 1) * period);
+                model->m_bulkUpdateEvent = Simulator::Schedule (next - Simulator::Now (),
+                                                                &ThreeGppChannelConditionModel::UpdateChannelConditions,
+                                                                model);
+              }
+          }
+        model->m_channelConditionMap [key] = mapItem;
       }
     }
 
   return cond;
 }
 
+void
+ThreeGppChannelConditionModel::UpdateChannelConditions (void)
+{
+  NS_LOG_FUNCTION (this << m_channelConditionMap.size ());
+
+  std::vector<uint32_t> keys;
+  keys.reserve (m_channelConditionMap.size ());
+  for (auto it = m_channelConditionMap.begin (); it != m_channelConditionMap.end (); )
+    {
+      if (!it->second.m_accessed)
+        {
+          // the link was not used since the previous update, forget it
+          it = m_channelConditionMap.erase (it);
+          continue;
+        }
+      keys.push_back (it->first);
+      ++it;
+    }
+
+  // draw the new conditions in the order of the keys, since the order of
+  // the unordered map depends on its buckets and would make the draws of
+  // the links depend on the history of the cache
+  std::sort (keys.begin (), keys.end ());
+  for (uint32_t key : keys)
+    {
+      Item &item = m_channelConditionMap[key];
+      // a new object is created, so that the users of the old condition,
+      // e.g., the channel matrices cached by the spectrum models, see the change
+      item.m_condition = ComputeChannelCondition (item.m_a, item.m_b);
+      item.m_generatedTime = Simulator::Now ();
+      item.m_accessed = false;
+    }
+
+  if (!m_channelConditionMap.empty ())
+    {
+      m_bulkUpdateEvent = Simulator::Schedule (m_updatePeriod,
+                                               &ThreeGppChannelConditionModel::UpdateChannelConditions,
+                                               this);
+    }
+}
+
 int64_t
 ThreeGppChannelConditionModel::AssignStreams (int64_t stream)
 {
@@ -24,6 +24,7 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/vector.h"
 #include "ns3/nstime.h"
+#include "ns3/event-id.h"
 #include <unordered_map>
 
 namespace ns3 {
@@ -307,7 +308,7 @@ public:
    *
    * If the channel condition does not exists, the method creates it and
    * store it in a local cache, that will be updated following the "UpdatePeriod"
-   * parameter.
+   * and "BulkUpdate" parameters.
    *
    * \param a mobility model
    * \param b mobility model
@@ -347,6 +348,22 @@ private:
    */
   virtual double ComputePlos (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const = 0;
 
+  /**
+   * Draw a new channel condition for the channel between a and b.
+   *
+   * \param a tx mobility model
+   * \param b rx mobility model
+   * \return the new channel condition
+   */
+  Ptr<ChannelCondition> ComputeChannelCondition (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
+
+  /**
+   * Recompute the channel conditions of all the links used since the
+   * previous call, remove the others from the cache and schedule the next
+   * update. Used when the "BulkUpdate" attribute is set.
+   */
+  void UpdateChannelConditions (void);
+
   /**
    * \brief Returns a unique and reciprocal key for the channel between a and b.
    * \param a tx mobility model
@@ -362,10 +379,15 @@ private:
   {
     Ptr<ChannelCondition> m_condition; //!< the channel condition
     Time m_generatedTime; //!< the time when the condition was generated
+    Ptr<const MobilityModel> m_a; //!< the tx mobility model, used by the bulk update
+    Ptr<const MobilityModel> m_b; //!< the rx mobility model, used by the bulk update
+    bool m_accessed {false}; //!< true if the condition was requested since the last bulk update
   };
 
   std::unordered_map<uint32_t, Item> m_channelConditionMap; //!< map to store the channel conditions
   Time m_updatePeriod; //!< the update period for the channel condition
+  bool m_bulkUpdate; //!< true if the channel conditions are updated together at each update period
+  EventId m_bulkUpdateEvent; //!< the next bulk update of the channel conditions
   Ptr<UniformRandomVariable> m_uniformVar; //!< uniform random variable
 };
 
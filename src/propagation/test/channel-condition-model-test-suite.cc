@@ -22,6 +22,7 @@
 #include "ns3/test.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simulator.h"
@@ -262,6 +263,109 @@ ThreeGppChannelConditionModelTestCase::DoRun (void)
     }
 }
 
+/**
+ * Test case for the bulk update of the 3GPP channel condition models. It
+ * checks that the channel conditions are the same objects between two
+ * multiples of the update period, that they are recomputed at each multiple
+ * of the update period and that the links which are not used are removed,
+ * so that the updates stop.
+ */
+class ThreeGppChannelConditionModelBulkUpdateTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppChannelConditionModelBulkUpdateTestCase ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppChannelConditionModelBulkUpdateTestCase ();
+
+private:
+  /**
+   * Builds the simulation scenario and perform the tests
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Gets the channel condition of a link and compares it with the one
+   * obtained by the previous call for the same link
+   * \param link the index of the link
+   * \param expectSame true if the condition has to be the same object
+   */
+  void CheckChannelCondition (uint32_t link, bool expectSame);
+
+  Ptr<ThreeGppChannelConditionModel> m_condModel; //!< the channel condition model
+  std::vector<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel> > > m_links; //!< the links
+  std::vector<Ptr<ChannelCondition> > m_conditions; //!< the last condition of each link
+};
+
+ThreeGppChannelConditionModelBulkUpdateTestCase::ThreeGppChannelConditionModelBulkUpdateTestCase ()
+  : TestCase ("Test case for the bulk update of ThreeGppChannelConditionModel")
+{
+}
+
+ThreeGppChannelConditionModelBulkUpdateTestCase::~ThreeGppChannelConditionModelBulkUpdateTestCase ()
+{
+}
+
+void
+ThreeGppChannelConditionModelBulkUpdateTestCase::CheckChannelCondition (uint32_t link, bool expectSame)
+{
+  Ptr<ChannelCondition> cond = m_condModel->GetChannelCondition (m_links[link].first, m_links[link].second);
+  NS_TEST_ASSERT_MSG_EQ ((cond == m_conditions[link]), expectSame,
+                         "Unexpected channel condition for link " << link << " at " << Simulator::Now ().As (Time::MS));
+  // the condition does not depend on the direction of the link
+  NS_TEST_ASSERT_MSG_EQ (m_condModel->GetChannelCondition (m_links[link].second, m_links[link].first), cond,
+                         "The channel condition is not reciprocal");
+  m_conditions[link] = cond;
+}
+
+void
+ThreeGppChannelConditionModelBulkUpdateTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+  std::vector<Ptr<MobilityModel> > mobility;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<MobilityModel> m = CreateObject<ConstantPositionMobilityModel> ();
+      m->SetPosition (Vector (100.0 * i, 0, i == 0 ? 35.0 : 1.5));
+      nodes.Get (i)->AggregateObject (m);
+      mobility.push_back (m);
+    }
+  m_links.push_back (std::make_pair (mobility[0], mobility[1]));
+  m_links.push_back (std::make_pair (mobility[0], mobility[2]));
+  m_conditions.resize (m_links.size ());
+
+  m_condModel = CreateObject<ThreeGppRmaChannelConditionModel> ();
+  m_condModel->SetAttribute ("UpdatePeriod", TimeValue (MilliSeconds (10)));
+  m_condModel->SetAttribute ("BulkUpdate", BooleanValue (true));
+
+  typedef ThreeGppChannelConditionModelBulkUpdateTestCase Self;
+  // first period: the conditions are created and then only read
+  Simulator::Schedule (MilliSeconds (1), &Self::CheckChannelCondition, this, 0, false);
+  Simulator::Schedule (MilliSeconds (5), &Self::CheckChannelCondition, this, 0, true);
+  Simulator::Schedule (MilliSeconds (5), &Self::CheckChannelCondition, this, 1, false);
+  Simulator::Schedule (MilliSeconds (9), &Self::CheckChannelCondition, this, 1, true);
+  // second period: both conditions were recomputed at 10 ms, link 1 is then
+  // not used and it is removed at 20 ms
+  Simulator::Schedule (MilliSeconds (11), &Self::CheckChannelCondition, this, 0, false);
+  Simulator::Schedule (MilliSeconds (19), &Self::CheckChannelCondition, this, 0, true);
+  // third period: link 1 is used again, link 0 is no longer used
+  Simulator::Schedule (MilliSeconds (25), &Self::CheckChannelCondition, this, 0, false);
+  Simulator::Schedule (MilliSeconds (25), &Self::CheckChannelCondition, this, 1, false);
+  Simulator::Schedule (MilliSeconds (29), &Self::CheckChannelCondition, this, 1, true);
+
+  Simulator::Run ();
+  // the conditions were updated at 30 ms and removed at 40 ms, when the
+  // updates stopped
+  NS_TEST_ASSERT_MSG_EQ (Simulator::Now (), MilliSeconds (40), "The bulk updates did not stop");
+  Simulator::Destroy ();
+}
+
 /**
  * Test suite for the channel condition models
  */
@@ -275,6 +379,7 @@ ChannelConditionModelsTestSuite::ChannelConditionModelsTestSuite ()
   : TestSuite ("propagation-channel-condition-model", UNIT)
 {
   AddTestCase (new ThreeGppChannelConditionModelTestCase, TestCase::QUICK);
+  AddTestCase (new ThreeGppChannelConditionModelBulkUpdateTestCase, TestCase::QUICK);
 }
 
 static ChannelConditionModelsTestSuite ChannelConditionModelsTestSuite;
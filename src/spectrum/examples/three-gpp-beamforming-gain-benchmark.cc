@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * This program measures the time needed to compute the long term component
+ * and the subband beamforming gains of a channel matrix, using:
+ * - the straightforward evaluation of the long term component and of the
+ *   delay phasors previously used by ThreeGppSpectrumPropagationLossModel
+ *   ("reference"),
+ * - the scalar implementation of ThreeGppBeamformingGainKernel ("scalar"),
+ * - the AVX2 implementation of ThreeGppBeamformingGainKernel ("avx2"), if
+ *   supported by the processor.
+ * The benchmark is repeated for square arrays of 4x4, 8x8 and 16x16 elements
+ * at both ends and for a number of subbands between 72 and 3300.
+ * The time per call is reported in microseconds.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/three-gpp-beamforming-gain-kernel.h"
+#include <iomanip>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE ("ThreeGppBeamformingGainBenchmark");
+
+using namespace ns3;
+
+/**
+ * Compute the long term component with the straightforward triple loop
+ * \param channel the channel matrix
+ * \param sW the beamforming vector of the s node
+ * \param uW the beamforming vector of the u node
+ * \return the long term component
+ */
+static ThreeGppAntennaArrayModel::ComplexVector
+ReferenceLongTerm (const MatrixBasedChannelModel::Complex3DTensor &channel,
+                   const ThreeGppAntennaArrayModel::ComplexVector &sW,
+                   const ThreeGppAntennaArrayModel::ComplexVector &uW)
+{
+  ThreeGppAntennaArrayModel::ComplexVector longTerm;
+  for (size_t cIndex = 0; cIndex < channel.GetNSize (); cIndex++)
+    {
+      std::complex<double> txSum (0,0);
+      for (size_t sIndex = 0; sIndex < sW.size (); sIndex++)
+        {
+          std::complex<double> rxSum (0,0);
+          for (size_t uIndex = 0; uIndex < uW.size (); uIndex++)
+            {
+              rxSum = rxSum + uW[uIndex] * channel[uIndex][sIndex][cIndex];
+            }
+          txSum = txSum + sW[sIndex] * rxSum;
+        }
+      longTerm.push_back (txSum);
+    }
+  return longTerm;
+}
+
+/**
+ * Apply the subband gains evaluating a complex exponential for each
+ * (subband, cluster) pair
+ * \param clusterGain the complex gain of each cluster
+ * \param delay the delay of each cluster
+ * \param bands the subbands
+ * \param psd the PSD values
+ */
+static void
+ReferenceSubbandGain (const ThreeGppAntennaArrayModel::ComplexVector &clusterGain,
+                      const MatrixBasedChannelModel::DoubleVector &delay,
+                      const Bands &bands,
+                      std::vector<double> &psd)
+{
+  for (size_t bIndex = 0; bIndex < bands.size (); bIndex++)
+    {
+      std::complex<double> subsbandGain (0.0,0.0);
+      if (psd[bIndex] != 0.00)
+        {
+          double fsb = bands[bIndex].fc;
+          for (size_t cIndex = 0; cIndex < clusterGain.size (); cIndex++)
+            {
+              double d = -2 * M_PI * fsb * delay[cIndex];
+              subsbandGain = subsbandGain + clusterGain[cIndex] * exp (std::complex<double> (0, d));
+            }
+          psd[bIndex] = psd[bIndex] * (norm (subsbandGain));
+        }
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numClusters = 24; // number of clusters, including the sub-clusters
+  uint32_t numRuns = 2000; // number of calls for each configuration
+
+  CommandLine cmd;
+  cmd.AddValue ("numClusters", "Number of clusters", numClusters);
+  cmd.AddValue ("numRuns", "Number of calls for each configuration", numRuns);
+  cmd.Parse (argc, argv);
+
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+
+  std::vector<std::pair<std::string, int> > impls;
+  impls.push_back (std::make_pair ("reference", -1));
+  impls.push_back (std::make_pair ("scalar", ThreeGppBeamformingGainKernel::SCALAR));
+  if (ThreeGppBeamformingGainKernel::IsSupported (ThreeGppBeamformingGainKernel::AVX2))
+    {
+      impls.push_back (std::make_pair ("avx2", ThreeGppBeamformingGainKernel::AVX2));
+    }
+
+  std::cout << std::setw (8) << "array" << std::setw (10) << "subbands" << std::setw (12) << "impl"
+            << std::setw (16) << "longTerm [us]" << std::setw (16) << "gain [us]" << std::endl;
+
+  for (uint32_t arraySide : {4, 8, 16})
+    {
+      uint32_t numElements = arraySide * arraySide;
+      MatrixBasedChannelModel::Complex3DTensor channel (numElements, numElements, numClusters);
+      for (uint32_t u = 0; u < numElements; u++)
+        {
+          for (uint32_t s = 0; s < numElements; s++)
+            {
+              for (uint32_t n = 0; n < numClusters; n++)
+                {
+                  channel (u, s, n) = std::complex<double> (rv->GetValue (-1, 1), rv->GetValue (-1, 1));
+                }
+            }
+        }
+      ThreeGppAntennaArrayModel::ComplexVector sW (numElements), uW (numElements);
+      for (uint32_t i = 0; i < numElements; i++)
+        {
+          sW[i] = std::polar (1 / std::sqrt (numElements), rv->GetValue (0, 2 * M_PI));
+          uW[i] = std::polar (1 / std::sqrt (numElements), rv->GetValue (0, 2 * M_PI));
+        }
+      MatrixBasedChannelModel::DoubleVector delay (numClusters);
+      for (uint32_t n = 0; n < numClusters; n++)
+        {
+          delay[n] = rv->GetValue (0, 1e-6);
+        }
+
+      for (uint32_t numBands : {72, 275, 792, 1650, 3300})
+        {
+          Bands bands;
+          for (uint32_t bIndex = 0; bIndex < numBands; bIndex++)
+            {
+              BandInfo band;
+              band.fl = 28e9 + bIndex * 120e3;
+              band.fc = band.fl + 60e3;
+              band.fh = band.fl + 120e3;
+              bands.push_back (band);
+            }
+
+          for (auto impl : impls)
+            {
+              std::vector<double> psd (numBands, 1.0);
+              ThreeGppAntennaArrayModel::ComplexVector longTerm;
+              SystemWallClockMs clock;
+
+              clock.Start ();
+              for (uint32_t run = 0; run < numRuns; run++)
+                {
+                  if (impl.second < 0)
+                    {
+                      longTerm = ReferenceLongTerm (channel, sW, uW);
+                    }
+                  else
+                    {
+                      longTerm = ThreeGppBeamformingGainKernel::CalcLongTerm (channel, sW, uW, static_cast<ThreeGppBeamformingGainKernel::Implementation> (impl.second));
+                    }
+                }
+              double longTermUs = clock.End () * 1e3 / numRuns;
+
+              clock.Start ();
+              for (uint32_t run = 0; run < numRuns; run++)
+                {
+                  std::fill (psd.begin (), psd.end (), 1.0);
+                  if (impl.second < 0)
+                    {
+                      ReferenceSubbandGain (longTerm, delay, bands, psd);
+                    }
+                  else
+                    {
+                      ThreeGppBeamformingGainKernel::ApplySubbandGain (longTerm, delay, bands.begin (), bands.end (), psd.data (), static_cast<ThreeGppBeamformingGainKernel::Implementation> (impl.second));
+                    }
+                }
+              double gainUs = clock.End () * 1e3 / numRuns;
+
+              std::cout << std::setw (8) << (std::to_string (arraySide) + "x" + std::to_string (arraySide))
+                        << std::setw (10) << numBands << std::setw (12) << impl.first
+                        << std::setw (16) << longTermUs << std::setw (16) << gainUs << std::endl;
+            }
+        }
+    }
+
+  return 0;
+}
@@ -20,6 +20,7 @@
  */
 
 #include "matrix-based-channel-model.h"
+#include "ns3/assert.h"
 
 namespace ns3 {
 
@@ -27,4 +28,40 @@ MatrixBasedChannelModel::~MatrixBasedChannelModel()
 {
 }
 
+MatrixBasedChannelModel::Complex3DTensor::Complex3DTensor (const Complex3DVector &v)
+  : m_uSize (v.size ()),
+    m_sSize (v.empty () ? 0 : v[0].size ()),
+    m_nSize (v.empty () || v[0].empty () ? 0 : v[0][0].size ())
+{
+  m_data.resize (m_uSize * m_sSize * m_nSize);
+  for (size_t u = 0; u < m_uSize; u++)
+    {
+      NS_ASSERT_MSG (v[u].size () == m_sSize, "All the vectors H[u] must have the same size");
+      for (size_t s = 0; s < m_sSize; s++)
+        {
+          NS_ASSERT_MSG (v[u][s].size () == m_nSize, "All the vectors H[u][s] must have the same size");
+          for (size_t n = 0; n < m_nSize; n++)
+            {
+              (*this) (u, s, n) = v[u][s][n];
+            }
+        }
+    }
+}
+
+MatrixBasedChannelModel::Complex3DTensor::operator Complex3DVector () const
+{
+  Complex3DVector v (m_uSize, Complex2DVector (m_sSize, ThreeGppAntennaArrayModel::ComplexVector (m_nSize)));
+  for (size_t u = 0; u < m_uSize; u++)
+    {
+      for (size_t s = 0; s < m_sSize; s++)
+        {
+          for (size_t n = 0; n < m_nSize; n++)
+            {
+              v[u][s][n] = (*this) (u, s, n);
+            }
+        }
+    }
+  return v;
+}
+
 }
@@ -28,6 +28,7 @@
 #include <ns3/vector.h>
 #include <ns3/three-gpp-antenna-array-model.h>
 #include <tuple>
+#include <stdexcept>
 
 namespace ns3 {
 
@@ -54,13 +55,296 @@ public:
   typedef std::vector<ThreeGppAntennaArrayModel::ComplexVector> Complex2DVector; //!< type definition for complex matrices
   typedef std::vector<Complex2DVector> Complex3DVector; //!< type definition for complex 3D matrices
 
+  /**
+   * Contiguous storage for a complex 3D matrix H[u][s][n], such as the
+   * channel matrix.
+   *
+   * All the elements are stored in a single buffer. The n-th page, i.e., the
+   * matrix H[.][.][n], is stored in column-major order, so that the elements
+   * H[0][s][n], ..., H[U-1][s][n] are contiguous in memory.
+   *
+   * The elements can be accessed either with operator () or with the
+   * strided views returned by operator [], which provide the same
+   * [u][s][n] accessors of Complex3DVector. Objects of type Complex3DVector
+   * are implicitly converted to and from this type.
+   */
+  class Complex3DTensor
+  {
+  public:
+    /**
+     * Strided view over the elements of a vector of the tensor
+     */
+    template <class T>
+    class VectorView
+    {
+    public:
+      /**
+       * Constructor
+       * \param data pointer to the first element
+       * \param stride distance between two consecutive elements
+       * \param size number of elements
+       */
+      VectorView (T *data, size_t stride, size_t size)
+        : m_data (data), m_stride (stride), m_size (size)
+      {
+      }
+
+      /**
+       * \return the number of elements
+       */
+      size_t size () const
+      {
+        return m_size;
+      }
+
+      /**
+       * \param i the element index
+       * \return a reference to the i-th element
+       */
+      T& operator[] (size_t i) const
+      {
+        return m_data[i * m_stride];
+      }
+
+      /**
+       * \param i the element index
+       * \return a reference to the i-th element, after checking the bounds
+       */
+      T& at (size_t i) const
+      {
+        if (i >= m_size)
+          {
+            throw std::out_of_range ("Complex3DTensor index out of range");
+          }
+        return m_data[i * m_stride];
+      }
+
+    private:
+      T *m_data; //!< pointer to the first element
+      size_t m_stride; //!< distance between two consecutive elements
+      size_t m_size; //!< number of elements
+    };
+
+    /**
+     * Strided view over the elements H[u][.][.] of the tensor
+     */
+    template <class T>
+    class MatrixView
+    {
+    public:
+      /**
+       * Constructor
+       * \param data pointer to the element H[u][0][0]
+       * \param uSize the first dimension of the tensor
+       * \param sSize the second dimension of the tensor
+       * \param nSize the third dimension of the tensor
+       */
+      MatrixView (T *data, size_t uSize, size_t sSize, size_t nSize)
+        : m_data (data), m_uSize (uSize), m_sSize (sSize), m_nSize (nSize)
+      {
+      }
+
+      /**
+       * \return the second dimension of the tensor
+       */
+      size_t size () const
+      {
+        return m_sSize;
+      }
+
+      /**
+       * \param s the index of the second dimension
+       * \return a view over the elements H[u][s][.]
+       */
+      VectorView<T> operator[] (size_t s) const
+      {
+        return VectorView<T> (m_data + s * m_uSize, m_uSize * m_sSize, m_nSize);
+      }
+
+      /**
+       * \param s the index of the second dimension
+       * \return a view over the elements H[u][s][.], after checking the bounds
+       */
+      VectorView<T> at (size_t s) const
+      {
+        if (s >= m_sSize)
+          {
+            throw std::out_of_range ("Complex3DTensor index out of range");
+          }
+        return (*this)[s];
+      }
+
+    private:
+      T *m_data; //!< pointer to the element H[u][0][0]
+      size_t m_uSize; //!< the first dimension of the tensor
+      size_t m_sSize; //!< the second dimension of the tensor
+      size_t m_nSize; //!< the third dimension of the tensor
+    };
+
+    /**
+     * Create an empty tensor
+     */
+    Complex3DTensor ()
+      : m_uSize (0), m_sSize (0), m_nSize (0)
+    {
+    }
+
+    /**
+     * Create a tensor with the given dimensions and all the elements equal
+     * to zero
+     * \param uSize the first dimension
+     * \param sSize the second dimension
+     * \param nSize the third dimension
+     */
+    Complex3DTensor (size_t uSize, size_t sSize, size_t nSize)
+      : m_data (uSize * sSize * nSize),
+        m_uSize (uSize), m_sSize (sSize), m_nSize (nSize)
+    {
+    }
+
+    /**
+     * Create a tensor with the same elements of a Complex3DVector
+     * \param v the Complex3DVector H[u][s][n]. All the vectors H[u] and
+     *        H[u][s] must have the same size.
+     */
+    Complex3DTensor (const Complex3DVector &v);
+
+    /**
+     * Convert the tensor to a Complex3DVector
+     * \return the Complex3DVector H[u][s][n]
+     */
+    operator Complex3DVector () const;
+
+    /**
+     * \return the first dimension of the tensor
+     */
+    size_t size () const
+    {
+      return m_uSize;
+    }
+
+    /**
+     * \return the first dimension of the tensor
+     */
+    size_t GetUSize () const
+    {
+      return m_uSize;
+    }
+
+    /**
+     * \return the second dimension of the tensor
+     */
+    size_t GetSSize () const
+    {
+      return m_sSize;
+    }
+
+    /**
+     * \return the third dimension of the tensor
+     */
+    size_t GetNSize () const
+    {
+      return m_nSize;
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \param s the index of the second dimension
+     * \param n the index of the third dimension
+     * \return a reference to the element H[u][s][n]
+     */
+    std::complex<double>& operator() (size_t u, size_t s, size_t n)
+    {
+      return m_data[(n * m_sSize + s) * m_uSize + u];
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \param s the index of the second dimension
+     * \param n the index of the third dimension
+     * \return a const reference to the element H[u][s][n]
+     */
+    const std::complex<double>& operator() (size_t u, size_t s, size_t n) const
+    {
+      return m_data[(n * m_sSize + s) * m_uSize + u];
+    }
+
+    /**
+     * \param n the index of the third dimension
+     * \return a pointer to the n-th page, which is stored in column-major order
+     */
+    std::complex<double>* GetPage (size_t n)
+    {
+      return m_data.data () + n * m_uSize * m_sSize;
+    }
+
+    /**
+     * \param n the index of the third dimension
+     * \return a const pointer to the n-th page, which is stored in column-major order
+     */
+    const std::complex<double>* GetPage (size_t n) const
+    {
+      return m_data.data () + n * m_uSize * m_sSize;
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \return a view over the elements H[u][.][.]
+     */
+    MatrixView<std::complex<double> > operator[] (size_t u)
+    {
+      return MatrixView<std::complex<double> > (m_data.data () + u, m_uSize, m_sSize, m_nSize);
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \return a const view over the elements H[u][.][.]
+     */
+    MatrixView<const std::complex<double> > operator[] (size_t u) const
+    {
+      return MatrixView<const std::complex<double> > (m_data.data () + u, m_uSize, m_sSize, m_nSize);
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \return a view over the elements H[u][.][.], after checking the bounds
+     */
+    MatrixView<std::complex<double> > at (size_t u)
+    {
+      if (u >= m_uSize)
+        {
+          throw std::out_of_range ("Complex3DTensor index out of range");
+        }
+      return (*this)[u];
+    }
+
+    /**
+     * \param u the index of the first dimension
+     * \return a const view over the elements H[u][.][.], after checking the bounds
+     */
+    MatrixView<const std::complex<double> > at (size_t u) const
+    {
+      if (u >= m_uSize)
+        {
+          throw std::out_of_range ("Complex3DTensor index out of range");
+        }
+      return (*this)[u];
+    }
+
+  private:
+    std::vector<std::complex<double> > m_data; //!< the elements of the tensor
+    size_t m_uSize; //!< the first dimension
+    size_t m_sSize; //!< the second dimension
+    size_t m_nSize; //!< the third dimension
+  };
+
 
   /**
    * Data structure that stores a channel realization
    */
   struct ChannelMatrix : public SimpleRefCount<ChannelMatrix>
   {
-    Complex3DVector    m_channel; //!< channel matrix H[u][s][n].
+    Complex3DTensor    m_channel; //!< channel matrix H[u][s][n].
     DoubleVector       m_delay; //!< cluster delay in nanoseconds.
     Double2DVector     m_angle; //!< cluster angle angle[direction][n], where direction = 0(AOA), 1(ZOA), 2(AOD), 3(ZOD) in degree.
     Time               m_generatedTime; //!< generation time
@@ -19,7 +19,9 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <utility>
 #include <ns3/object.h>
 #include <ns3/simulator.h>
@@ -29,6 +31,7 @@
 #include <ns3/net-device.h>
 #include <ns3/node.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <ns3/mobility-model.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-converter.h>
@@ -79,7 +82,9 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
-  : m_numDevices {0}
+  : m_numDevices {0},
+    m_rxIndexBuilt {false},
+    m_rxOrderValid {false}
 {
   NS_LOG_FUNCTION (this);
 }
@@ -90,6 +95,17 @@ MultiModelSpectrumChannel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  for (auto &mobIt : m_rxMobility)
+    {
+      ConstCast<MobilityModel> (mobIt.first)->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&MultiModelSpectrumChannel::NotifyCourseChange, this));
+    }
+  m_rxMobility.clear ();
+  m_movedRxMobility.clear ();
+  m_rxIndex.clear ();
+  m_rxGrid.clear ();
+  m_rxOrder.clear ();
+  m_rxOutsideGrid.clear ();
+  m_rxCandidates.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -100,7 +116,35 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("PruningDistance",
+                   "The distance in meters beyond which the receivers are not "
+                   "considered for a transmission. If 0, the receivers are not "
+                   "pruned by distance.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_pruningDistance),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("FreeSpacePruning",
+                   "If true, and if a PropagationLossModel is set, the receivers "
+                   "at a distance at which the free space loss at the lowest "
+                   "frequency of the signal, minus PruningMaxAntennaGainDb, "
+                   "exceeds MaxLossDb are not considered for a transmission. "
+                   "This assumes that the PropagationLossModel never predicts a "
+                   "loss lower than the free space loss.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MultiModelSpectrumChannel::m_freeSpacePruning),
+                   MakeBooleanChecker ())
+    .AddAttribute ("PruningMaxAntennaGainDb",
+                   "The maximum sum of the tx and rx antenna gains in dB, used "
+                   "to compute the range of the free space pruning.",
+                   DoubleValue (20.0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_pruningMaxAntennaGainDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("PruningGridCellSize",
+                   "The side in meters of the cells of the grid used to look up "
+                   "the receivers in range when pruning is enabled.",
+                   DoubleValue (100.0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_pruningGridCellSize),
+                   MakeDoubleChecker<double> (1e-3))
   ;
   return tid;
 }
@@ -169,6 +213,13 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       // spectrum model is already known, just add the device to the corresponding list
       rxInfoIterator->second.m_rxPhys.push_back (phy);
     }
+
+  if (m_rxIndexBuilt)
+    {
+      RemoveRxFromIndex (phy);
+      AddRxToIndex (phy);
+    }
+  m_rxOrderValid = false;
 }
 
 TxSpectrumModelInfoMap_t::const_iterator
@@ -235,6 +286,56 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
+  double pruningRange = GetPruningRange (txParams->psd);
+  if (txMobility && pruningRange < std::numeric_limits<double>::infinity ())
+    {
+      // only consider the receivers within the pruning range
+      UpdateRxIndex ();
+      GetRxCandidates (txMobility->GetPosition (), pruningRange, m_rxCandidates);
+      SortRxPhys (m_rxCandidates);
+      NS_LOG_LOGIC (m_rxCandidates.size () << " receivers within " << pruningRange << " m out of " << m_numDevices);
+
+      std::map<SpectrumModelUid_t, Ptr<SpectrumValue> > convertedTxPowerSpectrums;
+      for (const auto &rxPhy : m_rxCandidates)
+        {
+          if (rxPhy == txParams->txPhy)
+            {
+              continue;
+            }
+
+          SpectrumModelUid_t rxSpectrumModelUid = rxPhy->GetRxSpectrumModel ()->GetUid ();
+          NS_ASSERT_MSG (m_rxSpectrumModelInfoMap.find (rxSpectrumModelUid) != m_rxSpectrumModelInfoMap.end (),
+                         "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
+
+          auto convertedIt = convertedTxPowerSpectrums.find (rxSpectrumModelUid);
+          if (convertedIt == convertedTxPowerSpectrums.end ())
+            {
+              Ptr <SpectrumValue> convertedTxPowerSpectrum;
+              if (txSpectrumModelUid == rxSpectrumModelUid)
+                {
+                  convertedTxPowerSpectrum = txParams->psd;
+                }
+              else
+                {
+                  SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+                  // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+                  if (rxConverterIterator != txInfoIteratorerator->second.m_spectrumConverterMap.end ())
+                    {
+                      convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+                    }
+                }
+              convertedIt = convertedTxPowerSpectrums.insert (std::make_pair (rxSpectrumModelUid, convertedTxPowerSpectrum)).first;
+            }
+
+          if (convertedIt->second)
+            {
+              ScheduleRx (txParams, txMobility, convertedIt->second, rxPhy);
+            }
+        }
+      m_rxCandidates.clear ();
+      return;
+    }
+
   for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
@@ -269,83 +370,336 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
-              NS_LOG_LOGIC ("copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-              Time delay = MicroSeconds (0);
+              ScheduleRx (txParams, txMobility, convertedTxPowerSpectrum, *rxPhyIterator);
+            }
+        }
 
-              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+    }
 
-              if (txMobility && receiverMobility)
-                {
-                  double txAntennaGain = 0;
-                  double rxAntennaGain = 0;
-                  double propagationGainDb = 0;
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
-                    {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
-                    }
-                  if (m_propagationLoss)
-                    {
-                      propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
-                  // Gain trace
-                  m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
-                  // Pathloss trace
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-                  if (pathLossDb > m_maxLossDb)
-                    {
-                      // beyond range
-                      continue;
-                    }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
+}
 
-                  if (m_spectrumPropagationLoss)
-                    {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
-                    }
+void
+MultiModelSpectrumChannel::ScheduleRx (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                                       Ptr<SpectrumValue> convertedTxPowerSpectrum, Ptr<SpectrumPhy> receiver)
+{
+  NS_LOG_FUNCTION (this << txParams << receiver);
 
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
-                }
+  Time delay = MicroSeconds (0);
+  double pathGainLinear = 1.0;
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
+
+  // check if the receiver is in range before copying the signal parameters
+  if (txMobility && receiverMobility)
+    {
+      double txAntennaGain = 0;
+      double rxAntennaGain = 0;
+      double propagationGainDb = 0;
+      double pathLossDb = 0;
+      if (txParams->txAntenna != 0)
+        {
+          Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+          txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+          NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+          pathLossDb -= txAntennaGain;
+        }
+      Ptr<AntennaModel> rxAntenna = receiver->GetRxAntenna ();
+      if (rxAntenna != 0)
+        {
+          Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+          rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+          NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+          pathLossDb -= rxAntennaGain;
+        }
+      if (m_propagationLoss)
+        {
+          propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
+          NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+          pathLossDb -= propagationGainDb;
+        }
+      NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+      // Gain trace
+      m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+      // Pathloss trace
+      m_pathLossTrace (txParams->txPhy, receiver, pathLossDb);
+      if (pathLossDb > m_maxLossDb)
+        {
+          // beyond range
+          return;
+        }
+      pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+    }
+
+  NS_LOG_LOGIC ("copying signal parameters " << txParams);
+  Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+
+  if (txMobility && receiverMobility)
+    {
+      *(rxParams->psd) *= pathGainLinear;
+
+      if (m_spectrumPropagationLoss)
+        {
+          rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
+        }
+
+      if (m_propagationDelay)
+        {
+          delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+        }
+    }
+
+  Ptr<NetDevice> netDev = receiver->GetDevice ();
+  if (netDev)
+    {
+      // the receiver has a NetDevice, so we expect that it is attached to a Node
+      uint32_t dstNode =  netDev->GetNode ()->GetId ();
+      Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                      rxParams, receiver);
+    }
+  else
+    {
+      // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+      Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
+                           rxParams, receiver);
+    }
+}
+
+double
+MultiModelSpectrumChannel::GetPruningRange (Ptr<const SpectrumValue> txPsd) const
+{
+  double range = std::numeric_limits<double>::infinity ();
+  if (txPsd->GetSpectrumModel ()->GetNumBands () == 0)
+    {
+      // without bands there is no lowest frequency, do not prune
+      return range;
+    }
+  if (m_pruningDistance > 0)
+    {
+      range = m_pruningDistance;
+    }
+  if (m_freeSpacePruning && m_propagationLoss)
+    {
+      // the free space loss is minimum at the lowest frequency
+      double minFrequency = txPsd->GetSpectrumModel ()->Begin ()->fl;
+      if (minFrequency > 0)
+        {
+          double lambda = 299792458.0 / minFrequency;
+          double freeSpaceRange = lambda / (4 * M_PI) * std::pow (10.0, (m_maxLossDb + m_pruningMaxAntennaGainDb) / 20.0);
+          range = std::min (range, freeSpaceRange);
+        }
+    }
+  return range;
+}
+
+/**
+ * Returns the key of the cell of the grid with the given coordinates
+ * \param x the horizontal index of the cell
+ * \param y the vertical index of the cell
+ * \return the key of the cell
+ */
+static uint64_t
+GetCellKeyFromIndices (int32_t x, int32_t y)
+{
+  return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+}
 
-              Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
+uint64_t
+MultiModelSpectrumChannel::GetCellKey (const Vector &position) const
+{
+  return GetCellKeyFromIndices (static_cast<int32_t> (std::floor (position.x / m_pruningGridCellSize)),
+                                static_cast<int32_t> (std::floor (position.y / m_pruningGridCellSize)));
+}
+
+void
+MultiModelSpectrumChannel::AddRxToIndex (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+
+  RxIndexEntry entry;
+  entry.m_mobility = phy->GetMobility ();
+  entry.m_inGrid = false;
+  entry.m_cell = 0;
+  if (entry.m_mobility)
+    {
+      // track the course changes of the mobility model
+      auto mobIt = m_rxMobility.find (entry.m_mobility);
+      if (mobIt == m_rxMobility.end ())
+        {
+          entry.m_mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&MultiModelSpectrumChannel::NotifyCourseChange, this));
+          mobIt = m_rxMobility.insert (std::make_pair (entry.m_mobility, std::vector<Ptr<SpectrumPhy> > ())).first;
+        }
+      mobIt->second.push_back (phy);
+
+      // the position of a moving receiver changes without course change
+      // notifications, hence it cannot be stored in the grid
+      Vector velocity = entry.m_mobility->GetVelocity ();
+      entry.m_inGrid = (velocity.x == 0 && velocity.y == 0 && velocity.z == 0);
+    }
+
+  if (entry.m_inGrid)
+    {
+      entry.m_cell = GetCellKey (entry.m_mobility->GetPosition ());
+      m_rxGrid[entry.m_cell].push_back (phy);
+    }
+  else
+    {
+      m_rxOutsideGrid.push_back (phy);
+    }
+  m_rxIndex[phy] = entry;
+}
+
+void
+MultiModelSpectrumChannel::RemoveRxFromIndex (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+
+  auto indexIt = m_rxIndex.find (phy);
+  if (indexIt == m_rxIndex.end ())
+    {
+      return;
+    }
+  const RxIndexEntry &entry = indexIt->second;
+
+  if (entry.m_inGrid)
+    {
+      auto cellIt = m_rxGrid.find (entry.m_cell);
+      NS_ASSERT (cellIt != m_rxGrid.end ());
+      cellIt->second.erase (std::find (cellIt->second.begin (), cellIt->second.end (), phy));
+      if (cellIt->second.empty ())
+        {
+          m_rxGrid.erase (cellIt);
+        }
+    }
+  else
+    {
+      m_rxOutsideGrid.erase (std::find (m_rxOutsideGrid.begin (), m_rxOutsideGrid.end (), phy));
+    }
+
+  if (entry.m_mobility)
+    {
+      std::vector<Ptr<SpectrumPhy> > &mobilityPhys = m_rxMobility[entry.m_mobility];
+      mobilityPhys.erase (std::find (mobilityPhys.begin (), mobilityPhys.end (), phy));
+    }
+  m_rxIndex.erase (indexIt);
+}
+
+void
+MultiModelSpectrumChannel::UpdateRxIndex ()
+{
+  if (!m_rxIndexBuilt)
+    {
+      NS_LOG_LOGIC ("build the index of the receivers");
+      for (const auto &rxInfo : m_rxSpectrumModelInfoMap)
+        {
+          for (const auto &phy : rxInfo.second.m_rxPhys)
+            {
+              AddRxToIndex (phy);
+            }
+        }
+      m_rxIndexBuilt = true;
+      m_movedRxMobility.clear ();
+      return;
+    }
+
+  for (const auto &mobility : m_movedRxMobility)
+    {
+      auto mobIt = m_rxMobility.find (mobility);
+      NS_ASSERT (mobIt != m_rxMobility.end ());
+      // copy the receivers since the index is modified while moving them
+      std::vector<Ptr<SpectrumPhy> > phys = mobIt->second;
+      for (const auto &phy : phys)
+        {
+          RemoveRxFromIndex (phy);
+          AddRxToIndex (phy);
+        }
+    }
+  m_movedRxMobility.clear ();
+}
+
+void
+MultiModelSpectrumChannel::SortRxPhys (std::vector<Ptr<SpectrumPhy> > &phys)
+{
+  if (!m_rxOrderValid)
+    {
+      m_rxOrder.clear ();
+      for (const auto &rxInfo : m_rxSpectrumModelInfoMap)
+        {
+          for (const auto &phy : rxInfo.second.m_rxPhys)
+            {
+              m_rxOrder.insert (std::make_pair (phy, m_rxOrder.size ()));
+            }
+        }
+      m_rxOrderValid = true;
+    }
+
+  // the receivers are scheduled in the same order with and without pruning
+  std::sort (phys.begin (), phys.end (),
+             [this] (const Ptr<SpectrumPhy> &a, const Ptr<SpectrumPhy> &b)
+             {
+               return m_rxOrder.find (a)->second < m_rxOrder.find (b)->second;
+             });
+}
+
+void
+MultiModelSpectrumChannel::GetRxCandidates (const Vector &position, double range, std::vector<Ptr<SpectrumPhy> > &candidates)
+{
+  NS_LOG_FUNCTION (this << position << range);
+
+  candidates.clear ();
+  for (const auto &phy : m_rxOutsideGrid)
+    {
+      Ptr<MobilityModel> mobility = phy->GetMobility ();
+      if (!mobility || CalculateDistance (mobility->GetPosition (), position) <= range)
+        {
+          candidates.push_back (phy);
+        }
+    }
+
+  double minX = std::floor ((position.x - range) / m_pruningGridCellSize);
+  double maxX = std::floor ((position.x + range) / m_pruningGridCellSize);
+  double minY = std::floor ((position.y - range) / m_pruningGridCellSize);
+  double maxY = std::floor ((position.y + range) / m_pruningGridCellSize);
+  if ((maxX - minX + 1) * (maxY - minY + 1) > m_rxGrid.size ())
+    {
+      // the range covers more cells than the occupied ones, scan the occupied cells
+      for (const auto &cell : m_rxGrid)
+        {
+          for (const auto &phy : cell.second)
+            {
+              if (CalculateDistance (phy->GetMobility ()->GetPosition (), position) <= range)
                 {
-                  // the receiver has a NetDevice, so we expect that it is attached to a Node
-                  uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
+                  candidates.push_back (phy);
                 }
-              else
+            }
+        }
+      return;
+    }
+
+  for (int32_t x = static_cast<int32_t> (minX); x <= static_cast<int32_t> (maxX); x++)
+    {
+      for (int32_t y = static_cast<int32_t> (minY); y <= static_cast<int32_t> (maxY); y++)
+        {
+          auto cellIt = m_rxGrid.find (GetCellKeyFromIndices (x, y));
+          if (cellIt == m_rxGrid.end ())
+            {
+              continue;
+            }
+          for (const auto &phy : cellIt->second)
+            {
+              if (CalculateDistance (phy->GetMobility ()->GetPosition (), position) <= range)
                 {
-                  // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
+                  candidates.push_back (phy);
                 }
             }
         }
-
     }
+}
 
+void
+MultiModelSpectrumChannel::NotifyCourseChange (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  m_movedRxMobility.insert (mobility);
 }
 
 void
@@ -29,6 +29,8 @@
 #include <ns3/propagation-delay-model.h>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 
@@ -102,6 +104,15 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * The receivers which cannot be reached by a transmission can be
+ * optionally pruned before any computation, by means of the
+ * PruningDistance and FreeSpacePruning attributes. In this case, the
+ * receivers are stored in a uniform grid indexed by their position, which
+ * is updated when their mobility models notify a course change, and only
+ * the receivers within the pruning range of the transmitter are considered.
+ * The mobility models of the receivers are expected to be set before the
+ * first transmission.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -149,6 +160,87 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Applies the propagation models to a transmission towards a receiver and,
+   * if the receiver is in range, schedules the reception. The signal
+   * parameters are copied only for the receivers which are in range.
+   *
+   * \param txParams The signal parameters of the transmission.
+   * \param txMobility The mobility model of the transmitter.
+   * \param convertedTxPowerSpectrum The tx PSD in the SpectrumModel of the receiver.
+   * \param receiver A pointer to the receiver SpectrumPhy.
+   */
+  void ScheduleRx (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                   Ptr<SpectrumValue> convertedTxPowerSpectrum, Ptr<SpectrumPhy> receiver);
+
+  /**
+   * Computes the distance beyond which the receivers are pruned. The range
+   * is the minimum between PruningDistance and, if FreeSpacePruning is
+   * enabled, the distance at which the free space loss at the lowest
+   * frequency of the PSD, minus PruningMaxAntennaGainDb, exceeds MaxLossDb.
+   * A PSD without bands is never pruned.
+   *
+   * \param txPsd The tx PSD.
+   * \return the pruning range in meters, infinite if pruning is disabled
+   */
+  double GetPruningRange (Ptr<const SpectrumValue> txPsd) const;
+
+  /**
+   * Adds a receiver to the spatial index. The receivers which are moving or
+   * without mobility model are not stored in the grid and are always
+   * considered as candidates.
+   *
+   * \param phy The receiver.
+   */
+  void AddRxToIndex (Ptr<SpectrumPhy> phy);
+
+  /**
+   * Removes a receiver from the spatial index.
+   *
+   * \param phy The receiver.
+   */
+  void RemoveRxFromIndex (Ptr<SpectrumPhy> phy);
+
+  /**
+   * Moves to the right cell of the grid the receivers whose mobility model
+   * notified a course change. The index is built at the first call.
+   */
+  void UpdateRxIndex ();
+
+  /**
+   * Sorts the receivers in the order in which they are visited without
+   * pruning, i.e., by their position in m_rxSpectrumModelInfoMap.
+   *
+   * \param phys The receivers to sort.
+   */
+  void SortRxPhys (std::vector<Ptr<SpectrumPhy> > &phys);
+
+  /**
+   * Collects the receivers which are within a certain distance from a
+   * position, and the receivers which are not stored in the grid.
+   *
+   * \param position The position of the transmitter.
+   * \param range The maximum distance.
+   * \param candidates The vector in which the receivers are stored.
+   */
+  void GetRxCandidates (const Vector &position, double range, std::vector<Ptr<SpectrumPhy> > &candidates);
+
+  /**
+   * Callback for the CourseChange trace of the mobility models of the
+   * receivers.
+   *
+   * \param mobility The mobility model.
+   */
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility);
+
+  /**
+   * Returns the key of the grid cell which contains a position.
+   *
+   * \param position The position.
+   * \return the key of the cell
+   */
+  uint64_t GetCellKey (const Vector &position) const;
+
   /**
    * Data structure holding, for each TX SpectrumModel,  all the
    * converters to any RX SpectrumModel, and all the corresponding
@@ -169,6 +261,31 @@ private:
    */
   std::size_t m_numDevices;
 
+  double m_pruningDistance;        //!< distance beyond which the receivers are pruned (0 to disable)
+  bool m_freeSpacePruning;         //!< if true, prune the receivers which cannot satisfy MaxLossDb in free space
+  double m_pruningMaxAntennaGainDb; //!< bound of the sum of the tx and rx antenna gains used for the free space pruning
+  double m_pruningGridCellSize;    //!< side of the cells of the grid of receivers
+
+  /**
+   * Position of a receiver in the spatial index.
+   */
+  struct RxIndexEntry
+  {
+    Ptr<MobilityModel> m_mobility; //!< the mobility model of the receiver when indexed
+    bool m_inGrid;                 //!< true if the receiver is stored in the grid
+    uint64_t m_cell;               //!< the key of the cell, if in the grid
+  };
+
+  bool m_rxIndexBuilt;             //!< true if the spatial index has been built
+  std::map<Ptr<SpectrumPhy>, RxIndexEntry> m_rxIndex;  //!< position of each receiver in the index
+  std::unordered_map<uint64_t, std::vector<Ptr<SpectrumPhy> > > m_rxGrid;  //!< receivers stored in each cell
+  std::vector<Ptr<SpectrumPhy> > m_rxOutsideGrid;  //!< receivers which are not stored in the grid
+  std::map<Ptr<const MobilityModel>, std::vector<Ptr<SpectrumPhy> > > m_rxMobility;  //!< receivers attached to each traced mobility model
+  std::set<Ptr<const MobilityModel> > m_movedRxMobility;  //!< mobility models which notified a course change since the last update
+  std::vector<Ptr<SpectrumPhy> > m_rxCandidates;  //!< receivers considered in the last transmission, to avoid reallocations
+  bool m_rxOrderValid;             //!< false if m_rxOrder must be rebuilt after a change of the receivers
+  std::map<Ptr<SpectrumPhy>, std::size_t> m_rxOrder;  //!< position of each receiver in m_rxSpectrumModelInfoMap
+
 };
 
 
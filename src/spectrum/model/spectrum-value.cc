@@ -23,17 +23,23 @@
 #include <ns3/math.h>
 #include <ns3/log.h>
 
+#include <algorithm>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("SpectrumValue");
 
 SpectrumValue::SpectrumValue ()
+  : m_occupiedBegin (0),
+    m_occupiedEnd (0)
 {
 }
 
 SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sof)
   : m_spectrumModel (sof),
-    m_values (sof->GetNumBands ())
+    m_values (sof->GetNumBands ()),
+    m_occupiedBegin (0),
+    m_occupiedEnd (0)
 {
 
 }
@@ -41,7 +47,9 @@ SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sof)
 double&
 SpectrumValue::operator[] (size_t index)
 {
-  return m_values.at (index);
+  double &value = m_values.at (index);
+  Occupy (index, index + 1);
+  return value;
 }
 
 const double&
@@ -81,15 +89,25 @@ SpectrumValue::ConstValuesEnd () const
 Values::iterator
 SpectrumValue::ValuesBegin ()
 {
+  Occupy (0, m_values.size ());
   return m_values.begin ();
 }
 
 Values::iterator
 SpectrumValue::ValuesEnd ()
 {
+  Occupy (0, m_values.size ());
   return m_values.end ();
 }
 
+double*
+SpectrumValue::ValuesData (size_t begin, size_t end)
+{
+  NS_ASSERT (begin <= end && end <= m_values.size ());
+  Occupy (begin, end);
+  return m_values.data ();
+}
+
 Bands::const_iterator
 SpectrumValue::ConstBandsBegin () const
 {
@@ -106,24 +124,28 @@ SpectrumValue::ConstBandsEnd () const
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  // the values of x outside its occupied bands are zero
+  double *v = m_values.data ();
+  const double *w = x.m_values.data ();
+  for (size_t i = x.m_occupiedBegin; i < x.m_occupiedEnd; i++)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 += *it2;
-      ++it1;
-      ++it2;
+      v[i] += w[i];
     }
+  Occupy (x.m_occupiedBegin, x.m_occupiedEnd);
 }
 
 
 void
 SpectrumValue::Add (double s)
 {
+  if (s == 0)
+    {
+      return;
+    }
+
   Values::iterator it1 = m_values.begin ();
 
   while (it1 != m_values.end ())
@@ -131,6 +153,7 @@ SpectrumValue::Add (double s)
       *it1 += s;
       ++it1;
     }
+  Occupy (0, m_values.size ());
 }
 
 
@@ -138,18 +161,16 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const double *w = x.m_values.data ();
+  for (size_t i = x.m_occupiedBegin; i < x.m_occupiedEnd; i++)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 -= *it2;
-      ++it1;
-      ++it2;
+      v[i] -= w[i];
     }
+  Occupy (x.m_occupiedBegin, x.m_occupiedEnd);
 }
 
 
@@ -164,30 +185,38 @@ SpectrumValue::Subtract (double s)
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+
+  // the product is zero outside the bands occupied by both operands
+  size_t begin = std::max (m_occupiedBegin, x.m_occupiedBegin);
+  size_t end = std::max (begin, std::min (m_occupiedEnd, x.m_occupiedEnd));
+  double *v = m_values.data ();
+  const double *w = x.m_values.data ();
+  for (size_t i = m_occupiedBegin; i < std::min (begin, m_occupiedEnd); i++)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
+      v[i] = 0;
+    }
+  for (size_t i = begin; i < end; i++)
+    {
+      v[i] *= w[i];
+    }
+  for (size_t i = std::max (end, m_occupiedBegin); i < m_occupiedEnd; i++)
+    {
+      v[i] = 0;
     }
+  m_occupiedBegin = begin;
+  m_occupiedEnd = end;
 }
 
 
 void
 SpectrumValue::Multiply (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  for (size_t i = m_occupiedBegin; i < m_occupiedEnd; i++)
     {
-      *it1 *= s;
-      ++it1;
+      v[i] *= s;
     }
 }
 
@@ -197,17 +226,14 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const double *w = x.m_values.data ();
+  for (size_t i = m_occupiedBegin; i < m_occupiedEnd; i++)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
+      v[i] /= w[i];
     }
 }
 
@@ -216,12 +242,10 @@ void
 SpectrumValue::Divide (double s)
 {
   NS_LOG_FUNCTION (this << s);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  for (size_t i = m_occupiedBegin; i < m_occupiedEnd; i++)
     {
-      *it1 /= s;
-      ++it1;
+      v[i] /= s;
     }
 }
 
@@ -231,12 +255,10 @@ SpectrumValue::Divide (double s)
 void
 SpectrumValue::ChangeSign ()
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  for (size_t i = m_occupiedBegin; i < m_occupiedEnd; i++)
     {
-      *it1 = -(*it1);
-      ++it1;
+      v[i] = -v[i];
     }
 }
 
@@ -244,6 +266,7 @@ SpectrumValue::ChangeSign ()
 void
 SpectrumValue::ShiftLeft (int n)
 {
+  Occupy (0, m_values.size ());
   int i = 0;
   while (i < (int) m_values.size () - n)
     {
@@ -261,6 +284,7 @@ SpectrumValue::ShiftLeft (int n)
 void
 SpectrumValue::ShiftRight (int n)
 {
+  Occupy (0, m_values.size ());
   int i = m_values.size () - 1;
   while (i - n >= 0)
     {
@@ -287,6 +311,7 @@ SpectrumValue::Pow (double exp)
       *it1 = std::pow (*it1, exp);
       ++it1;
     }
+  Occupy (0, m_values.size ());
 }
 
 
@@ -301,6 +326,7 @@ SpectrumValue::Exp (double base)
       *it1 = std::pow (base, *it1);
       ++it1;
     }
+  Occupy (0, m_values.size ());
 }
 
 
@@ -315,6 +341,7 @@ SpectrumValue::Log10 ()
       *it1 = std::log10 (*it1);
       ++it1;
     }
+  Occupy (0, m_values.size ());
 }
 
 void
@@ -328,6 +355,7 @@ SpectrumValue::Log2 ()
       *it1 = log2 (*it1);
       ++it1;
     }
+  Occupy (0, m_values.size ());
 }
 
 
@@ -342,17 +370,17 @@ SpectrumValue::Log ()
       *it1 = std::log (*it1);
       ++it1;
     }
+  Occupy (0, m_values.size ());
 }
 
 double
 Norm (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  const double *v = x.m_values.data ();
+  for (size_t i = x.m_occupiedBegin; i < x.m_occupiedEnd; i++)
     {
-      s += (*it1) * (*it1);
-      ++it1;
+      s += v[i] * v[i];
     }
   return std::sqrt (s);
 }
@@ -362,11 +390,10 @@ double
 Sum (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  const double *v = x.m_values.data ();
+  for (size_t i = x.m_occupiedBegin; i < x.m_occupiedEnd; i++)
     {
-      s += (*it1);
-      ++it1;
+      s += v[i];
     }
   return s;
 }
@@ -403,6 +430,28 @@ Integral (const SpectrumValue& arg)
   return i;
 }
 
+SpectrumValue
+Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals, const SpectrumValue& noise)
+{
+  NS_ASSERT (signal.m_spectrumModel == allSignals.m_spectrumModel);
+  NS_ASSERT (signal.m_spectrumModel == noise.m_spectrumModel);
+  NS_ASSERT (signal.m_values.size () == allSignals.m_values.size ());
+  NS_ASSERT (signal.m_values.size () == noise.m_values.size ());
+
+  SpectrumValue sinr (signal.m_spectrumModel);
+  double *r = sinr.m_values.data ();
+  const double *s = signal.m_values.data ();
+  const double *a = allSignals.m_values.data ();
+  const double *n = noise.m_values.data ();
+  for (size_t i = signal.m_occupiedBegin; i < signal.m_occupiedEnd; i++)
+    {
+      r[i] = s[i] / (a[i] - s[i] + n[i]);
+    }
+  sinr.m_occupiedBegin = signal.m_occupiedBegin;
+  sinr.m_occupiedEnd = signal.m_occupiedEnd;
+  return sinr;
+}
+
 
 
 Ptr<SpectrumValue>
@@ -671,6 +720,8 @@ SpectrumValue::operator= (double rhs)
       *it1 = rhs;
       ++it1;
     }
+  m_occupiedBegin = 0;
+  m_occupiedEnd = (rhs == 0 ? 0 : m_values.size ());
   return *this;
 }
 
@@ -704,5 +755,52 @@ SpectrumValue::ValuesAt (uint32_t pos) const
   return m_values.at (pos);
 }
 
+size_t
+SpectrumValue::GetOccupiedBegin () const
+{
+  return m_occupiedBegin;
+}
+
+size_t
+SpectrumValue::GetOccupiedEnd () const
+{
+  return m_occupiedEnd;
+}
+
+void
+SpectrumValue::TrimOccupiedBands ()
+{
+  while (m_occupiedBegin < m_occupiedEnd && m_values[m_occupiedBegin] == 0)
+    {
+      m_occupiedBegin++;
+    }
+  while (m_occupiedEnd > m_occupiedBegin && m_values[m_occupiedEnd - 1] == 0)
+    {
+      m_occupiedEnd--;
+    }
+  if (m_occupiedBegin == m_occupiedEnd)
+    {
+      m_occupiedBegin = 0;
+      m_occupiedEnd = 0;
+    }
+}
+
+void
+SpectrumValue::Occupy (size_t begin, size_t end)
+{
+  if (begin == end)
+    {
+      return;
+    }
+  if (m_occupiedBegin == m_occupiedEnd)
+    {
+      m_occupiedBegin = begin;
+      m_occupiedEnd = end;
+      return;
+    }
+  m_occupiedBegin = std::min (m_occupiedBegin, begin);
+  m_occupiedEnd = std::max (m_occupiedEnd, end);
+}
+
 } // namespace ns3
 
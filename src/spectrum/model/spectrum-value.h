@@ -54,6 +54,18 @@ typedef std::vector<double> Values;
  * The intended use of this class is to represent frequency-dependent
  * things, such as power spectral densities, frequency-dependent
  * propagation losses, spectral masks, etc.
+ *
+ * A SpectrumValue keeps track of its occupied bands, i.e., a contiguous
+ * range of bands outside which all the values are zero, so that the
+ * arithmetic operations only walk the bands that can be non-zero. This
+ * matters for wideband carriers, with a large number of bands, and for
+ * transmissions which occupy only a part of them. The range is updated
+ * conservatively by the element accessors: a value written through
+ * operator[] adds its band to the range, ValuesData () adds the range of
+ * bands to be written, while ValuesBegin () and ValuesEnd () extend it to
+ * all the bands; TrimOccupiedBands () shrinks it back to the non-zero
+ * values. The bands outside the range are treated as structural zeros,
+ * which stay zero when they are multiplied or divided.
  */
 class SpectrumValue : public SimpleRefCount<SpectrumValue>
 {
@@ -157,6 +169,16 @@ public:
    */
   Values::iterator ValuesEnd ();
 
+  /**
+   * \brief Get a pointer to the values, to be modified only within a range
+   * of bands. Differently from ValuesBegin (), only the range is added to
+   * the occupied bands.
+   * \param begin the first band of the range
+   * \param end the index past the last band of the range
+   * \return a pointer to the first value, which may be null if there are no bands
+   */
+  double* ValuesData (size_t begin, size_t end);
+
   /**
    * \brief Get the number of values stored in the array
    * \return the values array size
@@ -170,6 +192,25 @@ public:
    */
   const double & ValuesAt (uint32_t pos) const;
 
+  /**
+   * \brief Get the first occupied band
+   * \return the index of the first band which can have a non-zero value
+   */
+  size_t GetOccupiedBegin () const;
+
+  /**
+   * \brief Get the end of the occupied bands
+   * \return the index past the last band which can have a non-zero value,
+   * equal to GetOccupiedBegin () if all the values are zero
+   */
+  size_t GetOccupiedEnd () const;
+
+  /**
+   * \brief Shrink the occupied bands to the first and the last non-zero
+   * value, e.g., after the values have been modified through ValuesBegin ()
+   */
+  void TrimOccupiedBands ();
+
   /**
    *  addition operator
    *
@@ -508,6 +549,22 @@ public:
    */
   friend double Integral (const SpectrumValue&  arg);
 
+  /**
+   * Compute the SINR of a signal received along with other signals, i.e.,
+   * signal / (allSignals - signal + noise), in a single pass over the
+   * occupied bands of the signal and without the temporary values of the
+   * equivalent expression. The SINR is zero outside the occupied bands of
+   * the signal.
+   *
+   * @param signal the received signal
+   * @param allSignals the sum of all the received signals, including the
+   * signal
+   * @param noise the noise
+   *
+   * @return the SINR
+   */
+  friend SpectrumValue Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals, const SpectrumValue& noise);
+
   /**
    *
    * @return a Ptr to a copy of this instance
@@ -603,6 +660,12 @@ private:
    * Applies a Log to each the elements
    */
   void Log ();
+  /**
+   * Extend the occupied bands to a range of bands
+   * \param begin the first band of the range
+   * \param end the index past the last band of the range
+   */
+  void Occupy (size_t begin, size_t end);
 
   Ptr<const SpectrumModel> m_spectrumModel; //!< The spectrum model
 
@@ -616,6 +679,8 @@ private:
    */
   Values m_values;
 
+  size_t m_occupiedBegin; //!< The first band which can have a non-zero value
+  size_t m_occupiedEnd; //!< The index past the last band which can have a non-zero value
 
 };
 
@@ -630,6 +695,7 @@ SpectrumValue Log10 (const SpectrumValue& arg);
 SpectrumValue Log2 (const SpectrumValue& arg);
 SpectrumValue Log (const SpectrumValue& arg);
 double Integral (const SpectrumValue& arg);
+SpectrumValue Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals, const SpectrumValue& noise);
 
 
 } // namespace ns3
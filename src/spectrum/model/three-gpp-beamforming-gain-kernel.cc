@@ -0,0 +1,397 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "three-gpp-beamforming-gain-kernel.h"
+#include "ns3/log.h"
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#define THREE_GPP_BEAMFORMING_GAIN_KERNEL_AVX2
+#include <immintrin.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ThreeGppBeamformingGainKernel");
+
+namespace {
+
+/**
+ * Compute the complex dot product sum_i a[i] * b[i]
+ * \param a pointer to the first vector
+ * \param b pointer to the second vector
+ * \param size the number of elements
+ * \return the dot product
+ */
+std::complex<double>
+DotScalar (const std::complex<double> *a, const std::complex<double> *b, size_t size)
+{
+  std::complex<double> sum (0, 0);
+  for (size_t i = 0; i < size; i++)
+    {
+      sum = sum + a[i] * b[i];
+    }
+  return sum;
+}
+
+/**
+ * Compute sum_i gain[i] * phasor[i], then rotate each phasor[i] by step[i]
+ * \param gain pointer to the gains
+ * \param phasor pointer to the phasors, which are updated
+ * \param step pointer to the rotation steps
+ * \param size the number of elements
+ * \return the sum of the rotated gains
+ */
+std::complex<double>
+RotateAndSumScalar (const std::complex<double> *gain, std::complex<double> *phasor,
+                    const std::complex<double> *step, size_t size)
+{
+  std::complex<double> sum (0, 0);
+  for (size_t i = 0; i < size; i++)
+    {
+      sum = sum + gain[i] * phasor[i];
+      phasor[i] = phasor[i] * step[i];
+    }
+  return sum;
+}
+
+/**
+ * Check if the center frequencies of the subbands are equally spaced
+ * \param bandsBegin iterator to the first subband
+ * \param bandsEnd iterator past the last subband
+ * \param [out] deltaF the distance between the first two center frequencies
+ * \return true if the subbands are equally spaced
+ */
+bool
+IsEquallySpaced (Bands::const_iterator bandsBegin, Bands::const_iterator bandsEnd, double &deltaF)
+{
+  size_t numBands = bandsEnd - bandsBegin;
+  deltaF = numBands > 1 ? bandsBegin[1].fc - bandsBegin[0].fc : 0.0;
+  for (size_t bIndex = 2; bIndex < numBands; bIndex++)
+    {
+      if (std::abs (bandsBegin[bIndex].fc - bandsBegin[bIndex - 1].fc - deltaF) > 1e-9 * std::abs (deltaF))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+#ifdef THREE_GPP_BEAMFORMING_GAIN_KERNEL_AVX2
+
+/**
+ * Multiply two pairs of complex numbers stored as (re0, im0, re1, im1)
+ * \param a the first pair
+ * \param b the second pair
+ * \return the element-wise product
+ */
+__attribute__ ((target ("avx2"))) inline __m256d
+ComplexMulAvx2 (__m256d a, __m256d b)
+{
+  __m256d bRe = _mm256_movedup_pd (b); // (bRe0, bRe0, bRe1, bRe1)
+  __m256d bIm = _mm256_permute_pd (b, 0xF); // (bIm0, bIm0, bIm1, bIm1)
+  __m256d aSwap = _mm256_permute_pd (a, 0x5); // (aIm0, aRe0, aIm1, aRe1)
+  return _mm256_addsub_pd (_mm256_mul_pd (a, bRe), _mm256_mul_pd (aSwap, bIm));
+}
+
+/**
+ * Sum the two complex numbers stored as (re0, im0, re1, im1)
+ * \param v the pair
+ * \return the sum
+ */
+__attribute__ ((target ("avx2"))) inline std::complex<double>
+HorizontalSumAvx2 (__m256d v)
+{
+  __m128d sum = _mm_add_pd (_mm256_castpd256_pd128 (v), _mm256_extractf128_pd (v, 1));
+  double out[2];
+  _mm_storeu_pd (out, sum);
+  return std::complex<double> (out[0], out[1]);
+}
+
+/**
+ * AVX2 version of DotScalar
+ * \param a pointer to the first vector
+ * \param b pointer to the second vector
+ * \param size the number of elements
+ * \return the dot product
+ */
+__attribute__ ((target ("avx2"))) std::complex<double>
+DotAvx2 (const std::complex<double> *a, const std::complex<double> *b, size_t size)
+{
+  const double *aPtr = reinterpret_cast<const double *> (a);
+  const double *bPtr = reinterpret_cast<const double *> (b);
+  __m256d acc = _mm256_setzero_pd ();
+  size_t i = 0;
+  for (; i + 1 < size; i += 2)
+    {
+      acc = _mm256_add_pd (acc, ComplexMulAvx2 (_mm256_loadu_pd (aPtr + 2 * i), _mm256_loadu_pd (bPtr + 2 * i)));
+    }
+  std::complex<double> sum = HorizontalSumAvx2 (acc);
+  for (; i < size; i++)
+    {
+      sum = sum + a[i] * b[i];
+    }
+  return sum;
+}
+
+/**
+ * AVX2 version of RotateAndSumScalar
+ * \param gain pointer to the gains
+ * \param phasor pointer to the phasors, which are updated
+ * \param step pointer to the rotation steps
+ * \param size the number of elements
+ * \return the sum of the rotated gains
+ */
+__attribute__ ((target ("avx2"))) std::complex<double>
+RotateAndSumAvx2 (const std::complex<double> *gain, std::complex<double> *phasor,
+                  const std::complex<double> *step, size_t size)
+{
+  const double *gainPtr = reinterpret_cast<const double *> (gain);
+  double *phasorPtr = reinterpret_cast<double *> (phasor);
+  const double *stepPtr = reinterpret_cast<const double *> (step);
+  __m256d acc = _mm256_setzero_pd ();
+  size_t i = 0;
+  for (; i + 1 < size; i += 2)
+    {
+      __m256d p = _mm256_loadu_pd (phasorPtr + 2 * i);
+      acc = _mm256_add_pd (acc, ComplexMulAvx2 (_mm256_loadu_pd (gainPtr + 2 * i), p));
+      _mm256_storeu_pd (phasorPtr + 2 * i, ComplexMulAvx2 (p, _mm256_loadu_pd (stepPtr + 2 * i)));
+    }
+  std::complex<double> sum = HorizontalSumAvx2 (acc);
+  for (; i < size; i++)
+    {
+      sum = sum + gain[i] * phasor[i];
+      phasor[i] = phasor[i] * step[i];
+    }
+  return sum;
+}
+
+#endif /* THREE_GPP_BEAMFORMING_GAIN_KERNEL_AVX2 */
+
+} // unnamed namespace
+
+bool
+ThreeGppBeamformingGainKernel::IsSupported (Implementation impl)
+{
+  switch (impl)
+    {
+    case SCALAR:
+      return true;
+    case AVX2:
+#ifdef THREE_GPP_BEAMFORMING_GAIN_KERNEL_AVX2
+      return __builtin_cpu_supports ("avx2");
+#else
+      return false;
+#endif
+    default:
+      NS_FATAL_ERROR ("Unknown implementation");
+    }
+  return false;
+}
+
+ThreeGppBeamformingGainKernel::Implementation
+ThreeGppBeamformingGainKernel::GetDefaultImplementation (void)
+{
+  static const Implementation impl = IsSupported (AVX2) ? AVX2 : SCALAR;
+  return impl;
+}
+
+ThreeGppAntennaArrayModel::ComplexVector
+ThreeGppBeamformingGainKernel::CalcLongTerm (const MatrixBasedChannelModel::Complex3DTensor &channel,
+                                             const ThreeGppAntennaArrayModel::ComplexVector &sW,
+                                             const ThreeGppAntennaArrayModel::ComplexVector &uW,
+                                             Implementation impl)
+{
+  NS_LOG_FUNCTION (impl);
+  NS_ASSERT_MSG (IsSupported (impl), "Implementation " << impl << " is not supported");
+
+  size_t uSize = channel.GetUSize ();
+  size_t sSize = channel.GetSSize ();
+  size_t numCluster = channel.GetNSize ();
+  ThreeGppAntennaArrayModel::ComplexVector longTerm (numCluster);
+  if (uW.empty () || sW.empty ())
+    {
+      // the beam of a node was not configured yet, e.g., before the
+      // attachment, hence there is no signal
+      return longTerm;
+    }
+  NS_ASSERT_MSG (uW.size () == uSize && sW.size () == sSize, "The beamforming vectors do not match the channel matrix");
+
+  std::complex<double> (*dot) (const std::complex<double> *, const std::complex<double> *, size_t) = &DotScalar;
+#ifdef THREE_GPP_BEAMFORMING_GAIN_KERNEL_AVX2
+  if (impl == AVX2)
+    {
+      dot = &DotAvx2;
+    }
+#endif
+
+  // each cluster is stored as a column-major uSize x sSize matrix H_n, hence
+  // the long term component is obtained as sW^T (H_n^T uW)
+  ThreeGppAntennaArrayModel::ComplexVector rxSum (sSize);
+  for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+      const std::complex<double> *page = channel.GetPage (cIndex);
+      for (size_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+          rxSum[sIndex] = dot (uW.data (), page + sIndex * uSize, uSize);
+        }
+      longTerm[cIndex] = dot (sW.data (), rxSum.data (), sSize);
+    }
+  return longTerm;
+}
+
+void
+ThreeGppBeamformingGainKernel::ApplySubbandGain (const ThreeGppAntennaArrayModel::ComplexVector &clusterGain,
+                                                 const MatrixBasedChannelModel::DoubleVector &delay,
+                                                 Bands::const_iterator bandsBegin,
+                                                 Bands::const_iterator bandsEnd,
+                                                 double *psd,
+                                                 Implementation impl)
+{
+  NS_LOG_FUNCTION (impl);
+  NS_ASSERT_MSG (IsSupported (impl), "Implementation " << impl << " is not supported");
+
+  size_t numCluster = clusterGain.size ();
+  size_t numBands = bandsEnd - bandsBegin;
+  NS_ASSERT_MSG (delay.size () >= numCluster, "A delay is needed for each cluster");
+
+  std::complex<double> (*rotateAndSum) (const std::complex<double> *, std::complex<double> *,
+                                        const std::complex<double> *, size_t) = &RotateAndSumScalar;
+#ifdef THREE_GPP_BEAMFORMING_GAIN_KERNEL_AVX2
+  if (impl == AVX2)
+    {
+      rotateAndSum = &RotateAndSumAvx2;
+    }
+#endif
+
+  // the delay phasors can be obtained by recurrence only if the subbands are
+  // equally spaced, otherwise they are computed from scratch for each subband
+  double deltaF;
+  uint32_t refreshPeriod = IsEquallySpaced (bandsBegin, bandsEnd, deltaF) ? PHASOR_REFRESH_PERIOD : 1;
+
+  ThreeGppAntennaArrayModel::ComplexVector phasor (numCluster);
+  ThreeGppAntennaArrayModel::ComplexVector step (numCluster);
+  for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+      step[cIndex] = exp (std::complex<double> (0, -2 * M_PI * deltaF * delay[cIndex]));
+    }
+
+  bool refresh = true; // true if the phasors have to be recomputed from scratch
+  uint32_t numRotations = 0; // number of rotations since the last refresh
+  for (size_t bIndex = 0; bIndex < numBands; bIndex++)
+    {
+      if (psd[bIndex] == 0.0)
+        {
+          // skip the empty subbands, the phasors will be recomputed at the
+          // next occupied one
+          refresh = true;
+          continue;
+        }
+
+      if (refresh || numRotations == refreshPeriod)
+        {
+          double fsb = bandsBegin[bIndex].fc; // center frequency of the sub-band
+          for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+            {
+              phasor[cIndex] = exp (std::complex<double> (0, -2 * M_PI * fsb * delay[cIndex]));
+            }
+          refresh = false;
+          numRotations = 0;
+        }
+
+      std::complex<double> subbandGain = rotateAndSum (clusterGain.data (), phasor.data (), step.data (), numCluster);
+      numRotations++;
+      psd[bIndex] = psd[bIndex] * norm (subbandGain);
+    }
+}
+
+ThreeGppAntennaArrayModel::ComplexVector
+ThreeGppBeamformingGainKernel::CalcDelayPhasors (const MatrixBasedChannelModel::DoubleVector &delay,
+                                                 size_t numCluster,
+                                                 Bands::const_iterator bandsBegin,
+                                                 Bands::const_iterator bandsEnd)
+{
+  NS_LOG_FUNCTION (numCluster);
+  NS_ASSERT_MSG (delay.size () >= numCluster, "A delay is needed for each cluster");
+
+  size_t numBands = bandsEnd - bandsBegin;
+  double deltaF;
+  uint32_t refreshPeriod = IsEquallySpaced (bandsBegin, bandsEnd, deltaF) ? PHASOR_REFRESH_PERIOD : 1;
+
+  ThreeGppAntennaArrayModel::ComplexVector step (numCluster);
+  for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+      step[cIndex] = exp (std::complex<double> (0, -2 * M_PI * deltaF * delay[cIndex]));
+    }
+
+  ThreeGppAntennaArrayModel::ComplexVector phasors (numBands * numCluster);
+  for (size_t bIndex = 0; bIndex < numBands; bIndex++)
+    {
+      std::complex<double> *row = phasors.data () + bIndex * numCluster;
+      if (bIndex % refreshPeriod == 0)
+        {
+          double fsb = bandsBegin[bIndex].fc; // center frequency of the sub-band
+          for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+            {
+              row[cIndex] = exp (std::complex<double> (0, -2 * M_PI * fsb * delay[cIndex]));
+            }
+        }
+      else
+        {
+          const std::complex<double> *previousRow = row - numCluster;
+          for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+            {
+              row[cIndex] = previousRow[cIndex] * step[cIndex];
+            }
+        }
+    }
+  return phasors;
+}
+
+void
+ThreeGppBeamformingGainKernel::ApplySubbandGain (const ThreeGppAntennaArrayModel::ComplexVector &clusterGain,
+                                                 const ThreeGppAntennaArrayModel::ComplexVector &delayPhasors,
+                                                 double *psd,
+                                                 size_t numBands,
+                                                 Implementation impl)
+{
+  NS_LOG_FUNCTION (impl);
+  NS_ASSERT_MSG (IsSupported (impl), "Implementation " << impl << " is not supported");
+
+  size_t numCluster = clusterGain.size ();
+  NS_ASSERT_MSG (delayPhasors.size () == numBands * numCluster, "The delay phasors do not match the PSD");
+
+  std::complex<double> (*dot) (const std::complex<double> *, const std::complex<double> *, size_t) = &DotScalar;
+#ifdef THREE_GPP_BEAMFORMING_GAIN_KERNEL_AVX2
+  if (impl == AVX2)
+    {
+      dot = &DotAvx2;
+    }
+#endif
+
+  for (size_t bIndex = 0; bIndex < numBands; bIndex++)
+    {
+      if (psd[bIndex] != 0.0)
+        {
+          std::complex<double> subbandGain = dot (clusterGain.data (), delayPhasors.data () + bIndex * numCluster, numCluster);
+          psd[bIndex] = psd[bIndex] * norm (subbandGain);
+        }
+    }
+}
+
+} // namespace ns3
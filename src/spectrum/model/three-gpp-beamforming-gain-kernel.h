@@ -0,0 +1,144 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef THREE_GPP_BEAMFORMING_GAIN_KERNEL_H
+#define THREE_GPP_BEAMFORMING_GAIN_KERNEL_H
+
+#include <ns3/matrix-based-channel-model.h>
+#include <ns3/spectrum-model.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup spectrum
+ * \brief Computational kernels used to evaluate the beamforming gain of a
+ * channel matrix
+ *
+ * The kernels are provided in a portable scalar version and, on x86
+ * processors, in a vectorized version based on the AVX2 instruction set.
+ * The vectorized version is compiled for the AVX2 target independently of
+ * the build flags and it is selected at runtime, only if the processor
+ * supports it.
+ *
+ * The two versions perform the same operations and differ only in the order
+ * of the floating point additions.
+ */
+class ThreeGppBeamformingGainKernel
+{
+public:
+  /**
+   * The implementations of the kernels
+   */
+  enum Implementation
+  {
+    SCALAR, //!< portable implementation
+    AVX2    //!< implementation based on the AVX2 instruction set
+  };
+
+  /**
+   * Check if an implementation can be used on this processor
+   * \param impl the implementation
+   * \return true if the implementation is supported
+   */
+  static bool IsSupported (Implementation impl);
+
+  /**
+   * Returns the fastest implementation supported by this processor. The
+   * processor features are checked only once.
+   * \return the implementation
+   */
+  static Implementation GetDefaultImplementation (void);
+
+  /**
+   * Compute the long term component of the channel, i.e.,
+   * longTerm[n] = sum_s sW[s] sum_u uW[u] H[u][s][n], as two complex
+   * matrix-vector products. If a beamforming vector is not set yet, i.e.,
+   * it is empty, the long term component is null.
+   * \param channel the channel matrix H[u][s][n]
+   * \param sW the beamforming vector of the s node
+   * \param uW the beamforming vector of the u node
+   * \param impl the implementation to use
+   * \return the long term component of each cluster
+   */
+  static ThreeGppAntennaArrayModel::ComplexVector CalcLongTerm (const MatrixBasedChannelModel::Complex3DTensor &channel,
+                                                                const ThreeGppAntennaArrayModel::ComplexVector &sW,
+                                                                const ThreeGppAntennaArrayModel::ComplexVector &uW,
+                                                                Implementation impl = GetDefaultImplementation ());
+
+  /**
+   * Multiply each non-zero element of a PSD by the squared norm of the
+   * subband gain, i.e., of sum_n clusterGain[n] exp (-j 2 pi f delay[n]),
+   * where f is the center frequency of the subband.
+   *
+   * The delay phasors are computed by recurrence when the subbands are
+   * equally spaced, and they are periodically recomputed from scratch to
+   * bound the accumulation of the rounding errors.
+   *
+   * \param clusterGain the complex gain of each cluster
+   * \param delay the delay of each cluster
+   * \param bandsBegin iterator to the first subband of the PSD
+   * \param bandsEnd iterator past the last subband of the PSD
+   * \param psd pointer to the first PSD value, there must be one value for
+   *        each subband
+   * \param impl the implementation to use
+   */
+  static void ApplySubbandGain (const ThreeGppAntennaArrayModel::ComplexVector &clusterGain,
+                                const MatrixBasedChannelModel::DoubleVector &delay,
+                                Bands::const_iterator bandsBegin,
+                                Bands::const_iterator bandsEnd,
+                                double *psd,
+                                Implementation impl = GetDefaultImplementation ());
+
+  /**
+   * Compute the delay phasors exp (-j 2 pi f delay[n]) for each subband and
+   * each cluster. As in ApplySubbandGain, the phasors are computed by
+   * recurrence when the subbands are equally spaced.
+   * \param delay the delay of each cluster
+   * \param numCluster the number of clusters
+   * \param bandsBegin iterator to the first subband
+   * \param bandsEnd iterator past the last subband
+   * \return the delay phasors, stored in row-major order, i.e., the phasor
+   *         of the n-th cluster in the k-th subband is at index k * numCluster + n
+   */
+  static ThreeGppAntennaArrayModel::ComplexVector CalcDelayPhasors (const MatrixBasedChannelModel::DoubleVector &delay,
+                                                                    size_t numCluster,
+                                                                    Bands::const_iterator bandsBegin,
+                                                                    Bands::const_iterator bandsEnd);
+
+  /**
+   * Multiply each non-zero element of a PSD by the squared norm of the
+   * subband gain, using the delay phasors computed by CalcDelayPhasors
+   * \param clusterGain the complex gain of each cluster
+   * \param delayPhasors the delay phasors of each subband and cluster
+   * \param psd pointer to the first PSD value
+   * \param numBands the number of PSD values
+   * \param impl the implementation to use
+   */
+  static void ApplySubbandGain (const ThreeGppAntennaArrayModel::ComplexVector &clusterGain,
+                                const ThreeGppAntennaArrayModel::ComplexVector &delayPhasors,
+                                double *psd,
+                                size_t numBands,
+                                Implementation impl = GetDefaultImplementation ());
+
+  static const uint32_t PHASOR_REFRESH_PERIOD = 64; //!< number of subbands after which the delay phasors are recomputed from scratch
+};
+
+} // namespace ns3
+
+#endif /* THREE_GPP_BEAMFORMING_GAIN_KERNEL_H */
@@ -1136,10 +1136,10 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
         }
     }
 
-  double rayAoa_radian[numReducedCluster][raysPerCluster]; //rayAoa_radian[n][m], where n is cluster index, m is ray index
-  double rayAod_radian[numReducedCluster][raysPerCluster]; //rayAod_radian[n][m], where n is cluster index, m is ray index
-  double rayZoa_radian[numReducedCluster][raysPerCluster]; //rayZoa_radian[n][m], where n is cluster index, m is ray index
-  double rayZod_radian[numReducedCluster][raysPerCluster]; //rayZod_radian[n][m], where n is cluster index, m is ray index
+  Double2DVector rayAoa_radian (numReducedCluster, DoubleVector (raysPerCluster)); //rayAoa_radian[n][m], where n is cluster index, m is ray index
+  Double2DVector rayAod_radian (numReducedCluster, DoubleVector (raysPerCluster)); //rayAod_radian[n][m], where n is cluster index, m is ray index
+  Double2DVector rayZoa_radian (numReducedCluster, DoubleVector (raysPerCluster)); //rayZoa_radian[n][m], where n is cluster index, m is ray index
+  Double2DVector rayZod_radian (numReducedCluster, DoubleVector (raysPerCluster)); //rayZod_radian[n][m], where n is cluster index, m is ray index
 
   for (uint8_t nInd = 0; nInd < numReducedCluster; nInd++)
     {
@@ -1290,10 +1290,10 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   //shuffle all the arrays to perform random coupling
   for (uint8_t cIndex = 0; cIndex < numReducedCluster; cIndex++)
     {
-      std::shuffle (&rayAod_radian[cIndex][0],&rayAod_radian[cIndex][raysPerCluster],std::default_random_engine (cIndex * 1000 + 100));
-      std::shuffle (&rayAoa_radian[cIndex][0],&rayAoa_radian[cIndex][raysPerCluster],std::default_random_engine (cIndex * 1000 + 200));
-      std::shuffle (&rayZod_radian[cIndex][0],&rayZod_radian[cIndex][raysPerCluster],std::default_random_engine (cIndex * 1000 + 300));
-      std::shuffle (&rayZoa_radian[cIndex][0],&rayZoa_radian[cIndex][raysPerCluster],std::default_random_engine (cIndex * 1000 + 400));
+      std::shuffle (rayAod_radian[cIndex].begin (),rayAod_radian[cIndex].end (),std::default_random_engine (cIndex * 1000 + 100));
+      std::shuffle (rayAoa_radian[cIndex].begin (),rayAoa_radian[cIndex].end (),std::default_random_engine (cIndex * 1000 + 200));
+      std::shuffle (rayZod_radian[cIndex].begin (),rayZod_radian[cIndex].end (),std::default_random_engine (cIndex * 1000 + 300));
+      std::shuffle (rayZoa_radian[cIndex].begin (),rayZoa_radian[cIndex].end (),std::default_random_engine (cIndex * 1000 + 400));
     }
 
   //Step 9: Generate the cross polarization power ratios
@@ -1325,8 +1325,6 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   //Step 11: Generate channel coefficients for each cluster n and each receiver
   // and transmitter element pair u,s.
 
-  Complex3DVector H_NLOS; // channel coefficients H_NLOS [u][s][n],
-  // where u and s are receive and transmit antenna element, n is cluster index.
   uint64_t uSize = uAntenna->GetNumberOfElements ();
   uint64_t sSize = sAntenna->GetNumberOfElements ();
 
@@ -1352,163 +1350,59 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
 
   NS_LOG_INFO ("1st strongest cluster:" << (int)cluster1st << ", 2nd strongest cluster:" << (int)cluster2nd);
 
-  Complex3DVector H_usn;  //channel coffecient H_usn[u][s][n];
   // NOTE Since each of the strongest 2 clusters are divided into 3 sub-clusters,
   // the total cluster will be numReducedCLuster + 4.
+  Complex3DTensor H_usn = CalcClusterCoefficients (sAntenna, uAntenna,
+                                                   rayAoa_radian, rayZoa_radian,
+                                                   rayAod_radian, rayZod_radian,
+                                                   clusterPhase, crossPolarizationPowerRatios,
+                                                   clusterPower, cluster1st, cluster2nd);
 
-  H_usn.resize (uSize);
-  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+  if (los) //(7.5-29) && (7.5-30)
     {
-      H_usn[uIndex].resize (sSize);
-      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
-        {
-          H_usn[uIndex][sIndex].resize (numReducedCluster);
-        }
-    }
+      // the LOS ray only depends on the element locations through the
+      // phase terms, hence the field patterns and the direction vectors
+      // are computed once and the phases are evaluated per element
+      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (uAngle.phi, uAngle.theta));
+      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (sAngle.phi, sAngle.theta));
 
-  // The following for loops computes the channel coefficients
-  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
-    {
-      Vector uLoc = uAntenna->GetElementLocation (uIndex);
+      double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
+      std::complex<double> losTerm = (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi)
+        * exp (std::complex<double> (0, - 2 * M_PI * dis3D / lambda));
+
+      Vector uDir (sin (uAngle.theta) * cos (uAngle.phi), sin (uAngle.theta) * sin (uAngle.phi), cos (uAngle.theta));
+      Vector sDir (sin (sAngle.theta) * cos (sAngle.phi), sin (sAngle.theta) * sin (sAngle.phi), cos (sAngle.theta));
 
+      ThreeGppAntennaArrayModel::ComplexVector sPhasor (sSize);
       for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
         {
-
           Vector sLoc = sAntenna->GetElementLocation (sIndex);
+          double txPhaseDiff = 2 * M_PI * (sDir.x * sLoc.x + sDir.y * sLoc.y + sDir.z * sLoc.z);
+          sPhasor[sIndex] = exp (std::complex<double> (0, txPhaseDiff));
+        }
 
-          for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
-            {
-              //Compute the N-2 weakest cluster, only vertical polarization. (7.5-22)
-              if (nIndex != cluster1st && nIndex != cluster2nd)
-                {
-                  std::complex<double> rays (0,0);
-                  for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
-                    {
-                      DoubleVector initialPhase = clusterPhase[nIndex][mIndex];
-                      double k = crossPolarizationPowerRatios[nIndex][mIndex];
-                      //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
-
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
-                      // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center anngle of each cluster.
-
-                      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoa_radian[nIndex][mIndex], rayZoa_radian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAod_radian[nIndex][mIndex], rayZod_radian[nIndex][mIndex]));
-
-                      rays += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                               +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                               +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                               +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                        * exp (std::complex<double> (0, rxPhaseDiff))
-                        * exp (std::complex<double> (0, txPhaseDiff));
-                    }
-                  rays *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  H_usn[uIndex][sIndex][nIndex] = rays;
-                }
-              else  //(7.5-28)
-                {
-                  std::complex<double> raysSub1 (0,0);
-                  std::complex<double> raysSub2 (0,0);
-                  std::complex<double> raysSub3 (0,0);
-
-                  for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
-                    {
-                      double k = crossPolarizationPowerRatios[nIndex][mIndex];
-
-                      //ZML:Just remind me that the angle offsets for the 3 subclusters were not generated correctly.
-
-                      DoubleVector initialPhase = clusterPhase[nIndex][mIndex];
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
-
-                      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoa_radian[nIndex][mIndex], rayZoa_radian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAod_radian[nIndex][mIndex], rayZod_radian[nIndex][mIndex]));
-
-                      switch (mIndex)
-                        {
-                        case 9:
-                        case 10:
-                        case 11:
-                        case 12:
-                        case 17:
-                        case 18:
-                          raysSub2 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                       +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                            * exp (std::complex<double> (0, rxPhaseDiff))
-                            * exp (std::complex<double> (0, txPhaseDiff));
-                          break;
-                        case 13:
-                        case 14:
-                        case 15:
-                        case 16:
-                          raysSub3 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                       +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                            * exp (std::complex<double> (0, rxPhaseDiff))
-                            * exp (std::complex<double> (0, txPhaseDiff));
-                          break;
-                        default:                        //case 1,2,3,4,5,6,7,8,19,20
-                          raysSub1 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                       +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                            * exp (std::complex<double> (0, rxPhaseDiff))
-                            * exp (std::complex<double> (0, txPhaseDiff));
-                          break;
-                        }
-                    }
-                  raysSub1 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  raysSub2 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  raysSub3 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  H_usn[uIndex][sIndex][nIndex] = raysSub1;
-                  H_usn[uIndex][sIndex].push_back (raysSub2);
-                  H_usn[uIndex][sIndex].push_back (raysSub3);
+      double K_linear = pow (10,K_factor / 10);
+      double nlosScaling = sqrt (1 / (K_linear + 1));
+      double losScaling = sqrt (K_linear / (1 + K_linear));
+      double losAttenuation = pow (10,attenuation_dB[0] / 10);
+      for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+          Vector uLoc = uAntenna->GetElementLocation (uIndex);
+          double rxPhaseDiff = 2 * M_PI * (uDir.x * uLoc.x + uDir.y * uLoc.y + uDir.z * uLoc.z);
+          std::complex<double> uLosTerm = losTerm * exp (std::complex<double> (0, rxPhaseDiff));
 
-                }
-            }
-          if (los) //(7.5-29) && (7.5-30)
+          for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
             {
-              std::complex<double> ray (0,0);
-              double rxPhaseDiff = 2 * M_PI * (sin (uAngle.theta) * cos (uAngle.phi) * uLoc.x
-                                               + sin (uAngle.theta) * sin (uAngle.phi) * uLoc.y
-                                               + cos (uAngle.theta) * uLoc.z);
-              double txPhaseDiff = 2 * M_PI * (sin (sAngle.theta) * cos (sAngle.phi) * sLoc.x
-                                               + sin (sAngle.theta) * sin (sAngle.phi) * sLoc.y
-                                               + cos (sAngle.theta) * sLoc.z);
-
-              double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-              std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (uAngle.phi, uAngle.theta));
-              std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (sAngle.phi, sAngle.theta));
-
-              double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
-
-              ray = (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi)
-                  * exp (std::complex<double> (0, - 2 * M_PI * dis3D / lambda))
-                  * exp (std::complex<double> (0, rxPhaseDiff))
-                  * exp (std::complex<double> (0, txPhaseDiff));
-
-              double K_linear = pow (10,K_factor / 10);
+              std::complex<double> ray = uLosTerm * sPhasor[sIndex];
+
               // the LOS path should be attenuated if blockage is enabled.
-              H_usn[uIndex][sIndex][0] = sqrt (1 / (K_linear + 1)) * H_usn[uIndex][sIndex][0] + sqrt (K_linear / (1 + K_linear)) * ray / pow (10,attenuation_dB[0] / 10);           //(7.5-30) for tau = tau1
-              double tempSize = H_usn[uIndex][sIndex].size ();
+              H_usn (uIndex, sIndex, 0) = nlosScaling * H_usn (uIndex, sIndex, 0) + losScaling * ray / losAttenuation; //(7.5-30) for tau = tau1
+              double tempSize = H_usn.GetNSize ();
               for (uint8_t nIndex = 1; nIndex < tempSize; nIndex++)
                 {
-                  H_usn[uIndex][sIndex][nIndex] *= sqrt (1 / (K_linear + 1)); //(7.5-30) for tau = tau2...taunN
+                  H_usn (uIndex, sIndex, nIndex) *= nlosScaling; //(7.5-30) for tau = tau2...taunN
                 }
-
             }
         }
     }
@@ -1572,7 +1466,7 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
 
     }
 
-  NS_LOG_INFO ("size of coefficient matrix =[" << H_usn.size () << "][" << H_usn[0].size () << "][" << H_usn[0][0].size () << "]");
+  NS_LOG_INFO ("size of coefficient matrix =[" << H_usn.GetUSize () << "][" << H_usn.GetSSize () << "][" << H_usn.GetNSize () << "]");
 
   channelParams->m_channel = H_usn;
   channelParams->m_delay = clusterDelay;
@@ -1586,6 +1480,162 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   return channelParams;
 }
 
+MatrixBasedChannelModel::Complex3DTensor
+ThreeGppChannelModel::CalcClusterCoefficients (Ptr<const ThreeGppAntennaArrayModel> sAntenna,
+                                               Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                               const Double2DVector &rayAoa_radian,
+                                               const Double2DVector &rayZoa_radian,
+                                               const Double2DVector &rayAod_radian,
+                                               const Double2DVector &rayZod_radian,
+                                               const Double3DVector &clusterPhase,
+                                               const Double2DVector &crossPolarizationPowerRatios,
+                                               const DoubleVector &clusterPower,
+                                               uint8_t cluster1st, uint8_t cluster2nd)
+{
+  uint64_t uSize = uAntenna->GetNumberOfElements ();
+  uint64_t sSize = sAntenna->GetNumberOfElements ();
+  uint8_t numReducedCluster = clusterPower.size ();
+  NS_ASSERT (numReducedCluster > 0 && rayAoa_radian.size () == numReducedCluster);
+  uint8_t raysPerCluster = rayAoa_radian[0].size ();
+  uint64_t numRays = numReducedCluster * raysPerCluster;
+
+  // Only the element locations depend on u and s, hence the direction vectors,
+  // the field patterns and the polarization terms are computed once per ray.
+  // The contribution of ray r to H_usn[u][s][n] is then given by the product
+  // uTerm[u][r] * sPhasor[s][r], where uTerm includes the polarization term
+  // and the rx phase, and sPhasor the tx phase.
+  // NOTE the operations are carried out in the same order as in the
+  // straightforward per-element evaluation, so that the results are the same.
+  std::vector<Vector> uDir (numRays); // rx direction vector of each ray
+  std::vector<Vector> sDir (numRays); // tx direction vector of each ray
+  ThreeGppAntennaArrayModel::ComplexVector polTerm (numRays); // polarization term of each ray (7.5-22)
+  for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+    {
+      for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+          uint64_t rIndex = nIndex * raysPerCluster + mIndex;
+          double aoa = rayAoa_radian[nIndex][mIndex];
+          double zoa = rayZoa_radian[nIndex][mIndex];
+          double aod = rayAod_radian[nIndex][mIndex];
+          double zod = rayZod_radian[nIndex][mIndex];
+          uDir[rIndex] = Vector (sin (zoa) * cos (aoa), sin (zoa) * sin (aoa), cos (zoa));
+          sDir[rIndex] = Vector (sin (zod) * cos (aod), sin (zod) * sin (aod), cos (zod));
+
+          // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center anngle of each cluster.
+          double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+          std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (aoa, zoa));
+          std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (aod, zod));
+
+          const DoubleVector &initialPhase = clusterPhase[nIndex][mIndex];
+          double k = crossPolarizationPowerRatios[nIndex][mIndex];
+          polTerm[rIndex] = exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
+            +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
+            +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
+            +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi;
+        }
+    }
+
+  // compute the tx phasors of each ray, for each s element
+  Complex2DVector sPhasor (sSize, ThreeGppAntennaArrayModel::ComplexVector (numRays));
+  for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+    {
+      //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
+      Vector sLoc = sAntenna->GetElementLocation (sIndex);
+      for (uint64_t rIndex = 0; rIndex < numRays; rIndex++)
+        {
+          double txPhaseDiff = 2 * M_PI * (sDir[rIndex].x * sLoc.x + sDir[rIndex].y * sLoc.y + sDir[rIndex].z * sLoc.z);
+          sPhasor[sIndex][rIndex] = exp (std::complex<double> (0, txPhaseDiff));
+        }
+    }
+
+  DoubleVector clusterScaling (numReducedCluster);
+  for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+    {
+      clusterScaling[nIndex] = sqrt (clusterPower[nIndex] / raysPerCluster);
+    }
+
+  // the sub-clusters 2 and 3 of the two strongest clusters are stored after
+  // the numReducedCluster clusters, in increasing order of cluster index
+  std::vector<uint64_t> subClusterIndex (numReducedCluster, 0);
+  uint64_t numSubClusters = 0;
+  for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+    {
+      if (nIndex == cluster1st || nIndex == cluster2nd)
+        {
+          subClusterIndex[nIndex] = numReducedCluster + numSubClusters;
+          numSubClusters += 2;
+        }
+    }
+
+  Complex3DTensor H_usn (uSize, sSize, numReducedCluster + numSubClusters);
+  ThreeGppAntennaArrayModel::ComplexVector uTerm (numRays);
+  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+      Vector uLoc = uAntenna->GetElementLocation (uIndex);
+      for (uint64_t rIndex = 0; rIndex < numRays; rIndex++)
+        {
+          double rxPhaseDiff = 2 * M_PI * (uDir[rIndex].x * uLoc.x + uDir[rIndex].y * uLoc.y + uDir[rIndex].z * uLoc.z);
+          uTerm[rIndex] = polTerm[rIndex] * exp (std::complex<double> (0, rxPhaseDiff));
+        }
+
+      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+          const std::complex<double> *sRow = sPhasor[sIndex].data ();
+          for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+            {
+              const std::complex<double> *uRay = uTerm.data () + nIndex * raysPerCluster;
+              const std::complex<double> *sRay = sRow + nIndex * raysPerCluster;
+
+              //Compute the N-2 weakest cluster, only vertical polarization. (7.5-22)
+              if (nIndex != cluster1st && nIndex != cluster2nd)
+                {
+                  std::complex<double> rays (0,0);
+                  for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+                    {
+                      rays += uRay[mIndex] * sRay[mIndex];
+                    }
+                  H_usn (uIndex, sIndex, nIndex) = rays * clusterScaling[nIndex];
+                }
+              else  //(7.5-28)
+                {
+                  std::complex<double> raysSub1 (0,0);
+                  std::complex<double> raysSub2 (0,0);
+                  std::complex<double> raysSub3 (0,0);
+                  for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+                    {
+                      //ZML:Just remind me that the angle offsets for the 3 subclusters were not generated correctly.
+                      switch (mIndex)
+                        {
+                        case 9:
+                        case 10:
+                        case 11:
+                        case 12:
+                        case 17:
+                        case 18:
+                          raysSub2 += uRay[mIndex] * sRay[mIndex];
+                          break;
+                        case 13:
+                        case 14:
+                        case 15:
+                        case 16:
+                          raysSub3 += uRay[mIndex] * sRay[mIndex];
+                          break;
+                        default:                        //case 1,2,3,4,5,6,7,8,19,20
+                          raysSub1 += uRay[mIndex] * sRay[mIndex];
+                          break;
+                        }
+                    }
+                  H_usn (uIndex, sIndex, nIndex) = raysSub1 * clusterScaling[nIndex];
+                  H_usn (uIndex, sIndex, subClusterIndex[nIndex]) = raysSub2 * clusterScaling[nIndex];
+                  H_usn (uIndex, sIndex, subClusterIndex[nIndex] + 1) = raysSub3 * clusterScaling[nIndex];
+                }
+            }
+        }
+    }
+
+  return H_usn;
+}
+
 MatrixBasedChannelModel::DoubleVector
 ThreeGppChannelModel::CalcAttenuationOfBlockage (Ptr<ThreeGppChannelModel::ThreeGppChannelMatrix> params,
                                                  const DoubleVector &clusterAOA,
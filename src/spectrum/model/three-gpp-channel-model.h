@@ -128,6 +128,44 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * Compute the NLOS channel coefficients H_usn[u][s][n] following
+   * 3GPP TR 38.901, (7.5-22) and (7.5-28).
+   *
+   * The field patterns, the direction vectors and the polarization terms
+   * only depend on the ray, hence they are computed once per ray. The
+   * contribution of each ray to the (u, s) element pair is obtained as the
+   * product of a per-u and a per-s phasor. The operations are performed in
+   * the same order as in the per-element evaluation of (7.5-22), therefore
+   * the result matches it up to floating point rounding.
+   *
+   * The coefficients of the sub-clusters 2 and 3 of the two strongest
+   * clusters are appended after the numReducedCluster clusters.
+   *
+   * \param sAntenna the s node antenna array
+   * \param uAntenna the u node antenna array
+   * \param rayAoa_radian the ray azimuth angles of arrival rayAoa_radian[n][m], in radians
+   * \param rayZoa_radian the ray zenith angles of arrival rayZoa_radian[n][m], in radians
+   * \param rayAod_radian the ray azimuth angles of departure rayAod_radian[n][m], in radians
+   * \param rayZod_radian the ray zenith angles of departure rayZod_radian[n][m], in radians
+   * \param clusterPhase the initial random phases clusterPhase[n][m][p]
+   * \param crossPolarizationPowerRatios the cross polarization power ratios, in linear scale
+   * \param clusterPower the power of each cluster
+   * \param cluster1st index of the strongest cluster
+   * \param cluster2nd index of the second strongest cluster
+   * \return the channel coefficients H_usn[u][s][n]
+   */
+  static Complex3DTensor CalcClusterCoefficients (Ptr<const ThreeGppAntennaArrayModel> sAntenna,
+                                                  Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                                  const Double2DVector &rayAoa_radian,
+                                                  const Double2DVector &rayZoa_radian,
+                                                  const Double2DVector &rayAod_radian,
+                                                  const Double2DVector &rayZod_radian,
+                                                  const Double3DVector &clusterPhase,
+                                                  const Double2DVector &crossPolarizationPowerRatios,
+                                                  const DoubleVector &clusterPower,
+                                                  uint8_t cluster1st, uint8_t cluster2nd);
+
 private:
   /**
    * Extends the struct ChannelMatrix by including information that are used 
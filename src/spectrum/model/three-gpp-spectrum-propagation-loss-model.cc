@@ -24,12 +24,15 @@
 #include "three-gpp-spectrum-propagation-loss-model.h"
 #include "ns3/net-device.h"
 #include "ns3/three-gpp-antenna-array-model.h"
+#include "ns3/three-gpp-beamforming-gain-kernel.h"
 #include "ns3/node.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
 #include "ns3/string.h"
 #include "ns3/simulator.h"
 #include "ns3/pointer.h"
+#include "ns3/trace-source-accessor.h"
 #include <map>
 
 namespace ns3 {
@@ -53,6 +56,8 @@ ThreeGppSpectrumPropagationLossModel::DoDispose ()
 {
   m_deviceAntennaMap.clear ();
   m_longTermMap.clear ();
+  m_longTermLru.clear ();
+  m_longTermCacheMemory = 0;
   m_channelModel->Dispose ();
   m_channelModel = nullptr;
 }
@@ -70,6 +75,40 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId (void)
                   MakePointerAccessor (&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                        &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
       MakePointerChecker<MatrixBasedChannelModel> ())
+    .AddAttribute ("MaxDelayPhasors",
+                   "The maximum number of delay phasors, i.e., number of subbands "
+                   "times number of clusters, stored for each tx-rx pair. "
+                   "If the PSD requires more phasors, they are computed at each call",
+                   UintegerValue (65536),
+                   MakeUintegerAccessor (&ThreeGppSpectrumPropagationLossModel::m_maxDelayPhasors),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("LongTermCacheMaxMemory",
+                   "The maximum memory, in bytes, occupied by the cached long term "
+                   "components. When exceeded, the least recently used entries are "
+                   "evicted. If 0, the memory is not limited",
+                   UintegerValue (128 * 1024 * 1024),
+                   MakeUintegerAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheMaxMemory),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("LongTermCacheTimeout",
+                   "The time after which a cached long term component which has not "
+                   "been used is evicted. If 0, the entries are never evicted "
+                   "because of their age",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheTimeout),
+                   MakeTimeChecker ())
+    .AddTraceSource ("LongTermCacheHits",
+                     "Number of long term lookups served by the cache",
+                     MakeTraceSourceAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheHits),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("LongTermCacheMisses",
+                     "Number of long term lookups which required the computation "
+                     "of the long term component",
+                     MakeTraceSourceAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheMisses),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("LongTermCacheEvictions",
+                     "Number of long term components evicted from the cache",
+                     MakeTraceSourceAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheEvictions),
+                     "ns3::TracedValueCallback::Uint64")
     ;
   return tid;
 }
@@ -126,102 +165,126 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm (Ptr<const MatrixBasedChannel
   NS_LOG_DEBUG ("CalcLongTerm with sAntenna " << sAntenna << " uAntenna " << uAntenna);
   //store the long term part to reduce computation load
   //only the small scale fading needs to be updated if the large scale parameters and antenna weights remain unchanged.
-  ThreeGppAntennaArrayModel::ComplexVector longTerm;
-  uint8_t numCluster = static_cast<uint8_t> (params->m_channel[0][0].size ());
-
-  for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
-    {
-      std::complex<double> txSum (0,0);
-      for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
-        {
-          std::complex<double> rxSum (0,0);
-          for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
-            {
-              rxSum = rxSum + uW[uIndex] * params->m_channel[uIndex][sIndex][cIndex];
-            }
-          txSum = txSum + sW[sIndex] * rxSum;
-        }
-      longTerm.push_back (txSum);
-    }
+  ThreeGppAntennaArrayModel::ComplexVector longTerm = ThreeGppBeamformingGainKernel::CalcLongTerm (params->m_channel, sW, uW);
   return longTerm;
 }
 
 Ptr<SpectrumValue>
 ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> txPsd,
-                                                           ThreeGppAntennaArrayModel::ComplexVector longTerm,
+                                                           Ptr<LongTerm> longTerm,
                                                            Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
-                                                           const ns3::Vector &sSpeed, const ns3::Vector &uSpeed) const
+                                                           const ns3::Vector &sSpeed, const ns3::Vector &uSpeed,
+                                                           bool cacheDelayPhasors) const
 {
   NS_LOG_FUNCTION (this);
 
   Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue> (txPsd);
 
   //channel[rx][tx][cluster]
-  uint8_t numCluster = static_cast<uint8_t> (params->m_channel[0][0].size ());
+  uint8_t numCluster = static_cast<uint8_t> (params->m_channel.GetNSize ());
+
+  // compute the direction cosines of the cluster angles, which only depend
+  // on the channel matrix
+  if (longTerm->m_uDirection.size () != numCluster)
+    {
+      longTerm->m_uDirection.resize (numCluster);
+      longTerm->m_sDirection.resize (numCluster);
+      for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+          //cluster angle angle[direction][n],where, direction = 0(aoa), 1(zoa).
+          double zoa = params->m_angle[MatrixBasedChannelModel::ZOA_INDEX][cIndex] * M_PI / 180;
+          double aoa = params->m_angle[MatrixBasedChannelModel::AOA_INDEX][cIndex] * M_PI / 180;
+          double zod = params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180;
+          double aod = params->m_angle[MatrixBasedChannelModel::AOD_INDEX][cIndex] * M_PI / 180;
+          longTerm->m_uDirection[cIndex] = Vector (sin (zoa) * cos (aoa), sin (zoa) * sin (aoa), cos (zoa));
+          longTerm->m_sDirection[cIndex] = Vector (sin (zod) * cos (aod), sin (zod) * sin (aod), cos (zod));
+        }
+      longTerm->m_dopplerRate.clear ();
+    }
 
   // compute the doppler term
   // NOTE the update of Doppler is simplified by only taking the center angle of
   // each cluster in to consideration.
+  if (longTerm->m_dopplerRate.size () != numCluster
+      || longTerm->m_sSpeed != sSpeed || longTerm->m_uSpeed != uSpeed)
+    {
+      longTerm->m_dopplerRate.resize (numCluster);
+      for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+          // TODO should I include the "alfa" term for the Doppler of delayed paths?
+          const Vector &uDir = longTerm->m_uDirection[cIndex];
+          const Vector &sDir = longTerm->m_sDirection[cIndex];
+          longTerm->m_dopplerRate[cIndex] = 2 * M_PI * ((uDir.x * uSpeed.x + uDir.y * uSpeed.y + uDir.z * uSpeed.z)
+                                                        + (sDir.x * sSpeed.x + sDir.y * sSpeed.y + sDir.z * sSpeed.z));
+        }
+      longTerm->m_sSpeed = sSpeed;
+      longTerm->m_uSpeed = uSpeed;
+    }
+
+  // apply the doppler term to the long term component
   double slotTime = Simulator::Now ().GetSeconds ();
-  ThreeGppAntennaArrayModel::ComplexVector doppler;
+  double frequency = GetFrequency ();
+  ThreeGppAntennaArrayModel::ComplexVector clusterGain (numCluster);
   for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
     {
-      //cluster angle angle[direction][n],where, direction = 0(aoa), 1(zoa).
-      // TODO should I include the "alfa" term for the Doppler of delayed paths?
-      double temp_doppler = 2 * M_PI * ((sin (params->m_angle[MatrixBasedChannelModel::ZOA_INDEX][cIndex] * M_PI / 180) * cos (params->m_angle[MatrixBasedChannelModel::AOA_INDEX][cIndex] * M_PI / 180) * uSpeed.x
-                                         + sin (params->m_angle[MatrixBasedChannelModel::ZOA_INDEX][cIndex] * M_PI / 180) * sin (params->m_angle[MatrixBasedChannelModel::AOA_INDEX][cIndex] * M_PI / 180) * uSpeed.y
-                                         + cos (params->m_angle[MatrixBasedChannelModel::ZOA_INDEX][cIndex] * M_PI / 180) * uSpeed.z)
-                                         + (sin (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * cos (params->m_angle[MatrixBasedChannelModel::AOD_INDEX][cIndex] * M_PI / 180) * sSpeed.x
-                                         + sin (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * sin (params->m_angle[MatrixBasedChannelModel::AOD_INDEX][cIndex] * M_PI / 180) * sSpeed.y
-                                         + cos (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * sSpeed.z))
-        * slotTime * GetFrequency () / 3e8;
-      doppler.push_back (exp (std::complex<double> (0, temp_doppler)));
+      double temp_doppler = longTerm->m_dopplerRate[cIndex] * slotTime * frequency / 3e8;
+      clusterGain[cIndex] = longTerm->m_longTerm[cIndex] * exp (std::complex<double> (0, temp_doppler));
     }
 
-  // apply the doppler term and the propagation delay to the long term component
-  // to obtain the beamforming gain
-  auto vit = tempPsd->ValuesBegin (); // psd iterator
-  auto sbit = tempPsd->ConstBandsBegin(); // band iterator
-  while (vit != tempPsd->ValuesEnd ())
+  // apply the propagation delay to obtain the beamforming gain
+  size_t numBands = tempPsd->GetSpectrumModel ()->GetNumBands ();
+  if (numBands == 0)
     {
-      std::complex<double> subsbandGain (0.0,0.0);
-      if ((*vit) != 0.00)
+      // there are no values to scale, nor a first value to point the kernels to
+      return tempPsd;
+    }
+  if (cacheDelayPhasors && numBands * numCluster <= m_maxDelayPhasors)
+    {
+      if (longTerm->m_delayPhasorsUid != tempPsd->GetSpectrumModelUid ()
+          || longTerm->m_delayPhasors.size () != numBands * numCluster)
         {
-          double fsb = (*sbit).fc; // center frequency of the sub-band
-          for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
-            {
-              double delay = -2 * M_PI * fsb * (params->m_delay[cIndex]);
-              subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] * exp (std::complex<double> (0, delay));
-            }
-          *vit = (*vit) * (norm (subsbandGain));
+          NS_LOG_DEBUG ("compute the delay phasors");
+          longTerm->m_delayPhasors = ThreeGppBeamformingGainKernel::CalcDelayPhasors (params->m_delay, numCluster,
+                                                                                      tempPsd->ConstBandsBegin (),
+                                                                                      tempPsd->ConstBandsEnd ());
+          longTerm->m_delayPhasorsUid = tempPsd->GetSpectrumModelUid ();
         }
-      vit++;
-      sbit++;
+      ThreeGppBeamformingGainKernel::ApplySubbandGain (clusterGain, longTerm->m_delayPhasors,
+                                                       &(*tempPsd->ValuesBegin ()), numBands);
+    }
+  else
+    {
+      ThreeGppBeamformingGainKernel::ApplySubbandGain (clusterGain, params->m_delay,
+                                                       tempPsd->ConstBandsBegin (), tempPsd->ConstBandsEnd (),
+                                                       &(*tempPsd->ValuesBegin ()));
     }
+  // the kernels only scale the non-zero values, the bands outside the
+  // occupied ones of the transmitted PSD are still empty
+  tempPsd->TrimOccupiedBands ();
   return tempPsd;
 }
 
-ThreeGppAntennaArrayModel::ComplexVector
+Ptr<ThreeGppSpectrumPropagationLossModel::LongTerm>
 ThreeGppSpectrumPropagationLossModel::GetLongTerm (uint32_t aId, uint32_t bId,
                                                    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-                                                   const ThreeGppAntennaArrayModel::ComplexVector &aW,
-                                                   const ThreeGppAntennaArrayModel::ComplexVector &bW) const
+                                                   Ptr<const ThreeGppAntennaArrayModel> aAntenna,
+                                                   Ptr<const ThreeGppAntennaArrayModel> bAntenna) const
 {
-  ThreeGppAntennaArrayModel::ComplexVector longTerm; // vector containing the long term component for each cluster
-
   // check if the channel matrix was generated considering a as the s-node and
   // b as the u-node or viceversa
-  ThreeGppAntennaArrayModel::ComplexVector sW, uW;
+  Ptr<const ThreeGppAntennaArrayModel> sAntenna, uAntenna;
   if (!channelMatrix->IsReverse (aId, bId))
   {
-    sW = aW;
-    uW = bW;
+    sAntenna = aAntenna;
+    uAntenna = bAntenna;
   }
   else
   {
-    sW = bW;
-    uW = aW;
+    sAntenna = bAntenna;
+    uAntenna = aAntenna;
   }
+  uint64_t sVersion = sAntenna->GetBeamformingVectorVersion ();
+  uint64_t uVersion = uAntenna->GetBeamformingVectorVersion ();
 
   // compute the long term key, the key is unique for each tx-rx pair
   uint32_t x1 = std::min (aId, bId);
@@ -229,45 +292,104 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm (uint32_t aId, uint32_t bId,
   uint32_t longTermId = MatrixBasedChannelModel::GetKey (x1, x2);
 
   bool update = false; // indicates whether the long term has to be updated
-  bool notFound = false; // indicates if the long term has not been computed yet
+  Ptr<LongTerm> longTermItem;
 
   // look for the long term in the map and check if it is valid
-  if (m_longTermMap.find (longTermId) != m_longTermMap.end ())
+  auto it = m_longTermMap.find (longTermId);
+  if (it != m_longTermMap.end ())
   {
     NS_LOG_DEBUG ("found the long term component in the map");
-    longTerm = m_longTermMap[longTermId]->m_longTerm;
+    longTermItem = it->second;
 
     // check if the channel matrix has been updated
+    if (longTermItem->m_channel->m_generatedTime != channelMatrix->m_generatedTime)
+      {
+        // reset the terms that depend on the channel matrix
+        longTermItem->m_uDirection.clear ();
+        longTermItem->m_sDirection.clear ();
+        longTermItem->m_dopplerRate.clear ();
+        longTermItem->m_delayPhasors.clear ();
+        update = true;
+      }
+
     // or the s beam has been changed
     // or the u beam has been changed
-    update = (m_longTermMap[longTermId]->m_channel->m_generatedTime != channelMatrix->m_generatedTime
-              || m_longTermMap[longTermId]->m_sW != sW
-              || m_longTermMap[longTermId]->m_uW != uW);
+    update = (update || longTermItem->m_sVersion != sVersion || longTermItem->m_uVersion != uVersion);
 
+    // mark the entry as the most recently used
+    m_longTermLru.splice (m_longTermLru.begin (), m_longTermLru, longTermItem->m_lruPosition);
   }
   else
   {
     NS_LOG_DEBUG ("long term component NOT found");
-    notFound = true;
+    longTermItem = Create<LongTerm> ();
+    m_longTermMap.emplace (longTermId, longTermItem);
+    m_longTermLru.push_front (longTermId);
+    longTermItem->m_lruPosition = m_longTermLru.begin ();
+    update = true;
   }
+  longTermItem->m_lastAccess = Simulator::Now ();
 
-  if (update || notFound)
+  if (!update)
+    {
+      m_longTermCacheHits++;
+    }
+  else
     {
+      m_longTermCacheMisses++;
       NS_LOG_DEBUG ("compute the long term");
-      // compute the long term component
-      longTerm = CalcLongTerm (channelMatrix, sW, uW);
-
-      // store the long term
-      Ptr<LongTerm> longTermItem = Create<LongTerm> ();
-      longTermItem->m_longTerm = longTerm;
+      // compute and store the long term component
+      longTermItem->m_longTerm = CalcLongTerm (channelMatrix, sAntenna->GetBeamformingVector (),
+                                               uAntenna->GetBeamformingVector ());
       longTermItem->m_channel = channelMatrix;
-      longTermItem->m_sW = sW;
-      longTermItem->m_uW = uW;
+      longTermItem->m_sVersion = sVersion;
+      longTermItem->m_uVersion = uVersion;
+    }
 
-      m_longTermMap[longTermId] = longTermItem;
+  return longTermItem;
+}
+
+void
+ThreeGppSpectrumPropagationLossModel::UpdateLongTermCache (Ptr<LongTerm> longTerm) const
+{
+  // the entry may have grown, e.g., when the delay phasors are computed
+  size_t memory = GetLongTermMemory (longTerm);
+  m_longTermCacheMemory = m_longTermCacheMemory - longTerm->m_memory + memory;
+  longTerm->m_memory = memory;
+
+  // evict the least recently used entries, the entry in use is at the front
+  // of the list and it is never evicted
+  Time now = Simulator::Now ();
+  while (m_longTermLru.size () > 1)
+    {
+      auto it = m_longTermMap.find (m_longTermLru.back ());
+      NS_ASSERT (it != m_longTermMap.end ());
+      bool overBudget = m_longTermCacheMaxMemory > 0 && m_longTermCacheMemory > m_longTermCacheMaxMemory;
+      bool expired = m_longTermCacheTimeout.IsStrictlyPositive ()
+        && now - it->second->m_lastAccess > m_longTermCacheTimeout;
+      if (!overBudget && !expired)
+        {
+          break;
+        }
+      NS_LOG_DEBUG ("evict the long term component " << it->first);
+      m_longTermCacheMemory -= it->second->m_memory;
+      m_longTermMap.erase (it);
+      m_longTermLru.pop_back ();
+      m_longTermCacheEvictions++;
     }
+}
 
-  return longTerm;
+size_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermMemory (Ptr<const LongTerm> longTerm)
+{
+  // account for the entry, the nodes of the map and of the list, and the
+  // content of the vectors
+  size_t memory = sizeof (LongTerm) + sizeof (std::pair<const uint32_t, Ptr<LongTerm> >) + 2 * sizeof (void *)
+    + sizeof (uint32_t) + 2 * sizeof (void *);
+  memory += (longTerm->m_longTerm.capacity () + longTerm->m_delayPhasors.capacity ()) * sizeof (std::complex<double>);
+  memory += (longTerm->m_uDirection.capacity () + longTerm->m_sDirection.capacity ()) * sizeof (Vector);
+  memory += longTerm->m_dopplerRate.capacity () * sizeof (double);
+  return memory;
 }
 
 Ptr<SpectrumValue>
@@ -302,18 +424,55 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<const Sp
 
   Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix = m_channelModel->GetChannel (a, b, aAntenna, bAntenna);
 
-  // get the precoding and combining vectors
-  ThreeGppAntennaArrayModel::ComplexVector aW = aAntenna->GetBeamformingVector ();
-  ThreeGppAntennaArrayModel::ComplexVector bW = bAntenna->GetBeamformingVector ();
-
   // retrieve the long term component
-  ThreeGppAntennaArrayModel::ComplexVector longTerm = GetLongTerm (aId, bId, channelMatrix, aW, bW);
+  Ptr<LongTerm> longTerm = GetLongTerm (aId, bId, channelMatrix, aAntenna, bAntenna);
 
   // apply the beamforming gain
   rxPsd = CalcBeamformingGain (rxPsd, longTerm, channelMatrix, a->GetVelocity (), b->GetVelocity ());
 
+  // account for the memory of the entry and enforce the limits of the cache
+  UpdateLongTermCache (longTerm);
+
   return rxPsd;
 }
 
+Ptr<SpectrumValue>
+ThreeGppSpectrumPropagationLossModel::CalcRxPowerSpectralDensityForBeams (Ptr<const SpectrumValue> txPsd,
+                                                                          Ptr<const MobilityModel> a,
+                                                                          Ptr<const MobilityModel> b,
+                                                                          const ThreeGppAntennaArrayModel::ComplexVector &aW,
+                                                                          const ThreeGppAntennaArrayModel::ComplexVector &bW) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t aId = a->GetObject<Node> ()->GetId (); // id of the node a
+  uint32_t bId = b->GetObject<Node> ()->GetId (); // id of the node b
+
+  NS_ASSERT (aId != bId);
+  NS_ASSERT_MSG (a->GetDistanceFrom (b) > 0.0, "The position of a and b devices cannot be the same");
+
+  NS_ASSERT_MSG (m_deviceAntennaMap.find (aId) != m_deviceAntennaMap.end (), "Antenna not found for node " << aId);
+  Ptr<const ThreeGppAntennaArrayModel> aAntenna = m_deviceAntennaMap.at (aId);
+  NS_ASSERT_MSG (m_deviceAntennaMap.find (bId) != m_deviceAntennaMap.end (), "Antenna not found for device " << bId);
+  Ptr<const ThreeGppAntennaArrayModel> bAntenna = m_deviceAntennaMap.at (bId);
+
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix = m_channelModel->GetChannel (a, b, aAntenna, bAntenna);
+
+  // compute the long term component in a temporary entry, which does not
+  // replace the one computed for the beamforming vectors of the antennas
+  Ptr<LongTerm> longTerm = Create<LongTerm> ();
+  if (!channelMatrix->IsReverse (aId, bId))
+    {
+      longTerm->m_longTerm = CalcLongTerm (channelMatrix, aW, bW);
+    }
+  else
+    {
+      longTerm->m_longTerm = CalcLongTerm (channelMatrix, bW, aW);
+    }
+  longTerm->m_channel = channelMatrix;
+
+  // CalcBeamformingGain does not modify the tx PSD, it returns a copy
+  return CalcBeamformingGain (ConstCast<SpectrumValue> (txPsd), longTerm, channelMatrix, a->GetVelocity (), b->GetVelocity (), false);
+}
+
 
 }  // namespace ns3
@@ -24,9 +24,12 @@
 
 #include "ns3/spectrum-propagation-loss-model.h"
 #include <complex.h>
+#include <list>
 #include <map>
 #include <unordered_map>
 #include "ns3/matrix-based-channel-model.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-value.h"
 
 namespace ns3 {
 
@@ -118,6 +121,11 @@ public:
    * To reduce the computational load, the long term component associated with
    * a certain channel is cached and recomputed only when the channel realization
    * is updated, or when the beamforming vectors change.
+   * The cache is bounded: the least recently used entries are evicted when
+   * the memory they occupy exceeds the LongTermCacheMaxMemory attribute, or
+   * when they have not been used for longer than the LongTermCacheTimeout
+   * attribute. The number of hits, misses and evictions can be monitored
+   * through the corresponding trace sources.
    *
    * \param txPsd tx PSD
    * \param a first node mobility model
@@ -129,6 +137,28 @@ public:
                                                            Ptr<const MobilityModel> a,
                                                            Ptr<const MobilityModel> b) const override;
 
+  /**
+   * \brief Computes the received PSD for given beamforming vectors.
+   *
+   * As DoCalcRxPowerSpectralDensity, but the beamforming vectors of the two
+   * devices are passed as arguments instead of being read from their
+   * antennas. This allows to evaluate the gain of candidate beams without
+   * reconfiguring the antennas. The long term component is not cached.
+   *
+   * \param txPsd tx PSD
+   * \param a first node mobility model
+   * \param b second node mobility model
+   * \param aW the beamforming vector of the first node
+   * \param bW the beamforming vector of the second node
+   *
+   * \return the received PSD
+   */
+  Ptr<SpectrumValue> CalcRxPowerSpectralDensityForBeams (Ptr<const SpectrumValue> txPsd,
+                                                         Ptr<const MobilityModel> a,
+                                                         Ptr<const MobilityModel> b,
+                                                         const ThreeGppAntennaArrayModel::ComplexVector &aW,
+                                                         const ThreeGppAntennaArrayModel::ComplexVector &bW) const;
+
 private:
   /**
    * Data structure that stores the long term component for a tx-rx pair
@@ -137,8 +167,22 @@ private:
   {
     ThreeGppAntennaArrayModel::ComplexVector m_longTerm; //!< vector containing the long term component for each cluster
     Ptr<const MatrixBasedChannelModel::ChannelMatrix> m_channel; //!< pointer to the channel matrix used to compute the long term
-    ThreeGppAntennaArrayModel::ComplexVector m_sW; //!< the beamforming vector for the node s used to compute the long term
-    ThreeGppAntennaArrayModel::ComplexVector m_uW; //!< the beamforming vector for the node u used to compute the long term
+    uint64_t m_sVersion; //!< the version of the beamforming vector of the node s used to compute the long term
+    uint64_t m_uVersion; //!< the version of the beamforming vector of the node u used to compute the long term
+
+    // The following terms only depend on m_channel, they are computed when
+    // needed and reset when the channel matrix is updated
+    std::vector<Vector> m_uDirection; //!< the direction cosines of the arrival angles of each cluster
+    std::vector<Vector> m_sDirection; //!< the direction cosines of the departure angles of each cluster
+    Vector m_sSpeed; //!< the speed of the s node used to compute m_dopplerRate
+    Vector m_uSpeed; //!< the speed of the u node used to compute m_dopplerRate
+    MatrixBasedChannelModel::DoubleVector m_dopplerRate; //!< the Doppler phase of each cluster, to be multiplied by time and frequency
+    SpectrumModelUid_t m_delayPhasorsUid {0}; //!< the uid of the SpectrumModel used to compute m_delayPhasors
+    ThreeGppAntennaArrayModel::ComplexVector m_delayPhasors; //!< the delay phasors of each subband and cluster
+
+    std::list<uint32_t>::iterator m_lruPosition; //!< the position of the entry in m_longTermLru
+    Time m_lastAccess; //!< the last time the entry was used
+    size_t m_memory {0}; //!< the memory occupied by the entry, in bytes, as accounted in m_longTermCacheMemory
   };
 
   /**
@@ -153,15 +197,33 @@ private:
    * calls the method CalcLongTerm to compute it.
    * \param aId id of the first node
    * \param bId id of the second node
+   * The beamforming vectors are compared through their versions, see
+   * ThreeGppAntennaArrayModel::GetBeamformingVectorVersion.
    * \param channelMatrix the channel matrix
-   * \param aW the beamforming vector of the first device
-   * \param bW the beamforming vector of the second device
-   * \return vector containing the long term compoenent for each cluster
+   * \param aAntenna the antenna array of the first device
+   * \param bAntenna the antenna array of the second device
+   * \return the cache entry containing the long term compoenent for each cluster
+   */
+  Ptr<LongTerm> GetLongTerm (uint32_t aId, uint32_t bId,
+                             Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                             Ptr<const ThreeGppAntennaArrayModel> aAntenna,
+                             Ptr<const ThreeGppAntennaArrayModel> bAntenna) const;
+  /**
+   * Updates the memory occupied by a long term entry after its use and
+   * evicts the least recently used entries which exceed the memory budget or
+   * the timeout. The entry passed as argument is never evicted.
+   * \param longTerm the long term entry which has just been used
    */
-  ThreeGppAntennaArrayModel::ComplexVector GetLongTerm (uint32_t aId, uint32_t bId,
-                                                        Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-                                                        const ThreeGppAntennaArrayModel::ComplexVector &aW,
-                                                        const ThreeGppAntennaArrayModel::ComplexVector &bW) const;
+  void UpdateLongTermCache (Ptr<LongTerm> longTerm) const;
+
+  /**
+   * Estimates the memory occupied by a long term entry, including the
+   * overhead of the containers of the cache
+   * \param longTerm the long term entry
+   * \return the memory in bytes
+   */
+  static size_t GetLongTermMemory (Ptr<const LongTerm> longTerm);
+
   /**
    * Computes the long term component
    * \param channelMatrix the channel matrix H
@@ -174,22 +236,36 @@ private:
                                                          const ThreeGppAntennaArrayModel::ComplexVector &uW) const;
 
   /**
-   * Computes the beamforming gain and applies it to the tx PSD
+   * Computes the beamforming gain and applies it to the tx PSD.
+   * The direction cosines of the cluster angles, the Doppler rates and the
+   * delay phasors are stored in the long term entry and reused as long as
+   * the channel matrix, the speeds and the SpectrumModel do not change.
    * \param txPsd the tx PSD
-   * \param longTerm the long term component
+   * \param longTerm the long term entry
    * \param params The channel matrix
    * \param sSpeed speed of the first node
    * \param uSpeed speed of the second node
+   * \param cacheDelayPhasors if false, the delay phasors are computed on the
+   *        fly and they are not stored in the long term entry
    * \return the rx PSD
    */
   Ptr<SpectrumValue> CalcBeamformingGain (Ptr<SpectrumValue> txPsd,
-                                          ThreeGppAntennaArrayModel::ComplexVector longTerm,
+                                          Ptr<LongTerm> longTerm,
                                           Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
-                                          const Vector &sSpeed, const Vector &uSpeed) const;
+                                          const Vector &sSpeed, const Vector &uSpeed,
+                                          bool cacheDelayPhasors = true) const;
 
   std::unordered_map <uint32_t, Ptr<const ThreeGppAntennaArrayModel> > m_deviceAntennaMap; //!< map containig the <node, antenna> associations
-  mutable std::unordered_map < uint32_t, Ptr<const LongTerm> > m_longTermMap; //!< map containing the long term components
+  mutable std::unordered_map < uint32_t, Ptr<LongTerm> > m_longTermMap; //!< map containing the long term components
+  mutable std::list<uint32_t> m_longTermLru; //!< keys of the long term entries, from the most to the least recently used
+  mutable uint64_t m_longTermCacheMemory {0}; //!< the memory occupied by the long term entries, in bytes
+  uint64_t m_longTermCacheMaxMemory; //!< the maximum memory occupied by the long term entries, in bytes (0 for no limit)
+  Time m_longTermCacheTimeout; //!< the time after which an unused long term entry is evicted (0 to disable)
+  mutable TracedValue<uint64_t> m_longTermCacheHits; //!< number of long term lookups served by the cache
+  mutable TracedValue<uint64_t> m_longTermCacheMisses; //!< number of long term lookups which required the computation of the long term
+  mutable TracedValue<uint64_t> m_longTermCacheEvictions; //!< number of long term entries evicted from the cache
   Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
+  uint32_t m_maxDelayPhasors; //!< the maximum number of delay phasors stored for each long term entry
 };
 } // namespace ns3
 
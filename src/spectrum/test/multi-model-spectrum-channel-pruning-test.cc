@@ -0,0 +1,322 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/boolean.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/net-device.h>
+#include <ns3/antenna-model.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/friis-spectrum-propagation-loss.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/wifi-spectrum-value-helper.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MultiModelSpectrumChannelPruningTest");
+
+/**
+ * \ingroup spectrum
+ *
+ * SpectrumPhy which counts the received signals
+ */
+class PruningTestSpectrumPhy : public SpectrumPhy
+{
+public:
+  /**
+   * Constructor
+   * \param rxSpectrumModel the rx SpectrumModel
+   */
+  PruningTestSpectrumPhy (Ptr<const SpectrumModel> rxSpectrumModel);
+
+  // inherited from SpectrumPhy
+  void SetDevice (Ptr<NetDevice> d) override;
+  Ptr<NetDevice> GetDevice () const override;
+  void SetMobility (Ptr<MobilityModel> m) override;
+  Ptr<MobilityModel> GetMobility () override;
+  void SetChannel (Ptr<SpectrumChannel> c) override;
+  Ptr<const SpectrumModel> GetRxSpectrumModel () const override;
+  Ptr<AntennaModel> GetRxAntenna () override;
+  void StartRx (Ptr<SpectrumSignalParameters> params) override;
+
+  uint32_t m_numRx {0}; //!< number of received signals
+  double m_lastRxPower {0}; //!< total power of the last received signal
+
+private:
+  Ptr<MobilityModel> m_mobility; //!< the mobility model
+  Ptr<const SpectrumModel> m_rxSpectrumModel; //!< the rx SpectrumModel
+};
+
+PruningTestSpectrumPhy::PruningTestSpectrumPhy (Ptr<const SpectrumModel> rxSpectrumModel)
+  : m_rxSpectrumModel (rxSpectrumModel)
+{
+}
+
+void
+PruningTestSpectrumPhy::SetDevice (Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+PruningTestSpectrumPhy::GetDevice () const
+{
+  return 0;
+}
+
+void
+PruningTestSpectrumPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+PruningTestSpectrumPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+void
+PruningTestSpectrumPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+PruningTestSpectrumPhy::GetRxSpectrumModel () const
+{
+  return m_rxSpectrumModel;
+}
+
+Ptr<AntennaModel>
+PruningTestSpectrumPhy::GetRxAntenna ()
+{
+  return 0;
+}
+
+void
+PruningTestSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  m_numRx++;
+  m_lastRxPower = Sum (*params->psd);
+}
+
+/**
+ * \ingroup spectrum
+ *
+ * Test case for the pruning of the receivers in MultiModelSpectrumChannel.
+ * 1) without pruning, all the receivers receive the signal
+ * 2) with PruningDistance, only the receivers within the distance receive
+ *    the signal, with the same power obtained without pruning
+ * 3) the index is updated when a static receiver changes position, and the
+ *    moving receivers are always considered
+ * 4) with FreeSpacePruning, the receivers at which the free space loss
+ *    exceeds MaxLossDb are pruned
+ * 5) a PSD without bands is not pruned
+ * In all the cases, the receivers are visited in the order in which they
+ * were added to the channel.
+ */
+class MultiModelSpectrumChannelPruningTestCase : public TestCase
+{
+public:
+  MultiModelSpectrumChannelPruningTestCase ();
+  virtual ~MultiModelSpectrumChannelPruningTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Transmit a signal from m_txPhy, run the simulation and check the number
+   * of signals received by each receiver, and the order of the path loss
+   * computations
+   * \param expectedRx the expected number of received signals of each receiver
+   * \param expectedPathLoss the expected number of path loss computations
+   * \param msg the message printed if the check fails
+   */
+  void CheckTx (std::vector<uint32_t> expectedRx, uint32_t expectedPathLoss, std::string msg);
+
+  /**
+   * Callback of the PathLoss trace of the channel
+   * \param txPhy the transmitter
+   * \param rxPhy the receiver
+   * \param lossDb the path loss in dB
+   */
+  void PathLoss (Ptr<const SpectrumPhy> txPhy, Ptr<const SpectrumPhy> rxPhy, double lossDb);
+
+  uint32_t m_numPathLoss {0}; //!< number of path loss computations
+  std::vector<Ptr<const SpectrumPhy> > m_pathLossRxPhys; //!< receivers of the path loss computations, in order
+
+  Ptr<MultiModelSpectrumChannel> m_channel; //!< the channel
+  Ptr<PruningTestSpectrumPhy> m_txPhy; //!< the transmitter
+  std::vector<Ptr<PruningTestSpectrumPhy> > m_rxPhys; //!< the receivers
+  Ptr<SpectrumValue> m_txPsd; //!< the tx PSD
+};
+
+MultiModelSpectrumChannelPruningTestCase::MultiModelSpectrumChannelPruningTestCase ()
+  : TestCase ("Check the pruning of the receivers in MultiModelSpectrumChannel")
+{
+}
+
+MultiModelSpectrumChannelPruningTestCase::~MultiModelSpectrumChannelPruningTestCase ()
+{
+}
+
+void
+MultiModelSpectrumChannelPruningTestCase::PathLoss (Ptr<const SpectrumPhy> txPhy, Ptr<const SpectrumPhy> rxPhy, double lossDb)
+{
+  m_numPathLoss++;
+  m_pathLossRxPhys.push_back (rxPhy);
+}
+
+void
+MultiModelSpectrumChannelPruningTestCase::CheckTx (std::vector<uint32_t> expectedRx, uint32_t expectedPathLoss, std::string msg)
+{
+  for (auto &phy : m_rxPhys)
+    {
+      phy->m_numRx = 0;
+    }
+  m_numPathLoss = 0;
+  m_pathLossRxPhys.clear ();
+
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->psd = m_txPsd;
+  params->txPhy = m_txPhy;
+  params->duration = MilliSeconds (1);
+  m_channel->StartTx (params);
+  Simulator::Run ();
+
+  for (uint32_t i = 0; i < m_rxPhys.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_rxPhys[i]->m_numRx, expectedRx[i], msg << " (receiver " << i << ")");
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_numPathLoss, expectedPathLoss, msg << " (path loss computations)");
+
+  std::vector<Ptr<const SpectrumPhy> > expectedRxPhys;
+  for (uint32_t i = 0; i < m_rxPhys.size (); i++)
+    {
+      if (expectedRx[i] > 0)
+        {
+          expectedRxPhys.push_back (m_rxPhys[i]);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ ((m_pathLossRxPhys == expectedRxPhys), true, msg << " (order of the receivers)");
+}
+
+void
+MultiModelSpectrumChannelPruningTestCase::DoRun ()
+{
+  WifiSpectrumValue5MhzFactory sf;
+  m_txPsd = sf.CreateTxPowerSpectralDensity (0.1, 1);
+
+  m_channel = CreateObject<MultiModelSpectrumChannel> ();
+  m_channel->SetAttribute ("PruningGridCellSize", DoubleValue (100.0));
+  m_channel->AddPropagationLossModel (CreateObjectWithAttributes<FriisPropagationLossModel> ("Frequency", DoubleValue (2.412e9)));
+  m_channel->TraceConnectWithoutContext ("PathLoss", MakeCallback (&MultiModelSpectrumChannelPruningTestCase::PathLoss, this));
+
+  m_txPhy = CreateObject<PruningTestSpectrumPhy> (m_txPsd->GetSpectrumModel ());
+  Ptr<MobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+  txMobility->SetPosition (Vector (0.0, 0.0, 10.0));
+  m_txPhy->SetMobility (txMobility);
+  m_channel->AddRx (m_txPhy);
+
+  // two static receivers at 50 m and 500 m, and a receiver at 1000 m
+  // moving towards the transmitter at 500 m/s
+  std::vector<Ptr<MobilityModel> > rxMobility;
+  rxMobility.push_back (CreateObject<ConstantPositionMobilityModel> ());
+  rxMobility.push_back (CreateObject<ConstantPositionMobilityModel> ());
+  rxMobility.push_back (CreateObject<ConstantVelocityMobilityModel> ());
+  rxMobility[0]->SetPosition (Vector (50.0, 0.0, 10.0));
+  rxMobility[1]->SetPosition (Vector (0.0, -500.0, 10.0));
+  rxMobility[2]->SetPosition (Vector (1000.0, 0.0, 10.0));
+  DynamicCast<ConstantVelocityMobilityModel> (rxMobility[2])->SetVelocity (Vector (-500.0, 0.0, 0.0));
+  for (auto &mobility : rxMobility)
+    {
+      Ptr<PruningTestSpectrumPhy> phy = CreateObject<PruningTestSpectrumPhy> (m_txPsd->GetSpectrumModel ());
+      phy->SetMobility (mobility);
+      m_channel->AddRx (phy);
+      m_rxPhys.push_back (phy);
+    }
+
+  // 1) without pruning all the receivers receive the signal
+  CheckTx ({1, 1, 1}, 3, "Without pruning all the receivers should receive the signal");
+  double rxPower = m_rxPhys[0]->m_lastRxPower;
+
+  // 2) only the first receiver is within the pruning distance (the third one
+  // is now at 500 m)
+  m_channel->SetAttribute ("PruningDistance", DoubleValue (200.0));
+  CheckTx ({1, 0, 0}, 1, "Only the receivers within the pruning distance should receive the signal");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_rxPhys[0]->m_lastRxPower, rxPower, rxPower * 1e-12, "The pruning changed the received power");
+
+  // 3) move the second receiver within the pruning distance, while the
+  // third receiver gets within it after the simulation time advances
+  rxMobility[1]->SetPosition (Vector (0.0, -150.0, 10.0));
+  Simulator::Schedule (MilliSeconds (1700), &MultiModelSpectrumChannelPruningTestCase::CheckTx, this,
+                       std::vector<uint32_t> {1, 1, 1}, 3, std::string ("The index of the receivers was not updated"));
+  Simulator::Run ();
+
+  // 4) the free space loss at 2.4 GHz is about 80 dB at 100 m, hence with
+  // MaxLossDb equal to 80 dB and no antenna gain, the receivers at 150 m are
+  // pruned without computing the path loss
+  m_channel->SetAttribute ("PruningDistance", DoubleValue (0.0));
+  m_channel->SetAttribute ("FreeSpacePruning", BooleanValue (true));
+  m_channel->SetAttribute ("PruningMaxAntennaGainDb", DoubleValue (0.0));
+  m_channel->SetAttribute ("MaxLossDb", DoubleValue (80.0));
+  CheckTx ({1, 0, 0}, 1, "The receivers beyond the free space range should be pruned");
+
+  // 5) a PSD without bands has no lowest frequency and is not pruned, even
+  // by PruningDistance: a receiver with the same SpectrumModel at 1000 m
+  // receives the signal
+  m_channel->SetAttribute ("PruningDistance", DoubleValue (200.0));
+  m_channel->SetAttribute ("MaxLossDb", DoubleValue (200.0));
+  m_txPsd = Create<SpectrumValue> (Create<SpectrumModel> (Bands ()));
+  Ptr<PruningTestSpectrumPhy> emptyPhy = CreateObject<PruningTestSpectrumPhy> (m_txPsd->GetSpectrumModel ());
+  Ptr<MobilityModel> emptyMobility = CreateObject<ConstantPositionMobilityModel> ();
+  emptyMobility->SetPosition (Vector (0.0, 1000.0, 10.0));
+  emptyPhy->SetMobility (emptyMobility);
+  m_channel->AddRx (emptyPhy);
+  m_rxPhys.push_back (emptyPhy);
+  CheckTx ({0, 0, 0, 1}, 1, "A PSD without bands should not be pruned");
+
+  Simulator::Destroy ();
+  m_channel->Dispose ();
+}
+
+/**
+ * \ingroup spectrum
+ *
+ * Test suite for the pruning of the receivers in MultiModelSpectrumChannel
+ */
+class MultiModelSpectrumChannelPruningTestSuite : public TestSuite
+{
+public:
+  MultiModelSpectrumChannelPruningTestSuite ();
+};
+
+MultiModelSpectrumChannelPruningTestSuite::MultiModelSpectrumChannelPruningTestSuite ()
+  : TestSuite ("multi-model-spectrum-channel-pruning", UNIT)
+{
+  NS_LOG_INFO ("creating MultiModelSpectrumChannelPruningTestSuite");
+  AddTestCase (new MultiModelSpectrumChannelPruningTestCase, TestCase::QUICK);
+}
+
+static MultiModelSpectrumChannelPruningTestSuite g_multiModelSpectrumChannelPruningTestSuite;
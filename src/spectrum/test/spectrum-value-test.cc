@@ -25,6 +25,7 @@
 #include <ns3/test.h>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 #include "spectrum-test.h"
 
@@ -82,6 +83,99 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+/**
+ * Check that the occupied bands are tracked by the operations, and that
+ * the operations restricted to them give the same values as on all the
+ * bands.
+ */
+class SpectrumValueOccupiedBandsTestCase : public TestCase
+{
+public:
+  SpectrumValueOccupiedBandsTestCase ();
+  virtual ~SpectrumValueOccupiedBandsTestCase ();
+  virtual void DoRun (void);
+};
+
+SpectrumValueOccupiedBandsTestCase::SpectrumValueOccupiedBandsTestCase ()
+  : TestCase ("occupied bands")
+{
+}
+
+SpectrumValueOccupiedBandsTestCase::~SpectrumValueOccupiedBandsTestCase ()
+{
+}
+
+void
+SpectrumValueOccupiedBandsTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (int i = 1; i <= 20; i++)
+    {
+      freqs.push_back (i);
+    }
+  Ptr<SpectrumModel> f = Create<SpectrumModel> (freqs);
+
+  SpectrumValue signal (f), other (f), noise (f);
+  NS_TEST_ASSERT_MSG_EQ (signal.GetOccupiedBegin (), signal.GetOccupiedEnd (), "a new value should be empty");
+  for (int i = 4; i < 9; i++)
+    {
+      signal[i] = 0.1 * i;
+    }
+  for (int i = 7; i < 15; i++)
+    {
+      other[i] = 0.05 * i;
+    }
+  noise = 0.01;
+  NS_TEST_ASSERT_MSG_EQ (signal.GetOccupiedBegin (), 4, "wrong first occupied band");
+  NS_TEST_ASSERT_MSG_EQ (signal.GetOccupiedEnd (), 9, "wrong end of the occupied bands");
+  NS_TEST_ASSERT_MSG_EQ (noise.GetOccupiedEnd (), 20, "a flat value should occupy all the bands");
+
+  SpectrumValue allSignals = signal + other;
+  NS_TEST_ASSERT_MSG_EQ (allSignals.GetOccupiedBegin (), 4, "wrong first occupied band of the sum");
+  NS_TEST_ASSERT_MSG_EQ (allSignals.GetOccupiedEnd (), 15, "wrong end of the occupied bands of the sum");
+  SpectrumValue product = signal * other;
+  NS_TEST_ASSERT_MSG_EQ (product.GetOccupiedBegin (), 7, "wrong first occupied band of the product");
+  NS_TEST_ASSERT_MSG_EQ (product.GetOccupiedEnd (), 9, "wrong end of the occupied bands of the product");
+
+  // compare with the same operations on values which occupy all the bands
+  SpectrumValue fullSignal (f), fullOther (f), fullNoise (f);
+  std::copy (signal.ConstValuesBegin (), signal.ConstValuesEnd (), fullSignal.ValuesBegin ());
+  std::copy (other.ConstValuesBegin (), other.ConstValuesEnd (), fullOther.ValuesBegin ());
+  std::copy (noise.ConstValuesBegin (), noise.ConstValuesEnd (), fullNoise.ValuesBegin ());
+  NS_TEST_ASSERT_MSG_EQ (fullSignal.GetOccupiedEnd () - fullSignal.GetOccupiedBegin (), 20, "the iterators should occupy all the bands");
+  SpectrumValue fullSum = fullSignal + fullOther;
+  NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL (allSignals, fullSum, TOLERANCE, "wrong sum");
+  SpectrumValue fullProduct = fullSignal * fullOther;
+  NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL (product, fullProduct, TOLERANCE, "wrong product");
+  SpectrumValue ratio = signal / noise;
+  SpectrumValue fullRatio = fullSignal / fullNoise;
+  NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL (ratio, fullRatio, TOLERANCE, "wrong ratio");
+  NS_TEST_ASSERT_MSG_EQ_TOL (Sum (signal), Sum (fullSignal), TOLERANCE, "wrong sum of the values");
+  NS_TEST_ASSERT_MSG_EQ_TOL (Norm (other), Norm (fullOther), TOLERANCE, "wrong norm");
+
+  SpectrumValue sinr = Sinr (signal, allSignals, noise);
+  SpectrumValue fullSinr = fullSignal / (fullSignal + fullOther - fullSignal + fullNoise);
+  NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL (sinr, fullSinr, TOLERANCE, "wrong SINR");
+  NS_TEST_ASSERT_MSG_EQ (sinr.GetOccupiedBegin (), 4, "wrong first occupied band of the SINR");
+  NS_TEST_ASSERT_MSG_EQ (sinr.GetOccupiedEnd (), 9, "wrong end of the occupied bands of the SINR");
+
+  fullSignal.TrimOccupiedBands ();
+  NS_TEST_ASSERT_MSG_EQ (fullSignal.GetOccupiedBegin (), 4, "wrong first occupied band after the trim");
+  NS_TEST_ASSERT_MSG_EQ (fullSignal.GetOccupiedEnd (), 9, "wrong end of the occupied bands after the trim");
+
+  // the pointer to the values only occupies the range to be written
+  SpectrumValue integral (f);
+  double *values = integral.ValuesData (signal.GetOccupiedBegin (), signal.GetOccupiedEnd ());
+  for (size_t i = signal.GetOccupiedBegin (); i < signal.GetOccupiedEnd (); i++)
+    {
+      values[i] += signal[i];
+    }
+  NS_TEST_ASSERT_MSG_EQ (integral.GetOccupiedBegin (), 4, "wrong first occupied band after the write");
+  NS_TEST_ASSERT_MSG_EQ (integral.GetOccupiedEnd (), 9, "wrong end of the occupied bands after the write");
+  NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL (integral, signal, TOLERANCE, "wrong values after the write");
+}
+
+
 class SpectrumValueTestSuite : public TestSuite
 {
 public:
@@ -241,6 +335,8 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  AddTestCase (new SpectrumValueOccupiedBandsTestCase, TestCase::QUICK);
+
 
 }
 
@@ -33,6 +33,7 @@
 #include "ns3/simulator.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/three-gpp-beamforming-gain-kernel.h"
 #include "ns3/wifi-spectrum-value-helper.h"
 
 using namespace ns3;
@@ -333,6 +334,450 @@ ThreeGppChannelMatrixUpdateTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * Test case for the MatrixBasedChannelModel::Complex3DTensor class.
+ * It checks that the strided views and the conversion to and from
+ * Complex3DVector preserve the [u][s][n] indexing.
+ */
+class Complex3DTensorTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  Complex3DTensorTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~Complex3DTensorTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+};
+
+Complex3DTensorTest::Complex3DTensorTest ()
+  : TestCase ("Check the indexing of the Complex3DTensor class")
+{
+}
+
+Complex3DTensorTest::~Complex3DTensorTest ()
+{
+}
+
+void
+Complex3DTensorTest::DoRun (void)
+{
+  uint16_t uSize = 3;
+  uint16_t sSize = 5;
+  uint16_t nSize = 7;
+
+  MatrixBasedChannelModel::Complex3DVector v (uSize, MatrixBasedChannelModel::Complex2DVector (sSize, ThreeGppAntennaArrayModel::ComplexVector (nSize)));
+  for (uint16_t u = 0; u < uSize; u++)
+    {
+      for (uint16_t s = 0; s < sSize; s++)
+        {
+          for (uint16_t n = 0; n < nSize; n++)
+            {
+              v[u][s][n] = std::complex<double> (u * 100 + s * 10 + n, n);
+            }
+        }
+    }
+
+  MatrixBasedChannelModel::Complex3DTensor t = v;
+  NS_TEST_ASSERT_MSG_EQ (t.size (), uSize, "Wrong first dimension");
+  NS_TEST_ASSERT_MSG_EQ (t.at (0).size (), sSize, "Wrong second dimension");
+  NS_TEST_ASSERT_MSG_EQ (t.at (0).at (0).size (), nSize, "Wrong third dimension");
+
+  for (uint16_t u = 0; u < uSize; u++)
+    {
+      for (uint16_t s = 0; s < sSize; s++)
+        {
+          for (uint16_t n = 0; n < nSize; n++)
+            {
+              NS_TEST_ASSERT_MSG_EQ (t[u][s][n], v[u][s][n], "Wrong element in position " << u << " " << s << " " << n);
+              NS_TEST_ASSERT_MSG_EQ (t (u, s, n), v[u][s][n], "Wrong element in position " << u << " " << s << " " << n);
+              NS_TEST_ASSERT_MSG_EQ (t.GetPage (n)[s * uSize + u], v[u][s][n], "Wrong element in position " << u << " " << s << " " << n);
+            }
+        }
+    }
+
+  // write through the views and convert back
+  t[1][2][3] = std::complex<double> (-1, -1);
+  MatrixBasedChannelModel::Complex3DVector w = t;
+  v[1][2][3] = std::complex<double> (-1, -1);
+  NS_TEST_ASSERT_MSG_EQ ((w == v), true, "The conversion to Complex3DVector should preserve the elements");
+}
+
+/**
+ * Test case for the ThreeGppChannelModel class.
+ * It checks that the channel coefficients computed by
+ * ThreeGppChannelModel::CalcClusterCoefficients match the ones obtained
+ * by evaluating (7.5-22) and (7.5-28) of 3GPP TR 38.901 independently for
+ * each (u, s, n) tuple.
+ */
+class ThreeGppClusterCoefficientsTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppClusterCoefficientsTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppClusterCoefficientsTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Compute the contribution of a ray to the channel coefficient between
+   * the u-th and the s-th antenna elements, as in (7.5-22)
+   * \param sAntenna the s node antenna array
+   * \param uAntenna the u node antenna array
+   * \param uIndex index of the u element
+   * \param sIndex index of the s element
+   * \param aoa ray azimuth angle of arrival in radians
+   * \param zoa ray zenith angle of arrival in radians
+   * \param aod ray azimuth angle of departure in radians
+   * \param zod ray zenith angle of departure in radians
+   * \param initialPhase the initial random phases of the ray
+   * \param k the cross polarization power ratio of the ray
+   * \return the contribution of the ray
+   */
+  std::complex<double> CalcRay (Ptr<const ThreeGppAntennaArrayModel> sAntenna, Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                uint64_t uIndex, uint64_t sIndex, double aoa, double zoa, double aod, double zod,
+                                const MatrixBasedChannelModel::DoubleVector &initialPhase, double k) const;
+};
+
+ThreeGppClusterCoefficientsTest::ThreeGppClusterCoefficientsTest ()
+  : TestCase ("Check the per-ray computation of the channel coefficients")
+{
+}
+
+ThreeGppClusterCoefficientsTest::~ThreeGppClusterCoefficientsTest ()
+{
+}
+
+std::complex<double>
+ThreeGppClusterCoefficientsTest::CalcRay (Ptr<const ThreeGppAntennaArrayModel> sAntenna, Ptr<const ThreeGppAntennaArrayModel> uAntenna,
+                                          uint64_t uIndex, uint64_t sIndex, double aoa, double zoa, double aod, double zod,
+                                          const MatrixBasedChannelModel::DoubleVector &initialPhase, double k) const
+{
+  Vector uLoc = uAntenna->GetElementLocation (uIndex);
+  Vector sLoc = sAntenna->GetElementLocation (sIndex);
+  double rxPhaseDiff = 2 * M_PI * (sin (zoa) * cos (aoa) * uLoc.x + sin (zoa) * sin (aoa) * uLoc.y + cos (zoa) * uLoc.z);
+  double txPhaseDiff = 2 * M_PI * (sin (zod) * cos (aod) * sLoc.x + sin (zod) * sin (aod) * sLoc.y + cos (zod) * sLoc.z);
+
+  double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+  std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (aoa, zoa));
+  std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (aod, zod));
+
+  return (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
+          +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
+          +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
+          +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
+    * exp (std::complex<double> (0, rxPhaseDiff))
+    * exp (std::complex<double> (0, txPhaseDiff));
+}
+
+void
+ThreeGppClusterCoefficientsTest::DoRun (void)
+{
+  uint8_t numClusters = 12;
+  uint8_t raysPerCluster = 20;
+  uint8_t cluster1st = 3;
+  uint8_t cluster2nd = 7;
+
+  // create the antennas, use the directional element pattern so that the
+  // field patterns depend on the ray angles
+  Ptr<ThreeGppAntennaArrayModel> sAntenna = CreateObjectWithAttributes<ThreeGppAntennaArrayModel> ("NumColumns", UintegerValue (4), "NumRows", UintegerValue (2));
+  Ptr<ThreeGppAntennaArrayModel> uAntenna = CreateObjectWithAttributes<ThreeGppAntennaArrayModel> ("NumColumns", UintegerValue (2), "NumRows", UintegerValue (2));
+
+  // draw the ray parameters
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  rv->SetStream (1);
+  MatrixBasedChannelModel::Double2DVector rayAoa (numClusters, MatrixBasedChannelModel::DoubleVector (raysPerCluster));
+  MatrixBasedChannelModel::Double2DVector rayZoa (numClusters, MatrixBasedChannelModel::DoubleVector (raysPerCluster));
+  MatrixBasedChannelModel::Double2DVector rayAod (numClusters, MatrixBasedChannelModel::DoubleVector (raysPerCluster));
+  MatrixBasedChannelModel::Double2DVector rayZod (numClusters, MatrixBasedChannelModel::DoubleVector (raysPerCluster));
+  MatrixBasedChannelModel::Double2DVector xpr (numClusters, MatrixBasedChannelModel::DoubleVector (raysPerCluster));
+  MatrixBasedChannelModel::Double3DVector clusterPhase (numClusters, MatrixBasedChannelModel::Double2DVector (raysPerCluster, MatrixBasedChannelModel::DoubleVector (4)));
+  MatrixBasedChannelModel::DoubleVector clusterPower (numClusters);
+  for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+    {
+      clusterPower[nIndex] = rv->GetValue (0.01, 1);
+      for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+          rayAoa[nIndex][mIndex] = rv->GetValue (0, 2 * M_PI);
+          rayZoa[nIndex][mIndex] = rv->GetValue (0, M_PI);
+          rayAod[nIndex][mIndex] = rv->GetValue (0, 2 * M_PI);
+          rayZod[nIndex][mIndex] = rv->GetValue (0, M_PI);
+          xpr[nIndex][mIndex] = rv->GetValue (1, 100);
+          for (uint8_t pIndex = 0; pIndex < 4; pIndex++)
+            {
+              clusterPhase[nIndex][mIndex][pIndex] = rv->GetValue (-1 * M_PI, M_PI);
+            }
+        }
+    }
+
+  MatrixBasedChannelModel::Complex3DTensor H_usn = ThreeGppChannelModel::CalcClusterCoefficients (sAntenna, uAntenna,
+                                                                                                  rayAoa, rayZoa, rayAod, rayZod,
+                                                                                                  clusterPhase, xpr, clusterPower,
+                                                                                                  cluster1st, cluster2nd);
+
+  NS_TEST_ASSERT_MSG_EQ (H_usn.size (), uAntenna->GetNumberOfElements (), "The first dimension of H should be equal to the number of u antenna elements");
+  NS_TEST_ASSERT_MSG_EQ (H_usn[0].size (), sAntenna->GetNumberOfElements (), "The second dimension of H should be equal to the number of s antenna elements");
+  NS_TEST_ASSERT_MSG_EQ (H_usn[0][0].size (), numClusters + 4u, "The two strongest clusters should be divided into three sub-clusters");
+
+  // NOTE the coefficients are expected to be identical, a small tolerance is
+  // used to account for floating point contractions performed by the compiler
+  double tolerance = 1e-12;
+  for (uint64_t uIndex = 0; uIndex < uAntenna->GetNumberOfElements (); uIndex++)
+    {
+      for (uint64_t sIndex = 0; sIndex < sAntenna->GetNumberOfElements (); sIndex++)
+        {
+          uint8_t subClusterIndex = numClusters;
+          for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+            {
+              std::complex<double> raysSub[3] = {0, 0, 0};
+              for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+                {
+                  std::complex<double> ray = CalcRay (sAntenna, uAntenna, uIndex, sIndex,
+                                                      rayAoa[nIndex][mIndex], rayZoa[nIndex][mIndex],
+                                                      rayAod[nIndex][mIndex], rayZod[nIndex][mIndex],
+                                                      clusterPhase[nIndex][mIndex], xpr[nIndex][mIndex]);
+                  uint8_t sub = 0;
+                  if (nIndex == cluster1st || nIndex == cluster2nd)
+                    {
+                      if ((mIndex >= 9 && mIndex <= 12) || mIndex == 17 || mIndex == 18)
+                        {
+                          sub = 1;
+                        }
+                      else if (mIndex >= 13 && mIndex <= 16)
+                        {
+                          sub = 2;
+                        }
+                    }
+                  raysSub[sub] += ray;
+                }
+
+              std::vector<std::pair<uint8_t, std::complex<double> > > expected;
+              expected.push_back (std::make_pair (nIndex, raysSub[0]));
+              if (nIndex == cluster1st || nIndex == cluster2nd)
+                {
+                  expected.push_back (std::make_pair (subClusterIndex++, raysSub[1]));
+                  expected.push_back (std::make_pair (subClusterIndex++, raysSub[2]));
+                }
+
+              for (auto e : expected)
+                {
+                  std::complex<double> h = e.second * sqrt (clusterPower[nIndex] / raysPerCluster);
+                  NS_TEST_ASSERT_MSG_EQ_TOL (H_usn[uIndex][sIndex][e.first].real (), h.real (), tolerance, "Real part mismatch for u=" << uIndex << " s=" << sIndex << " n=" << (uint16_t) e.first);
+                  NS_TEST_ASSERT_MSG_EQ_TOL (H_usn[uIndex][sIndex][e.first].imag (), h.imag (), tolerance, "Imaginary part mismatch for u=" << uIndex << " s=" << sIndex << " n=" << (uint16_t) e.first);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Test case for the ThreeGppBeamformingGainKernel class.
+ * It checks that all the supported implementations of the kernels return
+ * the same long term component and the same subband gains obtained with a
+ * direct evaluation, for both equally and non-equally spaced subbands.
+ */
+class ThreeGppBeamformingGainKernelTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppBeamformingGainKernelTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppBeamformingGainKernelTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Check the subband gains computed by the kernels
+   * \param bands the subbands
+   * \param clusterGain the complex gain of each cluster
+   * \param delay the delay of each cluster
+   */
+  void CheckSubbandGain (const Bands &bands,
+                         const ThreeGppAntennaArrayModel::ComplexVector &clusterGain,
+                         const MatrixBasedChannelModel::DoubleVector &delay);
+};
+
+ThreeGppBeamformingGainKernelTest::ThreeGppBeamformingGainKernelTest ()
+  : TestCase ("Check the implementations of the beamforming gain kernels")
+{
+}
+
+ThreeGppBeamformingGainKernelTest::~ThreeGppBeamformingGainKernelTest ()
+{
+}
+
+void
+ThreeGppBeamformingGainKernelTest::CheckSubbandGain (const Bands &bands,
+                                                     const ThreeGppAntennaArrayModel::ComplexVector &clusterGain,
+                                                     const MatrixBasedChannelModel::DoubleVector &delay)
+{
+  // leave some subbands empty
+  std::vector<double> psd (bands.size (), 1.0);
+  for (uint32_t bIndex = 0; bIndex < bands.size (); bIndex += 7)
+    {
+      psd[bIndex] = 0.0;
+    }
+
+  std::vector<double> expected (psd);
+  for (uint32_t bIndex = 0; bIndex < bands.size (); bIndex++)
+    {
+      if (expected[bIndex] != 0.0)
+        {
+          std::complex<double> subbandGain (0.0, 0.0);
+          for (uint32_t cIndex = 0; cIndex < clusterGain.size (); cIndex++)
+            {
+              subbandGain += clusterGain[cIndex] * exp (std::complex<double> (0, -2 * M_PI * bands[bIndex].fc * delay[cIndex]));
+            }
+          expected[bIndex] *= norm (subbandGain);
+        }
+    }
+
+  for (auto impl : {ThreeGppBeamformingGainKernel::SCALAR, ThreeGppBeamformingGainKernel::AVX2})
+    {
+      if (!ThreeGppBeamformingGainKernel::IsSupported (impl))
+        {
+          continue;
+        }
+      std::vector<double> out (psd);
+      ThreeGppBeamformingGainKernel::ApplySubbandGain (clusterGain, delay, bands.begin (), bands.end (), out.data (), impl);
+      for (uint32_t bIndex = 0; bIndex < bands.size (); bIndex++)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (out[bIndex], expected[bIndex], 1e-9 * expected[bIndex],
+                                     "Wrong gain for subband " << bIndex << " with implementation " << impl);
+        }
+
+      // check the precomputed delay phasors
+      ThreeGppAntennaArrayModel::ComplexVector delayPhasors = ThreeGppBeamformingGainKernel::CalcDelayPhasors (delay, clusterGain.size (), bands.begin (), bands.end ());
+      out = psd;
+      ThreeGppBeamformingGainKernel::ApplySubbandGain (clusterGain, delayPhasors, out.data (), out.size (), impl);
+      for (uint32_t bIndex = 0; bIndex < bands.size (); bIndex++)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (out[bIndex], expected[bIndex], 1e-9 * expected[bIndex],
+                                     "Wrong gain for subband " << bIndex << " with precomputed phasors and implementation " << impl);
+        }
+    }
+}
+
+void
+ThreeGppBeamformingGainKernelTest::DoRun (void)
+{
+  uint16_t uSize = 16;
+  uint16_t sSize = 7; // odd, to check the handling of the last element
+  uint16_t numCluster = 23;
+
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  rv->SetStream (2);
+
+  MatrixBasedChannelModel::Complex3DTensor channel (uSize, sSize, numCluster);
+  for (uint16_t u = 0; u < uSize; u++)
+    {
+      for (uint16_t s = 0; s < sSize; s++)
+        {
+          for (uint16_t n = 0; n < numCluster; n++)
+            {
+              channel (u, s, n) = std::complex<double> (rv->GetValue (-1, 1), rv->GetValue (-1, 1));
+            }
+        }
+    }
+  ThreeGppAntennaArrayModel::ComplexVector uW (uSize);
+  for (auto &w : uW)
+    {
+      w = std::polar (1 / std::sqrt (uSize), rv->GetValue (0, 2 * M_PI));
+    }
+  ThreeGppAntennaArrayModel::ComplexVector sW (sSize);
+  for (auto &w : sW)
+    {
+      w = std::polar (1 / std::sqrt (sSize), rv->GetValue (0, 2 * M_PI));
+    }
+
+  // check the long term component
+  for (auto impl : {ThreeGppBeamformingGainKernel::SCALAR, ThreeGppBeamformingGainKernel::AVX2})
+    {
+      if (!ThreeGppBeamformingGainKernel::IsSupported (impl))
+        {
+          continue;
+        }
+      ThreeGppAntennaArrayModel::ComplexVector longTerm = ThreeGppBeamformingGainKernel::CalcLongTerm (channel, sW, uW, impl);
+      NS_TEST_ASSERT_MSG_EQ (longTerm.size (), numCluster, "The long term should contain a value for each cluster");
+      for (uint16_t n = 0; n < numCluster; n++)
+        {
+          std::complex<double> expected (0, 0);
+          for (uint16_t s = 0; s < sSize; s++)
+            {
+              for (uint16_t u = 0; u < uSize; u++)
+                {
+                  expected += sW[s] * uW[u] * channel (u, s, n);
+                }
+            }
+          NS_TEST_ASSERT_MSG_EQ_TOL (std::abs (longTerm[n] - expected), 0, 1e-12, "Wrong long term for cluster " << n << " with implementation " << impl);
+        }
+    }
+
+  // a beamforming vector which is not set yet gives no signal
+  ThreeGppAntennaArrayModel::ComplexVector noBeam = ThreeGppBeamformingGainKernel::CalcLongTerm (channel, sW, ThreeGppAntennaArrayModel::ComplexVector ());
+  NS_TEST_ASSERT_MSG_EQ (noBeam.size (), numCluster, "The long term should contain a value for each cluster");
+  for (uint16_t n = 0; n < numCluster; n++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (std::abs (noBeam[n]), 0, "The long term should be null without a beam");
+    }
+
+  // check the subband gains
+  ThreeGppAntennaArrayModel::ComplexVector clusterGain (numCluster);
+  MatrixBasedChannelModel::DoubleVector delay (numCluster);
+  for (uint16_t n = 0; n < numCluster; n++)
+    {
+      clusterGain[n] = std::complex<double> (rv->GetValue (-1, 1), rv->GetValue (-1, 1));
+      delay[n] = rv->GetValue (0, 1e-6);
+    }
+
+  // equally spaced subbands, as in a mmWave carrier
+  Bands bands;
+  for (uint32_t bIndex = 0; bIndex < 1000; bIndex++)
+    {
+      BandInfo band;
+      band.fl = 28e9 + bIndex * 1.44e6;
+      band.fc = band.fl + 0.72e6;
+      band.fh = band.fl + 1.44e6;
+      bands.push_back (band);
+    }
+  CheckSubbandGain (bands, clusterGain, delay);
+
+  // non-equally spaced subbands
+  for (uint32_t bIndex = 0; bIndex < bands.size (); bIndex++)
+    {
+      bands[bIndex].fc += rv->GetValue (-1e5, 1e5);
+    }
+  CheckSubbandGain (bands, clusterGain, delay);
+}
+
 /**
  * Test case for the ThreeGppSpectrumPropagationLossModelTest class.
  * 1) checks if the long term components for the direct and the reverse link
@@ -528,7 +973,9 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun ()
   rxMob->SetPosition (Vector (10.0, 5.0, 10.0));
   ThreeGppAntennaArrayModel::ComplexVector txBfVector = txAntenna->GetBeamformingVector ();
   txBfVector [0] = std::complex<double> (0.0, 0.0);
+  uint64_t txBfVersion = txAntenna->GetBeamformingVectorVersion ();
   txAntenna->SetBeamformingVector (txBfVector);
+  NS_TEST_ASSERT_MSG_GT (txAntenna->GetBeamformingVectorVersion (), txBfVersion, "The version of the BF vector is not updated");
 
   rxPsdNew = lossModel->DoCalcRxPowerSpectralDensity (txPsd, rxMob, txMob);
   NS_TEST_ASSERT_MSG_EQ (ArePsdEqual (rxPsdOld, rxPsdNew),  false, "Changing the BF vectors the rx PSD does not change");
@@ -536,13 +983,225 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun ()
   // update rxPsdOld
   rxPsdOld = rxPsdNew;
 
-  // 3) check if the long term is updated when the channel matrix is recomputed
+  // 3) check that the rx PSD obtained with the cached delay phasors matches
+  // the one obtained computing the delay phasors on the fly
+  lossModel->SetAttribute ("MaxDelayPhasors", UintegerValue (0));
+  rxPsdNew = lossModel->DoCalcRxPowerSpectralDensity (txPsd, rxMob, txMob);
+  for (uint32_t i = 0; i < rxPsdOld->GetSpectrumModel ()->GetNumBands (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL ((*rxPsdNew) [i], (*rxPsdOld) [i], std::abs ((*rxPsdOld) [i]) * 1e-9, "The cached delay phasors give a different rx PSD");
+    }
+  lossModel->SetAttribute ("MaxDelayPhasors", UintegerValue (65536));
+
+  // 4) check if the long term is updated when the channel matrix is recomputed
   Simulator::Schedule (MilliSeconds (101), &ThreeGppSpectrumPropagationLossModelTest::CheckLongTermUpdate, this, lossModel, txPsd, txMob, rxMob, rxPsdOld);
 
   Simulator::Run ();
   Simulator::Destroy ();
 }
 
+/**
+ * Test case for the cache of the long term components of the
+ * ThreeGppSpectrumPropagationLossModel class.
+ * 1) check that the hits, misses and evictions are correctly counted when
+ *    the memory budget only allows a single entry
+ * 2) check that an evicted entry is recomputed without changing the rx PSD
+ * 3) check that the entries which are not used for longer than the timeout
+ *    are evicted
+ */
+class ThreeGppLongTermCacheTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppLongTermCacheTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppLongTermCacheTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Compute the rx PSD after the timeout and check the number of evictions
+   * \param lossModel the ThreeGppSpectrumPropagationLossModel object
+   * \param txPsd the PSD of the transmitted signal
+   * \param txMob the tx mobility model
+   * \param rxMob the rx mobility model
+   */
+  void CheckTimeout (Ptr<ThreeGppSpectrumPropagationLossModel> lossModel, Ptr<SpectrumValue> txPsd, Ptr<MobilityModel> txMob, Ptr<MobilityModel> rxMob);
+
+  /**
+   * Check the counters of the cache
+   * \param hits the expected number of hits
+   * \param misses the expected number of misses
+   * \param evictions the expected number of evictions
+   */
+  void CheckCounters (uint64_t hits, uint64_t misses, uint64_t evictions);
+
+  /**
+   * Callback of the LongTermCacheHits trace source
+   * \param oldValue the old value
+   * \param newValue the new value
+   */
+  void UpdateHits (uint64_t oldValue, uint64_t newValue);
+
+  /**
+   * Callback of the LongTermCacheMisses trace source
+   * \param oldValue the old value
+   * \param newValue the new value
+   */
+  void UpdateMisses (uint64_t oldValue, uint64_t newValue);
+
+  /**
+   * Callback of the LongTermCacheEvictions trace source
+   * \param oldValue the old value
+   * \param newValue the new value
+   */
+  void UpdateEvictions (uint64_t oldValue, uint64_t newValue);
+
+  uint64_t m_hits {0}; //!< number of hits
+  uint64_t m_misses {0}; //!< number of misses
+  uint64_t m_evictions {0}; //!< number of evictions
+};
+
+ThreeGppLongTermCacheTest::ThreeGppLongTermCacheTest ()
+  : TestCase ("Test case for the long term cache of the ThreeGppSpectrumPropagationLossModel class")
+{
+}
+
+ThreeGppLongTermCacheTest::~ThreeGppLongTermCacheTest ()
+{
+}
+
+void
+ThreeGppLongTermCacheTest::UpdateHits (uint64_t oldValue, uint64_t newValue)
+{
+  m_hits = newValue;
+}
+
+void
+ThreeGppLongTermCacheTest::UpdateMisses (uint64_t oldValue, uint64_t newValue)
+{
+  m_misses = newValue;
+}
+
+void
+ThreeGppLongTermCacheTest::UpdateEvictions (uint64_t oldValue, uint64_t newValue)
+{
+  m_evictions = newValue;
+}
+
+void
+ThreeGppLongTermCacheTest::CheckCounters (uint64_t hits, uint64_t misses, uint64_t evictions)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_hits, hits, "Unexpected number of hits");
+  NS_TEST_ASSERT_MSG_EQ (m_misses, misses, "Unexpected number of misses");
+  NS_TEST_ASSERT_MSG_EQ (m_evictions, evictions, "Unexpected number of evictions");
+}
+
+void
+ThreeGppLongTermCacheTest::CheckTimeout (Ptr<ThreeGppSpectrumPropagationLossModel> lossModel, Ptr<SpectrumValue> txPsd, Ptr<MobilityModel> txMob, Ptr<MobilityModel> rxMob)
+{
+  // the entry of the other rx node has not been used for longer than the
+  // timeout
+  lossModel->DoCalcRxPowerSpectralDensity (txPsd, txMob, rxMob);
+  CheckCounters (4, 5, 3);
+}
+
+void
+ThreeGppLongTermCacheTest::DoRun ()
+{
+  Ptr<ThreeGppSpectrumPropagationLossModel> lossModel = CreateObject<ThreeGppSpectrumPropagationLossModel> ();
+  lossModel->SetChannelModelAttribute ("Frequency", DoubleValue (2.4e9));
+  lossModel->SetChannelModelAttribute ("Scenario", StringValue ("UMa"));
+  lossModel->SetChannelModelAttribute ("ChannelConditionModel", PointerValue (CreateObject<AlwaysLosChannelConditionModel> ()));
+  lossModel->TraceConnectWithoutContext ("LongTermCacheHits", MakeCallback (&ThreeGppLongTermCacheTest::UpdateHits, this));
+  lossModel->TraceConnectWithoutContext ("LongTermCacheMisses", MakeCallback (&ThreeGppLongTermCacheTest::UpdateMisses, this));
+  lossModel->TraceConnectWithoutContext ("LongTermCacheEvictions", MakeCallback (&ThreeGppLongTermCacheTest::UpdateEvictions, this));
+
+  // create a tx node and two rx nodes
+  NodeContainer nodes;
+  nodes.Create (3);
+  std::vector<Ptr<MobilityModel> > mobs;
+  std::vector<Ptr<ThreeGppAntennaArrayModel> > antennas;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+      nodes.Get (i)->AddDevice (dev);
+      dev->SetNode (nodes.Get (i));
+
+      Ptr<MobilityModel> mob = CreateObject<ConstantPositionMobilityModel> ();
+      mob->SetPosition (Vector (i * 15.0, i * 5.0, 10.0));
+      nodes.Get (i)->AggregateObject (mob);
+      mobs.push_back (mob);
+
+      Ptr<ThreeGppAntennaArrayModel> antenna = CreateObjectWithAttributes<ThreeGppAntennaArrayModel> ("NumColumns", UintegerValue (2), "NumRows", UintegerValue (2));
+      ThreeGppAntennaArrayModel::ComplexVector bfVector (antenna->GetNumberOfElements (), std::complex<double> (0.5, 0.0));
+      antenna->SetBeamformingVector (bfVector);
+      lossModel->AddDevice (dev, antenna);
+      antennas.push_back (antenna);
+    }
+
+  WifiSpectrumValue5MhzFactory sf;
+  Ptr<SpectrumValue> txPsd = sf.CreateTxPowerSpectralDensity (0.1, 1);
+
+  // 1) with a budget of one byte only the entry in use is kept
+  lossModel->SetAttribute ("LongTermCacheMaxMemory", UintegerValue (1));
+  Ptr<SpectrumValue> rxPsd1 = lossModel->DoCalcRxPowerSpectralDensity (txPsd, mobs[0], mobs[1]);
+  CheckCounters (0, 1, 0);
+  lossModel->DoCalcRxPowerSpectralDensity (txPsd, mobs[1], mobs[0]);
+  CheckCounters (1, 1, 0);
+  lossModel->DoCalcRxPowerSpectralDensity (txPsd, mobs[0], mobs[2]);
+  CheckCounters (1, 2, 1);
+
+  // 2) the evicted entry is recomputed and gives the same rx PSD
+  Ptr<SpectrumValue> rxPsd2 = lossModel->DoCalcRxPowerSpectralDensity (txPsd, mobs[0], mobs[1]);
+  CheckCounters (1, 3, 2);
+  for (uint32_t i = 0; i < rxPsd1->GetSpectrumModel ()->GetNumBands (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*rxPsd1) [i], (*rxPsd2) [i], "The rx PSD changed after the eviction of the long term");
+    }
+
+  // 3) without memory limits, the entry not used for longer than the timeout
+  // is evicted
+  lossModel->SetAttribute ("LongTermCacheMaxMemory", UintegerValue (0));
+  lossModel->SetAttribute ("LongTermCacheTimeout", TimeValue (MilliSeconds (10)));
+  lossModel->DoCalcRxPowerSpectralDensity (txPsd, mobs[0], mobs[2]);
+  CheckCounters (1, 4, 2);
+  lossModel->DoCalcRxPowerSpectralDensity (txPsd, mobs[0], mobs[1]);
+  CheckCounters (2, 4, 2);
+
+  // 4) setting the same beamforming vector again keeps its version, and the
+  // long term is still valid, while a different vector gets a new version
+  ThreeGppAntennaArrayModel::ComplexVector bfVector = antennas[0]->GetBeamformingVector ();
+  uint64_t version = antennas[0]->GetBeamformingVectorVersion ();
+  antennas[0]->SetBeamformingVector (bfVector);
+  NS_TEST_ASSERT_MSG_EQ (antennas[0]->GetBeamformingVectorVersion (), version, "The version changed for the same BF vector");
+  lossModel->DoCalcRxPowerSpectralDensity (txPsd, mobs[0], mobs[1]);
+  CheckCounters (3, 4, 2);
+  bfVector[0] = std::complex<double> (0.0, 0.5);
+  antennas[1]->SetBeamformingVector (bfVector);
+  NS_TEST_ASSERT_MSG_GT (antennas[1]->GetBeamformingVectorVersion (), version, "The version did not change for a new BF vector");
+  version = antennas[1]->GetBeamformingVectorVersion ();
+  antennas[1]->ChangeToOmniTx ();
+  antennas[1]->SetBeamformingVector (bfVector);
+  NS_TEST_ASSERT_MSG_GT (antennas[1]->GetBeamformingVectorVersion (), version, "The version did not change after an omni transmission");
+  lossModel->DoCalcRxPowerSpectralDensity (txPsd, mobs[0], mobs[1]);
+  CheckCounters (3, 5, 2);
+
+  Simulator::Schedule (MilliSeconds (20), &ThreeGppLongTermCacheTest::CheckTimeout, this, lossModel, txPsd, mobs[0], mobs[1]);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup spectrum
  *
@@ -562,7 +1221,11 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite ()
 {
   AddTestCase (new ThreeGppChannelMatrixComputationTest, TestCase::QUICK);
   AddTestCase (new ThreeGppChannelMatrixUpdateTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppClusterCoefficientsTest, TestCase::QUICK);
+  AddTestCase (new Complex3DTensorTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppBeamformingGainKernelTest, TestCase::QUICK);
   AddTestCase (new ThreeGppSpectrumPropagationLossModelTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppLongTermCacheTest, TestCase::QUICK);
 }
 
 static ThreeGppChannelTestSuite myTestSuite;